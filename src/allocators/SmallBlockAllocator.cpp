@@ -99,9 +99,12 @@ void* SmallBlockAllocator::allocate(u64 size)
         return allocate_raw(size);
     }
 
+    // blocks of the same slot are interchangeable on
+    // the free lists, so they must all be the same size
+    auto slot_index = get_slot_index_for_size(size);
+    size = (slot_index + 1) << sc_alignment;
     m_bytes_allocated += size;
 
-    auto slot_index = get_slot_index_for_size(size);
     AURUM_ASSERT((slot_index < sc_num_buckets));
     if (m_free_lists[slot_index] != nullptr) {
         auto retval = m_free_lists[slot_index];
@@ -141,9 +144,9 @@ void SmallBlockAllocator::deallocate(void *block_ptr, u64 block_size)
         // memory manager
         return deallocate_raw(block_ptr, block_size);
     }
-    m_bytes_allocated -= block_size;
-
     auto slot_index = get_slot_index_for_size(block_size);
+    m_bytes_allocated -= ((slot_index + 1) << sc_alignment);
+
     auto block_ptr_as_block_list = static_cast<BlockList*>(block_ptr);
     block_ptr_as_block_list->m_next = m_free_lists[slot_index];
     m_free_lists[slot_index] = block_ptr_as_block_list;
@@ -210,7 +213,8 @@ void SmallBlockAllocator::garbage_collect()
         auto head_ptr = m_chunks[i];
         auto chunk_ptr = m_chunks[i];
         auto prev_chunk_ptr = m_chunks[i];
-        for (; chunk_ptr != nullptr; chunk_ptr = chunk_ptr->m_next_chunk) {
+        for (Chunk* next_chunk_ptr = nullptr; chunk_ptr != nullptr; chunk_ptr = next_chunk_ptr) {
+            next_chunk_ptr = chunk_ptr->m_next_chunk;
             auto num_blocks_in_chunk =
                 (chunk_ptr->m_current_ptr - chunk_ptr->m_data) / slot_size;
             auto num_free_blocks_in_chunk =
@@ -223,10 +227,11 @@ void SmallBlockAllocator::garbage_collect()
                 m_bytes_claimed -= sc_page_size;
 
                 if (chunk_ptr == head_ptr) {
-                    m_chunks[i] = chunk_ptr->m_next_chunk;
-                    head_ptr = chunk_ptr->m_next_chunk;
+                    m_chunks[i] = next_chunk_ptr;
+                    head_ptr = next_chunk_ptr;
+                    prev_chunk_ptr = next_chunk_ptr;
                 } else {
-                    prev_chunk_ptr->m_next_chunk = chunk_ptr->m_next_chunk;
+                    prev_chunk_ptr->m_next_chunk = next_chunk_ptr;
                 }
                 continue;
             }
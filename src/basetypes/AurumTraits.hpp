@@ -42,6 +42,7 @@
 
 #include "AurumTypes.hpp"
 #include "../memory/ManagedPointer.hpp"
+#include "../memory/TaggedManagedPointer.hpp"
 
 namespace aurum {
 
@@ -299,12 +300,57 @@ struct RemovePointer<memory::ManagedConstPointer<T> >
     typedef T type;
 };
 
+// tagged managed pointers are hashable, comparable
+// and printable, like managed pointers
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct IsStringifiable<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+    : detail_::TrueStruct
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct IsHashable<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+    : detail_::TrueStruct
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct IsEComparable<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+    : detail_::TrueStruct
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct IsComparable<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+    : detail_::TrueStruct
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct IsPtrLike<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+    : detail_::TrueStruct
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+struct RemovePointer<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+{
+    typedef T type;
+};
+
 template <typename T>
 struct IsRefCountable
     : std::conditional<std::is_base_of<detail_::RefCountableEBC, T>::value,
                        detail_::TrueStruct, detail_::FalseStruct>::type
 {};
 
+template <typename T>
+struct IsAtomicRefCountable
+    : std::conditional<std::is_base_of<detail_::AtomicRefCountableEBC, T>::value,
+                       detail_::TrueStruct, detail_::FalseStruct>::type
+{};
+
+template <typename T>
+struct IsBiasedRefCountable
+    : std::conditional<std::is_base_of<detail_::BiasedRefCountableEBC, T>::value,
+                       detail_::TrueStruct, detail_::FalseStruct>::type
+{};
+
 } /* end namespace aurum */
 
 #endif /* AURUM_BASETYPES_AURUM_TRAITS_HPP_ */
@@ -100,15 +100,14 @@ public:
         aa::deallocate_raw(ptr, sz);
     }
 
-    inline AurumObject()
+    // constexpr and trivially destructible, so that derived
+    // classes with trivial members can still be literal types
+    constexpr AurumObject()
     {
         // Nothing here
     }
 
-    inline ~AurumObject()
-    {
-        // Nothing here
-    }
+    ~AurumObject() = default;
 };
 
 namespace detail_ {
@@ -199,6 +198,8 @@ class EComparableEBC;
 class ComparableEBC;
 class CloneableEBC;
 class RefCountableEBC;
+class AtomicRefCountableEBC;
+class BiasedRefCountableEBC;
 
 } /* end namespace detail_ */
 
@@ -209,6 +210,8 @@ template <typename Derived> class EComparable;
 template <typename Derived> class Comparable;
 template <typename Derived> class Clonable;
 template <typename Derived> class RefCountable;
+template <typename Derived> class AtomicRefCountable;
+template <typename Derived> class BiasedRefCountable;
 
 class Interruptible
 {
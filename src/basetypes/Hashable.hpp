@@ -40,6 +40,8 @@
 #if !defined AURUM_BASETYPES_HASHABLE_HPP_
 #define AURUM_BASETYPES_HASHABLE_HPP_
 
+#include <atomic>
+
 #include "AurumTypes.hpp"
 
 namespace aurum {
@@ -53,7 +55,22 @@ class HashableEBC
 
 } /* end namespace detail_ */
 
-// A base class for Hashable objects
+// A base class for Hashable objects. The derived class provides
+//   u64 compute_hash_value() const;
+// which hash() calls once, on first use, and caches the result of.
+// Objects that hash their children through hash() (or aurum_hash(),
+// or a DeepHasher) therefore hash a shared child only once, so that
+// hashing a DAG takes time linear in the number of its nodes.
+// Derived classes that can be mutated must call
+// invalidate_hash_value() on every mutation that changes the
+// hash value. Mutating a child does not invalidate the hash
+// values cached by its parents, so the children of objects hashed
+// this way should be immutable, as they are in a RefCache
+// hash() may be called concurrently on an object shared by several
+// threads (as a ConcurrentRefCache does): the cached value is read
+// and written with single relaxed atomic operations, and each thread
+// computing it stores the same value. Invalidation, like any other
+// mutation, must not race with uses of the object
 template <typename DerivedClass>
 class Hashable : public detail_::HashableEBC
 {
@@ -61,19 +78,25 @@ private:
     class HashValue
     {
     private:
-        mutable bool m_hash_valid : 1;
-        mutable u64 m_hash_value : 63;
+        // the hash value, truncated to its low order 63 bits, is
+        // kept in the high bits of a single word, with the valid
+        // bit in the low bit, so that both are written by one store.
+        // Threads that share the object may race to compute the hash
+        // value, but they all store the same word, and never observe
+        // a valid bit without its value
+        mutable std::atomic<u64> m_word;
+
+        static constexpr u64 sc_valid_bit = 1;
 
     public:
         inline HashValue()
-            : m_hash_valid(false), m_hash_value(0)
+            : m_word((u64)0)
         {
             // Nothing here
         }
 
         inline HashValue(const HashValue& other)
-            : m_hash_valid(other.m_hash_valid),
-              m_hash_value(other.m_hash_value)
+            : m_word(other.m_word.load(std::memory_order_relaxed))
         {
             // Nothing here
         }
@@ -83,37 +106,35 @@ private:
             if (&other == this) {
                 return *this;
             }
-            m_hash_valid = other.m_hash_valid;
-            m_hash_value = other.m_hash_value;
+            m_word.store(other.m_word.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
             return *this;
         }
 
         inline HashValue(u64 hash_value)
-            : m_hash_valid(true), m_hash_value(hash_value)
+            : m_word((hash_value << 1) | sc_valid_bit)
         {
             // Nothing here
         }
 
         inline bool is_hash_valid() const
         {
-            return m_hash_valid;
+            return ((m_word.load(std::memory_order_relaxed) & sc_valid_bit) != 0);
         }
 
         inline u64 get_hash_value() const
         {
-            return m_hash_value;
+            return (m_word.load(std::memory_order_relaxed) >> 1);
         }
 
         inline void set_hash_value(u64 hash_value) const
         {
-            m_hash_valid = true;
-            m_hash_value = false;
+            m_word.store((hash_value << 1) | sc_valid_bit, std::memory_order_relaxed);
         }
 
         inline void clear_hash_value() const
         {
-            m_hash_valid = false;
-            m_hash_value = (u64)0;
+            m_word.store((u64)0, std::memory_order_relaxed);
         }
     };
 
@@ -143,21 +164,45 @@ public:
 
     inline u64 hash() const
     {
-        if (m_hash_value.is_hash_valid()) {
-            return m_hash_value.get_hash_value();
+        // a single load, so that the valid bit and the
+        // value are read together
+        HashValue hash_value(m_hash_value);
+        if (hash_value.is_hash_valid()) {
+            return hash_value.get_hash_value();
         } else {
             auto this_as_derived = static_cast<const DerivedClass*>(this);
-            m_hash_value.set_hash_value(this_as_derived->compute_hash_value());
-            return m_hash_value.get_hash_value();
+            auto raw_hash_value = this_as_derived->compute_hash_value();
+            m_hash_value.set_hash_value(raw_hash_value);
+            return get_hash_value_for(raw_hash_value);
         }
     }
 
+    inline bool is_hash_value_cached() const
+    {
+        return m_hash_value.is_hash_valid();
+    }
+
+    // forces the hash value to be recomputed on next use
     inline void invalidate_hash_value() const
     {
         m_hash_value.clear_hash_value();
     }
+
+    // the value that hash() returns for an object whose
+    // compute_hash_value() returns raw_hash_value, so that
+    // objects can be looked up by a hash value computed
+    // without constructing them
+    static inline u64 get_hash_value_for(u64 raw_hash_value)
+    {
+        HashValue hash_value;
+        hash_value.set_hash_value(raw_hash_value);
+        return hash_value.get_hash_value();
+    }
 };
 
+template <typename DerivedClass>
+constexpr u64 Hashable<DerivedClass>::HashValue::sc_valid_bit;
+
 } /* end namespace aurum */
 
 #endif /* AURUM_BASETYPES_HASHABLE_HPP_ */
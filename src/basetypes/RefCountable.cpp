@@ -0,0 +1,257 @@
+// RefCountable.cpp ---
+//
+// Filename: RefCountable.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 03:52:47 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "RefCountable.hpp"
+
+namespace aurum {
+namespace detail_ {
+
+namespace {
+
+typedef std::pair<const void*, BiasedRefCounting::MergeFunction> QueuedObject;
+
+struct ThreadEntry
+{
+    BiasedRefCounting::ThreadState* m_state;
+    std::vector<QueuedObject> m_queued_objects;
+};
+
+// The threads which own biased objects, and the objects queued for them.
+// A thread is removed when it exits, so that the threads which release
+// its objects after that merge them on their own
+class ThreadRegistry
+{
+private:
+    std::mutex m_mutex;
+    std::unordered_map<u64, ThreadEntry> m_threads;
+    u64 m_next_token;
+
+public:
+    ThreadRegistry()
+        : m_mutex(), m_threads(), m_next_token(1)
+    {
+        // Nothing here
+    }
+
+    u64 add_thread(BiasedRefCounting::ThreadState* state)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto token = m_next_token++;
+        m_threads[token] = ThreadEntry { state, std::vector<QueuedObject>() };
+        return token;
+    }
+
+    bool queue(u64 owner_token, const void* object, BiasedRefCounting::MergeFunction merge_fun)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_threads.find(owner_token);
+        if (it == m_threads.end()) {
+            return false;
+        }
+        it->second.m_queued_objects.push_back(QueuedObject(object, merge_fun));
+        it->second.m_state->m_has_queued_objects.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::vector<QueuedObject> take_queued_objects(u64 token, bool remove_thread)
+    {
+        std::vector<QueuedObject> retval;
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto it = m_threads.find(token);
+        if (it == m_threads.end()) {
+            return retval;
+        }
+        retval.swap(it->second.m_queued_objects);
+        it->second.m_state->m_has_queued_objects.store(false, std::memory_order_relaxed);
+        if (remove_thread) {
+            m_threads.erase(it);
+        }
+        return retval;
+    }
+};
+
+static inline ThreadRegistry& get_thread_registry()
+{
+    static ThreadRegistry s_registry;
+    return s_registry;
+}
+
+static inline void merge_objects(const std::vector<QueuedObject>& objects)
+{
+    for (auto const& queued_object : objects) {
+        queued_object.second(queued_object.first);
+    }
+}
+
+// merges whatever is queued for a thread when it exits. Objects
+// queued while their merges delete other objects are merged as well
+class ThreadExitHook
+{
+private:
+    u64 m_token;
+
+public:
+    explicit ThreadExitHook(u64 token)
+        : m_token(token)
+    {
+        // Nothing here
+    }
+
+    ~ThreadExitHook()
+    {
+        auto& registry = get_thread_registry();
+        auto queued_objects = registry.take_queued_objects(m_token, false);
+        while (queued_objects.size() > 0) {
+            merge_objects(queued_objects);
+            queued_objects = registry.take_queued_objects(m_token, false);
+        }
+        // objects queued from here on are merged by whoever queues them
+        merge_objects(registry.take_queued_objects(m_token, true));
+    }
+};
+
+} /* end anonymous namespace */
+
+u64 BiasedRefCounting::register_current_thread(ThreadState* state)
+{
+    auto token = get_thread_registry().add_thread(state);
+    static thread_local ThreadExitHook s_exit_hook(token);
+    return token;
+}
+
+bool BiasedRefCounting::queue_for_merge(u64 owner_token, const void* object,
+                                        MergeFunction merge_fun)
+{
+    return get_thread_registry().queue(owner_token, object, merge_fun);
+}
+
+void BiasedRefCounting::merge_queued_objects()
+{
+    auto token = get_current_thread_state().m_token;
+    if (token == 0) {
+        return;
+    }
+    merge_objects(get_thread_registry().take_queued_objects(token, false));
+}
+
+namespace {
+
+// The controls are spread over shards by the address of their
+// object, so that threads which create and expire weak references
+// to their own objects rarely wait for each other
+class ControlTable
+{
+private:
+    static constexpr u64 sc_shard_bits = 6;
+    static constexpr u64 sc_num_shards = ((u64)1 << sc_shard_bits);
+
+    struct alignas(64) Shard
+    {
+        std::mutex m_mutex;
+        std::unordered_map<const void*, WeakReferenceControl*> m_controls;
+    };
+
+    Shard m_shards[sc_num_shards];
+
+    // the multiplication moves the bits that vary
+    // between addresses into the top bits
+    inline Shard& get_shard(const void* object)
+    {
+        auto index = ((u64)object * 0x9E3779B97F4A7C15ull) >> (64 - sc_shard_bits);
+        return m_shards[index];
+    }
+
+public:
+    ControlTable()
+    {
+        // Nothing here
+    }
+
+    WeakReferenceControl* get_control(const void* object)
+    {
+        auto& shard = get_shard(object);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto& control = shard.m_controls[object];
+        if (control == nullptr) {
+            control = new WeakReferenceControl();
+        }
+        return control;
+    }
+
+    WeakReferenceControl* remove_control(const void* object)
+    {
+        auto& shard = get_shard(object);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto it = shard.m_controls.find(object);
+        auto retval = it->second;
+        shard.m_controls.erase(it);
+        return retval;
+    }
+};
+
+constexpr u64 ControlTable::sc_shard_bits;
+constexpr u64 ControlTable::sc_num_shards;
+
+static inline ControlTable& get_control_table()
+{
+    static ControlTable s_table;
+    return s_table;
+}
+
+} /* end anonymous namespace */
+
+WeakReferenceControl* WeakReferenceTable::get_control(const void* object)
+{
+    return get_control_table().get_control(object);
+}
+
+WeakReferenceControl* WeakReferenceTable::remove_control(const void* object)
+{
+    return get_control_table().remove_control(object);
+}
+
+} /* end namespace detail_ */
+} /* end namespace aurum */
+
+//
+// RefCountable.cpp ends here
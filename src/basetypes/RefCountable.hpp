@@ -42,6 +42,7 @@
 #if !defined AURUM_BASETYPES_REF_COUNTABLE_HPP_
 #define AURUM_BASETYPES_REF_COUNTABLE_HPP_
 
+#include <atomic>
 #include <type_traits>
 
 #include "AurumBase.hpp"
@@ -55,17 +56,223 @@ class RefCountableEBC
     // Empty base class
 };
 
+class AtomicRefCountableEBC : public RefCountableEBC
+{
+    // Empty base class
+};
+
+class BiasedRefCountableEBC : public RefCountableEBC
+{
+    // Empty base class
+};
+
+// Support for BiasedRefCountable: identifies threads, and queues objects
+// whose shared counts went negative for their owners to merge
+class BiasedRefCounting
+{
+public:
+    typedef void (*MergeFunction)(const void* object);
+
+    struct ThreadState
+    {
+        // zero until the thread first creates a biased object
+        u64 m_token;
+        // set when objects have been queued for this thread
+        std::atomic<bool> m_has_queued_objects;
+
+        constexpr ThreadState()
+            : m_token(0), m_has_queued_objects(false)
+        {
+            // Nothing here
+        }
+    };
+
+private:
+    static u64 register_current_thread(ThreadState* state);
+
+public:
+    static inline ThreadState& get_current_thread_state()
+    {
+        static thread_local ThreadState s_state;
+        return s_state;
+    }
+
+    // a token that identifies the calling thread, never reused
+    static inline u64 get_current_thread_token()
+    {
+        auto& state = get_current_thread_state();
+        if (state.m_token == 0) {
+            state.m_token = register_current_thread(&state);
+        }
+        return state.m_token;
+    }
+
+    // queues the object for the owner thread to merge, returns
+    // false if the owner has exited, in which case the caller
+    // is responsible for merging the object
+    static bool queue_for_merge(u64 owner_token, const void* object, MergeFunction merge_fun);
+
+    // merges the objects queued for the calling thread
+    static void merge_queued_objects();
+
+    static inline void poll()
+    {
+        if (get_current_thread_state().m_has_queued_objects.load(std::memory_order_relaxed)) {
+            merge_queued_objects();
+        }
+    }
+};
+
+} /* end namespace detail_ */
+
+// Storage that objects can be constructed in, by placing them
+// after a RefCountableStorageHeader in a block obtained from it.
+// When the last reference to such an object is released, the block
+// goes back to the storage, instead of the object being deleted
+class RefCountableStorage
+{
+public:
+    virtual ~RefCountableStorage()
+    {
+        // Nothing here
+    }
+
+    virtual void release_block(void* block, u64 block_size) = 0;
+};
+
+struct RefCountableStorageHeader
+{
+    RefCountableStorage* m_storage;
+    u64 m_block_size;
+};
+
+// The shared state of the weak references to a RefCountable object,
+// which outlives the object for as long as weak references to it
+// remain. Whoever owns the object can also register a handler,
+// which is called when the object expires: after its last strong
+// reference is released, but before it is destroyed.
+// Weak references follow the threading rules of the object's
+// strong references: RefCountable objects are confined to a thread
+class WeakReferenceControl
+{
+public:
+    typedef void (*ExpiryHandler)(void* context, const void* object);
+
+private:
+    bool m_expired;
+    u64 m_num_weak_refs;
+    ExpiryHandler m_expiry_handler;
+    void* m_expiry_context;
+
+public:
+    inline WeakReferenceControl()
+        : m_expired(false), m_num_weak_refs(0),
+          m_expiry_handler(nullptr), m_expiry_context(nullptr)
+    {
+        // Nothing here
+    }
+
+    inline bool is_expired() const
+    {
+        return m_expired;
+    }
+
+    inline void inc_weak_ref()
+    {
+        ++m_num_weak_refs;
+    }
+
+    inline void dec_weak_ref()
+    {
+        --m_num_weak_refs;
+        if (m_expired && m_num_weak_refs == 0) {
+            delete this;
+        }
+    }
+
+    // the handler is called with the context, and with the object
+    // as the RefCountable<T> base of the T that expires
+    inline void set_expiry_handler(ExpiryHandler expiry_handler, void* expiry_context)
+    {
+        m_expiry_handler = expiry_handler;
+        m_expiry_context = expiry_context;
+    }
+
+    inline void expire(const void* object)
+    {
+        m_expired = true;
+        if (m_expiry_handler != nullptr) {
+            m_expiry_handler(m_expiry_context, object);
+        }
+        if (m_num_weak_refs == 0) {
+            delete this;
+        }
+    }
+};
+
+namespace detail_ {
+
+// The weak reference controls of the objects that have them, kept
+// on the side, so that objects without weak references pay one
+// bit for the ability to have them
+class WeakReferenceTable
+{
+public:
+    // creates the control if the object does not have one yet
+    static WeakReferenceControl* get_control(const void* object);
+    // removes the control of the object from the table
+    static WeakReferenceControl* remove_control(const void* object);
+};
+
 } /* end namespace detail_ */
 
 template <typename DerivedClass>
 class RefCountable : public detail_::RefCountableEBC
 {
 private:
-    mutable i64 m_ref_count_;
+    mutable i64 m_ref_count_ : 62;
+    // whether the object lives in a RefCountableStorage
+    mutable u64 m_in_storage_ : 1;
+    // whether the object has a WeakReferenceControl
+    mutable u64 m_has_weak_control_ : 1;
+
+    static inline const void* get_object_start_(const DerivedClass* object,
+                                                 const std::true_type& is_polymorphic_value)
+    {
+        return dynamic_cast<const void*>(object);
+    }
+
+    static inline const void* get_object_start_(const DerivedClass* object,
+                                                 const std::false_type& is_polymorphic_value)
+    {
+        return object;
+    }
+
+    inline void release_to_storage_(const DerivedClass* object) const
+    {
+        typename std::is_polymorphic<DerivedClass>::type is_polymorphic_value;
+        // the header is outside the object, as far as the compiler
+        // can tell, so the address is computed as an integer
+        auto object_start = reinterpret_cast<uintptr_t>(get_object_start_(object, is_polymorphic_value));
+        auto header = reinterpret_cast<RefCountableStorageHeader*>
+            (object_start - sizeof(RefCountableStorageHeader));
+        auto storage = header->m_storage;
+        auto block_size = header->m_block_size;
+
+        object->~DerivedClass();
+        storage->release_block(header, block_size);
+    }
 
 public:
     inline RefCountable()
-        : m_ref_count_((i64)0)
+        : m_ref_count_((i64)0), m_in_storage_(0), m_has_weak_control_(0)
+    {
+        // Nothing here
+    }
+
+    // a copy is a new object, nobody refers to it yet
+    inline RefCountable(const RefCountable& other)
+        : m_ref_count_((i64)0), m_in_storage_(0), m_has_weak_control_(0)
     {
         // Nothing here
     }
@@ -75,6 +282,12 @@ public:
         // Nothing here
     }
 
+    inline RefCountable& operator = (const RefCountable& other)
+    {
+        // the references are to this object, not to its value
+        return *this;
+    }
+
     inline void inc_ref_() const
     {
         m_ref_count_++;
@@ -85,7 +298,15 @@ public:
         m_ref_count_--;
         if (m_ref_count_ <= 0) {
             auto this_as_derived = static_cast<const DerivedClass*>(this);
-            delete this_as_derived;
+            if (m_has_weak_control_ != 0) {
+                m_has_weak_control_ = 0;
+                detail_::WeakReferenceTable::remove_control(this)->expire(this);
+            }
+            if (m_in_storage_ != 0) {
+                release_to_storage_(this_as_derived);
+            } else {
+                delete this_as_derived;
+            }
         }
     }
 
@@ -93,8 +314,265 @@ public:
     {
         return m_ref_count_;
     }
+
+    // marks the object as constructed in a RefCountableStorage
+    inline void set_in_storage_() const
+    {
+        m_in_storage_ = 1;
+    }
+
+    inline WeakReferenceControl* get_weak_reference_control_() const
+    {
+        m_has_weak_control_ = 1;
+        return detail_::WeakReferenceTable::get_control(this);
+    }
 };
 
+// A ref countable type whose references can be taken and
+// released concurrently from several threads, at the cost of an
+// atomic read-modify-write for each of them
+template <typename DerivedClass>
+class AtomicRefCountable : public detail_::AtomicRefCountableEBC
+{
+private:
+    mutable std::atomic<i64> m_ref_count_;
+
+public:
+    inline AtomicRefCountable()
+        : m_ref_count_((i64)0)
+    {
+        // Nothing here
+    }
+
+    // a copy is a new object, nobody refers to it yet
+    inline AtomicRefCountable(const AtomicRefCountable& other)
+        : m_ref_count_((i64)0)
+    {
+        // Nothing here
+    }
+
+    inline ~AtomicRefCountable()
+    {
+        // Nothing here
+    }
+
+    inline AtomicRefCountable& operator = (const AtomicRefCountable& other)
+    {
+        // the references are to this object, not to its value
+        return *this;
+    }
+
+    inline void inc_ref_() const
+    {
+        m_ref_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void dec_ref_() const
+    {
+        // the release orders our uses of the object before its
+        // deletion, the acquire in the deleting thread pairs with it
+        if (m_ref_count_.fetch_sub(1, std::memory_order_release) <= 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            auto this_as_derived = static_cast<const DerivedClass*>(this);
+            delete this_as_derived;
+        }
+    }
+
+    inline i64 get_ref_count_() const
+    {
+        return m_ref_count_.load(std::memory_order_acquire);
+    }
+};
+
+// A ref countable type whose references can be shared across threads,
+// but which are cheap to take and release on the thread that created
+// the object (the owner), as with biased reference counting: the owner
+// counts its references in a plain counter, other threads in an atomic
+// counter. The two counts are merged when the owner's count drops to
+// zero, and the object is deleted when the merged count does.
+// References that the owner takes but other threads release (say, by
+// moving a ManagedPointer to another thread) drive the shared count
+// negative. Such objects are queued for the owner, which merges them
+// the next time one of its own counts drops to zero, when it calls
+// merge_queued_ref_counts(), or when it exits, whichever is first.
+// get_ref_count_() is exact only on the owner thread, and only
+// as long as no other thread holds references.
+template <typename DerivedClass>
+class BiasedRefCountable : public detail_::BiasedRefCountableEBC
+{
+private:
+    typedef detail_::BiasedRefCounting BRC;
+
+    // the shared count is kept in units of four,
+    // with two flags in the low order bits
+    static constexpr i64 sc_merged_flag_ = 1;
+    static constexpr i64 sc_queued_flag_ = 2;
+    static constexpr i64 sc_flag_mask_ = 3;
+    static constexpr i64 sc_count_unit_ = 4;
+
+    const u64 m_owner_token_;
+    // only accessed by the owner thread
+    mutable i64 m_biased_count_;
+    mutable bool m_merged_;
+    mutable std::atomic<i64> m_shared_count_;
+
+    static inline i64 get_count_(i64 shared_count)
+    {
+        return ((shared_count - (shared_count & sc_flag_mask_)) / sc_count_unit_);
+    }
+
+    inline bool is_owner_() const
+    {
+        return (m_owner_token_ == BRC::get_current_thread_token() && !m_merged_);
+    }
+
+    inline void delete_this_() const
+    {
+        auto this_as_derived = static_cast<const DerivedClass*>(this);
+        delete this_as_derived;
+    }
+
+    // called by the owner when its count drops to zero
+    inline void merge_on_owner_() const
+    {
+        m_merged_ = true;
+        auto old_count = m_shared_count_.fetch_add(sc_merged_flag_, std::memory_order_acq_rel);
+        // queued objects are left to the queue
+        if (get_count_(old_count) == 0 && (old_count & sc_queued_flag_) == 0) {
+            delete_this_();
+        }
+        BRC::poll();
+    }
+
+    // called on queued objects, by the owner or, if the
+    // owner has exited, by the thread which queued them
+    inline void merge_queued_() const
+    {
+        i64 delta = -sc_queued_flag_;
+        if (!m_merged_) {
+            m_merged_ = true;
+            delta += (m_biased_count_ * sc_count_unit_) + sc_merged_flag_;
+            m_biased_count_ = 0;
+        }
+        auto old_count = m_shared_count_.fetch_add(delta, std::memory_order_acq_rel);
+        if (get_count_(old_count + delta) == 0) {
+            delete_this_();
+        }
+    }
+
+    static inline void merge_queued_object_(const void* object)
+    {
+        static_cast<const BiasedRefCountable*>(object)->merge_queued_();
+    }
+
+    inline void dec_shared_ref_() const
+    {
+        auto old_count = m_shared_count_.fetch_sub(sc_count_unit_, std::memory_order_acq_rel);
+        auto new_count = get_count_(old_count) - 1;
+
+        if ((old_count & sc_merged_flag_) != 0) {
+            if (new_count == 0 && (old_count & sc_queued_flag_) == 0) {
+                delete_this_();
+            }
+            return;
+        }
+
+        // the remaining references, if any, were counted by
+        // the owner, and only the owner can reconcile the counts
+        if (new_count <= 0 && (old_count & sc_queued_flag_) == 0) {
+            auto prev_count = m_shared_count_.fetch_or(sc_queued_flag_, std::memory_order_acq_rel);
+            if ((prev_count & sc_queued_flag_) == 0 &&
+                !BRC::queue_for_merge(m_owner_token_, this, &merge_queued_object_)) {
+                merge_queued_();
+            }
+        }
+    }
+
+public:
+    inline BiasedRefCountable()
+        : m_owner_token_(BRC::get_current_thread_token()),
+          m_biased_count_((i64)0), m_merged_(false), m_shared_count_((i64)0)
+    {
+        // Nothing here
+    }
+
+    // a copy is a new object, nobody refers to it yet
+    inline BiasedRefCountable(const BiasedRefCountable& other)
+        : BiasedRefCountable()
+    {
+        // Nothing here
+    }
+
+    inline ~BiasedRefCountable()
+    {
+        // Nothing here
+    }
+
+    inline BiasedRefCountable& operator = (const BiasedRefCountable& other)
+    {
+        // the references are to this object, not to its value
+        return *this;
+    }
+
+    inline void inc_ref_() const
+    {
+        if (is_owner_()) {
+            ++m_biased_count_;
+        } else {
+            m_shared_count_.fetch_add(sc_count_unit_, std::memory_order_relaxed);
+        }
+    }
+
+    inline void dec_ref_() const
+    {
+        if (!is_owner_()) {
+            dec_shared_ref_();
+        } else if (--m_biased_count_ <= 0) {
+            merge_on_owner_();
+        }
+    }
+
+    inline i64 get_ref_count_() const
+    {
+        auto shared_count = get_count_(m_shared_count_.load(std::memory_order_acquire));
+        return (is_owner_() ? m_biased_count_ + shared_count : shared_count);
+    }
+};
+
+template <typename DerivedClass>
+constexpr i64 BiasedRefCountable<DerivedClass>::sc_merged_flag_;
+template <typename DerivedClass>
+constexpr i64 BiasedRefCountable<DerivedClass>::sc_queued_flag_;
+template <typename DerivedClass>
+constexpr i64 BiasedRefCountable<DerivedClass>::sc_flag_mask_;
+template <typename DerivedClass>
+constexpr i64 BiasedRefCountable<DerivedClass>::sc_count_unit_;
+
+// merges the counts of biased ref countable objects that other
+// threads have queued for the calling thread, deleting the ones
+// that are no longer referenced
+static inline void merge_queued_ref_counts()
+{
+    detail_::BiasedRefCounting::merge_queued_objects();
+}
+
+// How the references to objects of a type are counted:
+// NonAtomic: plain counts, references are confined to one thread
+// Atomic: atomic counts, references can be shared across threads
+// Biased: plain counts on the thread that created the object,
+//         atomic counts on other threads
+enum class RefCountPolicy { NonAtomic, Atomic, Biased };
+
+// the ref countable base class for a policy, as in
+// class Foo : public RefCountableWithPolicy<Foo, RefCountPolicy::Biased>
+template <typename DerivedClass, RefCountPolicy POLICY>
+using RefCountableWithPolicy =
+    typename std::conditional<POLICY == RefCountPolicy::NonAtomic,
+                              RefCountable<DerivedClass>,
+                              typename std::conditional<POLICY == RefCountPolicy::Atomic,
+                                                        AtomicRefCountable<DerivedClass>,
+                                                        BiasedRefCountable<DerivedClass> >::type>::type;
+
 } /* end namespace aurum */
 
 #endif /* AURUM_BASETYPES_REF_COUNTABLE_HPP_ */
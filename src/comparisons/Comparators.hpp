@@ -138,6 +138,33 @@ class DeepLesser<memory::ManagedConstPointer<T>, NUM_DEREFS_ALLOWED>
     : public DeepLesser<T*, NUM_DEREFS_ALLOWED>
 {};
 
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+class DeepLesser<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>, 0>
+    : public Lesser<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+{};
+
+// orders on the pointees, then on the tags
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER, u64 NUM_DEREFS_ALLOWED>
+class DeepLesser<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>,
+                 NUM_DEREFS_ALLOWED>
+{
+private:
+    typedef memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> PointerType;
+
+public:
+    inline bool operator () (const PointerType& obj1, const PointerType& obj2) const
+    {
+        DeepLesser<T, NUM_DEREFS_ALLOWED-1> sub_comparator;
+        if (sub_comparator(*obj1, *obj2)) {
+            return true;
+        }
+        if (sub_comparator(*obj2, *obj1)) {
+            return false;
+        }
+        return (obj1.get_tag() < obj2.get_tag());
+    }
+};
+
 template <typename T1, typename T2, u64 NUM_DEREFS_ALLOWED>
 class DeepLesser<std::pair<T1, T2>, NUM_DEREFS_ALLOWED>
 {
@@ -261,6 +288,26 @@ class DeepEqualTo<memory::ManagedConstPointer<T>, NUM_DEREFS_ALLOWED>
     : public DeepEqualTo<T*, NUM_DEREFS_ALLOWED>
 {};
 
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+class DeepEqualTo<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>, 0>
+    : public EqualTo<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER, u64 NUM_DEREFS_ALLOWED>
+class DeepEqualTo<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>,
+                  NUM_DEREFS_ALLOWED>
+{
+private:
+    typedef memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> PointerType;
+
+public:
+    inline bool operator () (const PointerType& obj1, const PointerType& obj2) const
+    {
+        DeepEqualTo<T, NUM_DEREFS_ALLOWED-1> sub_comparator;
+        return (obj1.get_tag() == obj2.get_tag() && sub_comparator(*obj1, *obj2));
+    }
+};
+
 template <typename T1, typename T2, u64 NUM_DEREFS_ALLOWED>
 class DeepEqualTo<std::pair<T1, T2>, NUM_DEREFS_ALLOWED>
 {
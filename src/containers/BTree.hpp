@@ -0,0 +1,1220 @@
+// BTree.hpp ---
+//
+// Filename: BTree.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:09:13 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_BTREE_HPP_
+#define AURUM_CONTAINERS_BTREE_HPP_
+
+#include <algorithm>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/AurumErrors.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../allocators/MemoryManager.hpp"
+#include "../comparisons/Comparators.hpp"
+
+#include "Vector.hpp"
+#include "BTreeTypes.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace acmp = aurum::comparisons;
+
+namespace btree_detail_ {
+
+namespace aa = aurum::allocators;
+namespace ac = aurum::containers;
+namespace acd = aurum::containers::btree_detail_;
+
+// A B+-tree: values live only in the leaves, which are linked in
+// key order, and internal nodes hold copies of separator keys.
+// Node sizes are chosen so that a node occupies about NODEBYTES
+// bytes, so that a search touches one small, contiguous node per
+// level rather than one heap node per comparison.
+template <typename KeyType, typename ValueType, typename ValueTraits,
+          typename KeyLess, u32 NODEBYTES>
+class BTreeBase final
+    : public AurumObject<acd::BTreeBase<KeyType, ValueType, ValueTraits,
+                                        KeyLess, NODEBYTES> >,
+      public Stringifiable<acd::BTreeBase<KeyType, ValueType, ValueTraits,
+                                          KeyLess, NODEBYTES> >
+{
+private:
+    typedef BTreeCapacities<KeyType, ValueType, NODEBYTES> CapacitiesType;
+
+public:
+    static constexpr u32 sc_leaf_capacity = CapacitiesType::sc_leaf_capacity;
+    static constexpr u32 sc_internal_capacity = CapacitiesType::sc_internal_capacity;
+
+    typedef ValueType& RefType;
+    typedef const ValueType& ConstRefType;
+    typedef ValueType* PtrType;
+    typedef const ValueType* ConstPtrType;
+
+    typedef BTreeIterator<ValueType, sc_leaf_capacity, true> ConstIterator;
+    // values of a set are keys, and cannot be modified in place
+    typedef typename std::conditional<ValueTraits::sc_is_map,
+                                      BTreeIterator<ValueType, sc_leaf_capacity, false>,
+                                      ConstIterator>::type Iterator;
+    typedef Iterator iterator;
+    typedef ConstIterator const_iterator;
+    typedef std::reverse_iterator<Iterator> ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+    typedef std::reverse_iterator<ConstIterator> ConstReverseIterator;
+    typedef ConstReverseIterator const_reverse_iterator;
+
+private:
+    typedef BTreeLeaf<ValueType, sc_leaf_capacity> LeafType;
+    typedef BTreeInternal<KeyType, sc_internal_capacity> InternalType;
+    typedef typename ValueTraits::SortableValueType SortableValueType;
+
+    // nodes below these occupancies are rebalanced on erasure.
+    // The thresholds guarantee that two siblings can always be merged
+    static constexpr u32 sc_min_leaf_count = sc_leaf_capacity / 2;
+    static constexpr u32 sc_min_internal_count = (sc_internal_capacity - 1) / 2;
+    // every internal node has at least two children
+    static constexpr u32 sc_max_height = 64;
+
+    struct PathEntry
+    {
+        InternalType* m_node;
+        u32 m_index;
+    };
+
+    BTreeLeafBase m_header;
+    BTreeNodeBase* m_root;
+    // number of internal levels above the leaves
+    u32 m_height;
+    u64 m_size;
+
+    static inline const KeyType& key_of(const ValueType& value)
+    {
+        return ValueTraits::get_key(value);
+    }
+
+    static inline LeafType* as_leaf(BTreeNodeBase* node)
+    {
+        return static_cast<LeafType*>(node);
+    }
+
+    static inline InternalType* as_internal(BTreeNodeBase* node)
+    {
+        return static_cast<InternalType*>(node);
+    }
+
+    // opens up an uninitialized slot at index in an
+    // array holding count elements
+    template <typename U>
+    static inline void open_slot(U* array, u32 index, u32 count)
+    {
+        for (u32 i = count; i > index; --i) {
+            new (array + i) U(std::move(array[i - 1]));
+            array[i - 1].~U();
+        }
+    }
+
+    // closes the (already destroyed) slot at index in an
+    // array which held count elements
+    template <typename U>
+    static inline void close_slot(U* array, u32 index, u32 count)
+    {
+        for (u32 i = index + 1; i < count; ++i) {
+            new (array + i - 1) U(std::move(array[i]));
+            array[i].~U();
+        }
+    }
+
+    template <typename U>
+    static inline void move_elements(U* dst, U* src, u32 count)
+    {
+        for (u32 i = 0; i < count; ++i) {
+            new (dst + i) U(std::move(src[i]));
+            src[i].~U();
+        }
+    }
+
+    inline LeafType* allocate_leaf()
+    {
+        return aa::allocate_object_raw<LeafType>();
+    }
+
+    inline InternalType* allocate_internal()
+    {
+        return aa::allocate_object_raw<InternalType>();
+    }
+
+    inline void deallocate_leaf(LeafType* leaf)
+    {
+        aa::deallocate_object_raw(leaf, sizeof(LeafType));
+    }
+
+    inline void deallocate_internal(InternalType* node)
+    {
+        aa::deallocate_object_raw(node, sizeof(InternalType));
+    }
+
+    static inline void link_leaf_after(BTreeLeafBase* position, BTreeLeafBase* leaf)
+    {
+        leaf->m_prev = position;
+        leaf->m_next = position->m_next;
+        position->m_next->m_prev = leaf;
+        position->m_next = leaf;
+    }
+
+    static inline void unlink_leaf(BTreeLeafBase* leaf)
+    {
+        leaf->m_prev->m_next = leaf->m_next;
+        leaf->m_next->m_prev = leaf->m_prev;
+    }
+
+    // index of the first value in the leaf which is not less than key
+    static inline u32 leaf_lower_bound(LeafType* leaf, const KeyType& key)
+    {
+        KeyLess less_func;
+        auto values = leaf->get_values();
+        u32 low = 0;
+        u32 high = leaf->m_count;
+        while (low < high) {
+            u32 mid = (low + high) / 2;
+            if (less_func(key_of(values[mid]), key)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    // index of the first value in the leaf which is greater than key
+    static inline u32 leaf_upper_bound(LeafType* leaf, const KeyType& key)
+    {
+        KeyLess less_func;
+        auto values = leaf->get_values();
+        u32 low = 0;
+        u32 high = leaf->m_count;
+        while (low < high) {
+            u32 mid = (low + high) / 2;
+            if (less_func(key, key_of(values[mid]))) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    }
+
+    // index of the child of node whose subtree may contain key
+    static inline u32 child_index(InternalType* node, const KeyType& key)
+    {
+        KeyLess less_func;
+        auto keys = node->get_keys();
+        u32 low = 0;
+        u32 high = node->m_count;
+        while (low < high) {
+            u32 mid = (low + high) / 2;
+            if (less_func(key, keys[mid])) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        return low;
+    }
+
+    // descends to the leaf which may contain key, recording
+    // the path from the root in path[0 .. m_height - 1]
+    inline LeafType* descend(const KeyType& key, PathEntry* path) const
+    {
+        auto node = m_root;
+        for (u32 level = 0; level < m_height; ++level) {
+            auto internal = as_internal(node);
+            auto index = child_index(internal, key);
+            path[level].m_node = internal;
+            path[level].m_index = index;
+            node = internal->m_children[index];
+        }
+        return as_leaf(node);
+    }
+
+    inline LeafType* descend(const KeyType& key) const
+    {
+        auto node = m_root;
+        for (u32 level = 0; level < m_height; ++level) {
+            auto internal = as_internal(node);
+            node = internal->m_children[child_index(internal, key)];
+        }
+        return as_leaf(node);
+    }
+
+    inline BTreeLeafBase* get_header() const
+    {
+        return const_cast<BTreeLeafBase*>(&m_header);
+    }
+
+    inline ConstIterator lower_bound_impl(const KeyType& key) const
+    {
+        if (m_root == nullptr) {
+            return ConstIterator(get_header(), 0);
+        }
+        auto leaf = descend(key);
+        auto index = leaf_lower_bound(leaf, key);
+        if (index == leaf->m_count) {
+            return ConstIterator(leaf->m_next, 0);
+        }
+        return ConstIterator(leaf, index);
+    }
+
+    inline ConstIterator upper_bound_impl(const KeyType& key) const
+    {
+        if (m_root == nullptr) {
+            return ConstIterator(get_header(), 0);
+        }
+        auto leaf = descend(key);
+        auto index = leaf_upper_bound(leaf, key);
+        if (index == leaf->m_count) {
+            return ConstIterator(leaf->m_next, 0);
+        }
+        return ConstIterator(leaf, index);
+    }
+
+    inline ConstIterator find_impl(const KeyType& key) const
+    {
+        if (m_root == nullptr) {
+            return ConstIterator(get_header(), 0);
+        }
+        KeyLess less_func;
+        auto leaf = descend(key);
+        auto index = leaf_lower_bound(leaf, key);
+        if (index == leaf->m_count || less_func(key, key_of(leaf->get_values()[index]))) {
+            return ConstIterator(get_header(), 0);
+        }
+        return ConstIterator(leaf, index);
+    }
+
+    static inline Iterator to_iterator(const ConstIterator& it)
+    {
+        return Iterator(it.m_leaf, it.m_index);
+    }
+
+    // inserts key with right_child as the child after it,
+    // at key position index of a non-full internal node
+    static inline void insert_into_internal(InternalType* node, u32 index,
+                                            KeyType&& key, BTreeNodeBase* right_child)
+    {
+        auto keys = node->get_keys();
+        open_slot(keys, index, node->m_count);
+        new (keys + index) KeyType(std::move(key));
+
+        auto children = node->m_children;
+        for (u32 i = node->m_count + 1; i > index + 1; --i) {
+            children[i] = children[i - 1];
+        }
+        children[index + 1] = right_child;
+        ++(node->m_count);
+    }
+
+    // removes the key at index and the child after it
+    static inline void remove_from_internal(InternalType* node, u32 index)
+    {
+        auto keys = node->get_keys();
+        keys[index].~KeyType();
+        close_slot(keys, index, node->m_count);
+
+        auto children = node->m_children;
+        for (u32 i = index + 1; i < node->m_count; ++i) {
+            children[i] = children[i + 1];
+        }
+        --(node->m_count);
+    }
+
+    // propagates a split upwards: right_node has been created to the
+    // right of the node at path[level], with separator as its lowest key
+    inline void propagate_split(PathEntry* path, KeyType&& separator,
+                                BTreeNodeBase* right_node)
+    {
+        KeyType current_separator(std::move(separator));
+        auto current_right = right_node;
+
+        for (u32 i = m_height; i > 0; --i) {
+            auto parent = path[i - 1].m_node;
+            auto index = path[i - 1].m_index;
+
+            if (parent->m_count < sc_internal_capacity) {
+                insert_into_internal(parent, index, std::move(current_separator),
+                                     current_right);
+                return;
+            }
+
+            // split the parent: keys [0, mid) stay, keys[mid] moves up
+            // and keys (mid, capacity) move to the new node
+            const u32 mid = sc_internal_capacity / 2;
+            auto new_node = allocate_internal();
+            auto keys = parent->get_keys();
+            move_elements(new_node->get_keys(), keys + mid + 1,
+                          sc_internal_capacity - mid - 1);
+            for (u32 j = mid + 1; j <= sc_internal_capacity; ++j) {
+                new_node->m_children[j - mid - 1] = parent->m_children[j];
+            }
+            new_node->m_count = sc_internal_capacity - mid - 1;
+
+            KeyType up_key(std::move(keys[mid]));
+            keys[mid].~KeyType();
+            parent->m_count = mid;
+
+            if (index <= mid) {
+                insert_into_internal(parent, index, std::move(current_separator),
+                                     current_right);
+            } else {
+                insert_into_internal(new_node, index - mid - 1,
+                                     std::move(current_separator), current_right);
+            }
+
+            current_separator = std::move(up_key);
+            current_right = new_node;
+        }
+
+        // the root was split
+        auto new_root = allocate_internal();
+        new (new_root->get_keys()) KeyType(std::move(current_separator));
+        new_root->m_children[0] = m_root;
+        new_root->m_children[1] = current_right;
+        new_root->m_count = 1;
+        m_root = new_root;
+        ++m_height;
+    }
+
+    template <typename V>
+    inline std::pair<Iterator, bool> insert_unique(V&& value)
+    {
+        KeyLess less_func;
+        const KeyType& key = key_of(value);
+
+        if (m_root == nullptr) {
+            auto leaf = allocate_leaf();
+            link_leaf_after(&m_header, leaf);
+            m_root = leaf;
+            m_height = 0;
+        }
+
+        PathEntry path[sc_max_height];
+        auto leaf = descend(key, path);
+        auto index = leaf_lower_bound(leaf, key);
+        auto values = leaf->get_values();
+
+        if (index < leaf->m_count && !less_func(key, key_of(values[index]))) {
+            return std::make_pair(Iterator(leaf, index), false);
+        }
+
+        if (leaf->m_count < sc_leaf_capacity) {
+            open_slot(values, index, leaf->m_count);
+            new (values + index) ValueType(std::forward<V>(value));
+            ++(leaf->m_count);
+            ++m_size;
+            return std::make_pair(Iterator(leaf, index), true);
+        }
+
+        // split the leaf in half
+        const u32 mid = sc_leaf_capacity / 2;
+        auto new_leaf = allocate_leaf();
+        link_leaf_after(leaf, new_leaf);
+        move_elements(new_leaf->get_values(), values + mid, sc_leaf_capacity - mid);
+        new_leaf->m_count = sc_leaf_capacity - mid;
+        leaf->m_count = mid;
+
+        auto target = leaf;
+        auto target_index = index;
+        if (index > mid) {
+            target = new_leaf;
+            target_index = index - mid;
+        }
+
+        auto target_values = target->get_values();
+        open_slot(target_values, target_index, target->m_count);
+        new (target_values + target_index) ValueType(std::forward<V>(value));
+        ++(target->m_count);
+        ++m_size;
+
+        propagate_split(path, KeyType(key_of(new_leaf->get_values()[0])), new_leaf);
+        return std::make_pair(Iterator(target, target_index), true);
+    }
+
+    // restores the occupancy of a leaf which has fallen below the
+    // minimum, either by borrowing from a sibling or by merging
+    inline void rebalance_leaf(LeafType* leaf, const PathEntry& parent_entry)
+    {
+        auto parent = parent_entry.m_node;
+        auto index = parent_entry.m_index;
+        auto keys = parent->get_keys();
+        auto values = leaf->get_values();
+
+        LeafType* left = (index > 0 ? as_leaf(parent->m_children[index - 1]) : nullptr);
+        LeafType* right = (index < parent->m_count ?
+                           as_leaf(parent->m_children[index + 1]) : nullptr);
+
+        if (left != nullptr && left->m_count > sc_min_leaf_count) {
+            auto left_last = left->get_values() + left->m_count - 1;
+            open_slot(values, 0, leaf->m_count);
+            new (values) ValueType(std::move(*left_last));
+            left_last->~ValueType();
+            --(left->m_count);
+            ++(leaf->m_count);
+            keys[index - 1] = key_of(values[0]);
+            return;
+        }
+
+        if (right != nullptr && right->m_count > sc_min_leaf_count) {
+            auto right_values = right->get_values();
+            new (values + leaf->m_count) ValueType(std::move(right_values[0]));
+            right_values[0].~ValueType();
+            close_slot(right_values, 0, right->m_count);
+            --(right->m_count);
+            ++(leaf->m_count);
+            keys[index] = key_of(right_values[0]);
+            return;
+        }
+
+        if (left != nullptr) {
+            move_elements(left->get_values() + left->m_count, values, leaf->m_count);
+            left->m_count += leaf->m_count;
+            leaf->m_count = 0;
+            unlink_leaf(leaf);
+            deallocate_leaf(leaf);
+            remove_from_internal(parent, index - 1);
+        } else {
+            move_elements(values + leaf->m_count, right->get_values(), right->m_count);
+            leaf->m_count += right->m_count;
+            right->m_count = 0;
+            unlink_leaf(right);
+            deallocate_leaf(right);
+            remove_from_internal(parent, index);
+        }
+    }
+
+    // as above, for internal nodes. Borrowing rotates a key
+    // through the parent
+    inline void rebalance_internal(InternalType* node, const PathEntry& parent_entry)
+    {
+        auto parent = parent_entry.m_node;
+        auto index = parent_entry.m_index;
+        auto parent_keys = parent->get_keys();
+        auto keys = node->get_keys();
+
+        InternalType* left = (index > 0 ? as_internal(parent->m_children[index - 1]) : nullptr);
+        InternalType* right = (index < parent->m_count ?
+                               as_internal(parent->m_children[index + 1]) : nullptr);
+
+        if (left != nullptr && left->m_count > sc_min_internal_count) {
+            auto left_keys = left->get_keys();
+            open_slot(keys, 0, node->m_count);
+            new (keys) KeyType(std::move(parent_keys[index - 1]));
+            for (u32 i = node->m_count + 1; i > 0; --i) {
+                node->m_children[i] = node->m_children[i - 1];
+            }
+            node->m_children[0] = left->m_children[left->m_count];
+            ++(node->m_count);
+
+            parent_keys[index - 1] = std::move(left_keys[left->m_count - 1]);
+            left_keys[left->m_count - 1].~KeyType();
+            --(left->m_count);
+            return;
+        }
+
+        if (right != nullptr && right->m_count > sc_min_internal_count) {
+            auto right_keys = right->get_keys();
+            new (keys + node->m_count) KeyType(std::move(parent_keys[index]));
+            node->m_children[node->m_count + 1] = right->m_children[0];
+            ++(node->m_count);
+
+            parent_keys[index] = std::move(right_keys[0]);
+            right_keys[0].~KeyType();
+            close_slot(right_keys, 0, right->m_count);
+            for (u32 i = 0; i < right->m_count; ++i) {
+                right->m_children[i] = right->m_children[i + 1];
+            }
+            --(right->m_count);
+            return;
+        }
+
+        // merge the right one of the pair into the left one,
+        // pulling the separator down from the parent
+        auto merge_left = (left != nullptr ? left : node);
+        auto merge_right = (left != nullptr ? node : right);
+        auto separator_index = (left != nullptr ? index - 1 : index);
+        auto merge_left_keys = merge_left->get_keys();
+
+        new (merge_left_keys + merge_left->m_count)
+            KeyType(std::move(parent_keys[separator_index]));
+        move_elements(merge_left_keys + merge_left->m_count + 1,
+                      merge_right->get_keys(), merge_right->m_count);
+        for (u32 i = 0; i <= merge_right->m_count; ++i) {
+            merge_left->m_children[merge_left->m_count + 1 + i] = merge_right->m_children[i];
+        }
+        merge_left->m_count += merge_right->m_count + 1;
+        merge_right->m_count = 0;
+        deallocate_internal(merge_right);
+        remove_from_internal(parent, separator_index);
+    }
+
+    inline void erase_from_leaf(LeafType* leaf, u32 index, PathEntry* path)
+    {
+        auto values = leaf->get_values();
+        values[index].~ValueType();
+        close_slot(values, index, leaf->m_count);
+        --(leaf->m_count);
+        --m_size;
+
+        if (m_height == 0) {
+            if (leaf->m_count == 0) {
+                unlink_leaf(leaf);
+                deallocate_leaf(leaf);
+                m_root = nullptr;
+            }
+            return;
+        }
+
+        if (leaf->m_count >= sc_min_leaf_count) {
+            return;
+        }
+
+        rebalance_leaf(leaf, path[m_height - 1]);
+        for (u32 level = m_height - 1; level > 0; --level) {
+            auto node = path[level].m_node;
+            if (node->m_count >= sc_min_internal_count) {
+                break;
+            }
+            rebalance_internal(node, path[level - 1]);
+        }
+
+        if (m_root->m_count == 0) {
+            auto old_root = as_internal(m_root);
+            m_root = old_root->m_children[0];
+            deallocate_internal(old_root);
+            --m_height;
+        }
+    }
+
+    inline void destroy_subtree(BTreeNodeBase* node, u32 height)
+    {
+        if (height == 0) {
+            auto leaf = as_leaf(node);
+            auto values = leaf->get_values();
+            for (u32 i = 0; i < leaf->m_count; ++i) {
+                values[i].~ValueType();
+            }
+            deallocate_leaf(leaf);
+            return;
+        }
+
+        auto internal = as_internal(node);
+        auto keys = internal->get_keys();
+        for (u32 i = 0; i <= internal->m_count; ++i) {
+            destroy_subtree(internal->m_children[i], height - 1);
+        }
+        for (u32 i = 0; i < internal->m_count; ++i) {
+            keys[i].~KeyType();
+        }
+        deallocate_internal(internal);
+    }
+
+    // builds the tree bottom up from num_values sorted values with
+    // distinct keys. Leaves are filled completely, except that the
+    // values are spread evenly so that no node is underfull
+    template <typename InputIterator>
+    inline void bulk_load(const InputIterator& first, u64 num_values)
+    {
+        if (num_values == 0) {
+            return;
+        }
+
+        Vector<BTreeNodeBase*> level_nodes;
+        Vector<const KeyType*> level_min_keys;
+
+        const u64 num_leaves = (num_values + sc_leaf_capacity - 1) / sc_leaf_capacity;
+        level_nodes.reserve(num_leaves);
+        level_min_keys.reserve(num_leaves);
+
+        auto it = first;
+        for (u64 i = 0; i < num_leaves; ++i) {
+            const u32 num_in_leaf =
+                (u32)(num_values / num_leaves + (i < num_values % num_leaves ? 1 : 0));
+            auto leaf = allocate_leaf();
+            link_leaf_after(m_header.m_prev, leaf);
+            auto values = leaf->get_values();
+            for (u32 j = 0; j < num_in_leaf; ++j) {
+                new (values + j) ValueType(*it);
+                ++(leaf->m_count);
+                ++it;
+            }
+            level_nodes.push_back(leaf);
+            level_min_keys.push_back(&(key_of(values[0])));
+        }
+
+        m_size = num_values;
+        m_height = 0;
+
+        while (level_nodes.size() > 1) {
+            const u64 num_children = level_nodes.size();
+            const u64 num_parents =
+                (num_children + sc_internal_capacity) / (sc_internal_capacity + 1);
+
+            Vector<BTreeNodeBase*> parent_nodes;
+            Vector<const KeyType*> parent_min_keys;
+            parent_nodes.reserve(num_parents);
+            parent_min_keys.reserve(num_parents);
+
+            u64 child = 0;
+            for (u64 i = 0; i < num_parents; ++i) {
+                const u32 num_in_parent =
+                    (u32)(num_children / num_parents + (i < num_children % num_parents ? 1 : 0));
+                auto node = allocate_internal();
+                auto keys = node->get_keys();
+                node->m_children[0] = level_nodes[child];
+                for (u32 j = 1; j < num_in_parent; ++j) {
+                    new (keys + j - 1) KeyType(*(level_min_keys[child + j]));
+                    node->m_children[j] = level_nodes[child + j];
+                }
+                node->m_count = num_in_parent - 1;
+                parent_nodes.push_back(node);
+                parent_min_keys.push_back(level_min_keys[child]);
+                child += num_in_parent;
+            }
+
+            level_nodes = std::move(parent_nodes);
+            level_min_keys = std::move(parent_min_keys);
+            ++m_height;
+        }
+
+        m_root = level_nodes[0];
+    }
+
+    template <typename ForwardIterator>
+    static inline bool is_strictly_sorted(const ForwardIterator& first,
+                                          const ForwardIterator& last)
+    {
+        KeyLess less_func;
+        return (std::adjacent_find(first, last,
+                                   [&] (const ValueType& value1,
+                                        const ValueType& value2) -> bool
+                                   {
+                                       return !less_func(key_of(value1), key_of(value2));
+                                   }) == last);
+    }
+
+    inline void steal_from(BTreeBase& other)
+    {
+        m_root = other.m_root;
+        m_height = other.m_height;
+        m_size = other.m_size;
+
+        if (other.m_header.m_next != &(other.m_header)) {
+            m_header.m_next = other.m_header.m_next;
+            m_header.m_prev = other.m_header.m_prev;
+            m_header.m_next->m_prev = &m_header;
+            m_header.m_prev->m_next = &m_header;
+        } else {
+            m_header.m_next = &m_header;
+            m_header.m_prev = &m_header;
+        }
+
+        other.m_root = nullptr;
+        other.m_height = 0;
+        other.m_size = 0;
+        other.m_header.m_next = &(other.m_header);
+        other.m_header.m_prev = &(other.m_header);
+    }
+
+public:
+    BTreeBase()
+        : m_header(), m_root(nullptr), m_height(0), m_size(0)
+    {
+        // Nothing here
+    }
+
+    // sorts a copy of the input and bulk loads it. For equal
+    // keys, the first occurrence in the input is retained
+    template <typename InputIterator>
+    BTreeBase(const InputIterator& first, const InputIterator& last)
+        : BTreeBase()
+    {
+        KeyLess less_func;
+        Vector<SortableValueType> buffer(first, last);
+        std::stable_sort(buffer.begin(), buffer.end(),
+                         [&] (const SortableValueType& value1,
+                              const SortableValueType& value2) -> bool
+                         {
+                             return less_func(ValueTraits::get_key(value1),
+                                              ValueTraits::get_key(value2));
+                         });
+        auto new_end = std::unique(buffer.begin(), buffer.end(),
+                                   [&] (const SortableValueType& value1,
+                                        const SortableValueType& value2) -> bool
+                                   {
+                                       return !less_func(ValueTraits::get_key(value1),
+                                                         ValueTraits::get_key(value2));
+                                   });
+        bulk_load(buffer.begin(), (u64)(new_end - buffer.begin()));
+    }
+
+    BTreeBase(std::initializer_list<ValueType> init_list)
+        : BTreeBase(init_list.begin(), init_list.end())
+    {
+        // Nothing here
+    }
+
+    BTreeBase(const BTreeBase& other)
+        : BTreeBase()
+    {
+        bulk_load(other.begin(), other.size());
+    }
+
+    BTreeBase(BTreeBase&& other)
+        : BTreeBase()
+    {
+        steal_from(other);
+    }
+
+    ~BTreeBase()
+    {
+        clear();
+    }
+
+    inline void clear()
+    {
+        if (m_root != nullptr) {
+            destroy_subtree(m_root, m_height);
+        }
+        m_root = nullptr;
+        m_height = 0;
+        m_size = 0;
+        m_header.m_next = &m_header;
+        m_header.m_prev = &m_header;
+    }
+
+    // replaces the contents of the tree with [first, last), which
+    // must be sorted, with no two elements having equal keys
+    template <typename ForwardIterator>
+    inline void assign_sorted(const ForwardIterator& first, const ForwardIterator& last)
+    {
+        clear();
+        auto num_values = std::distance(first, last);
+
+        AURUM_ASSERT_WITH_MSG(is_strictly_sorted(first, last),
+                              "Input to BTreeBase::assign_sorted() is not sorted");
+        bulk_load(first, (u64)num_values);
+    }
+
+    inline BTreeBase& operator = (const BTreeBase& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        bulk_load(other.begin(), other.size());
+        return *this;
+    }
+
+    inline BTreeBase& operator = (BTreeBase&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        clear();
+        steal_from(other);
+        return *this;
+    }
+
+    inline BTreeBase& operator = (std::initializer_list<ValueType> init_list)
+    {
+        BTreeBase temp(init_list);
+        clear();
+        steal_from(temp);
+        return *this;
+    }
+
+    inline void swap(BTreeBase& other)
+    {
+        BTreeBase temp(std::move(other));
+        other.steal_from(*this);
+        steal_from(temp);
+    }
+
+    inline Iterator begin()
+    {
+        return Iterator(m_header.m_next, 0);
+    }
+
+    inline Iterator end()
+    {
+        return Iterator(&m_header, 0);
+    }
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(m_header.m_next, 0);
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator(get_header(), 0);
+    }
+
+    inline ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    inline ConstIterator cend() const
+    {
+        return end();
+    }
+
+    inline ReverseIterator rbegin()
+    {
+        return ReverseIterator(end());
+    }
+
+    inline ReverseIterator rend()
+    {
+        return ReverseIterator(begin());
+    }
+
+    inline ConstReverseIterator rbegin() const
+    {
+        return ConstReverseIterator(end());
+    }
+
+    inline ConstReverseIterator rend() const
+    {
+        return ConstReverseIterator(begin());
+    }
+
+    inline ConstReverseIterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    inline ConstReverseIterator crend() const
+    {
+        return rend();
+    }
+
+    inline bool empty() const
+    {
+        return (m_size == 0);
+    }
+
+    inline u64 size() const
+    {
+        return m_size;
+    }
+
+    inline u64 max_size() const
+    {
+        return UINT64_MAX;
+    }
+
+    inline Iterator find(const KeyType& key)
+    {
+        return to_iterator(find_impl(key));
+    }
+
+    inline ConstIterator find(const KeyType& key) const
+    {
+        return find_impl(key);
+    }
+
+    inline u64 count(const KeyType& key) const
+    {
+        return (find_impl(key) == end() ? 0 : 1);
+    }
+
+    inline Iterator lower_bound(const KeyType& key)
+    {
+        return to_iterator(lower_bound_impl(key));
+    }
+
+    inline ConstIterator lower_bound(const KeyType& key) const
+    {
+        return lower_bound_impl(key);
+    }
+
+    inline Iterator upper_bound(const KeyType& key)
+    {
+        return to_iterator(upper_bound_impl(key));
+    }
+
+    inline ConstIterator upper_bound(const KeyType& key) const
+    {
+        return upper_bound_impl(key);
+    }
+
+    inline std::pair<Iterator, Iterator> equal_range(const KeyType& key)
+    {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    inline std::pair<ConstIterator, ConstIterator> equal_range(const KeyType& key) const
+    {
+        return std::make_pair(lower_bound(key), upper_bound(key));
+    }
+
+    template <typename Traits = ValueTraits>
+    inline typename Traits::MappedType& operator [] (const KeyType& key)
+    {
+        auto it = find(key);
+        if (it != end()) {
+            return it->second;
+        }
+        return insert_unique(ValueType(key, typename Traits::MappedType())).first->second;
+    }
+
+    template <typename Traits = ValueTraits>
+    inline typename Traits::MappedType& at(const KeyType& key)
+    {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("Key not found in aurum::BTreeMap::at()");
+        }
+        return it->second;
+    }
+
+    template <typename Traits = ValueTraits>
+    inline const typename Traits::MappedType& at(const KeyType& key) const
+    {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("Key not found in aurum::BTreeMap::at()");
+        }
+        return it->second;
+    }
+
+    inline std::pair<Iterator, bool> insert(const ValueType& value)
+    {
+        return insert_unique(value);
+    }
+
+    inline std::pair<Iterator, bool> insert(ValueType&& value)
+    {
+        return insert_unique(std::move(value));
+    }
+
+    template <typename InputIterator>
+    inline void insert(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            insert_unique(ValueType(*it));
+        }
+    }
+
+    inline void insert(std::initializer_list<ValueType> init_list)
+    {
+        insert(init_list.begin(), init_list.end());
+    }
+
+    template <typename... ArgTypes>
+    inline std::pair<Iterator, bool> emplace(ArgTypes&&... args)
+    {
+        return insert_unique(ValueType(std::forward<ArgTypes>(args)...));
+    }
+
+    inline u64 erase(const KeyType& key)
+    {
+        if (m_root == nullptr) {
+            return 0;
+        }
+
+        KeyLess less_func;
+        PathEntry path[sc_max_height];
+        auto leaf = descend(key, path);
+        auto index = leaf_lower_bound(leaf, key);
+        if (index == leaf->m_count || less_func(key, key_of(leaf->get_values()[index]))) {
+            return 0;
+        }
+
+        erase_from_leaf(leaf, index, path);
+        return 1;
+    }
+
+    // returns an iterator to the element following the erased one
+    inline Iterator erase(const ConstIterator& position)
+    {
+        KeyType key(key_of(*position));
+        erase(key);
+        return lower_bound(key);
+    }
+
+    inline Iterator erase(const ConstIterator& first, const ConstIterator& last)
+    {
+        if (last == end()) {
+            auto it = first;
+            while (it != end()) {
+                it = erase(it);
+            }
+            return end();
+        }
+
+        KeyLess less_func;
+        KeyType last_key(key_of(*last));
+        auto it = to_iterator(first);
+        while (less_func(key_of(*it), last_key)) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    // not part of stl
+    inline u32 get_height() const
+    {
+        return (m_root == nullptr ? 0 : m_height + 1);
+    }
+
+    inline i64 compare(const BTreeBase& other) const
+    {
+        auto diff = (i64)size() - (i64)other.size();
+        if (diff != 0) {
+            return diff;
+        }
+
+        KeyLess less_func;
+        for (auto it1 = begin(), it2 = other.begin(), last = end(); it1 != last; ++it1, ++it2) {
+            if (less_func(key_of(*it1), key_of(*it2))) {
+                return -1;
+            } else if (less_func(key_of(*it2), key_of(*it1))) {
+                return 1;
+            }
+            auto mapped_diff = ValueTraits::compare_mapped(*it1, *it2);
+            if (mapped_diff != 0) {
+                return mapped_diff;
+            }
+        }
+        return 0;
+    }
+
+    inline bool operator == (const BTreeBase& other) const
+    {
+        return (compare(other) == 0);
+    }
+
+    inline bool operator != (const BTreeBase& other) const
+    {
+        return (compare(other) != 0);
+    }
+
+    inline bool operator < (const BTreeBase& other) const
+    {
+        return (compare(other) < 0);
+    }
+
+    inline bool operator <= (const BTreeBase& other) const
+    {
+        return (compare(other) <= 0);
+    }
+
+    inline bool operator > (const BTreeBase& other) const
+    {
+        return (compare(other) > 0);
+    }
+
+    inline bool operator >= (const BTreeBase& other) const
+    {
+        return (compare(other) >= 0);
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << ValueTraits::get_name() << " with " << size() << " elements:"
+             << std::endl << "<<";
+
+        bool first = true;
+        for (auto const& value : *this) {
+            if (!first) {
+                sstr << ", ";
+            }
+            first = false;
+            sstr << ValueTraits::value_to_string(value, verbosity);
+        }
+        sstr << ">>";
+        return sstr.str();
+    }
+};
+
+template <typename KeyType, typename ValueType, typename ValueTraits,
+          typename KeyLess, u32 NODEBYTES>
+constexpr u32 BTreeBase<KeyType, ValueType, ValueTraits,
+                        KeyLess, NODEBYTES>::sc_leaf_capacity;
+
+template <typename KeyType, typename ValueType, typename ValueTraits,
+          typename KeyLess, u32 NODEBYTES>
+constexpr u32 BTreeBase<KeyType, ValueType, ValueTraits,
+                        KeyLess, NODEBYTES>::sc_internal_capacity;
+
+} /* end namespace btree_detail_ */
+
+// Nodes default to four cache lines
+template <typename T, typename KeyLess = acmp::Lesser<T>, u32 NODEBYTES = 256>
+using BTreeSet = btree_detail_::BTreeBase<T, T, btree_detail_::BTreeSetTraits<T>,
+                                          KeyLess, NODEBYTES>;
+
+template <typename KeyType, typename MappedType,
+          typename KeyLess = acmp::Lesser<KeyType>, u32 NODEBYTES = 256>
+using BTreeMap =
+    btree_detail_::BTreeBase<KeyType, std::pair<const KeyType, MappedType>,
+                             btree_detail_::BTreeMapTraits<KeyType, MappedType>,
+                             KeyLess, NODEBYTES>;
+
+typedef BTreeSet<u08> u08BTreeSet;
+typedef BTreeSet<u16> u16BTreeSet;
+typedef BTreeSet<u32> u32BTreeSet;
+typedef BTreeSet<u64> u64BTreeSet;
+typedef BTreeSet<i08> i08BTreeSet;
+typedef BTreeSet<i16> i16BTreeSet;
+typedef BTreeSet<i32> i32BTreeSet;
+typedef BTreeSet<i64> i64BTreeSet;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_BTREE_HPP_ */
+
+//
+// BTree.hpp ends here
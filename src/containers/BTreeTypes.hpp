@@ -0,0 +1,372 @@
+// BTreeTypes.hpp ---
+//
+// Filename: BTreeTypes.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:09:13 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_BTREE_TYPES_HPP_
+#define AURUM_CONTAINERS_BTREE_TYPES_HPP_
+
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "../basetypes/AurumBase.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+namespace aurum {
+namespace containers {
+namespace btree_detail_ {
+
+namespace ac = aurum::containers;
+namespace as = aurum::stringification;
+
+template <typename KeyType, typename ValueType, typename ValueTraits,
+          typename KeyLess, u32 NODEBYTES>
+class BTreeBase;
+
+struct BTreeNodeBase
+{
+    u32 m_count;
+
+    inline BTreeNodeBase()
+        : m_count(0)
+    {
+        // Nothing here
+    }
+};
+
+// Leaves are kept on a circular doubly linked list, threaded through
+// a header owned by the tree. The header has no elements, so the end
+// iterator is always (header, 0), exactly as in UnrolledDList
+struct BTreeLeafBase : public BTreeNodeBase
+{
+    BTreeLeafBase* m_next;
+    BTreeLeafBase* m_prev;
+
+    inline BTreeLeafBase()
+        : BTreeNodeBase(), m_next(this), m_prev(this)
+    {
+        // Nothing here
+    }
+
+    BTreeLeafBase(const BTreeLeafBase& other) = delete;
+    BTreeLeafBase& operator = (const BTreeLeafBase& other) = delete;
+};
+
+template <typename ValueType, u32 CAPACITY>
+struct BTreeLeaf : public BTreeLeafBase
+{
+    typedef typename std::aligned_storage<sizeof(ValueType),
+                                          alignof(ValueType)>::type StorageType;
+
+    StorageType m_values[CAPACITY];
+
+    inline ValueType* get_values()
+    {
+        return reinterpret_cast<ValueType*>(m_values);
+    }
+
+    inline const ValueType* get_values() const
+    {
+        return reinterpret_cast<const ValueType*>(m_values);
+    }
+};
+
+// An internal node with m_count keys has m_count + 1 children.
+// Every key in m_children[i] is less than m_keys[i], and every
+// key in m_children[i + 1] is not less than m_keys[i]
+template <typename KeyType, u32 CAPACITY>
+struct BTreeInternal : public BTreeNodeBase
+{
+    typedef typename std::aligned_storage<sizeof(KeyType),
+                                          alignof(KeyType)>::type StorageType;
+
+    StorageType m_keys[CAPACITY];
+    BTreeNodeBase* m_children[CAPACITY + 1];
+
+    inline KeyType* get_keys()
+    {
+        return reinterpret_cast<KeyType*>(m_keys);
+    }
+
+    inline const KeyType* get_keys() const
+    {
+        return reinterpret_cast<const KeyType*>(m_keys);
+    }
+};
+
+// node capacities for a target node size of NODEBYTES,
+// never fewer than four entries per node
+template <typename KeyType, typename ValueType, u32 NODEBYTES>
+struct BTreeCapacities
+{
+    static constexpr u64 sc_raw_leaf_capacity =
+        (NODEBYTES > sizeof(BTreeLeafBase) ?
+         (NODEBYTES - sizeof(BTreeLeafBase)) / sizeof(ValueType) : 0);
+
+    static constexpr u64 sc_raw_internal_capacity =
+        (NODEBYTES > sizeof(BTreeNodeBase) + sizeof(void*) ?
+         ((NODEBYTES - sizeof(BTreeNodeBase) - sizeof(void*)) /
+          (sizeof(KeyType) + sizeof(void*))) : 0);
+
+    static constexpr u32 sc_leaf_capacity =
+        (sc_raw_leaf_capacity < 4 ? 4 : (u32)sc_raw_leaf_capacity);
+    static constexpr u32 sc_internal_capacity =
+        (sc_raw_internal_capacity < 4 ? 4 : (u32)sc_raw_internal_capacity);
+};
+
+template <typename T>
+class BTreeSetTraits
+{
+public:
+    typedef T KeyType;
+    typedef T ValueType;
+    typedef T SortableValueType;
+    static constexpr bool sc_is_map = false;
+
+    static inline const KeyType& get_key(const ValueType& value)
+    {
+        return value;
+    }
+
+    // the key is the entire value, so there is nothing more to compare
+    static inline i64 compare_mapped(const ValueType& value1, const ValueType& value2)
+    {
+        return 0;
+    }
+
+    static inline std::string get_name()
+    {
+        std::ostringstream sstr;
+        sstr << "BTreeSet<" << type_name<T>() << ">";
+        return sstr.str();
+    }
+
+    static inline std::string value_to_string(const ValueType& value, i64 verbosity)
+    {
+        as::Stringifier<T> stringifier;
+        return stringifier(value, verbosity);
+    }
+};
+
+template <typename K, typename M>
+class BTreeMapTraits
+{
+public:
+    typedef K KeyType;
+    typedef M MappedType;
+    typedef std::pair<const K, M> ValueType;
+    typedef std::pair<K, M> SortableValueType;
+    static constexpr bool sc_is_map = true;
+
+    static inline const KeyType& get_key(const ValueType& value)
+    {
+        return value.first;
+    }
+
+    static inline i64 compare_mapped(const ValueType& value1, const ValueType& value2)
+    {
+        std::less<M> less_func;
+        if (less_func(value1.second, value2.second)) {
+            return -1;
+        } else if (less_func(value2.second, value1.second)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    static inline std::string get_name()
+    {
+        std::ostringstream sstr;
+        sstr << "BTreeMap<" << type_name<K>() << ", " << type_name<M>() << ">";
+        return sstr.str();
+    }
+
+    static inline std::string value_to_string(const ValueType& value, i64 verbosity)
+    {
+        as::Stringifier<K> key_stringifier;
+        as::Stringifier<M> map_stringifier;
+        std::ostringstream sstr;
+        sstr << "{" << key_stringifier(value.first, verbosity) << " |--> "
+             << map_stringifier(value.second, verbosity) << "}";
+        return sstr.str();
+    }
+};
+
+// Iterators are (leaf, index) pairs. They are invalidated by any
+// insertion or erasure which modifies the tree
+template <typename ValueType, u32 LEAFCAPACITY, bool ISCONST>
+class BTreeIterator
+    : public std::iterator<std::bidirectional_iterator_tag, ValueType, i64,
+                           typename std::conditional<ISCONST, const ValueType*,
+                                                     ValueType*>::type,
+                           typename std::conditional<ISCONST, const ValueType&,
+                                                     ValueType&>::type>
+{
+    template <typename, typename, typename, typename, u32> friend class BTreeBase;
+    friend class ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY, true>;
+    friend class ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY, false>;
+
+private:
+    typedef BTreeLeaf<ValueType, LEAFCAPACITY> LeafType;
+    typedef typename std::conditional<ISCONST, const ValueType&, ValueType&>::type RefType;
+    typedef typename std::conditional<ISCONST, const ValueType*, ValueType*>::type PtrType;
+
+    BTreeLeafBase* m_leaf;
+    u32 m_index;
+
+public:
+    inline BTreeIterator()
+        : m_leaf(nullptr), m_index(0)
+    {
+        // Nothing here
+    }
+
+    inline BTreeIterator(BTreeLeafBase* leaf, u32 index)
+        : m_leaf(leaf), m_index(index)
+    {
+        // Nothing here
+    }
+
+    inline BTreeIterator(const BTreeIterator& other)
+        : m_leaf(other.m_leaf), m_index(other.m_index)
+    {
+        // Nothing here
+    }
+
+    template <bool OISCONST>
+    inline BTreeIterator(const ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY,
+                                                                OISCONST>& other)
+        : m_leaf(other.m_leaf), m_index(other.m_index)
+    {
+        static_assert(!OISCONST || ISCONST,
+                      "Cannot construct non-const iterator from const iterator");
+    }
+
+    inline BTreeIterator& operator = (const BTreeIterator& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_leaf = other.m_leaf;
+        m_index = other.m_index;
+        return *this;
+    }
+
+    template <bool OISCONST>
+    inline BTreeIterator&
+    operator = (const ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY,
+                                                       OISCONST>& other)
+    {
+        static_assert(!OISCONST || ISCONST,
+                      "Cannot assign const iterator to non-const iterator");
+        m_leaf = other.m_leaf;
+        m_index = other.m_index;
+        return *this;
+    }
+
+    template <bool OISCONST>
+    inline bool
+    operator == (const ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY,
+                                                        OISCONST>& other) const
+    {
+        return (m_leaf == other.m_leaf && m_index == other.m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool
+    operator != (const ac::btree_detail_::BTreeIterator<ValueType, LEAFCAPACITY,
+                                                        OISCONST>& other) const
+    {
+        return (m_leaf != other.m_leaf || m_index != other.m_index);
+    }
+
+    inline BTreeIterator& operator ++ ()
+    {
+        if (++m_index >= m_leaf->m_count) {
+            m_leaf = m_leaf->m_next;
+            m_index = 0;
+        }
+        return *this;
+    }
+
+    inline BTreeIterator& operator -- ()
+    {
+        if (m_index == 0) {
+            m_leaf = m_leaf->m_prev;
+            m_index = m_leaf->m_count - 1;
+        } else {
+            --m_index;
+        }
+        return *this;
+    }
+
+    inline BTreeIterator operator ++ (int unused)
+    {
+        auto retval = *this;
+        ++(*this);
+        return retval;
+    }
+
+    inline BTreeIterator operator -- (int unused)
+    {
+        auto retval = *this;
+        --(*this);
+        return retval;
+    }
+
+    inline RefType operator * () const
+    {
+        return static_cast<LeafType*>(m_leaf)->get_values()[m_index];
+    }
+
+    inline PtrType operator -> () const
+    {
+        return (static_cast<LeafType*>(m_leaf)->get_values() + m_index);
+    }
+};
+
+} /* end namespace btree_detail_ */
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_BTREE_TYPES_HPP_ */
+
+//
+// BTreeTypes.hpp ends here
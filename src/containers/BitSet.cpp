@@ -38,19 +38,22 @@
 // Code:
 
 #include <sstream>
-#include <iomanip>
 #include <cstring>
 #include <utility>
 #include <string>
 
 #include "../allocators/MemoryManager.hpp"
 
+#include "../basetypes/AurumErrors.hpp"
+
 #include "BitSet.hpp"
+#include "BitSetKernels.hpp"
 
 namespace aurum {
 namespace containers {
 
 namespace aa = aurum::allocators;
+namespace bsd = aurum::containers::bit_set_detail_;
 
 // Implementation of BitRef
 BitSet::BitRef::BitRef(BitSet* bit_set, u64 bit_num)
@@ -125,6 +128,11 @@ bool BitSet::BitRef::operator ! () const
 }
 
 // implementation of BitSet
+static inline u64 get_num_words_for_bits(u64 num_bits)
+{
+    return ((num_bits + 63) / 64);
+}
+
 BitSet::BitSet()
     : m_num_bits(0), m_bit_array(nullptr)
 {
@@ -132,35 +140,28 @@ BitSet::BitSet()
 }
 
 BitSet::BitSet(u64 size)
-    : m_num_bits(size)
+    : m_num_bits(size), m_bit_array(nullptr)
 {
-    u64 num_bytes = (m_num_bits + 7) / 8;
-    m_bit_array = aa::casted_allocate_raw_cleared<u08>(sizeof(u08) * num_bytes);
+    if (m_num_bits > 0) {
+        m_bit_array =
+            aa::casted_allocate_raw_cleared<u64>(sizeof(u64) * get_num_words_for_bits(m_num_bits));
+    }
 }
 
 BitSet::BitSet(u64 size, bool initial_value)
     : BitSet(size)
 {
     if (initial_value) {
-        memset(m_bit_array, 0xFF, size / 8);
-        // take care of the last few bits.
-        if (m_num_bits % 8 != 0) {
-            u08 mask = 0;
-            for (u32 i = 0; i < m_num_bits % 8; ++i) {
-                mask >>= 1;
-                mask |= (u08)0x80;
-            }
-            m_bit_array[m_num_bits / 8] |= mask;
-        }
+        set();
     }
 }
 
 BitSet::BitSet(const BitSet& other)
-    : m_num_bits(other.m_num_bits)
+    : BitSet(other.m_num_bits)
 {
-    u64 num_bytes = (m_num_bits + 7) / 8;
-    m_bit_array = aa::casted_allocate_raw_cleared<u08>(sizeof(u08) * num_bytes);
-    memcpy(m_bit_array, other.m_bit_array, num_bytes);
+    if (m_num_bits > 0) {
+        memcpy(m_bit_array, other.m_bit_array, sizeof(u64) * get_word_count());
+    }
 }
 
 BitSet::BitSet(BitSet&& other)
@@ -178,29 +179,28 @@ BitSet::~BitSet()
 void BitSet::reset()
 {
     if (m_bit_array != nullptr) {
-        u64 num_bytes = (m_num_bits + 7) / 8;
-        aa::deallocate_raw(m_bit_array, num_bytes);
+        aa::deallocate_raw(m_bit_array, sizeof(u64) * get_word_count());
         m_bit_array = nullptr;
     }
     m_num_bits = 0;
 }
 
-
 BitSet& BitSet::operator = (const BitSet& other)
 {
     if (&other == this) {
         return *this;
     }
 
-    if (m_bit_array != nullptr) {
-        u64 old_num_bytes = (m_num_bits + 7) / 8;
-        aa::deallocate_raw(m_bit_array, old_num_bytes);
+    if (get_word_count() != other.get_word_count()) {
+        reset();
+        if (other.m_num_bits > 0) {
+            m_bit_array = aa::casted_allocate_raw<u64>(sizeof(u64) * other.get_word_count());
+        }
     }
-
     m_num_bits = other.m_num_bits;
-    u64 num_bytes = (m_num_bits + 7) / 8;
-    m_bit_array = aa::casted_allocate_raw<u08>(sizeof(u08) * num_bytes);
-    memcpy(m_bit_array, other.m_bit_array, num_bytes);
+    if (m_num_bits > 0) {
+        memcpy(m_bit_array, other.m_bit_array, sizeof(u64) * get_word_count());
+    }
     return *this;
 }
 
@@ -211,13 +211,28 @@ BitSet& BitSet::operator = (BitSet&& other)
     return *this;
 }
 
+void BitSet::clear_trailing_bits()
+{
+    if (m_num_bits > 0) {
+        m_bit_array[get_word_count() - 1] &= bsd::get_last_word_mask(m_num_bits);
+    }
+}
+
+// orders first by size, and then on the first bit in which the
+// sets differ, with the set that has the bit set being greater
 i32 BitSet::compare(const BitSet& other) const
 {
-    i32 diff = m_num_bits - other.m_num_bits;
-    if (diff != 0) {
-        return diff;
+    if (m_num_bits != other.m_num_bits) {
+        return (m_num_bits < other.m_num_bits ? -1 : 1);
     }
-    return memcmp(m_bit_array, other.m_bit_array, (m_num_bits + 7) / 8);
+
+    for (u64 i = 0, last = get_word_count(); i < last; ++i) {
+        auto diff = m_bit_array[i] ^ other.m_bit_array[i];
+        if (diff != 0) {
+            return ((m_bit_array[i] & (diff & -diff)) != 0 ? 1 : -1);
+        }
+    }
+    return 0;
 }
 
 bool BitSet::operator == (const BitSet& other) const
@@ -252,83 +267,51 @@ bool BitSet::operator != (const BitSet& other) const
 
 void BitSet::set(u64 bit_num)
 {
-    u64 offset = bit_num / 8;
-    const u64 bit_num_mod_8 = bit_num % 8;
-    u08 mask = 0x80;
-    if (bit_num_mod_8 != 0) {
-        mask >>= (bit_num_mod_8);
-    }
-    m_bit_array[offset] |= mask;
+    m_bit_array[bit_num / 64] |= (1ull << (bit_num % 64));
 }
 
 void BitSet::clear(u64 bit_num)
 {
-    u64 offset = bit_num / 8;
-    const u32 bit_num_mod_8 = bit_num % 8;
-    u08 mask = 0x80;
-    if (bit_num_mod_8 != 0) {
-        mask >>= (bit_num_mod_8);
-    }
-    m_bit_array[offset] &= (~mask);
+    m_bit_array[bit_num / 64] &= ~(1ull << (bit_num % 64));
 }
 
 bool BitSet::test(u64 bit_num) const
 {
-    u64 offset = bit_num / 8;
-    const u32 bit_num_mod_8 = bit_num % 8;
-    u08 mask = 0x80;
-    if (bit_num_mod_8 != 0) {
-        mask >>= (bit_num_mod_8);
-    }
-    return (((m_bit_array[offset] & mask) == 0) ? false : true);
+    return (((m_bit_array[bit_num / 64] >> (bit_num % 64)) & 1) != 0);
 }
 
 bool BitSet::flip(u64 bit_num)
 {
-    u32 offset = bit_num / 8;
-    const u32 bit_num_mod_8 = bit_num % 8;
-    u08 mask = 0x80;
-    if (bit_num_mod_8 != 0) {
-        mask >>= (bit_num_mod_8);
-    }
-    bool retval = (((m_bit_array[offset] & mask) == 0) ? false : true);
-    if (retval) {
-        m_bit_array[offset] &= (~mask);
-    } else {
-        m_bit_array[offset] |= mask;
-    }
+    const u64 mask = (1ull << (bit_num % 64));
+    auto& word = m_bit_array[bit_num / 64];
+    bool retval = ((word & mask) != 0);
+    word ^= mask;
     return retval;
 }
 
 void BitSet::set()
 {
-    memset(m_bit_array, 0xFF, m_num_bits / 8);
-    // take care of the last few bits.
-    if (m_num_bits % 8 != 0) {
-        u32 mask = 0;
-        for (u32 i = 0; i < m_num_bits % 8; ++i) {
-            mask >>= 1;
-            mask |= (u08)0x80;
-        }
-        m_bit_array[m_num_bits / 8] |= mask;
+    if (m_num_bits == 0) {
+        return;
     }
+    memset(m_bit_array, 0xFF, sizeof(u64) * get_word_count());
+    clear_trailing_bits();
 }
 
 void BitSet::clear()
 {
-    memset(m_bit_array, 0, (m_num_bits + 7) / 8);
+    if (m_num_bits == 0) {
+        return;
+    }
+    memset(m_bit_array, 0, sizeof(u64) * get_word_count());
 }
 
 void BitSet::flip()
 {
-    for (u64 i = 0; i < m_num_bits / 8; ++i) {
-        m_bit_array[i] = (~(m_bit_array[i]));
-    }
-    // take care of the last few bits with
-    // explicit calls
-    for (u32 i = 0; i < m_num_bits % 8; ++i) {
-        flip(((m_num_bits / 8) * 8) + i);
+    for (u64 i = 0, last = get_word_count(); i < last; ++i) {
+        m_bit_array[i] = ~(m_bit_array[i]);
     }
+    clear_trailing_bits();
 }
 
 bool BitSet::operator [] (u64 bit_num) const
@@ -341,6 +324,152 @@ BitSet::BitRef BitSet::operator [] (u64 bit_num)
     return BitRef(this, bit_num);
 }
 
+BitSet& BitSet::operator &= (const BitSet& other)
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    bsd::apply_words<bsd::AndOp>(m_bit_array, m_bit_array, other.m_bit_array, get_word_count());
+    return *this;
+}
+
+BitSet& BitSet::operator |= (const BitSet& other)
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    bsd::apply_words<bsd::OrOp>(m_bit_array, m_bit_array, other.m_bit_array, get_word_count());
+    return *this;
+}
+
+BitSet& BitSet::operator ^= (const BitSet& other)
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    bsd::apply_words<bsd::XorOp>(m_bit_array, m_bit_array, other.m_bit_array, get_word_count());
+    return *this;
+}
+
+BitSet& BitSet::operator -= (const BitSet& other)
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    bsd::apply_words<bsd::AndNotOp>(m_bit_array, m_bit_array,
+                                    other.m_bit_array, get_word_count());
+    return *this;
+}
+
+BitSet BitSet::operator & (const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    BitSet retval(m_num_bits);
+    bsd::apply_words<bsd::AndOp>(retval.m_bit_array, m_bit_array,
+                                 other.m_bit_array, get_word_count());
+    return retval;
+}
+
+BitSet BitSet::operator | (const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    BitSet retval(m_num_bits);
+    bsd::apply_words<bsd::OrOp>(retval.m_bit_array, m_bit_array,
+                                other.m_bit_array, get_word_count());
+    return retval;
+}
+
+BitSet BitSet::operator ^ (const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    BitSet retval(m_num_bits);
+    bsd::apply_words<bsd::XorOp>(retval.m_bit_array, m_bit_array,
+                                 other.m_bit_array, get_word_count());
+    return retval;
+}
+
+BitSet BitSet::operator - (const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    BitSet retval(m_num_bits);
+    bsd::apply_words<bsd::AndNotOp>(retval.m_bit_array, m_bit_array,
+                                    other.m_bit_array, get_word_count());
+    return retval;
+}
+
+BitSet BitSet::operator ~ () const
+{
+    BitSet retval(*this);
+    retval.flip();
+    return retval;
+}
+
+u64 BitSet::count() const
+{
+    return bsd::popcount_words(m_bit_array, get_word_count());
+}
+
+bool BitSet::any() const
+{
+    return (bsd::find_nonzero_word(m_bit_array, 0, get_word_count()) != get_word_count());
+}
+
+bool BitSet::none() const
+{
+    return !any();
+}
+
+bool BitSet::all() const
+{
+    return (count() == m_num_bits);
+}
+
+bool BitSet::is_subset_of(const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    return bsd::all_zero_words<bsd::AndNotOp>(m_bit_array, other.m_bit_array, get_word_count());
+}
+
+bool BitSet::intersects(const BitSet& other) const
+{
+    AURUM_ASSERT(m_num_bits == other.m_num_bits);
+    return !bsd::all_zero_words<bsd::AndOp>(m_bit_array, other.m_bit_array, get_word_count());
+}
+
+u64 BitSet::find_first() const
+{
+    auto const num_words = get_word_count();
+    auto word_index = bsd::find_nonzero_word(m_bit_array, 0, num_words);
+    if (word_index == num_words) {
+        return m_num_bits;
+    }
+    return ((word_index * 64) + __builtin_ctzll(m_bit_array[word_index]));
+}
+
+u64 BitSet::find_next(u64 bit_num) const
+{
+    ++bit_num;
+    if (bit_num >= m_num_bits) {
+        return m_num_bits;
+    }
+
+    // look at the rest of the current word first
+    auto word_index = bit_num / 64;
+    auto const word = m_bit_array[word_index] & (~(u64)0 << (bit_num % 64));
+    if (word != 0) {
+        return ((word_index * 64) + __builtin_ctzll(word));
+    }
+
+    auto const num_words = get_word_count();
+    word_index = bsd::find_nonzero_word(m_bit_array, word_index + 1, num_words);
+    if (word_index == num_words) {
+        return m_num_bits;
+    }
+    return ((word_index * 64) + __builtin_ctzll(m_bit_array[word_index]));
+}
+
+const u64* BitSet::get_words() const
+{
+    return m_bit_array;
+}
+
+u64 BitSet::get_word_count() const
+{
+    return get_num_words_for_bits(m_num_bits);
+}
+
 u64 BitSet::size() const
 {
     return m_num_bits;
@@ -349,38 +478,33 @@ u64 BitSet::size() const
 std::string BitSet::as_string(i64 verbosity) const
 {
     std::ostringstream sstr;
-    sstr << "BitSet with " << m_num_bits << " bits: " << std::endl;
-    sstr << "<<" << std::endl;
-    for (u64 i = 0; i < m_num_bits; ++i) {
-        if (test(i)) {
-            sstr << std::setw(16) << std::setfill(' ') << i << " -> 1" << std::endl;
-        } else {
-            sstr << std::setw(16) << std::setfill(' ') << i << " -> 0" << std::endl;
+    sstr << "BitSet with " << m_num_bits << " bits: {";
+    bool first = true;
+    for (auto i = find_first(); i < m_num_bits; i = find_next(i)) {
+        if (!first) {
+            sstr << ", ";
         }
+        first = false;
+        sstr << i;
     }
-    sstr << ">>" << std::endl;
+    sstr << "}";
     return sstr.str();
 }
 
 void BitSet::resize_and_clear(u64 new_num_bits)
 {
-    if (new_num_bits == m_num_bits) {
+    if (get_num_words_for_bits(new_num_bits) == get_word_count()) {
+        m_num_bits = new_num_bits;
         clear();
-    }
-    if (new_num_bits == 0) {
-        aa::deallocate_raw(m_bit_array, (m_num_bits + 7 / 8));
-        m_bit_array = nullptr;
-        m_num_bits = 0;
+        return;
     }
 
-    auto new_num_bytes = (new_num_bits + 7) / 8;
-    auto new_bit_array = aa::casted_allocate_raw_cleared<u08>(new_num_bytes * sizeof(u08));
-
-    if (m_bit_array != nullptr) {
-        aa::deallocate_raw(m_bit_array, (m_num_bits + 7) / 8);
+    reset();
+    if (new_num_bits > 0) {
+        m_bit_array =
+            aa::casted_allocate_raw_cleared<u64>(sizeof(u64) * get_num_words_for_bits(new_num_bits));
     }
     m_num_bits = new_num_bits;
-    m_bit_array = new_bit_array;
 }
 
 } /* end namespace containers */
@@ -48,9 +48,12 @@ class BitSet final : public AurumObject<BitSet>, public Stringifiable<BitSet>
 {
 private:
     u64 m_num_bits;
-    u08* m_bit_array;
+    // bit i lives in bit (i % 64) of word (i / 64). The bits
+    // in the last word beyond m_num_bits are always zero
+    u64* m_bit_array;
 
     inline i32 compare(const BitSet& other) const;
+    inline void clear_trailing_bits();
 
 public:
     class BitRef
@@ -112,6 +115,38 @@ public:
     bool operator [] (u64 bit_num) const;
     BitRef operator [] (u64 bit_num);
 
+    // Set algebra. Both operands must be of the same size.
+    // operator - is set difference, i.e., (*this & ~other)
+    BitSet& operator &= (const BitSet& other);
+    BitSet& operator |= (const BitSet& other);
+    BitSet& operator ^= (const BitSet& other);
+    BitSet& operator -= (const BitSet& other);
+
+    BitSet operator & (const BitSet& other) const;
+    BitSet operator | (const BitSet& other) const;
+    BitSet operator ^ (const BitSet& other) const;
+    BitSet operator - (const BitSet& other) const;
+    BitSet operator ~ () const;
+
+    // number of set bits
+    u64 count() const;
+    bool any() const;
+    bool none() const;
+    bool all() const;
+
+    bool is_subset_of(const BitSet& other) const;
+    bool intersects(const BitSet& other) const;
+
+    // iteration over the set bits:
+    // for (auto i = bs.find_first(); i < bs.size(); i = bs.find_next(i)) { ... }
+    // both return size() if there are no more set bits
+    u64 find_first() const;
+    u64 find_next(u64 bit_num) const;
+
+    // raw access to the underlying words, see above for the layout
+    const u64* get_words() const;
+    u64 get_word_count() const;
+
     u64 size() const;
     void resize_and_clear(u64 new_num_bits);
     std::string as_string(i64 verbosity) const;
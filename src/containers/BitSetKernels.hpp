@@ -0,0 +1,234 @@
+// BitSetKernels.hpp ---
+//
+// Filename: BitSetKernels.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:24:50 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_BIT_SET_KERNELS_HPP_
+#define AURUM_CONTAINERS_BIT_SET_KERNELS_HPP_
+
+#if defined __AVX2__ || defined __SSE2__ || defined __BMI2__
+#include <immintrin.h>
+#endif /* __AVX2__ || __SSE2__ || __BMI2__ */
+
+#include "../basetypes/AurumTypes.hpp"
+
+// Word level kernels shared by the bit set implementations.
+// All kernels operate on arrays of u64 words, of which no
+// alignment is assumed. The bulk of the words is processed 256 bits
+// at a time when compiling with AVX2, 128 bits at a time with SSE2,
+// and the remainder (or everything, on other platforms) one
+// word at a time.
+
+namespace aurum {
+namespace containers {
+namespace bit_set_detail_ {
+
+class AndOp
+{
+public:
+    static inline u64 apply(u64 a, u64 b) { return (a & b); }
+#if defined __AVX2__
+    static inline __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif /* __AVX2__ */
+#if defined __SSE2__
+    static inline __m128i apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif /* __SSE2__ */
+};
+
+class OrOp
+{
+public:
+    static inline u64 apply(u64 a, u64 b) { return (a | b); }
+#if defined __AVX2__
+    static inline __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif /* __AVX2__ */
+#if defined __SSE2__
+    static inline __m128i apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif /* __SSE2__ */
+};
+
+class XorOp
+{
+public:
+    static inline u64 apply(u64 a, u64 b) { return (a ^ b); }
+#if defined __AVX2__
+    static inline __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif /* __AVX2__ */
+#if defined __SSE2__
+    static inline __m128i apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif /* __SSE2__ */
+};
+
+// a & ~b
+class AndNotOp
+{
+public:
+    static inline u64 apply(u64 a, u64 b) { return (a & ~b); }
+#if defined __AVX2__
+    static inline __m256i apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif /* __AVX2__ */
+#if defined __SSE2__
+    static inline __m128i apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif /* __SSE2__ */
+};
+
+// dst[i] = Op(a[i], b[i]), for i in [0, num_words).
+// dst may alias a or b.
+template <typename Op>
+static inline void apply_words(u64* dst, const u64* a, const u64* b, u64 num_words)
+{
+    u64 i = 0;
+#if defined __AVX2__
+    for (; i + 4 <= num_words; i += 4) {
+        auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(va, vb));
+    }
+#endif /* __AVX2__ */
+#if defined __SSE2__
+    for (; i + 2 <= num_words; i += 2) {
+        auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Op::apply(va, vb));
+    }
+#endif /* __SSE2__ */
+    for (; i < num_words; ++i) {
+        dst[i] = Op::apply(a[i], b[i]);
+    }
+}
+
+// true iff Op(a[i], b[i]) is zero for all i in [0, num_words)
+template <typename Op>
+static inline bool all_zero_words(const u64* a, const u64* b, u64 num_words)
+{
+    u64 i = 0;
+#if defined __AVX2__
+    for (; i + 4 <= num_words; i += 4) {
+        auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        auto vr = Op::apply(va, vb);
+        if (!_mm256_testz_si256(vr, vr)) {
+            return false;
+        }
+    }
+#endif /* __AVX2__ */
+    for (; i < num_words; ++i) {
+        if (Op::apply(a[i], b[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline u64 popcount_words(const u64* words, u64 num_words)
+{
+    // four independent accumulators, so that the popcounts
+    // are not serialized on a single dependency chain
+    u64 c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    u64 i = 0;
+    for (const u64 last = (num_words & ~(u64)3); i < last; i += 4) {
+        c0 += __builtin_popcountll(words[i]);
+        c1 += __builtin_popcountll(words[i + 1]);
+        c2 += __builtin_popcountll(words[i + 2]);
+        c3 += __builtin_popcountll(words[i + 3]);
+    }
+    for (; i < num_words; ++i) {
+        c0 += __builtin_popcountll(words[i]);
+    }
+    return (c0 + c1 + c2 + c3);
+}
+
+// index of the first non-zero word at or after start_word,
+// or num_words if there is none
+static inline u64 find_nonzero_word(const u64* words, u64 start_word, u64 num_words)
+{
+    u64 i = start_word;
+#if defined __AVX2__
+    for (; i + 4 <= num_words; i += 4) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        if (!_mm256_testz_si256(v, v)) {
+            break;
+        }
+    }
+#endif /* __AVX2__ */
+    for (; i < num_words; ++i) {
+        if (words[i] != 0) {
+            return i;
+        }
+    }
+    return num_words;
+}
+
+// the mask of valid bits in the last word of a set of num_bits bits
+static inline u64 get_last_word_mask(u64 num_bits)
+{
+    return ((num_bits % 64) == 0 ? ~(u64)0 : ((1ull << (num_bits % 64)) - 1));
+}
+
+// position of the set bit of the given rank (zero based) within
+// the word, which must have more than rank bits set
+static inline u64 select_in_word(u64 word, u64 rank)
+{
+#if defined __BMI2__
+    return __builtin_ctzll(_pdep_u64(1ull << rank, word));
+#else /* !__BMI2__ */
+    // narrow down to the byte holding the bit first, then
+    // clear the lower bits of that byte one at a time
+    u64 shift = 0;
+    for (u64 step = 32; step >= 8; step >>= 1) {
+        const u64 count = __builtin_popcountll((word >> shift) & ((1ull << step) - 1));
+        if (count <= rank) {
+            rank -= count;
+            shift += step;
+        }
+    }
+    u64 byte = (word >> shift) & 0xFF;
+    for (; rank > 0; --rank) {
+        byte &= (byte - 1);
+    }
+    return (shift + __builtin_ctzll(byte));
+#endif /* __BMI2__ */
+}
+
+} /* end namespace bit_set_detail_ */
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_BIT_SET_KERNELS_HPP_ */
+
+//
+// BitSetKernels.hpp ends here
@@ -0,0 +1,563 @@
+// BoundedCache.hpp ---
+//
+// Filename: BoundedCache.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:55:38 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_BOUNDED_CACHE_HPP_
+#define AURUM_CONTAINERS_BOUNDED_CACHE_HPP_
+
+#include <mutex>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <utility>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../allocators/MemoryManager.hpp"
+#include "../hashing/Hashers.hpp"
+#include "../comparisons/Comparators.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+#include "Vector.hpp"
+#include "UnorderedMap.hpp"
+#include "BoundedCacheTypes.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace aa = aurum::allocators;
+namespace ah = aurum::hashing;
+namespace acmp = aurum::comparisons;
+namespace as = aurum::stringification;
+
+// A cache of at most a given capacity, which evicts entries as
+// chosen by EvictionPolicy (see BoundedCacheTypes.hpp) to make room
+// for new ones. The size of each entry is given by SizeFunction, so
+// the capacity is a number of entries by default, and can be a
+// number of bytes, or anything else, with a different SizeFunction.
+// Entries are stored in an array of slots which are reused after an
+// eviction, with an UnorderedMap from keys to slots.
+// Lookups update the eviction policy and the statistics, so they
+// are not const: use peek() or contains() for lookups which do not.
+// Pointers to values are valid until the next update of the cache.
+template <typename K, typename V,
+          typename EvictionPolicy = LRUCachePolicy,
+          typename SizeFunction = UnitCacheSize,
+          typename HashFunction = ah::Hasher<K>,
+          typename EqualsFunction = acmp::EqualTo<K> >
+class BoundedCache final
+    : public AurumObject<BoundedCache<K, V, EvictionPolicy, SizeFunction,
+                                      HashFunction, EqualsFunction> >,
+      public Stringifiable<BoundedCache<K, V, EvictionPolicy, SizeFunction,
+                                        HashFunction, EqualsFunction> >,
+      private HashFunction, private SizeFunction
+{
+private:
+    struct Slot
+    {
+        K m_key;
+        V m_value;
+        u64 m_hash;
+        u64 m_size;
+    };
+
+    typedef UnifiedUnorderedMap<K, u32, HashFunction, EqualsFunction> IndexType;
+
+    EvictionPolicy m_policy;
+    IndexType m_index;
+    Vector<Slot> m_slots;
+    Vector<u32> m_free_slots;
+    u64 m_capacity;
+    u64 m_used_capacity;
+    CacheStatistics m_statistics;
+
+    inline u64 hash(const K& key) const
+    {
+        return HashFunction::operator()(key);
+    }
+
+    inline u64 get_size(const K& key, const V& value) const
+    {
+        return SizeFunction::operator()(key, value);
+    }
+
+    inline u32 allocate_slot()
+    {
+        if (m_free_slots.size() > 0) {
+            auto retval = m_free_slots.back();
+            m_free_slots.pop_back();
+            return retval;
+        }
+        const u32 retval = m_slots.size();
+        m_slots.push_back(Slot());
+        m_policy.reserve(m_slots.size());
+        return retval;
+    }
+
+    inline void erase_slot(u32 slot)
+    {
+        auto& entry = m_slots[slot];
+        m_policy.on_erase(slot);
+        m_index.erase(entry.m_key);
+        m_used_capacity -= entry.m_size;
+        // release whatever the key and value hold on to
+        entry.m_key = K();
+        entry.m_value = V();
+        m_free_slots.push_back(slot);
+    }
+
+    // evicts until the used capacity is within the capacity,
+    // never evicting the entry in keep_slot
+    inline void shrink_to_capacity(u32 keep_slot)
+    {
+        while (m_used_capacity > m_capacity) {
+            const u32 victim = m_policy.get_victim();
+            if (victim == keep_slot) {
+                // only possible when everything else has been
+                // passed over as well, so this terminates
+                m_policy.on_access(victim, m_slots[victim].m_hash);
+                continue;
+            }
+            erase_slot(victim);
+            ++m_statistics.m_evictions;
+        }
+    }
+
+    // record_miss is false when the miss has already been
+    // reported to the policy by a lookup
+    inline bool insert(const K& key, const V& value, u64 key_hash, bool record_miss)
+    {
+        const u64 size = get_size(key, value);
+        auto it = m_index.find(key);
+
+        if (it != m_index.end()) {
+            const u32 slot = it->second;
+            auto& entry = m_slots[slot];
+            if (size > m_capacity) {
+                erase_slot(slot);
+                ++m_statistics.m_rejections;
+                return false;
+            }
+            m_used_capacity = m_used_capacity - entry.m_size + size;
+            entry.m_value = value;
+            entry.m_size = size;
+            m_policy.on_access(slot, key_hash);
+            shrink_to_capacity(slot);
+            return true;
+        }
+
+        if (record_miss) {
+            m_policy.on_miss(key_hash);
+        }
+        if (size > m_capacity) {
+            ++m_statistics.m_rejections;
+            return false;
+        }
+        // every victim must be worth evicting for the new entry, so
+        // that one large entry cannot displace many that the policy
+        // would keep. The victims are only known one at a time, so
+        // those evicted before a victim turns the new entry down
+        // stay evicted, each having lost to the new entry
+        while (m_used_capacity + size > m_capacity) {
+            const u32 victim = m_policy.get_victim();
+            if (!m_policy.admit(key_hash, m_slots[victim].m_hash)) {
+                ++m_statistics.m_rejections;
+                return false;
+            }
+            erase_slot(victim);
+            ++m_statistics.m_evictions;
+        }
+
+        const u32 slot = allocate_slot();
+        auto& entry = m_slots[slot];
+        entry.m_key = key;
+        entry.m_value = value;
+        entry.m_hash = key_hash;
+        entry.m_size = size;
+        m_index.insert(key, slot);
+        m_used_capacity += size;
+        m_policy.on_insert(slot, key_hash);
+        ++m_statistics.m_insertions;
+        return true;
+    }
+
+public:
+    typedef K KeyType;
+    typedef V ValueType;
+
+    inline explicit BoundedCache(u64 capacity)
+        : HashFunction(), SizeFunction(), m_policy(), m_index(), m_slots(),
+          m_free_slots(), m_capacity(capacity), m_used_capacity(0), m_statistics()
+    {
+        // Nothing here
+    }
+
+    inline BoundedCache(const BoundedCache& other)
+        : HashFunction(other), SizeFunction(other), m_policy(other.m_policy),
+          m_index(other.m_index), m_slots(other.m_slots), m_free_slots(other.m_free_slots),
+          m_capacity(other.m_capacity), m_used_capacity(other.m_used_capacity),
+          m_statistics(other.m_statistics)
+    {
+        // Nothing here
+    }
+
+    inline ~BoundedCache()
+    {
+        // Nothing here
+    }
+
+    inline BoundedCache& operator = (const BoundedCache& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_policy = other.m_policy;
+        m_index = other.m_index;
+        m_slots = other.m_slots;
+        m_free_slots = other.m_free_slots;
+        m_capacity = other.m_capacity;
+        m_used_capacity = other.m_used_capacity;
+        m_statistics = other.m_statistics;
+        return *this;
+    }
+
+    // the number of entries
+    inline u64 size() const
+    {
+        return m_index.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_index.size() == 0);
+    }
+
+    inline u64 get_capacity() const
+    {
+        return m_capacity;
+    }
+
+    // the sum of the sizes of the entries
+    inline u64 get_used_capacity() const
+    {
+        return m_used_capacity;
+    }
+
+    // evicts entries as needed to fit in the new capacity
+    inline void set_capacity(u64 capacity)
+    {
+        m_capacity = capacity;
+        shrink_to_capacity(bounded_cache_detail_::sc_nil_slot);
+    }
+
+    inline const CacheStatistics& get_statistics() const
+    {
+        return m_statistics;
+    }
+
+    inline void reset_statistics()
+    {
+        m_statistics = CacheStatistics();
+    }
+
+    // the value for key, or nullptr on a miss
+    inline const V* find(const K& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            ++m_statistics.m_misses;
+            m_policy.on_miss(hash(key));
+            return nullptr;
+        }
+        ++m_statistics.m_hits;
+        auto& entry = m_slots[it->second];
+        m_policy.on_access(it->second, entry.m_hash);
+        return &(entry.m_value);
+    }
+
+    // like find(), but affects neither the eviction order
+    // nor the statistics
+    inline const V* peek(const K& key) const
+    {
+        auto it = m_index.find(key);
+        return (it == m_index.end() ? nullptr : &(m_slots[it->second].m_value));
+    }
+
+    inline bool contains(const K& key) const
+    {
+        return (m_index.find(key) != m_index.end());
+    }
+
+    // inserts or replaces the value for key, evicting other entries
+    // as needed. returns false if the entry did not make it into the
+    // cache, because the admission policy turned it down, or it is
+    // larger than the capacity of the cache
+    inline bool insert(const K& key, const V& value)
+    {
+        return insert(key, value, hash(key), true);
+    }
+
+    // the value for key, computed with compute(key) and
+    // inserted on a miss
+    template <typename ComputeFunction>
+    inline V get_or_compute(const K& key, const ComputeFunction& compute)
+    {
+        auto value_ptr = find(key);
+        if (value_ptr != nullptr) {
+            return *value_ptr;
+        }
+        V retval = compute(key);
+        insert(key, retval, hash(key), false);
+        return retval;
+    }
+
+    inline bool erase(const K& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end()) {
+            return false;
+        }
+        erase_slot(it->second);
+        return true;
+    }
+
+    // the statistics are kept, they cover the lifetime of
+    // the cache until reset_statistics() is called
+    inline void clear()
+    {
+        m_policy = EvictionPolicy();
+        m_index.clear();
+        m_slots.clear();
+        m_free_slots.clear();
+        m_used_capacity = 0;
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "BoundedCache<" << type_name<K>() << ", " << type_name<V>() << "> with "
+             << size() << " elements, using " << m_used_capacity << " of "
+             << m_capacity << ":" << std::endl << "<<" << std::endl;
+        as::Stringifier<K> key_stringifier;
+        as::Stringifier<V> value_stringifier;
+        for (auto const& key_slot : m_index) {
+            sstr << "  {" << key_stringifier(key_slot.first, verbosity) << " |--> "
+                 << value_stringifier(m_slots[key_slot.second].m_value, verbosity)
+                 << "}" << std::endl;
+        }
+        sstr << ">>";
+        return sstr.str();
+    }
+};
+
+// A BoundedCache split into shards by key, each with its own lock
+// and an equal share of the capacity, for use from multiple threads.
+// Values are copied out of the cache, since entries may be evicted
+// by other threads at any point
+template <typename K, typename V,
+          typename EvictionPolicy = LRUCachePolicy,
+          typename SizeFunction = UnitCacheSize,
+          typename HashFunction = ah::Hasher<K>,
+          typename EqualsFunction = acmp::EqualTo<K> >
+class ConcurrentBoundedCache final
+    : public AurumObject<ConcurrentBoundedCache<K, V, EvictionPolicy, SizeFunction,
+                                                HashFunction, EqualsFunction> >,
+      private HashFunction
+{
+private:
+    typedef BoundedCache<K, V, EvictionPolicy, SizeFunction,
+                         HashFunction, EqualsFunction> CacheType;
+
+    // shards are allocated separately, which keeps the locks of
+    // different shards off each other's cache lines
+    struct Shard
+    {
+        std::mutex m_mutex;
+        CacheType m_cache;
+
+        inline Shard(u64 capacity)
+            : m_mutex(), m_cache(capacity)
+        {
+            // Nothing here
+        }
+    };
+
+    Vector<Shard*> m_shards;
+
+    inline Shard& get_shard(const K& key) const
+    {
+        // the hashers of integral types are the identity,
+        // so mix the bits before picking a shard
+        const u64 mixed = (HashFunction::operator()(key) * 0x9E3779B97F4A7C15ull);
+        return *(m_shards[(mixed >> 32) % m_shards.size()]);
+    }
+
+public:
+    static constexpr u32 sc_default_num_shards = 16;
+
+    inline explicit ConcurrentBoundedCache(u64 capacity,
+                                           u32 num_shards = sc_default_num_shards)
+        : HashFunction(), m_shards()
+    {
+        num_shards = std::max(num_shards, (u32)1);
+        for (u32 i = 0; i < num_shards; ++i) {
+            // the first (capacity % num_shards) shards get one more
+            const u64 shard_capacity = (capacity / num_shards) +
+                (i < (capacity % num_shards) ? 1 : 0);
+            m_shards.push_back(aa::allocate_object_raw<Shard>(shard_capacity));
+        }
+    }
+
+    ConcurrentBoundedCache(const ConcurrentBoundedCache& other) = delete;
+    ConcurrentBoundedCache& operator = (const ConcurrentBoundedCache& other) = delete;
+
+    inline ~ConcurrentBoundedCache()
+    {
+        for (auto shard : m_shards) {
+            aa::deallocate_object_raw(shard, sizeof(Shard));
+        }
+    }
+
+    inline u32 get_num_shards() const
+    {
+        return m_shards.size();
+    }
+
+    inline u64 size() const
+    {
+        u64 retval = 0;
+        for (auto shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard->m_mutex);
+            retval += shard->m_cache.size();
+        }
+        return retval;
+    }
+
+    inline bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    inline CacheStatistics get_statistics() const
+    {
+        CacheStatistics retval;
+        for (auto shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard->m_mutex);
+            retval += shard->m_cache.get_statistics();
+        }
+        return retval;
+    }
+
+    inline void reset_statistics()
+    {
+        for (auto shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard->m_mutex);
+            shard->m_cache.reset_statistics();
+        }
+    }
+
+    // copies the value for key into value on a hit
+    inline bool find(const K& key, V& value)
+    {
+        auto& shard = get_shard(key);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        auto value_ptr = shard.m_cache.find(key);
+        if (value_ptr == nullptr) {
+            return false;
+        }
+        value = *value_ptr;
+        return true;
+    }
+
+    inline bool contains(const K& key) const
+    {
+        auto& shard = get_shard(key);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        return shard.m_cache.contains(key);
+    }
+
+    inline bool insert(const K& key, const V& value)
+    {
+        auto& shard = get_shard(key);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        return shard.m_cache.insert(key, value);
+    }
+
+    // the value is computed without holding any locks, so
+    // concurrent misses on the same key may compute it more than once
+    template <typename ComputeFunction>
+    inline V get_or_compute(const K& key, const ComputeFunction& compute)
+    {
+        V retval;
+        if (find(key, retval)) {
+            return retval;
+        }
+        retval = compute(key);
+        insert(key, retval);
+        return retval;
+    }
+
+    inline bool erase(const K& key)
+    {
+        auto& shard = get_shard(key);
+        std::lock_guard<std::mutex> guard(shard.m_mutex);
+        return shard.m_cache.erase(key);
+    }
+
+    // the statistics are kept, as in BoundedCache
+    inline void clear()
+    {
+        for (auto shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard->m_mutex);
+            shard->m_cache.clear();
+        }
+    }
+};
+
+template <typename K, typename V, typename EvictionPolicy, typename SizeFunction,
+          typename HashFunction, typename EqualsFunction>
+constexpr u32 ConcurrentBoundedCache<K, V, EvictionPolicy, SizeFunction,
+                                     HashFunction, EqualsFunction>::sc_default_num_shards;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_BOUNDED_CACHE_HPP_ */
+
+//
+// BoundedCache.hpp ends here
@@ -0,0 +1,425 @@
+// BoundedCacheTypes.hpp ---
+//
+// Filename: BoundedCacheTypes.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:55:38 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_BOUNDED_CACHE_TYPES_HPP_
+#define AURUM_CONTAINERS_BOUNDED_CACHE_TYPES_HPP_
+
+#include <algorithm>
+
+#include "../basetypes/AurumTypes.hpp"
+
+#include "Vector.hpp"
+
+// Eviction policies, size functors and statistics for BoundedCache.
+// The entries of a cache live in an array of slots, and the policies
+// keep their bookkeeping in arrays indexed by slot, so no per entry
+// nodes are allocated. A policy must provide:
+//   void reserve(u32 num_slots): slots are in [0, num_slots) from now on
+//   void on_insert(u32 slot, u64 hash): an entry was put in slot
+//   void on_access(u32 slot, u64 hash): a hit on the entry in slot
+//   void on_miss(u64 hash): a key with the hash, which is not in the
+//                           cache, was looked up or inserted
+//   void on_erase(u32 slot): the entry in slot was erased or evicted
+//   u32 get_victim(): the slot of the entry to evict next, there
+//                     will always be at least one entry
+//   bool admit(u64 hash, u64 victim_hash): whether a new entry is worth
+//                                          evicting the victim for
+//   void clear(): all the entries are gone
+
+namespace aurum {
+namespace containers {
+
+namespace bounded_cache_detail_ {
+
+static constexpr u32 sc_nil_slot = 0xFFFFFFFF;
+
+} /* end namespace bounded_cache_detail_ */
+
+// every entry has size one, so capacities are in number of entries
+class UnitCacheSize
+{
+public:
+    template <typename K, typename V>
+    inline u64 operator () (const K& key, const V& value) const
+    {
+        return 1;
+    }
+};
+
+struct CacheStatistics
+{
+    u64 m_hits;
+    u64 m_misses;
+    u64 m_insertions;
+    u64 m_evictions;
+    // insertions turned down by the admission policy, or because
+    // the entry is larger than the whole cache
+    u64 m_rejections;
+
+    inline CacheStatistics()
+        : m_hits(0), m_misses(0), m_insertions(0), m_evictions(0), m_rejections(0)
+    {
+        // Nothing here
+    }
+
+    inline CacheStatistics& operator += (const CacheStatistics& other)
+    {
+        m_hits += other.m_hits;
+        m_misses += other.m_misses;
+        m_insertions += other.m_insertions;
+        m_evictions += other.m_evictions;
+        m_rejections += other.m_rejections;
+        return *this;
+    }
+
+    inline double get_hit_ratio() const
+    {
+        const u64 lookups = m_hits + m_misses;
+        return (lookups == 0 ? 0.0 : (double)m_hits / lookups);
+    }
+};
+
+// Least recently used: the slots are kept on a doubly linked list
+// in order of use, threaded through two arrays
+class LRUCachePolicy
+{
+private:
+    Vector<u32> m_prev;
+    Vector<u32> m_next;
+    // most recently used
+    u32 m_head;
+    // least recently used
+    u32 m_tail;
+
+    inline void unlink(u32 slot)
+    {
+        const u32 prev = m_prev[slot];
+        const u32 next = m_next[slot];
+        if (prev == bounded_cache_detail_::sc_nil_slot) {
+            m_head = next;
+        } else {
+            m_next[prev] = next;
+        }
+        if (next == bounded_cache_detail_::sc_nil_slot) {
+            m_tail = prev;
+        } else {
+            m_prev[next] = prev;
+        }
+    }
+
+    inline void push_front(u32 slot)
+    {
+        m_prev[slot] = bounded_cache_detail_::sc_nil_slot;
+        m_next[slot] = m_head;
+        if (m_head == bounded_cache_detail_::sc_nil_slot) {
+            m_tail = slot;
+        } else {
+            m_prev[m_head] = slot;
+        }
+        m_head = slot;
+    }
+
+public:
+    inline LRUCachePolicy()
+        : m_prev(), m_next(),
+          m_head(bounded_cache_detail_::sc_nil_slot),
+          m_tail(bounded_cache_detail_::sc_nil_slot)
+    {
+        // Nothing here
+    }
+
+    inline void reserve(u32 num_slots)
+    {
+        m_prev.resize(num_slots, bounded_cache_detail_::sc_nil_slot);
+        m_next.resize(num_slots, bounded_cache_detail_::sc_nil_slot);
+    }
+
+    inline void on_insert(u32 slot, u64 hash)
+    {
+        push_front(slot);
+    }
+
+    inline void on_access(u32 slot, u64 hash)
+    {
+        if (slot != m_head) {
+            unlink(slot);
+            push_front(slot);
+        }
+    }
+
+    inline void on_miss(u64 hash)
+    {
+        // Nothing here
+    }
+
+    inline void on_erase(u32 slot)
+    {
+        unlink(slot);
+    }
+
+    inline u32 get_victim() const
+    {
+        return m_tail;
+    }
+
+    inline bool admit(u64 hash, u64 victim_hash) const
+    {
+        return true;
+    }
+
+    inline void clear()
+    {
+        m_head = m_tail = bounded_cache_detail_::sc_nil_slot;
+    }
+};
+
+// CLOCK (second chance): a hand sweeps over the slots, clearing the
+// referenced bits it finds set, and evicts the first entry it finds
+// with a clear bit. A hit only sets a bit, which makes it cheaper than
+// LRU, while approximating it well
+class ClockCachePolicy
+{
+private:
+    enum SlotState : u08 {
+        Empty = 0, Unreferenced = 1, Referenced = 2
+    };
+
+    Vector<u08> m_states;
+    u32 m_hand;
+
+public:
+    inline ClockCachePolicy()
+        : m_states(), m_hand(0)
+    {
+        // Nothing here
+    }
+
+    inline void reserve(u32 num_slots)
+    {
+        m_states.resize(num_slots, Empty);
+    }
+
+    inline void on_insert(u32 slot, u64 hash)
+    {
+        m_states[slot] = Unreferenced;
+    }
+
+    inline void on_access(u32 slot, u64 hash)
+    {
+        m_states[slot] = Referenced;
+    }
+
+    inline void on_miss(u64 hash)
+    {
+        // Nothing here
+    }
+
+    inline void on_erase(u32 slot)
+    {
+        m_states[slot] = Empty;
+    }
+
+    inline u32 get_victim()
+    {
+        const u32 num_slots = m_states.size();
+        while (true) {
+            if (m_hand >= num_slots) {
+                m_hand = 0;
+            }
+            const u32 slot = m_hand++;
+            if (m_states[slot] == Unreferenced) {
+                return slot;
+            }
+            if (m_states[slot] == Referenced) {
+                m_states[slot] = Unreferenced;
+            }
+        }
+    }
+
+    inline bool admit(u64 hash, u64 victim_hash) const
+    {
+        return true;
+    }
+
+    inline void clear()
+    {
+        std::fill(m_states.begin(), m_states.end(), (u08)Empty);
+        m_hand = 0;
+    }
+};
+
+// LRU eviction with TinyLFU admission (Einziger, Friedman and Manes):
+// the access frequencies of recently seen keys, hits and misses alike,
+// are estimated with a count-min sketch of four bit counters, and a
+// new entry only displaces each LRU victim if it is estimated to be
+// more frequently used. This keeps one-off keys (scans, say) from
+// flushing out the working set. The counters are halved periodically,
+// so that the estimates track recent history
+class TinyLFUCachePolicy : public LRUCachePolicy
+{
+private:
+    static constexpr u32 sc_num_rows = 4;
+    static constexpr u64 sc_max_count = 15;
+
+    // sixteen four bit counters per word
+    Vector<u64> m_table;
+    u64 m_row_mask;
+    u64 m_num_increments;
+    u64 m_reset_threshold;
+
+    inline u64 get_counter_index(u64 hash, u32 row) const
+    {
+        // a different multiplicative rehash of the hash for each row
+        static constexpr u64 sc_seeds[sc_num_rows] = {
+            0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full,
+            0x165667B19E3779F9ull, 0xD6E8FEB86659FD93ull
+        };
+        const u64 rehashed = (hash * sc_seeds[row]);
+        return ((rehashed >> 32) & m_row_mask) + (row * (m_row_mask + 1));
+    }
+
+    inline u64 get_counter(u64 index) const
+    {
+        return ((m_table[index / 16] >> ((index % 16) * 4)) & 0xF);
+    }
+
+    inline void halve_counters()
+    {
+        for (auto& word : m_table) {
+            word = (word >> 1) & 0x7777777777777777ull;
+        }
+        m_num_increments /= 2;
+    }
+
+    inline void increment(u64 hash)
+    {
+        if (m_table.size() == 0) {
+            return;
+        }
+        // only the smallest counters are incremented (conservative
+        // update), which reduces the overestimation
+        const u64 estimate = get_estimate(hash);
+        if (estimate == sc_max_count) {
+            return;
+        }
+        for (u32 row = 0; row < sc_num_rows; ++row) {
+            const u64 index = get_counter_index(hash, row);
+            if (get_counter(index) == estimate) {
+                m_table[index / 16] += ((u64)1 << ((index % 16) * 4));
+            }
+        }
+        if (++m_num_increments >= m_reset_threshold) {
+            halve_counters();
+        }
+    }
+
+public:
+    inline TinyLFUCachePolicy()
+        : LRUCachePolicy(), m_table(), m_row_mask(0), m_num_increments(0),
+          m_reset_threshold(0)
+    {
+        // Nothing here
+    }
+
+    inline void reserve(u32 num_slots)
+    {
+        LRUCachePolicy::reserve(num_slots);
+        // about four counters per row per slot, the sketch is
+        // rebuilt (and its history forgotten) as the cache grows
+        u64 row_size = 64;
+        while (row_size < (u64)num_slots * 4) {
+            row_size *= 2;
+        }
+        if (row_size != m_row_mask + 1) {
+            m_row_mask = row_size - 1;
+            m_table.clear();
+            m_table.resize(row_size * sc_num_rows / 16, 0);
+            m_num_increments = 0;
+            m_reset_threshold = row_size * 10;
+        }
+    }
+
+    inline void on_insert(u32 slot, u64 hash)
+    {
+        LRUCachePolicy::on_insert(slot, hash);
+    }
+
+    inline void on_access(u32 slot, u64 hash)
+    {
+        increment(hash);
+        LRUCachePolicy::on_access(slot, hash);
+    }
+
+    inline void on_miss(u64 hash)
+    {
+        increment(hash);
+    }
+
+    inline u64 get_estimate(u64 hash) const
+    {
+        if (m_table.size() == 0) {
+            return 0;
+        }
+        u64 retval = sc_max_count;
+        for (u32 row = 0; row < sc_num_rows; ++row) {
+            retval = std::min(retval, get_counter(get_counter_index(hash, row)));
+        }
+        return retval;
+    }
+
+    inline bool admit(u64 hash, u64 victim_hash) const
+    {
+        return (get_estimate(hash) > get_estimate(victim_hash));
+    }
+
+    inline void clear()
+    {
+        LRUCachePolicy::clear();
+        std::fill(m_table.begin(), m_table.end(), (u64)0);
+        m_num_increments = 0;
+    }
+};
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_BOUNDED_CACHE_TYPES_HPP_ */
+
+//
+// BoundedCacheTypes.hpp ends here
@@ -0,0 +1,319 @@
+// ConcurrentRefCache.hpp ---
+//
+// Filename: ConcurrentRefCache.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 03:44:19 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_CONCURRENT_REF_CACHE_HPP_
+#define AURUM_CONTAINERS_CONCURRENT_REF_CACHE_HPP_
+
+#include <mutex>
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/AurumTraits.hpp"
+#include "../basetypes/RefCountable.hpp"
+#include "../memory/ManagedPointer.hpp"
+#include "../allocators/MemoryManager.hpp"
+
+#include "RefCache.hpp"
+#include "HashTable.hpp"
+#include "Vector.hpp"
+
+namespace aurum {
+namespace containers {
+namespace concurrent_ref_cache_detail_ {
+
+namespace ac = aurum::containers;
+namespace am = aurum::memory;
+namespace aa = aurum::allocators;
+namespace rcd = aurum::containers::ref_cache_detail_;
+
+// A RefCache that can be shared by several threads, which then get
+// the same canonical object for equal values. The objects are
+// partitioned into shards on their hash values, and each shard is a
+// hash table guarded by its own lock.
+// The objects must be AtomicRefCountable. Their hash values are
+// computed concurrently, which Hashable supports: the cached value
+// is published with a single atomic store, so a thread sees either
+// no cached value or the complete one. Other hash functions must be
+// safe to call concurrently on a shared object.
+// The cache collects a shard when it grows past its limit, in the
+// thread whose get() grew it. Only get() takes references from the
+// cache, under the lock of the shard, so an object that the cache holds
+// the only reference to can be deleted under that lock regardless of
+// what other threads are doing; the deletions themselves happen after
+// the lock is released.
+template <typename T, typename HashFunction, typename EqualsFunction>
+class ConcurrentRefCache final
+    : public AurumObject<ConcurrentRefCache<T, HashFunction, EqualsFunction> >
+{
+    static_assert(IsAtomicRefCountable<T>::value,
+                  "ConcurrentRefCaches can only be created with AtomicRefCountable types.");
+
+private:
+    typedef rcd::KeyHasher<T, HashFunction> KeyHasherType;
+    typedef rcd::KeyEqualTo<T, HashFunction, EqualsFunction> KeyEqualToType;
+    typedef RestrictedHashTable<T*, KeyHasherType, KeyEqualToType> HashTableType;
+
+    static constexpr bool sc_can_use_construction_keys =
+        (std::is_same<HashFunction, rcd::DefaultHashFunction<T> >::value &&
+         std::is_same<EqualsFunction, rcd::DefaultEqualsFunction<T> >::value);
+    static constexpr float sc_default_growth_factor = 1.5f;
+    static constexpr u64 sc_initial_gc_limit = 128;
+
+    // shards are allocated separately, which keeps the locks of
+    // different shards off each other's cache lines
+    struct Shard
+    {
+        std::mutex m_mutex;
+        HashTableType m_hash_table;
+        u64 m_next_gc_limit;
+
+        inline Shard()
+            : m_mutex(), m_hash_table(), m_next_gc_limit(sc_initial_gc_limit)
+        {
+            // Nothing here
+        }
+    };
+
+    Vector<Shard*> m_shards;
+    const float m_growth_factor;
+
+    inline Shard& get_shard(u64 hash_value) const
+    {
+        // the hashers of integral types are the identity,
+        // so mix the bits before picking a shard
+        const u64 mixed = (hash_value * 0x9E3779B97F4A7C15ull);
+        return *(m_shards[(mixed >> 32) % m_shards.size()]);
+    }
+
+    // removes the objects which only the cache refers to from the
+    // shard, and then deletes them, returns the number deleted
+    inline u64 collect_shard(Shard& shard)
+    {
+        Vector<T*> garbage;
+        {
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            auto& hash_table = shard.m_hash_table;
+            if (hash_table.size() > 0) {
+                hash_table.begin_multi_erase_sequence();
+                for (auto it = hash_table.begin(), last = hash_table.end(); it != last; ++it) {
+                    if ((*it)->get_ref_count_() == 1) {
+                        garbage.push_back(*it);
+                        hash_table.erase(it);
+                    }
+                }
+                hash_table.end_multi_erase_sequence();
+            }
+            shard.m_next_gc_limit = std::max((u64)ceilf((float)hash_table.size() * m_growth_factor),
+                                             sc_initial_gc_limit);
+        }
+
+        // these may release objects in any shard, which
+        // are then found by later collections
+        for (auto object : garbage) {
+            object->dec_ref_();
+        }
+        return garbage.size();
+    }
+
+    // inserts the object, unless another thread got an equal one into
+    // the cache first, in which case the object is deleted, and the
+    // one in the cache is returned
+    template <typename U>
+    inline am::ManagedPointer<U> insert_new(Shard& shard, U* new_object)
+    {
+        am::ManagedPointer<U> retval;
+        bool already_present;
+        bool needs_gc;
+        {
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            auto it = shard.m_hash_table.insert(new_object, already_present);
+            if (!already_present) {
+                new_object->inc_ref_();
+            }
+            retval = static_cast<U*>(*it);
+            needs_gc = (shard.m_hash_table.size() >= shard.m_next_gc_limit);
+        }
+
+        if (already_present) {
+            delete new_object;
+        }
+        if (needs_gc) {
+            collect_shard(shard);
+        }
+        return retval;
+    }
+
+    // probes with the construction arguments, and constructs
+    // an object only if there is no equal object in the cache
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get_(std::true_type use_construction_key, ArgTypes&&... args)
+    {
+        rcd::ConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...> key(args...);
+        auto& shard = get_shard(key.get_hash_value());
+        {
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            auto it = shard.m_hash_table.find(key);
+            if (it != shard.m_hash_table.end()) {
+                return am::ManagedPointer<U>(static_cast<U*>(*it));
+            }
+        }
+        // constructed without holding the lock, since
+        // constructors may well get objects from the cache
+        return insert_new(shard, new U(std::forward<ArgTypes>(args)...));
+    }
+
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get_(std::false_type use_construction_key, ArgTypes&&... args)
+    {
+        auto new_object = new U(std::forward<ArgTypes>(args)...);
+        HashFunction hash_fun;
+        return insert_new(get_shard(hash_fun(new_object)), new_object);
+    }
+
+public:
+    typedef am::ManagedPointer<T> RefType;
+    typedef am::ManagedConstPointer<T> CRefType;
+
+    static constexpr u32 sc_default_num_shards = 16;
+
+    inline explicit ConcurrentRefCache(u32 num_shards = sc_default_num_shards,
+                                       float growth_factor = sc_default_growth_factor)
+        : m_shards(), m_growth_factor(std::max(growth_factor, 1.1f))
+    {
+        num_shards = std::max(num_shards, (u32)1);
+        for (u32 i = 0; i < num_shards; ++i) {
+            m_shards.push_back(aa::allocate_object_raw<Shard>());
+        }
+    }
+
+    ConcurrentRefCache(const ConcurrentRefCache& other) = delete;
+    ConcurrentRefCache& operator = (const ConcurrentRefCache& other) = delete;
+
+    inline ~ConcurrentRefCache()
+    {
+        // as with RefCache, anyone still holding references
+        // releases the objects eventually
+        for (auto shard : m_shards) {
+            for (auto const& ptr : shard->m_hash_table) {
+                ptr->dec_ref_();
+            }
+            shard->m_hash_table.clear();
+            aa::deallocate_object_raw(shard, sizeof(Shard));
+        }
+    }
+
+    // returns the cached object equal to U(args...), constructing it
+    // only if there is none. The reference is taken under the lock
+    // of the shard, so the object cannot be collected before the
+    // caller gets to it
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get(ArgTypes&&... args)
+    {
+        static_assert(std::is_convertible<U*, T*>::value,
+                      "ConcurrentRefCache: Cannot call get on unrelated type.");
+
+        typedef typename rcd::HasConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...>::type
+            HasKeyType;
+        typedef std::integral_constant<bool, (HasKeyType::value && sc_can_use_construction_keys)>
+            UseKeyType;
+        return get_<U>(UseKeyType(), std::forward<ArgTypes>(args)...);
+    }
+
+    inline u64 size() const
+    {
+        u64 retval = 0;
+        for (auto shard : m_shards) {
+            std::lock_guard<std::mutex> guard(shard->m_mutex);
+            retval += shard->m_hash_table.size();
+        }
+        return retval;
+    }
+
+    inline u32 get_num_shards() const
+    {
+        return m_shards.size();
+    }
+
+    inline float get_growth_factor() const
+    {
+        return m_growth_factor;
+    }
+
+    // collects all the shards, until nothing more is released.
+    // Safe to call while other threads use the cache, but then
+    // there may be garbage left behind by their releases
+    inline void garbage_collect()
+    {
+        u64 num_collected;
+        do {
+            num_collected = 0;
+            for (auto shard : m_shards) {
+                num_collected += collect_shard(*shard);
+            }
+        } while (num_collected > 0);
+    }
+};
+
+template <typename T, typename HashFunction, typename EqualsFunction>
+constexpr float ConcurrentRefCache<T, HashFunction, EqualsFunction>::sc_default_growth_factor;
+
+template <typename T, typename HashFunction, typename EqualsFunction>
+constexpr u64 ConcurrentRefCache<T, HashFunction, EqualsFunction>::sc_initial_gc_limit;
+
+template <typename T, typename HashFunction, typename EqualsFunction>
+constexpr u32 ConcurrentRefCache<T, HashFunction, EqualsFunction>::sc_default_num_shards;
+
+} /* end namespace concurrent_ref_cache_detail_ */
+
+template <typename T,
+          typename HashFunction = ref_cache_detail_::DefaultHashFunction<T>,
+          typename EqualsFunction = ref_cache_detail_::DefaultEqualsFunction<T> >
+using ConcurrentRefCache =
+    concurrent_ref_cache_detail_::ConcurrentRefCache<T, HashFunction, EqualsFunction>;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_CONCURRENT_REF_CACHE_HPP_ */
+
+//
+// ConcurrentRefCache.hpp ends here
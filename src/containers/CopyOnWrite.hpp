@@ -0,0 +1,261 @@
+// CopyOnWrite.hpp ---
+//
+// Filename: CopyOnWrite.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:50:46 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_COPY_ON_WRITE_HPP_
+#define AURUM_CONTAINERS_COPY_ON_WRITE_HPP_
+
+#include <atomic>
+#include <utility>
+#include <string>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../allocators/MemoryManager.hpp"
+
+#include "Vector.hpp"
+#include "UnorderedMap.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace copy_on_write_detail_ {
+
+namespace aa = aurum::allocators;
+
+template <typename ContainerType>
+class SharedBlock final
+{
+public:
+    std::atomic<u64> m_ref_count;
+    ContainerType m_container;
+
+    template <typename... ArgTypes>
+    inline SharedBlock(ArgTypes&&... args)
+        : m_ref_count(1), m_container(std::forward<ArgTypes>(args)...)
+    {
+        // Nothing here
+    }
+
+    inline ~SharedBlock()
+    {
+        // Nothing here
+    }
+};
+
+} /* end namespace copy_on_write_detail_ */
+
+// An opt-in copy-on-write handle to a container. Copies of the
+// handle share the container, which is cloned only on the first
+// mutable access through a handle that is not the only one sharing
+// it. So copies which are only ever read cost an (atomic) increment.
+// Sharing is thread safe: handles to the same container may be
+// copied, read through and destroyed concurrently from different
+// threads, which is what makes read-only copies handed to worker
+// threads free. As with any other object, a single handle must not be
+// used from one thread while it is being mutated from another.
+// References obtained through get() stay valid only until the next
+// call to get_mutable() on the same handle.
+template <typename ContainerType_>
+class CopyOnWrite final : public AurumObject<CopyOnWrite<ContainerType_> >,
+                          public Stringifiable<CopyOnWrite<ContainerType_> >
+{
+public:
+    typedef ContainerType_ ContainerType;
+
+private:
+    typedef copy_on_write_detail_::SharedBlock<ContainerType> BlockType;
+
+    BlockType* m_block;
+
+    static inline void acquire(BlockType* block)
+    {
+        block->m_ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static inline void release(BlockType* block)
+    {
+        // the acquire half orders the destruction after all the
+        // reads made through the other handles
+        if (block->m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            aa::deallocate_object_raw(block, sizeof(BlockType));
+        }
+    }
+
+public:
+    inline CopyOnWrite()
+        : m_block(aa::allocate_object_raw<BlockType>())
+    {
+        // Nothing here
+    }
+
+    inline explicit CopyOnWrite(const ContainerType& container)
+        : m_block(aa::allocate_object_raw<BlockType>(container))
+    {
+        // Nothing here
+    }
+
+    inline explicit CopyOnWrite(ContainerType&& container)
+        : m_block(aa::allocate_object_raw<BlockType>(std::move(container)))
+    {
+        // Nothing here
+    }
+
+    inline CopyOnWrite(const CopyOnWrite& other)
+        : m_block(other.m_block)
+    {
+        acquire(m_block);
+    }
+
+    inline ~CopyOnWrite()
+    {
+        release(m_block);
+    }
+
+    inline CopyOnWrite& operator = (const CopyOnWrite& other)
+    {
+        if (&other == this || other.m_block == m_block) {
+            return *this;
+        }
+        acquire(other.m_block);
+        release(m_block);
+        m_block = other.m_block;
+        return *this;
+    }
+
+    inline CopyOnWrite& operator = (const ContainerType& container)
+    {
+        get_mutable() = container;
+        return *this;
+    }
+
+    inline CopyOnWrite& operator = (ContainerType&& container)
+    {
+        get_mutable() = std::move(container);
+        return *this;
+    }
+
+    inline const ContainerType& get() const
+    {
+        return m_block->m_container;
+    }
+
+    inline const ContainerType& operator * () const
+    {
+        return m_block->m_container;
+    }
+
+    inline const ContainerType* operator -> () const
+    {
+        return &(m_block->m_container);
+    }
+
+    // clones the container first if it is shared
+    inline ContainerType& get_mutable()
+    {
+        // the acquire load pairs with the release in other handles
+        // going away, so that their reads happen before our writes
+        if (m_block->m_ref_count.load(std::memory_order_acquire) != 1) {
+            auto clone = aa::allocate_object_raw<BlockType>(m_block->m_container);
+            release(m_block);
+            m_block = clone;
+        }
+        return m_block->m_container;
+    }
+
+    // the number of handles sharing the container, including this one
+    inline u64 get_share_count() const
+    {
+        return m_block->m_ref_count.load(std::memory_order_relaxed);
+    }
+
+    inline bool is_shared() const
+    {
+        return (get_share_count() > 1);
+    }
+
+    inline bool shares_with(const CopyOnWrite& other) const
+    {
+        return (m_block == other.m_block);
+    }
+
+    inline u64 size() const
+    {
+        return m_block->m_container.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_block->m_container.size() == 0);
+    }
+
+    inline bool operator == (const CopyOnWrite& other) const
+    {
+        return (m_block == other.m_block || m_block->m_container == other.m_block->m_container);
+    }
+
+    inline bool operator != (const CopyOnWrite& other) const
+    {
+        return (!(*this == other));
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        return m_block->m_container.as_string(verbosity);
+    }
+};
+
+// Some useful typedefs
+
+template <typename T>
+using CopyOnWriteVector = CopyOnWrite<Vector<T> >;
+
+template <typename MappedKeyType, typename MappedValueType,
+          typename HashFunction = ah::Hasher<MappedKeyType>,
+          typename EqualsFunction = acmp::EqualTo<MappedKeyType> >
+using CopyOnWriteUnorderedMap =
+    CopyOnWrite<UnifiedUnorderedMap<MappedKeyType, MappedValueType,
+                                    HashFunction, EqualsFunction> >;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_COPY_ON_WRITE_HPP_ */
+
+//
+// CopyOnWrite.hpp ends here
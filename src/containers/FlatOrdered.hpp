@@ -0,0 +1,811 @@
+// FlatOrdered.hpp ---
+//
+// Filename: FlatOrdered.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:13:27 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_FLAT_ORDERED_HPP_
+#define AURUM_CONTAINERS_FLAT_ORDERED_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../comparisons/Comparators.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+#include "Vector.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace acmp = aurum::comparisons;
+
+// How lookups search the sorted array. Branchless binary search works
+// directly on the sorted values. Eytzinger search lays out a copy of
+// the keys in breadth first (heap) order, so that the first few levels
+// of every search share cache lines, and the next levels can be
+// prefetched. The copy is rebuilt eagerly by every modification
+// (batch inserts through a range insert), so it only pays off for
+// read-mostly data. With either search, lookups never modify the
+// container, so concurrent const lookups are safe
+enum class FlatSearchType {
+    Branchless,
+    Eytzinger
+};
+
+namespace flat_ordered_detail_ {
+
+namespace ac = aurum::containers;
+namespace as = aurum::stringification;
+namespace acd = aurum::containers::flat_ordered_detail_;
+
+template <typename T>
+class FlatSetTraits
+{
+public:
+    typedef T KeyType;
+    typedef T ValueType;
+    static constexpr bool sc_is_map = false;
+
+    static inline const KeyType& get_key(const ValueType& value)
+    {
+        return value;
+    }
+
+    static inline i64 compare_mapped(const ValueType& value1, const ValueType& value2)
+    {
+        return 0;
+    }
+
+    static inline std::string get_name()
+    {
+        std::ostringstream sstr;
+        sstr << "FlatOrderedSet<" << type_name<T>() << ">";
+        return sstr.str();
+    }
+
+    static inline std::string value_to_string(const ValueType& value, i64 verbosity)
+    {
+        as::Stringifier<T> stringifier;
+        return stringifier(value, verbosity);
+    }
+};
+
+// the key is not const in the stored pairs, so that the underlying
+// vector can shift them around. Modifying a key through an iterator
+// breaks the ordering of the map
+template <typename K, typename M>
+class FlatMapTraits
+{
+public:
+    typedef K KeyType;
+    typedef M MappedType;
+    typedef std::pair<K, M> ValueType;
+    static constexpr bool sc_is_map = true;
+
+    static inline const KeyType& get_key(const ValueType& value)
+    {
+        return value.first;
+    }
+
+    static inline i64 compare_mapped(const ValueType& value1, const ValueType& value2)
+    {
+        std::less<M> less_func;
+        if (less_func(value1.second, value2.second)) {
+            return -1;
+        } else if (less_func(value2.second, value1.second)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    static inline std::string get_name()
+    {
+        std::ostringstream sstr;
+        sstr << "FlatOrderedMap<" << type_name<K>() << ", " << type_name<M>() << ">";
+        return sstr.str();
+    }
+
+    static inline std::string value_to_string(const ValueType& value, i64 verbosity)
+    {
+        as::Stringifier<K> key_stringifier;
+        as::Stringifier<M> map_stringifier;
+        std::ostringstream sstr;
+        sstr << "{" << key_stringifier(value.first, verbosity) << " |--> "
+             << map_stringifier(value.second, verbosity) << "}";
+        return sstr.str();
+    }
+};
+
+template <typename KeyType, typename ValueType, typename ValueTraits,
+          typename KeyLess, FlatSearchType SEARCHTYPE>
+class FlatOrderedBase final
+    : public AurumObject<acd::FlatOrderedBase<KeyType, ValueType, ValueTraits,
+                                              KeyLess, SEARCHTYPE> >,
+      public Stringifiable<acd::FlatOrderedBase<KeyType, ValueType, ValueTraits,
+                                                KeyLess, SEARCHTYPE> >
+{
+private:
+    typedef Vector<ValueType> StorageType;
+
+public:
+    typedef ValueType& RefType;
+    typedef const ValueType& ConstRefType;
+    typedef ValueType* PtrType;
+    typedef const ValueType* ConstPtrType;
+
+    typedef typename StorageType::ConstIterator ConstIterator;
+    // values of a set are keys, and cannot be modified in place
+    typedef typename std::conditional<ValueTraits::sc_is_map,
+                                      typename StorageType::Iterator,
+                                      ConstIterator>::type Iterator;
+    typedef Iterator iterator;
+    typedef ConstIterator const_iterator;
+    typedef std::reverse_iterator<Iterator> ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+    typedef std::reverse_iterator<ConstIterator> ConstReverseIterator;
+    typedef ConstReverseIterator const_reverse_iterator;
+
+private:
+    // prefetch the node 2^sc_prefetch_levels levels down in the
+    // Eytzinger layout: with 4 levels, that is 16 consecutive keys
+    static constexpr u64 sc_prefetch_levels = 4;
+
+    StorageType m_data;
+    // 1-based, m_eytzinger_keys[0] and m_eytzinger_ranks[0] are unused
+    Vector<KeyType> m_eytzinger_keys;
+    Vector<u64> m_eytzinger_ranks;
+
+    static inline const KeyType& key_of(const ValueType& value)
+    {
+        return ValueTraits::get_key(value);
+    }
+
+    static inline bool value_less(const ValueType& value1, const ValueType& value2)
+    {
+        KeyLess less_func;
+        return less_func(key_of(value1), key_of(value2));
+    }
+
+    // lays out the keys in breadth first order, by an in-order
+    // walk of the implicit tree
+    inline u64 build_eytzinger(u64 sorted_index, u64 tree_index)
+    {
+        const u64 num_values = m_data.size();
+        if (tree_index > num_values) {
+            return sorted_index;
+        }
+        sorted_index = build_eytzinger(sorted_index, 2 * tree_index);
+        m_eytzinger_keys[tree_index] = key_of(m_data[sorted_index]);
+        m_eytzinger_ranks[tree_index] = sorted_index;
+        ++sorted_index;
+        return build_eytzinger(sorted_index, 2 * tree_index + 1);
+    }
+
+    // called after every modification of the values
+    inline void rebuild_search_structures()
+    {
+        if (SEARCHTYPE != FlatSearchType::Eytzinger) {
+            return;
+        }
+        const u64 num_values = m_data.size();
+        m_eytzinger_keys.clear();
+        m_eytzinger_ranks.clear();
+        if (num_values == 0) {
+            return;
+        }
+        m_eytzinger_keys.resize(num_values + 1, key_of(m_data[0]));
+        m_eytzinger_ranks.resize(num_values + 1, 0);
+        build_eytzinger(0, 1);
+    }
+
+    // LOWER = true: index of the first value whose key is not less than key
+    // LOWER = false: index of the first value whose key is greater than key
+    template <bool LOWER>
+    inline u64 branchless_bound(const KeyType& key) const
+    {
+        KeyLess less_func;
+        const ValueType* base = m_data.data();
+        u64 num_values = m_data.size();
+        if (num_values == 0) {
+            return 0;
+        }
+
+        while (num_values > 1) {
+            const u64 half = num_values / 2;
+            auto const& probe = key_of(base[half - 1]);
+            const bool go_right = (LOWER ? less_func(probe, key) : !less_func(key, probe));
+            base = (go_right ? base + half : base);
+            num_values -= half;
+        }
+
+        auto const& probe = key_of(*base);
+        const bool go_right = (LOWER ? less_func(probe, key) : !less_func(key, probe));
+        return (base - m_data.data()) + (go_right ? 1 : 0);
+    }
+
+    template <bool LOWER>
+    inline u64 eytzinger_bound(const KeyType& key) const
+    {
+        KeyLess less_func;
+        const u64 num_values = m_data.size();
+        const KeyType* keys = m_eytzinger_keys.data();
+        u64 index = 1;
+
+        while (index <= num_values) {
+            __builtin_prefetch(keys + std::min(index << sc_prefetch_levels, num_values));
+            auto const& probe = keys[index];
+            const bool go_right = (LOWER ? less_func(probe, key) : !less_func(key, probe));
+            index = 2 * index + (go_right ? 1 : 0);
+        }
+
+        // undo the trailing right turns, and the final left turn
+        index >>= __builtin_ffsll(~index);
+        return (index == 0 ? num_values : m_eytzinger_ranks[index]);
+    }
+
+    template <bool LOWER>
+    inline u64 bound(const KeyType& key) const
+    {
+        if (SEARCHTYPE == FlatSearchType::Eytzinger) {
+            return eytzinger_bound<LOWER>(key);
+        } else {
+            return branchless_bound<LOWER>(key);
+        }
+    }
+
+    inline u64 find_index(const KeyType& key) const
+    {
+        KeyLess less_func;
+        auto index = bound<true>(key);
+        if (index == m_data.size() || less_func(key, key_of(m_data[index]))) {
+            return m_data.size();
+        }
+        return index;
+    }
+
+    // sorts the values and removes later duplicates of a key
+    static inline void sort_and_unique(StorageType& values)
+    {
+        std::stable_sort(values.begin(), values.end(), value_less);
+        auto new_end = std::unique(values.begin(), values.end(),
+                                   [] (const ValueType& value1,
+                                       const ValueType& value2) -> bool
+                                   {
+                                       return !value_less(value1, value2);
+                                   });
+        values.erase(new_end, values.end());
+    }
+
+    // merges a sorted run with unique keys into the data.
+    // Values already present win over those in the run
+    inline void merge_sorted_run(StorageType& run)
+    {
+        if (run.empty()) {
+            return;
+        }
+
+        if (m_data.empty() || value_less(m_data.back(), run.front())) {
+            m_data.reserve(m_data.size() + run.size());
+            for (auto& value : run) {
+                m_data.push_back(std::move(value));
+            }
+            rebuild_search_structures();
+            return;
+        }
+
+        StorageType merged;
+        merged.reserve(m_data.size() + run.size());
+
+        auto it1 = m_data.begin();
+        auto end1 = m_data.end();
+        auto it2 = run.begin();
+        auto end2 = run.end();
+
+        while (it1 != end1 && it2 != end2) {
+            if (value_less(*it1, *it2)) {
+                merged.push_back(std::move(*it1));
+                ++it1;
+            } else if (value_less(*it2, *it1)) {
+                merged.push_back(std::move(*it2));
+                ++it2;
+            } else {
+                merged.push_back(std::move(*it1));
+                ++it1;
+                ++it2;
+            }
+        }
+        for (; it1 != end1; ++it1) {
+            merged.push_back(std::move(*it1));
+        }
+        for (; it2 != end2; ++it2) {
+            merged.push_back(std::move(*it2));
+        }
+
+        m_data = std::move(merged);
+        rebuild_search_structures();
+    }
+
+public:
+    FlatOrderedBase()
+        : m_data(), m_eytzinger_keys(), m_eytzinger_ranks()
+    {
+        // Nothing here
+    }
+
+    // bulk construction: sort and unique a copy of the input. For
+    // equal keys, the first occurrence in the input is retained
+    template <typename InputIterator>
+    FlatOrderedBase(const InputIterator& first, const InputIterator& last)
+        : m_data(first, last), m_eytzinger_keys(), m_eytzinger_ranks()
+    {
+        sort_and_unique(m_data);
+        rebuild_search_structures();
+    }
+
+    FlatOrderedBase(std::initializer_list<ValueType> init_list)
+        : FlatOrderedBase(init_list.begin(), init_list.end())
+    {
+        // Nothing here
+    }
+
+    FlatOrderedBase(const FlatOrderedBase& other)
+        : m_data(other.m_data), m_eytzinger_keys(other.m_eytzinger_keys),
+          m_eytzinger_ranks(other.m_eytzinger_ranks)
+    {
+        // Nothing here
+    }
+
+    FlatOrderedBase(FlatOrderedBase&& other)
+        : FlatOrderedBase()
+    {
+        swap(other);
+    }
+
+    ~FlatOrderedBase()
+    {
+        // Nothing here
+    }
+
+    inline FlatOrderedBase& operator = (const FlatOrderedBase& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_data = other.m_data;
+        m_eytzinger_keys = other.m_eytzinger_keys;
+        m_eytzinger_ranks = other.m_eytzinger_ranks;
+        return *this;
+    }
+
+    inline FlatOrderedBase& operator = (FlatOrderedBase&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        swap(other);
+        return *this;
+    }
+
+    inline FlatOrderedBase& operator = (std::initializer_list<ValueType> init_list)
+    {
+        m_data.assign(init_list);
+        sort_and_unique(m_data);
+        rebuild_search_structures();
+        return *this;
+    }
+
+    inline void swap(FlatOrderedBase& other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_eytzinger_keys, other.m_eytzinger_keys);
+        std::swap(m_eytzinger_ranks, other.m_eytzinger_ranks);
+    }
+
+    inline void clear()
+    {
+        m_data.clear();
+        m_eytzinger_keys.clear();
+        m_eytzinger_ranks.clear();
+    }
+
+    inline Iterator begin()
+    {
+        return m_data.begin();
+    }
+
+    inline Iterator end()
+    {
+        return m_data.end();
+    }
+
+    inline ConstIterator begin() const
+    {
+        return m_data.begin();
+    }
+
+    inline ConstIterator end() const
+    {
+        return m_data.end();
+    }
+
+    inline ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    inline ConstIterator cend() const
+    {
+        return end();
+    }
+
+    inline ReverseIterator rbegin()
+    {
+        return ReverseIterator(end());
+    }
+
+    inline ReverseIterator rend()
+    {
+        return ReverseIterator(begin());
+    }
+
+    inline ConstReverseIterator rbegin() const
+    {
+        return ConstReverseIterator(end());
+    }
+
+    inline ConstReverseIterator rend() const
+    {
+        return ConstReverseIterator(begin());
+    }
+
+    inline ConstReverseIterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    inline ConstReverseIterator crend() const
+    {
+        return rend();
+    }
+
+    inline bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    inline u64 size() const
+    {
+        return m_data.size();
+    }
+
+    inline u64 max_size() const
+    {
+        return m_data.max_size();
+    }
+
+    inline void reserve(u64 new_capacity)
+    {
+        m_data.reserve(new_capacity);
+    }
+
+    inline void shrink_to_fit()
+    {
+        m_data.shrink_to_fit();
+        m_eytzinger_keys.shrink_to_fit();
+        m_eytzinger_ranks.shrink_to_fit();
+    }
+
+    // not part of stl: the value with the index-th smallest key
+    inline ConstRefType nth(u64 index) const
+    {
+        return m_data[index];
+    }
+
+    inline Iterator find(const KeyType& key)
+    {
+        return begin() + find_index(key);
+    }
+
+    inline ConstIterator find(const KeyType& key) const
+    {
+        return begin() + find_index(key);
+    }
+
+    inline u64 count(const KeyType& key) const
+    {
+        return (find_index(key) == m_data.size() ? 0 : 1);
+    }
+
+    inline Iterator lower_bound(const KeyType& key)
+    {
+        return begin() + bound<true>(key);
+    }
+
+    inline ConstIterator lower_bound(const KeyType& key) const
+    {
+        return begin() + bound<true>(key);
+    }
+
+    inline Iterator upper_bound(const KeyType& key)
+    {
+        return begin() + bound<false>(key);
+    }
+
+    inline ConstIterator upper_bound(const KeyType& key) const
+    {
+        return begin() + bound<false>(key);
+    }
+
+    // keys are unique, so the upper bound is at most one past the lower bound
+    inline std::pair<Iterator, Iterator> equal_range(const KeyType& key)
+    {
+        auto index = find_index(key);
+        if (index == m_data.size()) {
+            auto it = lower_bound(key);
+            return std::make_pair(it, it);
+        }
+        return std::make_pair(begin() + index, begin() + index + 1);
+    }
+
+    inline std::pair<ConstIterator, ConstIterator> equal_range(const KeyType& key) const
+    {
+        auto index = find_index(key);
+        if (index == m_data.size()) {
+            auto it = lower_bound(key);
+            return std::make_pair(it, it);
+        }
+        return std::make_pair(begin() + index, begin() + index + 1);
+    }
+
+    template <typename Traits = ValueTraits>
+    inline typename Traits::MappedType& operator [] (const KeyType& key)
+    {
+        auto it = find(key);
+        if (it != end()) {
+            return it->second;
+        }
+        return insert(ValueType(key, typename Traits::MappedType())).first->second;
+    }
+
+    template <typename Traits = ValueTraits>
+    inline typename Traits::MappedType& at(const KeyType& key)
+    {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("Key not found in aurum::FlatOrderedMap::at()");
+        }
+        return it->second;
+    }
+
+    template <typename Traits = ValueTraits>
+    inline const typename Traits::MappedType& at(const KeyType& key) const
+    {
+        auto it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("Key not found in aurum::FlatOrderedMap::at()");
+        }
+        return it->second;
+    }
+
+    // single insertions are O(n), prefer the batched insert
+    // below when adding many values
+    inline std::pair<Iterator, bool> insert(const ValueType& value)
+    {
+        ValueType value_copy(value);
+        return insert(std::move(value_copy));
+    }
+
+    inline std::pair<Iterator, bool> insert(ValueType&& value)
+    {
+        KeyLess less_func;
+        auto index = branchless_bound<true>(key_of(value));
+        if (index < m_data.size() && !less_func(key_of(value), key_of(m_data[index]))) {
+            return std::make_pair(begin() + index, false);
+        }
+        // append and rotate into place, which keeps the amortized
+        // growth policy of push_back
+        m_data.push_back(std::move(value));
+        std::rotate(m_data.begin() + index, m_data.end() - 1, m_data.end());
+        rebuild_search_structures();
+        return std::make_pair(begin() + index, true);
+    }
+
+    template <typename... ArgTypes>
+    inline std::pair<Iterator, bool> emplace(ArgTypes&&... args)
+    {
+        return insert(ValueType(std::forward<ArgTypes>(args)...));
+    }
+
+    // batched insertion: the input is sorted into a run, which is then
+    // merged into the existing values in one linear pass
+    template <typename InputIterator>
+    inline void insert(const InputIterator& first, const InputIterator& last)
+    {
+        StorageType run(first, last);
+        sort_and_unique(run);
+        merge_sorted_run(run);
+    }
+
+    inline void insert(std::initializer_list<ValueType> init_list)
+    {
+        insert(init_list.begin(), init_list.end());
+    }
+
+    inline Iterator erase(const ConstIterator& position)
+    {
+        auto retval = m_data.erase(position);
+        rebuild_search_structures();
+        return retval;
+    }
+
+    inline Iterator erase(const ConstIterator& first, const ConstIterator& last)
+    {
+        auto retval = m_data.erase(first, last);
+        rebuild_search_structures();
+        return retval;
+    }
+
+    inline u64 erase(const KeyType& key)
+    {
+        auto index = find_index(key);
+        if (index == m_data.size()) {
+            return 0;
+        }
+        erase(begin() + index);
+        return 1;
+    }
+
+    // removes all values satisfying predicate in one linear pass
+    template <typename UnaryPredicate>
+    inline u64 erase_if(UnaryPredicate predicate)
+    {
+        auto new_end = std::remove_if(m_data.begin(), m_data.end(), predicate);
+        u64 num_erased = m_data.end() - new_end;
+        m_data.erase(new_end, m_data.end());
+        rebuild_search_structures();
+        return num_erased;
+    }
+
+    inline i64 compare(const FlatOrderedBase& other) const
+    {
+        auto diff = (i64)size() - (i64)other.size();
+        if (diff != 0) {
+            return diff;
+        }
+
+        KeyLess less_func;
+        for (auto it1 = begin(), it2 = other.begin(), last = end(); it1 != last; ++it1, ++it2) {
+            if (less_func(key_of(*it1), key_of(*it2))) {
+                return -1;
+            } else if (less_func(key_of(*it2), key_of(*it1))) {
+                return 1;
+            }
+            auto mapped_diff = ValueTraits::compare_mapped(*it1, *it2);
+            if (mapped_diff != 0) {
+                return mapped_diff;
+            }
+        }
+        return 0;
+    }
+
+    inline bool operator == (const FlatOrderedBase& other) const
+    {
+        return (compare(other) == 0);
+    }
+
+    inline bool operator != (const FlatOrderedBase& other) const
+    {
+        return (compare(other) != 0);
+    }
+
+    inline bool operator < (const FlatOrderedBase& other) const
+    {
+        return (compare(other) < 0);
+    }
+
+    inline bool operator <= (const FlatOrderedBase& other) const
+    {
+        return (compare(other) <= 0);
+    }
+
+    inline bool operator > (const FlatOrderedBase& other) const
+    {
+        return (compare(other) > 0);
+    }
+
+    inline bool operator >= (const FlatOrderedBase& other) const
+    {
+        return (compare(other) >= 0);
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << ValueTraits::get_name() << " with " << size() << " elements:"
+             << std::endl << "<<";
+
+        bool first = true;
+        for (auto const& value : m_data) {
+            if (!first) {
+                sstr << ", ";
+            }
+            first = false;
+            sstr << ValueTraits::value_to_string(value, verbosity);
+        }
+        sstr << ">>";
+        return sstr.str();
+    }
+};
+
+} /* end namespace flat_ordered_detail_ */
+
+template <typename T, typename KeyLess = acmp::Lesser<T>,
+          FlatSearchType SEARCHTYPE = FlatSearchType::Branchless>
+using FlatOrderedSet =
+    flat_ordered_detail_::FlatOrderedBase<T, T, flat_ordered_detail_::FlatSetTraits<T>,
+                                          KeyLess, SEARCHTYPE>;
+
+template <typename KeyType, typename MappedType,
+          typename KeyLess = acmp::Lesser<KeyType>,
+          FlatSearchType SEARCHTYPE = FlatSearchType::Branchless>
+using FlatOrderedMap =
+    flat_ordered_detail_::FlatOrderedBase<KeyType, std::pair<KeyType, MappedType>,
+                                          flat_ordered_detail_::FlatMapTraits<KeyType,
+                                                                              MappedType>,
+                                          KeyLess, SEARCHTYPE>;
+
+template <typename T, typename KeyLess = acmp::Lesser<T> >
+using EytzingerOrderedSet = FlatOrderedSet<T, KeyLess, FlatSearchType::Eytzinger>;
+
+template <typename KeyType, typename MappedType,
+          typename KeyLess = acmp::Lesser<KeyType> >
+using EytzingerOrderedMap = FlatOrderedMap<KeyType, MappedType, KeyLess,
+                                           FlatSearchType::Eytzinger>;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_FLAT_ORDERED_HPP_ */
+
+//
+// FlatOrdered.hpp ends here
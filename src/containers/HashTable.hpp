@@ -544,6 +544,20 @@ public:
         return Iterator(const_cast<HashTableImplBase*>(this), m_table + m_table_size);
     }
 
+    // the first entry at or after the slot with the given index,
+    // for walking over the table a few entries at a time
+    inline Iterator begin_at(u64 index) const
+    {
+        if (index >= m_table_size) {
+            return end();
+        }
+        auto retval = Iterator(const_cast<HashTableImplBase*>(this), m_table + index);
+        if (!this_as_impl()->is_entry_used(retval.get_current())) {
+            ++retval;
+        }
+        return retval;
+    }
+
     inline u64 size() const
     {
         return m_table_used;
@@ -1461,8 +1475,8 @@ private:
     inline void set_special_values_(std::false_type is_pointer,
                                     std::true_type is_managed_pointer)
     {
-        m_deleted_value = T((typename T::RawPointerType)0x1);
-        m_nonused_value = T::null_pointer;
+        m_deleted_value = T::get_deleted_marker_();
+        m_nonused_value = T::get_nonused_marker_();
     }
 
     inline void set_special_values_()
@@ -0,0 +1,368 @@
+// IndexedHeap.hpp ---
+//
+// Filename: IndexedHeap.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:18:24 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_INDEXED_HEAP_HPP_
+#define AURUM_CONTAINERS_INDEXED_HEAP_HPP_
+
+#include <utility>
+
+#include "../basetypes/AurumErrors.hpp"
+#include "Vector.hpp"
+
+namespace aurum {
+namespace containers {
+namespace indexed_heap_detail_ {
+
+namespace acd = aurum::containers::indexed_heap_detail_;
+
+// A d-ary heap which hands out a handle for every inserted element.
+// The handle remains valid until the element is removed from the heap,
+// and allows the element's key to be changed, or the element to be
+// erased, in O(log n) without searching for it.
+// Handles of removed elements are recycled. A heap with no recycled
+// handles (e.g., a freshly constructed or cleared heap) hands out
+// consecutive handles starting from zero, so that callers can use
+// their own dense indices (graph nodes, tasks, ...) as handles.
+template <typename T, typename Comparator, u32 ARITY>
+class IndexedMultiWayHeap
+    : public AurumObject<acd::IndexedMultiWayHeap<T, Comparator, ARITY> >
+{
+    static_assert(ARITY >= 2, "ARITY of indexed multiway heap must be at least 2");
+
+public:
+    typedef u64 HandleType;
+    static constexpr u64 sc_invalid_position = UINT64_MAX;
+
+private:
+    // the handle is stored alongside the value, so that comparisons
+    // during sifting do not have to chase the handle
+    struct HeapEntry
+    {
+        T m_value;
+        HandleType m_handle;
+
+        inline HeapEntry()
+            : m_value(), m_handle(0)
+        {
+            // Nothing here
+        }
+
+        inline HeapEntry(const T& value, HandleType handle)
+            : m_value(value), m_handle(handle)
+        {
+            // Nothing here
+        }
+    };
+
+    Vector<HeapEntry> m_data;
+    // position in m_data of every handle, or sc_invalid_position
+    Vector<u64> m_positions;
+    Vector<HandleType> m_free_handles;
+
+    inline u64 get_first_child(u64 index) const __attribute__ ((__always_inline__))
+    {
+        return (index * ARITY) + 1;
+    }
+
+    inline u64 get_parent(u64 index) const __attribute__ ((__always_inline__))
+    {
+        return (index - 1) / ARITY;
+    }
+
+    inline HandleType allocate_handle()
+    {
+        if (m_free_handles.size() > 0) {
+            auto retval = m_free_handles.back();
+            m_free_handles.pop_back();
+            return retval;
+        }
+        m_positions.push_back(sc_invalid_position);
+        return (m_positions.size() - 1);
+    }
+
+    inline void place(u64 index, HeapEntry&& entry)
+    {
+        m_positions[entry.m_handle] = index;
+        m_data[index] = std::move(entry);
+    }
+
+    inline void sift_up(u64 hole)
+    {
+        Comparator comparator;
+        HeapEntry bubble = std::move(m_data[hole]);
+
+        while (hole != 0) {
+            auto parent = get_parent(hole);
+            if (!comparator(bubble.m_value, m_data[parent].m_value)) {
+                break;
+            }
+            place(hole, std::move(m_data[parent]));
+            hole = parent;
+        }
+        place(hole, std::move(bubble));
+    }
+
+    inline void sift_down(u64 hole)
+    {
+        Comparator comparator;
+        const u64 size = get_size();
+        HeapEntry bubble = std::move(m_data[hole]);
+
+        for (u64 child0 = get_first_child(hole); child0 < size;
+             child0 = get_first_child(hole)) {
+            u64 min_index = child0;
+            for (u64 i = child0 + 1, last = std::min(size, child0 + ARITY); i < last; ++i) {
+                if (comparator(m_data[i].m_value, m_data[min_index].m_value)) {
+                    min_index = i;
+                }
+            }
+            if (!comparator(m_data[min_index].m_value, bubble.m_value)) {
+                break;
+            }
+            place(hole, std::move(m_data[min_index]));
+            hole = min_index;
+        }
+        place(hole, std::move(bubble));
+    }
+
+    inline void erase_at(u64 position)
+    {
+        Comparator comparator;
+        auto const last_position = get_size() - 1;
+        m_free_handles.push_back(m_data[position].m_handle);
+        m_positions[m_data[position].m_handle] = sc_invalid_position;
+
+        if (position == last_position) {
+            m_data.pop_back();
+            return;
+        }
+
+        const bool moves_up = comparator(m_data[last_position].m_value,
+                                         m_data[position].m_value);
+        m_data[position] = std::move(m_data[last_position]);
+        m_data.pop_back();
+
+        if (moves_up) {
+            sift_up(position);
+        } else {
+            sift_down(position);
+        }
+    }
+
+    inline u64 get_position(HandleType handle) const
+    {
+        AURUM_ASSERT_WITH_MSG(contains(handle), "Invalid handle used with indexed heap");
+        return m_positions[handle];
+    }
+
+public:
+    inline IndexedMultiWayHeap()
+        : m_data(), m_positions(), m_free_handles()
+    {
+        // Nothing here
+    }
+
+    inline IndexedMultiWayHeap(const IndexedMultiWayHeap& other)
+        : m_data(other.m_data), m_positions(other.m_positions),
+          m_free_handles(other.m_free_handles)
+    {
+        // Nothing here
+    }
+
+    inline IndexedMultiWayHeap(IndexedMultiWayHeap&& other)
+        : IndexedMultiWayHeap()
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_positions, other.m_positions);
+        std::swap(m_free_handles, other.m_free_handles);
+    }
+
+    inline ~IndexedMultiWayHeap()
+    {
+        // Nothing here
+    }
+
+    inline IndexedMultiWayHeap& operator = (const IndexedMultiWayHeap& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_data = other.m_data;
+        m_positions = other.m_positions;
+        m_free_handles = other.m_free_handles;
+        return *this;
+    }
+
+    inline IndexedMultiWayHeap& operator = (IndexedMultiWayHeap&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        std::swap(m_data, other.m_data);
+        std::swap(m_positions, other.m_positions);
+        std::swap(m_free_handles, other.m_free_handles);
+        return *this;
+    }
+
+    inline u64 get_size() const
+    {
+        return m_data.size();
+    }
+
+    inline const T& get_min() const
+    {
+        return m_data[0].m_value;
+    }
+
+    inline HandleType get_min_handle() const
+    {
+        return m_data[0].m_handle;
+    }
+
+    inline void delete_min()
+    {
+        erase_at(0);
+    }
+
+    inline HandleType insert(const T& new_elem)
+    {
+        auto handle = allocate_handle();
+        m_data.push_back(HeapEntry(new_elem, handle));
+        m_positions[handle] = get_size() - 1;
+        sift_up(get_size() - 1);
+        return handle;
+    }
+
+    // appends the elements in [first, last), allocating handles
+    // in input order, and restores the heap property bottom up,
+    // which is linear in the size of the heap
+    template <typename InputIterator>
+    inline void heapify(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            auto handle = allocate_handle();
+            m_positions[handle] = get_size();
+            m_data.push_back(HeapEntry(*it, handle));
+        }
+
+        const u64 size = get_size();
+        if (size <= 1) {
+            return;
+        }
+        for (u64 i = get_parent(size - 1) + 1; i > 0; --i) {
+            sift_down(i - 1);
+        }
+    }
+
+    inline bool contains(HandleType handle) const
+    {
+        return (handle < m_positions.size() && m_positions[handle] != sc_invalid_position);
+    }
+
+    inline const T& get_value(HandleType handle) const
+    {
+        return m_data[get_position(handle)].m_value;
+    }
+
+    // new_value must not compare greater than the current value
+    inline void decrease_key(HandleType handle, const T& new_value)
+    {
+        auto position = get_position(handle);
+        AURUM_ASSERT_WITH_MSG(!Comparator()(m_data[position].m_value, new_value),
+                              "decrease_key() called with a greater key");
+        m_data[position].m_value = new_value;
+        sift_up(position);
+    }
+
+    // new_value must not compare less than the current value
+    inline void increase_key(HandleType handle, const T& new_value)
+    {
+        auto position = get_position(handle);
+        AURUM_ASSERT_WITH_MSG(!Comparator()(new_value, m_data[position].m_value),
+                              "increase_key() called with a lesser key");
+        m_data[position].m_value = new_value;
+        sift_down(position);
+    }
+
+    inline void update_key(HandleType handle, const T& new_value)
+    {
+        auto position = get_position(handle);
+        const bool moves_up = Comparator()(new_value, m_data[position].m_value);
+        m_data[position].m_value = new_value;
+        if (moves_up) {
+            sift_up(position);
+        } else {
+            sift_down(position);
+        }
+    }
+
+    inline void erase(HandleType handle)
+    {
+        erase_at(get_position(handle));
+    }
+
+    inline void clear()
+    {
+        m_data.clear();
+        m_positions.clear();
+        m_free_handles.clear();
+    }
+};
+
+template <typename T, typename Comparator, u32 ARITY>
+constexpr u64 IndexedMultiWayHeap<T, Comparator, ARITY>::sc_invalid_position;
+
+} /* end namespace indexed_heap_detail_ */
+
+template <typename T, typename Comparator, u32 ARITY>
+using IndexedMultiWayHeap = indexed_heap_detail_::IndexedMultiWayHeap<T, Comparator, ARITY>;
+
+template <typename T, typename Comparator = std::less<T> >
+using IndexedBinaryHeap = indexed_heap_detail_::IndexedMultiWayHeap<T, Comparator, 2>;
+
+template <typename T, typename Comparator = std::less<T> >
+using IndexedQuaternaryHeap = indexed_heap_detail_::IndexedMultiWayHeap<T, Comparator, 4>;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_INDEXED_HEAP_HPP_ */
+
+//
+// IndexedHeap.hpp ends here
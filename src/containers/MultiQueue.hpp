@@ -0,0 +1,304 @@
+// MultiQueue.hpp ---
+//
+// Filename: MultiQueue.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:52:29 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_MULTI_QUEUE_HPP_
+#define AURUM_CONTAINERS_MULTI_QUEUE_HPP_
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../allocators/MemoryManager.hpp"
+#include "../comparisons/Comparators.hpp"
+
+#include "MultiWayHeap.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace aa = aurum::allocators;
+namespace acmp = aurum::comparisons;
+
+namespace multi_queue_detail_ {
+
+static constexpr u64 sc_cache_line_size = 64;
+
+// a xorshift64* generator per thread, seeded off the thread id
+static inline u64 get_random()
+{
+    static thread_local u64 s_state = 0;
+    if (s_state == 0) {
+        s_state = (std::hash<std::thread::id>()(std::this_thread::get_id()) |
+                   (u64)1);
+    }
+    s_state ^= (s_state >> 12);
+    s_state ^= (s_state << 25);
+    s_state ^= (s_state >> 27);
+    return (s_state * 0x2545F4914F6CDD1Dull);
+}
+
+// A lock protected heap. Shards are aligned to cache lines
+// (and their size rounded up to one), so that threads working on
+// different shards do not contend on the same lines
+template <typename HeapType>
+class alignas(sc_cache_line_size) Shard final
+{
+public:
+    std::mutex m_mutex;
+    HeapType m_heap;
+    // mirrors m_heap.get_size(), and can be read without the lock
+    std::atomic<u64> m_size;
+
+    inline Shard()
+        : m_mutex(), m_heap(), m_size(0)
+    {
+        // Nothing here
+    }
+
+    inline ~Shard()
+    {
+        // Nothing here
+    }
+};
+
+} /* end namespace multi_queue_detail_ */
+
+// A concurrent, relaxed priority queue, in the style of the
+// MultiQueues of Rihani, Sanders and Dementiev: c * p lock protected
+// heaps for p threads. A push goes to a random heap, a pop takes the
+// better of the minimums of two random heaps. So a pop returns an
+// element which is close to, but not necessarily, the minimum: the
+// expected rank of the popped element is O(c * p), independent of
+// the number of elements. The number of queues per thread (c) trades
+// this rank error for lower contention.
+// Heaps which are locked by another thread are skipped rather than
+// waited on, so threads never block each other except when looking
+// for elements in an (almost) empty queue.
+template <typename T, typename Comparator = acmp::Lesser<T>,
+          typename HeapType = QuaternaryHeap<T, Comparator> >
+class MultiQueue final : public AurumObject<MultiQueue<T, Comparator, HeapType> >
+{
+private:
+    typedef multi_queue_detail_::Shard<HeapType> ShardType;
+
+    void* m_shard_memory;
+    ShardType* m_shards;
+    u32 m_num_shards;
+
+    inline u64 get_shard_memory_size() const
+    {
+        return (sizeof(ShardType) * m_num_shards) + multi_queue_detail_::sc_cache_line_size;
+    }
+
+    inline ShardType& get_random_shard()
+    {
+        return m_shards[multi_queue_detail_::get_random() % m_num_shards];
+    }
+
+    // pops from a shard which is locked by the caller
+    inline void pop_locked(ShardType& shard, T& value)
+    {
+        value = shard.m_heap.get_min();
+        shard.m_heap.delete_min();
+        shard.m_size.store(shard.m_heap.get_size(), std::memory_order_relaxed);
+    }
+
+    // locks every shard in turn, and pops from the first non-empty
+    // one. returns false if every shard was found empty
+    inline bool try_pop_sweep(T& value)
+    {
+        for (u32 i = 0; i < m_num_shards; ++i) {
+            auto& shard = m_shards[i];
+            if (shard.m_size.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            if (shard.m_heap.get_size() > 0) {
+                pop_locked(shard, value);
+                return true;
+            }
+        }
+        // the relaxed size checks above can miss a push which
+        // has not yet become visible, so check again under the locks
+        for (u32 i = 0; i < m_num_shards; ++i) {
+            auto& shard = m_shards[i];
+            std::lock_guard<std::mutex> guard(shard.m_mutex);
+            if (shard.m_heap.get_size() > 0) {
+                pop_locked(shard, value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    static constexpr u32 sc_default_queues_per_thread = 2;
+    // the number of consecutive samples of two empty heaps after which
+    // try_pop() looks at all the heaps
+    static constexpr u32 sc_max_empty_samples = 4;
+
+    inline explicit MultiQueue(u32 num_threads,
+                               u32 queues_per_thread = sc_default_queues_per_thread)
+        : m_shard_memory(nullptr), m_shards(nullptr),
+          m_num_shards(std::max(num_threads * queues_per_thread, (u32)2))
+    {
+        m_shard_memory = aa::allocate_raw(get_shard_memory_size());
+        auto aligned_address = ((reinterpret_cast<u64>(m_shard_memory) +
+                                 multi_queue_detail_::sc_cache_line_size - 1) &
+                                ~(multi_queue_detail_::sc_cache_line_size - 1));
+        m_shards = reinterpret_cast<ShardType*>(aligned_address);
+        for (u32 i = 0; i < m_num_shards; ++i) {
+            new (m_shards + i) ShardType();
+        }
+    }
+
+    MultiQueue() = delete;
+    MultiQueue(const MultiQueue& other) = delete;
+    MultiQueue(MultiQueue&& other) = delete;
+    MultiQueue& operator = (const MultiQueue& other) = delete;
+    MultiQueue& operator = (MultiQueue&& other) = delete;
+
+    inline ~MultiQueue()
+    {
+        for (u32 i = 0; i < m_num_shards; ++i) {
+            m_shards[i].~ShardType();
+        }
+        aa::deallocate_raw(m_shard_memory, get_shard_memory_size());
+    }
+
+    inline u32 get_num_queues() const
+    {
+        return m_num_shards;
+    }
+
+    // only exact when there are no concurrent updates
+    inline u64 size() const
+    {
+        u64 retval = 0;
+        for (u32 i = 0; i < m_num_shards; ++i) {
+            retval += m_shards[i].m_size.load(std::memory_order_relaxed);
+        }
+        return retval;
+    }
+
+    inline bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    inline void push(const T& value)
+    {
+        while (true) {
+            auto& shard = get_random_shard();
+            if (!shard.m_mutex.try_lock()) {
+                continue;
+            }
+            shard.m_heap.insert(value);
+            shard.m_size.store(shard.m_heap.get_size(), std::memory_order_relaxed);
+            shard.m_mutex.unlock();
+            return;
+        }
+    }
+
+    // pops an element close to the minimum into value. returns false,
+    // leaving value alone, only if the queue was found empty
+    inline bool try_pop(T& value)
+    {
+        Comparator comparator;
+        u32 num_empty_samples = 0;
+
+        while (num_empty_samples < sc_max_empty_samples) {
+            auto shard1 = &(get_random_shard());
+            auto shard2 = &(get_random_shard());
+            if (shard1 == shard2) {
+                continue;
+            }
+            if (shard1->m_size.load(std::memory_order_relaxed) == 0 &&
+                shard2->m_size.load(std::memory_order_relaxed) == 0) {
+                ++num_empty_samples;
+                continue;
+            }
+            if (!shard1->m_mutex.try_lock()) {
+                continue;
+            }
+            if (!shard2->m_mutex.try_lock()) {
+                shard1->m_mutex.unlock();
+                continue;
+            }
+
+            const u64 size1 = shard1->m_heap.get_size();
+            const u64 size2 = shard2->m_heap.get_size();
+            if (size1 == 0 && size2 == 0) {
+                ++num_empty_samples;
+            } else if (size2 == 0 ||
+                       (size1 > 0 && !comparator(shard2->m_heap.get_min(),
+                                                 shard1->m_heap.get_min()))) {
+                pop_locked(*shard1, value);
+            } else {
+                pop_locked(*shard2, value);
+            }
+
+            shard2->m_mutex.unlock();
+            shard1->m_mutex.unlock();
+            if (size1 > 0 || size2 > 0) {
+                return true;
+            }
+        }
+
+        return try_pop_sweep(value);
+    }
+};
+
+template <typename T, typename Comparator, typename HeapType>
+constexpr u32 MultiQueue<T, Comparator, HeapType>::sc_default_queues_per_thread;
+
+template <typename T, typename Comparator, typename HeapType>
+constexpr u32 MultiQueue<T, Comparator, HeapType>::sc_max_empty_samples;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_MULTI_QUEUE_HPP_ */
+
+//
+// MultiQueue.hpp ends here
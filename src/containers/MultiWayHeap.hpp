@@ -40,12 +40,20 @@
 #if !defined AURUM_CONTAINERS_MULTI_WAY_HEAP_HPP_
 #define AURUM_CONTAINERS_MULTI_WAY_HEAP_HPP_
 
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+#include "../allocators/MemoryManager.hpp"
+
 #include "Vector.hpp"
 
 namespace aurum {
 namespace containers {
 namespace multiway_heap_detail_ {
 
+namespace aa = aurum::allocators;
 namespace acd = aurum::containers::multiway_heap_detail_;
 
 template <typename T, typename Comparator, u32 ARITY>
@@ -66,6 +74,31 @@ private:
         return (index - 1) / ARITY;
     }
 
+    // moves the element at hole down until the heap
+    // property is restored below it
+    inline void sift_down(u64 hole)
+    {
+        Comparator comparator;
+        const u64 size = get_size();
+        T bubble = std::move(m_data[hole]);
+
+        for (u64 child0 = get_first_child(hole); child0 < size;
+             child0 = get_first_child(hole)) {
+            u64 min_index = child0;
+            for (u64 i = child0 + 1, last = std::min(size, child0 + ARITY); i < last; ++i) {
+                if (comparator(m_data[i], m_data[min_index])) {
+                    min_index = i;
+                }
+            }
+            if (!comparator(m_data[min_index], bubble)) {
+                break;
+            }
+            m_data[hole] = std::move(m_data[min_index]);
+            hole = min_index;
+        }
+        m_data[hole] = std::move(bubble);
+    }
+
 public:
     inline MultiWayHeap()
         : m_data()
@@ -182,6 +215,24 @@ public:
 
         m_data[hole] = new_elem;
     }
+
+    // appends the elements in [first, last) and restores the heap
+    // property bottom up, which is linear in the size of the heap
+    template <typename InputIterator>
+    inline void heapify(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            m_data.push_back(*it);
+        }
+
+        const u64 size = get_size();
+        if (size <= 1) {
+            return;
+        }
+        for (u64 i = get_parent(size - 1) + 1; i > 0; --i) {
+            sift_down(i - 1);
+        }
+    }
 };
 
 // We specialize (partially) for the case where ARITY = 2, because the
@@ -204,6 +255,27 @@ private:
         return (index - 1) >> 1;
     }
 
+    inline void sift_down(u64 hole)
+    {
+        Comparator comparator;
+        const u64 size = get_size();
+        T bubble = std::move(m_data[hole]);
+
+        for (u64 child0 = get_first_child(hole); child0 < size;
+             child0 = get_first_child(hole)) {
+            u64 min_index = child0;
+            if (child0 + 1 < size && comparator(m_data[child0 + 1], m_data[child0])) {
+                min_index = child0 + 1;
+            }
+            if (!comparator(m_data[min_index], bubble)) {
+                break;
+            }
+            m_data[hole] = std::move(m_data[min_index]);
+            hole = min_index;
+        }
+        m_data[hole] = std::move(bubble);
+    }
+
 public:
     inline MultiWayHeap()
         : m_data()
@@ -311,8 +383,341 @@ public:
 
         m_data[hole] = new_elem;
     }
+
+    // appends the elements in [first, last) and restores the heap
+    // property bottom up, which is linear in the size of the heap
+    template <typename InputIterator>
+    inline void heapify(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            m_data.push_back(*it);
+        }
+
+        const u64 size = get_size();
+        if (size <= 1) {
+            return;
+        }
+        for (u64 i = get_parent(size - 1) + 1; i > 0; --i) {
+            sift_down(i - 1);
+        }
+    }
 };
 
+static constexpr u64 sc_cache_line_size = 64;
+
+// the largest power of two arity, between 2 and 16, for which the
+// children of a node fit in a cache line
+template <typename T>
+static constexpr u32 get_cache_line_arity()
+{
+    u32 retval = 2;
+    while (retval < 16 && (retval * 2 * sizeof(T)) <= sc_cache_line_size) {
+        retval *= 2;
+    }
+    return retval;
+}
+
+// A multiway heap laid out so that the children of each node share
+// a cache line (in the style of LaMarca and Ladner): the elements are
+// stored in a cache line aligned array, with the root at index
+// ARITY - 1, which puts the first child of every node at a multiple
+// of ARITY. So when ARITY * sizeof(T) is at most (and divides) the
+// cache line size, finding the smallest child touches exactly one
+// cache line. The smallest of a full group of children is selected
+// without branches, which leaves no data dependent branches to
+// mispredict. Since that also stops the processor from speculatively
+// running ahead to the next level of the heap, the children of the
+// children are prefetched instead.
+// ARITY must be a power of two, get_cache_line_arity<T>() gives the
+// one that makes the children fill a cache line, and the arity
+// benchmark in the tests picks the fastest one for a given sizeof(T)
+template <typename T, typename Comparator, u32 ARITY>
+class AlignedMultiWayHeap
+    : public AurumObject<acd::AlignedMultiWayHeap<T, Comparator, ARITY> >
+{
+    static_assert(ARITY >= 2 && (ARITY & (ARITY - 1)) == 0,
+                  "ARITY of aligned multiway heap must be a power of two");
+
+private:
+    static constexpr u64 sc_root = ARITY - 1;
+    static constexpr u64 sc_max_prefetch_size = 4 * sc_cache_line_size;
+
+    void* m_memory;
+    // the elements are in [sc_root, sc_root + m_size),
+    // m_data itself is aligned to a cache line
+    T* m_data;
+    u64 m_size;
+    // in number of elements, excluding the unused ones before the root
+    u64 m_capacity;
+
+    static inline u64 get_first_child(u64 index) __attribute__ ((__always_inline__))
+    {
+        return (index - sc_root + 1) * ARITY;
+    }
+
+    static inline u64 get_parent(u64 index) __attribute__ ((__always_inline__))
+    {
+        return (index / ARITY) + sc_root - 1;
+    }
+
+    static inline u64 get_memory_size(u64 capacity)
+    {
+        return ((capacity + sc_root) * sizeof(T)) + sc_cache_line_size;
+    }
+
+    inline u64 get_end() const
+    {
+        return sc_root + m_size;
+    }
+
+    // index of the smallest of the ARITY elements starting at first.
+    // small trivially copyable elements are carried along with the
+    // index, so that both are selected with conditional moves, and
+    // the loads do not depend on the earlier comparisons
+    inline u64 get_min_of_group(u64 first, std::true_type carry_value) const
+    {
+        Comparator comparator;
+        u64 min_index = first;
+        T min_value = m_data[first];
+        for (u64 i = first + 1; i < first + ARITY; ++i) {
+            const bool is_less = comparator(m_data[i], min_value);
+            min_value = (is_less ? m_data[i] : min_value);
+            min_index = (is_less ? i : min_index);
+        }
+        return min_index;
+    }
+
+    inline u64 get_min_of_group(u64 first, std::false_type carry_value) const
+    {
+        Comparator comparator;
+        u64 min_index = first;
+        for (u64 i = first + 1; i < first + ARITY; ++i) {
+            min_index = (comparator(m_data[i], m_data[min_index]) ? i : min_index);
+        }
+        return min_index;
+    }
+
+    // index of the smallest of the elements in [first, last)
+    inline u64 get_min_child(u64 first, u64 last) const
+    {
+        if (first + ARITY <= last) {
+            typedef std::integral_constant<bool, (std::is_trivially_copyable<T>::value &&
+                                                  sizeof(T) <= 16)> CarryValueType;
+            return get_min_of_group(first, CarryValueType());
+        }
+        Comparator comparator;
+        u64 min_index = first;
+        for (u64 i = first + 1; i < last; ++i) {
+            min_index = (comparator(m_data[i], m_data[min_index]) ? i : min_index);
+        }
+        return min_index;
+    }
+
+    // the children of the ARITY children starting at first are
+    // contiguous, so they can all be fetched while the smallest of
+    // the children is being found
+    inline void prefetch_grandchildren(u64 first, u64 end) const
+    {
+        const u64 grandchild = get_first_child(first);
+        if (grandchild >= end) {
+            return;
+        }
+        auto block = reinterpret_cast<const u08*>(m_data + grandchild);
+        for (u64 offset = 0; offset < std::min(ARITY * ARITY * sizeof(T), sc_max_prefetch_size);
+             offset += sc_cache_line_size) {
+            __builtin_prefetch(block + offset);
+        }
+    }
+
+    inline void reallocate(u64 new_capacity)
+    {
+        auto new_memory = aa::allocate_raw(get_memory_size(new_capacity));
+        auto new_data = reinterpret_cast<T*>((reinterpret_cast<u64>(new_memory) +
+                                              sc_cache_line_size - 1) &
+                                             ~(sc_cache_line_size - 1));
+        for (u64 i = sc_root, end = get_end(); i < end; ++i) {
+            new (new_data + i) T(std::move(m_data[i]));
+            m_data[i].~T();
+        }
+        if (m_memory != nullptr) {
+            aa::deallocate_raw(m_memory, get_memory_size(m_capacity));
+        }
+        m_memory = new_memory;
+        m_data = new_data;
+        m_capacity = new_capacity;
+    }
+
+    inline void destroy_all()
+    {
+        for (u64 i = sc_root, end = get_end(); i < end; ++i) {
+            m_data[i].~T();
+        }
+        m_size = 0;
+    }
+
+    // moves bubble up from hole, which must not hold an element
+    // (or hold a moved from one), until the heap property holds
+    inline void sift_up(u64 hole, T&& bubble)
+    {
+        Comparator comparator;
+        while (hole != sc_root) {
+            const u64 parent = get_parent(hole);
+            if (!comparator(bubble, m_data[parent])) {
+                break;
+            }
+            m_data[hole] = std::move(m_data[parent]);
+            hole = parent;
+        }
+        m_data[hole] = std::move(bubble);
+    }
+
+    inline void sift_down(u64 hole)
+    {
+        Comparator comparator;
+        const u64 end = get_end();
+        T bubble = std::move(m_data[hole]);
+
+        for (u64 first = get_first_child(hole); first < end; first = get_first_child(hole)) {
+            prefetch_grandchildren(first, end);
+            const u64 min_index = get_min_child(first, end);
+            if (!comparator(m_data[min_index], bubble)) {
+                break;
+            }
+            m_data[hole] = std::move(m_data[min_index]);
+            hole = min_index;
+        }
+        m_data[hole] = std::move(bubble);
+    }
+
+    inline void push_back(const T& value)
+    {
+        if (m_size == m_capacity) {
+            reallocate(std::max(m_capacity * 2,
+                                std::max(sc_cache_line_size / sizeof(T), (u64)ARITY * 2)));
+        }
+        new (m_data + get_end()) T(value);
+        ++m_size;
+    }
+
+public:
+    inline AlignedMultiWayHeap()
+        : m_memory(nullptr), m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        // Nothing here
+    }
+
+    inline AlignedMultiWayHeap(const AlignedMultiWayHeap& other)
+        : AlignedMultiWayHeap()
+    {
+        *this = other;
+    }
+
+    inline AlignedMultiWayHeap(AlignedMultiWayHeap&& other)
+        : AlignedMultiWayHeap()
+    {
+        *this = std::move(other);
+    }
+
+    inline ~AlignedMultiWayHeap()
+    {
+        destroy_all();
+        if (m_memory != nullptr) {
+            aa::deallocate_raw(m_memory, get_memory_size(m_capacity));
+        }
+    }
+
+    inline AlignedMultiWayHeap& operator = (const AlignedMultiWayHeap& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        destroy_all();
+        if (m_capacity < other.m_size) {
+            reallocate(other.m_size);
+        }
+        for (u64 i = sc_root, end = other.get_end(); i < end; ++i) {
+            new (m_data + i) T(other.m_data[i]);
+        }
+        m_size = other.m_size;
+        return *this;
+    }
+
+    inline AlignedMultiWayHeap& operator = (AlignedMultiWayHeap&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        std::swap(m_memory, other.m_memory);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        return *this;
+    }
+
+    inline u64 get_size() const
+    {
+        return m_size;
+    }
+
+    inline const T& get_min() const
+    {
+        return m_data[sc_root];
+    }
+
+    inline void delete_min()
+    {
+        // move the smallest child into the hole all the way
+        // down to a leaf, then fill the hole with the last
+        // element, as in MultiWayHeap
+        const u64 last = get_end() - 1;
+        u64 hole = sc_root;
+
+        for (u64 first = get_first_child(hole); first < last; first = get_first_child(hole)) {
+            prefetch_grandchildren(first, last);
+            const u64 min_index = get_min_child(first, last);
+            m_data[hole] = std::move(m_data[min_index]);
+            hole = min_index;
+        }
+
+        if (hole != last) {
+            sift_up(hole, std::move(m_data[last]));
+        }
+        m_data[last].~T();
+        --m_size;
+    }
+
+    inline void insert(const T& new_elem)
+    {
+        push_back(new_elem);
+        const u64 hole = get_end() - 1;
+        if (hole != sc_root) {
+            sift_up(hole, T(std::move(m_data[hole])));
+        }
+    }
+
+    // appends the elements in [first, last) and restores the heap
+    // property bottom up, which is linear in the size of the heap
+    template <typename InputIterator>
+    inline void heapify(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            push_back(*it);
+        }
+        if (m_size <= 1) {
+            return;
+        }
+        for (u64 i = get_parent(get_end() - 1) + 1; i > sc_root; --i) {
+            sift_down(i - 1);
+        }
+    }
+};
+
+template <typename T, typename Comparator, u32 ARITY>
+constexpr u64 AlignedMultiWayHeap<T, Comparator, ARITY>::sc_root;
+
+template <typename T, typename Comparator, u32 ARITY>
+constexpr u64 AlignedMultiWayHeap<T, Comparator, ARITY>::sc_max_prefetch_size;
+
 } /* end namespace multiway_heap_detail_ */
 
 template <typename T, typename Comparator, u32 ARITY>
@@ -327,6 +732,16 @@ using TernaryHeap = multiway_heap_detail_::MultiWayHeap<T, Comparator, 3>;
 template <typename T, typename Comparator = std::less<T> >
 using QuaternaryHeap = multiway_heap_detail_::MultiWayHeap<T, Comparator, 4>;
 
+template <typename T, typename Comparator, u32 ARITY>
+using AlignedMultiWayHeap = multiway_heap_detail_::AlignedMultiWayHeap<T, Comparator, ARITY>;
+
+// an aligned multiway heap whose nodes have as many children
+// as fit in a cache line
+template <typename T, typename Comparator = std::less<T> >
+using CacheAlignedHeap =
+    multiway_heap_detail_::AlignedMultiWayHeap<T, Comparator,
+                                               multiway_heap_detail_::get_cache_line_arity<T>()>;
+
 } /* end namespace containers */
 } /* end namespace aurum */
 
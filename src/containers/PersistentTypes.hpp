@@ -0,0 +1,244 @@
+// PersistentTypes.hpp ---
+//
+// Filename: PersistentTypes.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:49:36 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_PERSISTENT_TYPES_HPP_
+#define AURUM_CONTAINERS_PERSISTENT_TYPES_HPP_
+
+#include <new>
+#include <utility>
+#include <algorithm>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/AurumErrors.hpp"
+#include "../basetypes/RefCountable.hpp"
+#include "../allocators/MemoryManager.hpp"
+#include "../memory/ManagedPointer.hpp"
+
+// Pieces shared by the persistent containers.
+// The nodes of the persistent containers are RefCountable and are
+// linked with ManagedPointers, so a snapshot of a container is a
+// copy of a pointer to its root. A node is updated in place only
+// when the path to it from the root is not shared with any other
+// container (i.e., the reference count of each node on the path is
+// one), and is copied otherwise. Transients rely on this to batch
+// updates, persistent containers apply every update to a fresh copy
+// of the root, which makes the whole path get copied.
+// Note that the reference counts are not atomic, so containers
+// sharing structure must not be used from different threads.
+
+namespace aurum {
+namespace containers {
+namespace persistent_detail_ {
+
+namespace aa = aurum::allocators;
+namespace am = aurum::memory;
+
+// A small array with exact-ish capacity, for node contents. Unlike
+// Vector, only the elements in [0, size()) are ever constructed,
+// and elements are destroyed as soon as they are removed
+template <typename T>
+class NodeArray
+{
+private:
+    T* m_data;
+    u32 m_size;
+    u32 m_capacity;
+
+    inline void grow(u32 new_capacity)
+    {
+        auto new_data = aa::casted_allocate_raw<T>(sizeof(T) * new_capacity);
+        for (u32 i = 0; i < m_size; ++i) {
+            new (new_data + i) T(std::move(m_data[i]));
+            m_data[i].~T();
+        }
+        if (m_data != nullptr) {
+            aa::deallocate_raw(m_data, sizeof(T) * m_capacity);
+        }
+        m_data = new_data;
+        m_capacity = new_capacity;
+    }
+
+public:
+    inline NodeArray()
+        : m_data(nullptr), m_size(0), m_capacity(0)
+    {
+        // Nothing here
+    }
+
+    inline NodeArray(const NodeArray& other)
+        : NodeArray()
+    {
+        reserve(other.m_size);
+        for (u32 i = 0; i < other.m_size; ++i) {
+            new (m_data + i) T(other.m_data[i]);
+        }
+        m_size = other.m_size;
+    }
+
+    inline NodeArray(NodeArray&& other)
+        : NodeArray()
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    inline ~NodeArray()
+    {
+        clear();
+        if (m_data != nullptr) {
+            aa::deallocate_raw(m_data, sizeof(T) * m_capacity);
+        }
+    }
+
+    inline NodeArray& operator = (NodeArray other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+        return *this;
+    }
+
+    inline u32 size() const
+    {
+        return m_size;
+    }
+
+    inline bool empty() const
+    {
+        return (m_size == 0);
+    }
+
+    inline void reserve(u32 new_capacity)
+    {
+        if (new_capacity > m_capacity) {
+            grow(new_capacity);
+        }
+    }
+
+    inline T& operator [] (u32 index)
+    {
+        AURUM_ASSERT(index < m_size);
+        return m_data[index];
+    }
+
+    inline const T& operator [] (u32 index) const
+    {
+        AURUM_ASSERT(index < m_size);
+        return m_data[index];
+    }
+
+    inline T& back()
+    {
+        return m_data[m_size - 1];
+    }
+
+    inline const T& back() const
+    {
+        return m_data[m_size - 1];
+    }
+
+    inline const T* begin() const
+    {
+        return m_data;
+    }
+
+    inline const T* end() const
+    {
+        return (m_data + m_size);
+    }
+
+    inline void push_back(T value)
+    {
+        if (m_size == m_capacity) {
+            grow(m_capacity == 0 ? 2 : m_capacity * 2);
+        }
+        new (m_data + m_size) T(std::move(value));
+        ++m_size;
+    }
+
+    inline void insert(u32 index, T value)
+    {
+        AURUM_ASSERT(index <= m_size);
+        push_back(std::move(value));
+        std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+    }
+
+    inline void pop_back()
+    {
+        AURUM_ASSERT(m_size > 0);
+        --m_size;
+        m_data[m_size].~T();
+    }
+
+    inline void erase(u32 index)
+    {
+        AURUM_ASSERT(index < m_size);
+        std::move(m_data + index + 1, m_data + m_size, m_data + index);
+        pop_back();
+    }
+
+    inline void clear()
+    {
+        for (u32 i = 0; i < m_size; ++i) {
+            m_data[i].~T();
+        }
+        m_size = 0;
+    }
+};
+
+// makes node point to a node that is referenced from node alone,
+// copying it if it is shared, and returns the raw pointer
+template <typename NodeType>
+static inline NodeType* make_unique_node(am::ManagedPointer<NodeType>& node)
+{
+    if (node->get_ref_count_() > 1) {
+        node = new NodeType(*node);
+    }
+    return node.get_raw_pointer();
+}
+
+} /* end namespace persistent_detail_ */
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_PERSISTENT_TYPES_HPP_ */
+
+//
+// PersistentTypes.hpp ends here
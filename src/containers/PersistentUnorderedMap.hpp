@@ -0,0 +1,798 @@
+// PersistentUnorderedMap.hpp ---
+//
+// Filename: PersistentUnorderedMap.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:49:36 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_PERSISTENT_UNORDERED_MAP_HPP_
+#define AURUM_CONTAINERS_PERSISTENT_UNORDERED_MAP_HPP_
+
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <initializer_list>
+#include <string>
+#include <sstream>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../hashing/Hashers.hpp"
+#include "../comparisons/Comparators.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+#include "PersistentTypes.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace ah = aurum::hashing;
+namespace acmp = aurum::comparisons;
+namespace as = aurum::stringification;
+
+template <typename K, typename V, typename HashFunction, typename EqualsFunction>
+class PersistentUnorderedMap;
+template <typename K, typename V, typename HashFunction, typename EqualsFunction>
+class TransientUnorderedMap;
+
+namespace persistent_unordered_map_detail_ {
+
+namespace am = aurum::memory;
+namespace apd = aurum::containers::persistent_detail_;
+
+static constexpr u32 sc_bits_per_level = 5;
+static constexpr u32 sc_level_mask = (1u << sc_bits_per_level) - 1;
+// levels at or beyond this shift have run out of hash bits,
+// and hold colliding entries in a plain list
+static constexpr u32 sc_max_shift = 64;
+
+// A node of a hash array mapped trie, laid out as in CHAMP: the
+// entries stored inline and the sub-tries are kept in two separate
+// dense arrays, indexed by the popcount of the bitmaps below the
+// bit for the 5 hash bits at this level
+template <typename K, typename V>
+class HAMTNode : public AurumObject<HAMTNode<K, V> >,
+                 public RefCountable<HAMTNode<K, V> >
+{
+public:
+    typedef am::ManagedPointer<HAMTNode> NodePtrType;
+    typedef std::pair<K, V> EntryType;
+
+    u32 m_data_map;
+    u32 m_node_map;
+    bool m_is_collision;
+    apd::NodeArray<EntryType> m_entries;
+    apd::NodeArray<NodePtrType> m_children;
+
+    inline HAMTNode(bool is_collision)
+        : m_data_map(0), m_node_map(0), m_is_collision(is_collision),
+          m_entries(), m_children()
+    {
+        // Nothing here
+    }
+
+    // a copy starts out unreferenced
+    inline HAMTNode(const HAMTNode& other)
+        : AurumObject<HAMTNode<K, V> >(), RefCountable<HAMTNode<K, V> >(),
+          m_data_map(other.m_data_map), m_node_map(other.m_node_map),
+          m_is_collision(other.m_is_collision), m_entries(other.m_entries),
+          m_children(other.m_children)
+    {
+        // Nothing here
+    }
+
+    inline ~HAMTNode()
+    {
+        // Nothing here
+    }
+
+    HAMTNode& operator = (const HAMTNode& other) = delete;
+
+    static inline u32 get_index(u32 bitmap, u32 bit)
+    {
+        return __builtin_popcount(bitmap & (bit - 1));
+    }
+};
+
+static inline u32 get_bit(u64 hash, u32 shift)
+{
+    return (1u << ((hash >> shift) & sc_level_mask));
+}
+
+template <typename K, typename V, typename HashFunction, typename EqualsFunction>
+class HAMTrie : private HashFunction, private EqualsFunction
+{
+public:
+    typedef HAMTNode<K, V> NodeType;
+    typedef typename NodeType::NodePtrType NodePtrType;
+    typedef typename NodeType::EntryType EntryType;
+
+private:
+    NodePtrType m_root;
+    u64 m_size;
+
+    inline u64 hash(const K& key) const
+    {
+        return HashFunction::operator()(key);
+    }
+
+    inline bool equals(const K& key1, const K& key2) const
+    {
+        return EqualsFunction::operator()(key1, key2);
+    }
+
+    // a new trie at shift holding the two entries, whose hashes
+    // agree on all the bits below shift
+    static NodePtrType make_pair_node(u32 shift, const EntryType& entry1, u64 hash1,
+                                      EntryType&& entry2, u64 hash2)
+    {
+        if (shift >= sc_max_shift) {
+            auto node = new NodeType(true);
+            node->m_entries.push_back(entry1);
+            node->m_entries.push_back(std::move(entry2));
+            return NodePtrType(node);
+        }
+
+        auto node = new NodeType(false);
+        const u32 bit1 = get_bit(hash1, shift);
+        const u32 bit2 = get_bit(hash2, shift);
+        if (bit1 == bit2) {
+            node->m_node_map = bit1;
+            node->m_children.push_back(make_pair_node(shift + sc_bits_per_level,
+                                                      entry1, hash1,
+                                                      std::move(entry2), hash2));
+        } else {
+            node->m_data_map = (bit1 | bit2);
+            if (bit1 < bit2) {
+                node->m_entries.push_back(entry1);
+                node->m_entries.push_back(std::move(entry2));
+            } else {
+                node->m_entries.push_back(std::move(entry2));
+                node->m_entries.push_back(entry1);
+            }
+        }
+        return NodePtrType(node);
+    }
+
+    // returns true if a new key was added, false if the value of
+    // an existing key was replaced (or left alone, if not assign)
+    bool insert_in(NodePtrType& node_ptr, u32 shift, u64 key_hash,
+                   EntryType&& entry, bool assign)
+    {
+        auto node = node_ptr.get_raw_pointer();
+        if (node->m_is_collision) {
+            for (u32 i = 0; i < node->m_entries.size(); ++i) {
+                if (equals(node->m_entries[i].first, entry.first)) {
+                    if (assign) {
+                        apd::make_unique_node(node_ptr)->m_entries[i].second =
+                            std::move(entry.second);
+                    }
+                    return false;
+                }
+            }
+            apd::make_unique_node(node_ptr)->m_entries.push_back(std::move(entry));
+            return true;
+        }
+
+        const u32 bit = get_bit(key_hash, shift);
+        if ((node->m_data_map & bit) != 0) {
+            const u32 index = NodeType::get_index(node->m_data_map, bit);
+            if (equals(node->m_entries[index].first, entry.first)) {
+                if (assign) {
+                    apd::make_unique_node(node_ptr)->m_entries[index].second =
+                        std::move(entry.second);
+                }
+                return false;
+            }
+
+            // push both entries down into a new sub-trie
+            node = apd::make_unique_node(node_ptr);
+            auto const& existing = node->m_entries[index];
+            auto child = make_pair_node(shift + sc_bits_per_level, existing,
+                                        hash(existing.first), std::move(entry), key_hash);
+            node->m_entries.erase(index);
+            node->m_data_map &= ~bit;
+            node->m_children.insert(NodeType::get_index(node->m_node_map, bit),
+                                    std::move(child));
+            node->m_node_map |= bit;
+            return true;
+        }
+
+        if ((node->m_node_map & bit) != 0) {
+            const u32 index = NodeType::get_index(node->m_node_map, bit);
+            node = apd::make_unique_node(node_ptr);
+            return insert_in(node->m_children[index], shift + sc_bits_per_level,
+                             key_hash, std::move(entry), assign);
+        }
+
+        node = apd::make_unique_node(node_ptr);
+        node->m_entries.insert(NodeType::get_index(node->m_data_map, bit), std::move(entry));
+        node->m_data_map |= bit;
+        return true;
+    }
+
+    // the key must be present
+    void erase_in(NodePtrType& node_ptr, u32 shift, u64 key_hash, const K& key)
+    {
+        auto node = apd::make_unique_node(node_ptr);
+        if (node->m_is_collision) {
+            for (u32 i = 0; i < node->m_entries.size(); ++i) {
+                if (equals(node->m_entries[i].first, key)) {
+                    node->m_entries.erase(i);
+                    return;
+                }
+            }
+            AURUM_UNREACHABLE_CODE();
+        }
+
+        const u32 bit = get_bit(key_hash, shift);
+        if ((node->m_data_map & bit) != 0) {
+            node->m_entries.erase(NodeType::get_index(node->m_data_map, bit));
+            node->m_data_map &= ~bit;
+            return;
+        }
+
+        const u32 index = NodeType::get_index(node->m_node_map, bit);
+        erase_in(node->m_children[index], shift + sc_bits_per_level, key_hash, key);
+
+        // a sub-trie left with a single entry is pulled back up
+        // into this node, which keeps the trie canonical
+        auto child = node->m_children[index].get_raw_pointer();
+        if (child->m_children.empty() && child->m_entries.size() == 1) {
+            EntryType entry = child->m_entries[0];
+            node->m_children.erase(index);
+            node->m_node_map &= ~bit;
+            node->m_entries.insert(NodeType::get_index(node->m_data_map, bit),
+                                   std::move(entry));
+            node->m_data_map |= bit;
+        }
+    }
+
+public:
+    inline HAMTrie()
+        : HashFunction(), EqualsFunction(), m_root(new NodeType(false)), m_size(0)
+    {
+        // Nothing here
+    }
+
+    inline HAMTrie(const HAMTrie& other)
+        : HashFunction(other), EqualsFunction(other), m_root(other.m_root),
+          m_size(other.m_size)
+    {
+        // Nothing here
+    }
+
+    inline ~HAMTrie()
+    {
+        // Nothing here
+    }
+
+    inline HAMTrie& operator = (const HAMTrie& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_root = other.m_root;
+        m_size = other.m_size;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_size;
+    }
+
+    inline const NodeType* get_root() const
+    {
+        return m_root.get_raw_pointer();
+    }
+
+    inline const EntryType* find(const K& key) const
+    {
+        const u64 key_hash = hash(key);
+        const NodeType* node = m_root.get_raw_pointer();
+        for (u32 shift = 0; ; shift += sc_bits_per_level) {
+            if (node->m_is_collision) {
+                for (auto const& entry : node->m_entries) {
+                    if (equals(entry.first, key)) {
+                        return &entry;
+                    }
+                }
+                return nullptr;
+            }
+
+            const u32 bit = get_bit(key_hash, shift);
+            if ((node->m_data_map & bit) != 0) {
+                auto const& entry = node->m_entries[NodeType::get_index(node->m_data_map, bit)];
+                return (equals(entry.first, key) ? &entry : nullptr);
+            }
+            if ((node->m_node_map & bit) == 0) {
+                return nullptr;
+            }
+            node = node->m_children[NodeType::get_index(node->m_node_map, bit)].get_raw_pointer();
+        }
+    }
+
+    inline bool insert(const K& key, const V& value, bool assign)
+    {
+        const bool retval = insert_in(m_root, 0, hash(key), EntryType(key, value), assign);
+        if (retval) {
+            ++m_size;
+        }
+        return retval;
+    }
+
+    inline bool erase(const K& key)
+    {
+        if (find(key) == nullptr) {
+            return false;
+        }
+        erase_in(m_root, 0, hash(key), key);
+        --m_size;
+        return true;
+    }
+
+    inline void clear()
+    {
+        m_root = new NodeType(false);
+        m_size = 0;
+    }
+};
+
+// Iterates depth first, keeping the path down from the root on an
+// explicit stack, which is never deeper than the trie
+template <typename K, typename V>
+class HAMTConstIterator
+    : public std::iterator<std::forward_iterator_tag, std::pair<K, V>, i64,
+                           const std::pair<K, V>*, const std::pair<K, V>&>
+{
+private:
+    typedef HAMTNode<K, V> NodeType;
+    typedef typename NodeType::EntryType EntryType;
+
+    static constexpr u32 sc_max_depth = (sc_max_shift / sc_bits_per_level) + 2;
+
+    struct Frame
+    {
+        const NodeType* m_node;
+        u32 m_next_entry;
+        u32 m_next_child;
+    };
+
+    Frame m_stack[sc_max_depth];
+    u32 m_depth;
+    const EntryType* m_current;
+
+    inline void advance()
+    {
+        while (m_depth > 0) {
+            auto& frame = m_stack[m_depth - 1];
+            if (frame.m_next_entry < frame.m_node->m_entries.size()) {
+                m_current = &(frame.m_node->m_entries[frame.m_next_entry++]);
+                return;
+            }
+            if (frame.m_next_child < frame.m_node->m_children.size()) {
+                auto child = frame.m_node->m_children[frame.m_next_child++].get_raw_pointer();
+                m_stack[m_depth++] = Frame { child, 0, 0 };
+                continue;
+            }
+            --m_depth;
+        }
+        m_current = nullptr;
+    }
+
+public:
+    inline HAMTConstIterator()
+        : m_depth(0), m_current(nullptr)
+    {
+        // Nothing here
+    }
+
+    inline HAMTConstIterator(const NodeType* root)
+        : m_depth(0), m_current(nullptr)
+    {
+        if (root != nullptr) {
+            m_stack[m_depth++] = Frame { root, 0, 0 };
+            advance();
+        }
+    }
+
+    inline HAMTConstIterator(const HAMTConstIterator& other)
+        : m_depth(other.m_depth), m_current(other.m_current)
+    {
+        std::copy(other.m_stack, other.m_stack + m_depth, m_stack);
+    }
+
+    inline ~HAMTConstIterator()
+    {
+        // Nothing here
+    }
+
+    inline HAMTConstIterator& operator = (const HAMTConstIterator& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_depth = other.m_depth;
+        m_current = other.m_current;
+        std::copy(other.m_stack, other.m_stack + m_depth, m_stack);
+        return *this;
+    }
+
+    inline bool operator == (const HAMTConstIterator& other) const
+    {
+        return (m_current == other.m_current);
+    }
+
+    inline bool operator != (const HAMTConstIterator& other) const
+    {
+        return (m_current != other.m_current);
+    }
+
+    inline HAMTConstIterator& operator ++ ()
+    {
+        advance();
+        return *this;
+    }
+
+    inline HAMTConstIterator operator ++ (int unused)
+    {
+        auto retval = *this;
+        advance();
+        return retval;
+    }
+
+    inline const EntryType& operator * () const
+    {
+        return *m_current;
+    }
+
+    inline const EntryType* operator -> () const
+    {
+        return m_current;
+    }
+};
+
+} /* end namespace persistent_unordered_map_detail_ */
+
+// An immutable hash map with structural sharing, implemented as a
+// hash array mapped trie with 32 way nodes. Copies (snapshots) take
+// constant time, while lookups, inserts and erases take
+// O(log32(n)) time, with the updates returning a new map that
+// shares all but the updated path with this one. Use a
+// TransientUnorderedMap for batches of updates
+template <typename K, typename V,
+          typename HashFunction = ah::Hasher<K>,
+          typename EqualsFunction = acmp::EqualTo<K> >
+class PersistentUnorderedMap final
+    : public AurumObject<PersistentUnorderedMap<K, V, HashFunction, EqualsFunction> >,
+      public Stringifiable<PersistentUnorderedMap<K, V, HashFunction, EqualsFunction> >
+{
+    friend class TransientUnorderedMap<K, V, HashFunction, EqualsFunction>;
+
+private:
+    typedef persistent_unordered_map_detail_::HAMTrie<K, V, HashFunction,
+                                                      EqualsFunction> TrieType;
+
+    TrieType m_trie;
+
+    inline PersistentUnorderedMap(const TrieType& trie)
+        : m_trie(trie)
+    {
+        // Nothing here
+    }
+
+public:
+    typedef std::pair<K, V> ValueType;
+    typedef ValueType value_type;
+    typedef persistent_unordered_map_detail_::HAMTConstIterator<K, V> ConstIterator;
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator Iterator;
+    typedef Iterator iterator;
+
+    inline PersistentUnorderedMap()
+        : m_trie()
+    {
+        // Nothing here
+    }
+
+    inline PersistentUnorderedMap(std::initializer_list<ValueType> init_list)
+        : m_trie()
+    {
+        for (auto const& value : init_list) {
+            m_trie.insert(value.first, value.second, true);
+        }
+    }
+
+    inline PersistentUnorderedMap(const PersistentUnorderedMap& other)
+        : m_trie(other.m_trie)
+    {
+        // Nothing here
+    }
+
+    inline ~PersistentUnorderedMap()
+    {
+        // Nothing here
+    }
+
+    inline PersistentUnorderedMap& operator = (const PersistentUnorderedMap& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_trie = other.m_trie;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_trie.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_trie.size() == 0);
+    }
+
+    inline u64 count(const K& key) const
+    {
+        return (m_trie.find(key) == nullptr ? 0 : 1);
+    }
+
+    // the value for key, or nullptr if key is not in the map
+    inline const V* find(const K& key) const
+    {
+        auto entry = m_trie.find(key);
+        return (entry == nullptr ? nullptr : &(entry->second));
+    }
+
+    inline const V& at(const K& key) const
+    {
+        auto entry = m_trie.find(key);
+        if (entry == nullptr) {
+            throw std::out_of_range("Key not found in aurum::PersistentUnorderedMap::at()");
+        }
+        return entry->second;
+    }
+
+    // a map with key mapped to value, replacing any existing mapping
+    inline PersistentUnorderedMap insert(const K& key, const V& value) const
+    {
+        PersistentUnorderedMap retval(*this);
+        retval.m_trie.insert(key, value, true);
+        return retval;
+    }
+
+    inline PersistentUnorderedMap erase(const K& key) const
+    {
+        PersistentUnorderedMap retval(*this);
+        retval.m_trie.erase(key);
+        return retval;
+    }
+
+    inline TransientUnorderedMap<K, V, HashFunction, EqualsFunction> transient() const;
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(m_trie.get_root());
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator();
+    }
+
+    inline ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    inline ConstIterator cend() const
+    {
+        return end();
+    }
+
+    inline bool operator == (const PersistentUnorderedMap& other) const
+    {
+        if (size() != other.size()) {
+            return false;
+        }
+        if (m_trie.get_root() == other.m_trie.get_root()) {
+            return true;
+        }
+        for (auto const& entry : *this) {
+            auto other_value = other.find(entry.first);
+            if (other_value == nullptr || !(*other_value == entry.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline bool operator != (const PersistentUnorderedMap& other) const
+    {
+        return (!(*this == other));
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "PersistentUnorderedMap<" << type_name<K>() << ", "
+             << type_name<V>() << "> with " << size()
+             << " elements:" << std::endl << "<<" << std::endl;
+        as::Stringifier<K> key_stringifier;
+        as::Stringifier<V> value_stringifier;
+        for (auto const& entry : *this) {
+            sstr << "  {" << key_stringifier(entry.first, verbosity) << " |--> "
+                 << value_stringifier(entry.second, verbosity) << "}" << std::endl;
+        }
+        sstr << ">>";
+        return sstr.str();
+    }
+};
+
+// The mutable counterpart of a PersistentUnorderedMap, for batches
+// of updates. Nodes created by (or copied into) a transient are
+// updated in place. persistent() takes a constant time snapshot,
+// after which the transient may still be used: it simply copies any
+// node shared with a snapshot before updating it.
+// Iterators and references into a transient are invalidated by any
+// update
+template <typename K, typename V,
+          typename HashFunction = ah::Hasher<K>,
+          typename EqualsFunction = acmp::EqualTo<K> >
+class TransientUnorderedMap final
+    : public AurumObject<TransientUnorderedMap<K, V, HashFunction, EqualsFunction> >
+{
+private:
+    typedef persistent_unordered_map_detail_::HAMTrie<K, V, HashFunction,
+                                                      EqualsFunction> TrieType;
+    typedef PersistentUnorderedMap<K, V, HashFunction, EqualsFunction> PersistentType;
+
+    TrieType m_trie;
+
+public:
+    typedef std::pair<K, V> ValueType;
+    typedef ValueType value_type;
+    typedef persistent_unordered_map_detail_::HAMTConstIterator<K, V> ConstIterator;
+    typedef ConstIterator const_iterator;
+
+    inline TransientUnorderedMap()
+        : m_trie()
+    {
+        // Nothing here
+    }
+
+    inline explicit TransientUnorderedMap(const PersistentType& persistent_map)
+        : m_trie(persistent_map.m_trie)
+    {
+        // Nothing here
+    }
+
+    inline TransientUnorderedMap(const TransientUnorderedMap& other)
+        : m_trie(other.m_trie)
+    {
+        // Nothing here
+    }
+
+    inline ~TransientUnorderedMap()
+    {
+        // Nothing here
+    }
+
+    inline TransientUnorderedMap& operator = (const TransientUnorderedMap& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_trie = other.m_trie;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_trie.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_trie.size() == 0);
+    }
+
+    inline u64 count(const K& key) const
+    {
+        return (m_trie.find(key) == nullptr ? 0 : 1);
+    }
+
+    inline const V* find(const K& key) const
+    {
+        auto entry = m_trie.find(key);
+        return (entry == nullptr ? nullptr : &(entry->second));
+    }
+
+    // returns true if key was not already present, the value of
+    // an existing key is left alone
+    inline bool insert(const K& key, const V& value)
+    {
+        return m_trie.insert(key, value, false);
+    }
+
+    // returns true if key was not already present, the value of
+    // an existing key is replaced
+    inline bool insert_or_assign(const K& key, const V& value)
+    {
+        return m_trie.insert(key, value, true);
+    }
+
+    inline bool erase(const K& key)
+    {
+        return m_trie.erase(key);
+    }
+
+    inline void clear()
+    {
+        m_trie.clear();
+    }
+
+    inline PersistentType persistent() const
+    {
+        return PersistentType(m_trie);
+    }
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(m_trie.get_root());
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator();
+    }
+};
+
+template <typename K, typename V, typename HashFunction, typename EqualsFunction>
+inline TransientUnorderedMap<K, V, HashFunction, EqualsFunction>
+PersistentUnorderedMap<K, V, HashFunction, EqualsFunction>::transient() const
+{
+    return TransientUnorderedMap<K, V, HashFunction, EqualsFunction>(*this);
+}
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_PERSISTENT_UNORDERED_MAP_HPP_ */
+
+//
+// PersistentUnorderedMap.hpp ends here
@@ -0,0 +1,907 @@
+// PersistentVector.hpp ---
+//
+// Filename: PersistentVector.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:49:36 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_PERSISTENT_VECTOR_HPP_
+#define AURUM_CONTAINERS_PERSISTENT_VECTOR_HPP_
+
+#include <iterator>
+#include <stdexcept>
+#include <initializer_list>
+#include <string>
+#include <sstream>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+#include "PersistentTypes.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace as = aurum::stringification;
+
+template <typename T> class PersistentVector;
+template <typename T> class TransientVector;
+
+namespace persistent_vector_detail_ {
+
+namespace am = aurum::memory;
+namespace apd = aurum::containers::persistent_detail_;
+
+static constexpr u32 sc_bits_per_level = 5;
+static constexpr u32 sc_branching_factor = (1u << sc_bits_per_level);
+
+// A node of a relaxed radix balanced tree. Leaves hold up to 32
+// values, internal nodes up to 32 children. An internal node is
+// either regular, in which case all of its children are regular,
+// and all but the last hold as many elements as they possibly can,
+// so that the child holding an index is found by radix arithmetic,
+// or relaxed, in which case it carries a table of the cumulative
+// sizes of its children, which is searched instead
+template <typename T>
+class RRBNode : public AurumObject<RRBNode<T> >,
+                public RefCountable<RRBNode<T> >
+{
+public:
+    typedef am::ManagedPointer<RRBNode> NodePtrType;
+
+    apd::NodeArray<T> m_values;
+    apd::NodeArray<NodePtrType> m_children;
+    apd::NodeArray<u64> m_sizes;
+    bool m_is_leaf;
+
+    inline RRBNode(bool is_leaf)
+        : m_values(), m_children(), m_sizes(), m_is_leaf(is_leaf)
+    {
+        // Nothing here
+    }
+
+    // a copy starts out unreferenced
+    inline RRBNode(const RRBNode& other)
+        : AurumObject<RRBNode<T> >(), RefCountable<RRBNode<T> >(),
+          m_values(other.m_values), m_children(other.m_children),
+          m_sizes(other.m_sizes), m_is_leaf(other.m_is_leaf)
+    {
+        // Nothing here
+    }
+
+    inline ~RRBNode()
+    {
+        // Nothing here
+    }
+
+    RRBNode& operator = (const RRBNode& other) = delete;
+
+    inline u32 get_count() const
+    {
+        return (m_is_leaf ? m_values.size() : m_children.size());
+    }
+
+    inline bool is_relaxed() const
+    {
+        return (!m_sizes.empty());
+    }
+};
+
+// The tree itself, along with all the algorithms. Every mutating
+// operation copies the nodes on its path which are shared, so a
+// tree can be copied in constant time, and the copies can then be
+// updated independently
+template <typename T>
+class RRBTree
+{
+public:
+    typedef RRBNode<T> NodeType;
+    typedef typename NodeType::NodePtrType NodePtrType;
+    typedef apd::NodeArray<NodePtrType> NodeListType;
+
+private:
+    NodePtrType m_root;
+    // the root is a leaf when this is zero
+    u32 m_shift;
+    u64 m_size;
+
+    static inline u64 get_node_size(const NodeType* node, u32 shift)
+    {
+        if (node->m_is_leaf) {
+            return node->m_values.size();
+        }
+        if (node->is_relaxed()) {
+            return node->m_sizes.back();
+        }
+        return ((((u64)node->m_children.size() - 1) << shift) +
+                get_node_size(node->m_children.back().get_raw_pointer(),
+                              shift - sc_bits_per_level));
+    }
+
+    // the child of an internal node at shift which holds index,
+    // index is updated to be relative to that child
+    static inline u32 find_child(const NodeType* node, u32 shift, u64& index)
+    {
+        if (!node->is_relaxed()) {
+            const u32 child = (u32)(index >> shift);
+            index -= ((u64)child << shift);
+            return child;
+        }
+        // a child cannot hold more than (1 << shift) elements,
+        // so the radix guess never overshoots
+        u32 child = (u32)(index >> shift);
+        while (node->m_sizes[child] <= index) {
+            ++child;
+        }
+        if (child > 0) {
+            index -= node->m_sizes[child - 1];
+        }
+        return child;
+    }
+
+    static inline NodePtrType make_path(u32 shift, const T& value)
+    {
+        if (shift == 0) {
+            auto leaf = new NodeType(true);
+            leaf->m_values.push_back(value);
+            return NodePtrType(leaf);
+        }
+        auto node = new NodeType(false);
+        node->m_children.push_back(make_path(shift - sc_bits_per_level, value));
+        return NodePtrType(node);
+    }
+
+    // builds an internal node over the children, adding a size
+    // table only if the children do not line up as in a regular node
+    static inline NodePtrType make_internal(const NodeListType& children, u32 first,
+                                            u32 last, u32 shift)
+    {
+        auto node = new NodeType(false);
+        node->m_children.reserve(last - first);
+        bool regular = true;
+        u64 total = 0;
+        for (u32 i = first; i < last; ++i) {
+            auto child = children[i].get_raw_pointer();
+            const u64 child_size = get_node_size(child, shift - sc_bits_per_level);
+            regular = (regular && !child->is_relaxed() &&
+                       (i + 1 == last || child_size == ((u64)1 << shift)));
+            total += child_size;
+            node->m_children.push_back(children[i]);
+            node->m_sizes.push_back(total);
+        }
+        if (regular) {
+            node->m_sizes = apd::NodeArray<u64>();
+        }
+        return NodePtrType(node);
+    }
+
+    // packs nodes at shift - 5 into one or two nodes at shift
+    static inline void pack(const NodeListType& children, u32 shift, NodeListType& result)
+    {
+        const u32 count = children.size();
+        if (count <= sc_branching_factor) {
+            result.push_back(make_internal(children, 0, count, shift));
+        } else {
+            result.push_back(make_internal(children, 0, sc_branching_factor, shift));
+            result.push_back(make_internal(children, sc_branching_factor, count, shift));
+        }
+    }
+
+    // concatenates the trees rooted at left and right, which need
+    // not be of the same height, into one or two nodes at the larger
+    // of the two shifts, merging the nodes along the seam
+    static void merge(const NodePtrType& left, u32 left_shift,
+                      const NodePtrType& right, u32 right_shift,
+                      NodeListType& result)
+    {
+        NodeListType children;
+        if (left_shift > right_shift) {
+            NodeListType middle;
+            merge(left->m_children.back(), left_shift - sc_bits_per_level,
+                  right, right_shift, middle);
+            for (u32 i = 0; i + 1 < left->m_children.size(); ++i) {
+                children.push_back(left->m_children[i]);
+            }
+            for (auto const& node : middle) {
+                children.push_back(node);
+            }
+            pack(children, left_shift, result);
+            return;
+        }
+
+        if (right_shift > left_shift) {
+            merge(left, left_shift, right->m_children[0], right_shift - sc_bits_per_level,
+                  children);
+            for (u32 i = 1; i < right->m_children.size(); ++i) {
+                children.push_back(right->m_children[i]);
+            }
+            pack(children, right_shift, result);
+            return;
+        }
+
+        if (left_shift == 0) {
+            // two leaves, repack their values
+            const u32 total = left->m_values.size() + right->m_values.size();
+            auto first = new NodeType(true);
+            result.push_back(NodePtrType(first));
+            auto cur = first;
+            for (u32 i = 0; i < total; ++i) {
+                if (i == sc_branching_factor) {
+                    cur = new NodeType(true);
+                    result.push_back(NodePtrType(cur));
+                }
+                const u32 left_count = left->m_values.size();
+                cur->m_values.push_back(i < left_count ?
+                                        left->m_values[i] : right->m_values[i - left_count]);
+            }
+            return;
+        }
+
+        NodeListType middle;
+        merge(left->m_children.back(), left_shift - sc_bits_per_level,
+              right->m_children[0], right_shift - sc_bits_per_level, middle);
+        for (u32 i = 0; i + 1 < left->m_children.size(); ++i) {
+            children.push_back(left->m_children[i]);
+        }
+        for (auto const& node : middle) {
+            children.push_back(node);
+        }
+        for (u32 i = 1; i < right->m_children.size(); ++i) {
+            children.push_back(right->m_children[i]);
+        }
+        pack(children, left_shift, result);
+    }
+
+    static inline bool can_push(const NodeType* node, u32 shift)
+    {
+        for (; !node->m_is_leaf; shift -= sc_bits_per_level) {
+            if (node->m_children.size() < sc_branching_factor) {
+                return true;
+            }
+            node = node->m_children.back().get_raw_pointer();
+        }
+        return (node->m_values.size() < sc_branching_factor);
+    }
+
+    // node must be able to take one more value
+    static void push_back_in(NodePtrType& node_ptr, u32 shift, const T& value)
+    {
+        auto node = apd::make_unique_node(node_ptr);
+        if (node->m_is_leaf) {
+            node->m_values.push_back(value);
+            return;
+        }
+
+        const u32 child_shift = shift - sc_bits_per_level;
+        if (can_push(node->m_children.back().get_raw_pointer(), child_shift)) {
+            push_back_in(node->m_children.back(), child_shift, value);
+            if (node->is_relaxed()) {
+                ++(node->m_sizes.back());
+            }
+            return;
+        }
+
+        node->m_children.push_back(make_path(child_shift, value));
+        if (node->is_relaxed()) {
+            node->m_sizes.push_back(node->m_sizes.back() + 1);
+        }
+    }
+
+    static void pop_back_in(NodePtrType& node_ptr, u32 shift)
+    {
+        auto node = apd::make_unique_node(node_ptr);
+        if (node->m_is_leaf) {
+            node->m_values.pop_back();
+            return;
+        }
+
+        pop_back_in(node->m_children.back(), shift - sc_bits_per_level);
+        if (node->is_relaxed()) {
+            --(node->m_sizes.back());
+        }
+        if (node->m_children.back()->get_count() == 0) {
+            node->m_children.pop_back();
+            if (node->is_relaxed()) {
+                node->m_sizes.pop_back();
+            }
+        }
+    }
+
+public:
+    inline RRBTree()
+        : m_root(), m_shift(0), m_size(0)
+    {
+        // Nothing here
+    }
+
+    inline RRBTree(const RRBTree& other)
+        : m_root(other.m_root), m_shift(other.m_shift), m_size(other.m_size)
+    {
+        // Nothing here
+    }
+
+    inline ~RRBTree()
+    {
+        // Nothing here
+    }
+
+    inline RRBTree& operator = (const RRBTree& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_root = other.m_root;
+        m_shift = other.m_shift;
+        m_size = other.m_size;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_size;
+    }
+
+    inline bool shares_root_with(const RRBTree& other) const
+    {
+        return (m_root == other.m_root);
+    }
+
+    // the leaf holding index, along with the index of the first
+    // element in that leaf
+    inline const NodeType* find_leaf(u64 index, u64& leaf_start) const
+    {
+        AURUM_ASSERT(index < m_size);
+        const NodeType* node = m_root.get_raw_pointer();
+        u64 relative_index = index;
+        for (u32 shift = m_shift; !node->m_is_leaf; shift -= sc_bits_per_level) {
+            const u32 child = find_child(node, shift, relative_index);
+            node = node->m_children[child].get_raw_pointer();
+        }
+        leaf_start = index - relative_index;
+        return node;
+    }
+
+    inline const T& get(u64 index) const
+    {
+        u64 leaf_start = 0;
+        auto leaf = find_leaf(index, leaf_start);
+        return leaf->m_values[(u32)(index - leaf_start)];
+    }
+
+    inline void set(u64 index, const T& value)
+    {
+        AURUM_ASSERT(index < m_size);
+        NodePtrType* node_ptr = &m_root;
+        for (u32 shift = m_shift; ; shift -= sc_bits_per_level) {
+            auto node = apd::make_unique_node(*node_ptr);
+            if (node->m_is_leaf) {
+                node->m_values[(u32)index] = value;
+                return;
+            }
+            node_ptr = &(node->m_children[find_child(node, shift, index)]);
+        }
+    }
+
+    inline void push_back(const T& value)
+    {
+        if (m_size == 0) {
+            m_root = make_path(0, value);
+            m_shift = 0;
+        } else if (can_push(m_root.get_raw_pointer(), m_shift)) {
+            push_back_in(m_root, m_shift, value);
+        } else {
+            // the root is full, grow a level. A full regular root
+            // holds as many elements as it can, so the new root is
+            // regular iff the old one is
+            const bool relaxed = (!m_root->m_is_leaf && m_root->is_relaxed());
+            auto root = new NodeType(false);
+            root->m_children.push_back(m_root);
+            root->m_children.push_back(make_path(m_shift, value));
+            if (relaxed) {
+                root->m_sizes.push_back(m_size);
+                root->m_sizes.push_back(m_size + 1);
+            }
+            m_root = root;
+            m_shift += sc_bits_per_level;
+        }
+        ++m_size;
+    }
+
+    inline void pop_back()
+    {
+        AURUM_ASSERT(m_size > 0);
+        if (m_size == 1) {
+            clear();
+            return;
+        }
+        pop_back_in(m_root, m_shift);
+        --m_size;
+        while (!m_root->m_is_leaf && m_root->m_children.size() == 1) {
+            NodePtrType child = m_root->m_children[0];
+            m_root = child;
+            m_shift -= sc_bits_per_level;
+        }
+    }
+
+    inline void append(const RRBTree& other)
+    {
+        if (other.m_size == 0) {
+            return;
+        }
+        if (m_size == 0) {
+            *this = other;
+            return;
+        }
+
+        NodeListType roots;
+        merge(m_root, m_shift, other.m_root, other.m_shift, roots);
+        m_shift = std::max(m_shift, other.m_shift);
+        if (roots.size() == 1) {
+            m_root = roots[0];
+        } else {
+            m_shift += sc_bits_per_level;
+            m_root = make_internal(roots, 0, roots.size(), m_shift);
+        }
+        m_size += other.m_size;
+    }
+
+    inline void clear()
+    {
+        m_root = nullptr;
+        m_shift = 0;
+        m_size = 0;
+    }
+};
+
+// Iterates over the values of a tree one leaf at a time, so
+// advancing costs a tree lookup only once every leaf
+template <typename T>
+class RRBConstIterator : public std::iterator<std::forward_iterator_tag, T, i64,
+                                              const T*, const T&>
+{
+private:
+    typedef RRBTree<T> TreeType;
+    typedef typename TreeType::NodeType NodeType;
+
+    const TreeType* m_tree;
+    u64 m_index;
+    const NodeType* m_leaf;
+    u64 m_leaf_start;
+
+    inline void find_leaf()
+    {
+        if (m_index < m_tree->size()) {
+            m_leaf = m_tree->find_leaf(m_index, m_leaf_start);
+        } else {
+            m_leaf = nullptr;
+        }
+    }
+
+public:
+    inline RRBConstIterator()
+        : m_tree(nullptr), m_index(0), m_leaf(nullptr), m_leaf_start(0)
+    {
+        // Nothing here
+    }
+
+    inline RRBConstIterator(const TreeType* tree, u64 index)
+        : m_tree(tree), m_index(index), m_leaf(nullptr), m_leaf_start(0)
+    {
+        find_leaf();
+    }
+
+    inline RRBConstIterator(const RRBConstIterator& other)
+        : m_tree(other.m_tree), m_index(other.m_index),
+          m_leaf(other.m_leaf), m_leaf_start(other.m_leaf_start)
+    {
+        // Nothing here
+    }
+
+    inline ~RRBConstIterator()
+    {
+        // Nothing here
+    }
+
+    inline RRBConstIterator& operator = (const RRBConstIterator& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_tree = other.m_tree;
+        m_index = other.m_index;
+        m_leaf = other.m_leaf;
+        m_leaf_start = other.m_leaf_start;
+        return *this;
+    }
+
+    inline bool operator == (const RRBConstIterator& other) const
+    {
+        return (m_tree == other.m_tree && m_index == other.m_index);
+    }
+
+    inline bool operator != (const RRBConstIterator& other) const
+    {
+        return (!(*this == other));
+    }
+
+    inline RRBConstIterator& operator ++ ()
+    {
+        ++m_index;
+        if (m_index - m_leaf_start >= m_leaf->m_values.size()) {
+            find_leaf();
+        }
+        return *this;
+    }
+
+    inline RRBConstIterator operator ++ (int unused)
+    {
+        auto retval = *this;
+        ++(*this);
+        return retval;
+    }
+
+    inline const T& operator * () const
+    {
+        return m_leaf->m_values[(u32)(m_index - m_leaf_start)];
+    }
+
+    inline const T* operator -> () const
+    {
+        return &(**this);
+    }
+};
+
+} /* end namespace persistent_vector_detail_ */
+
+// An immutable vector with structural sharing, implemented as a
+// relaxed radix balanced tree with a branching factor of 32.
+// Copies (snapshots) take constant time, lookups, updates, pushes
+// and pops take O(log32(n)) time and return a new vector, sharing
+// all but the updated path with this one. Vectors can also be
+// concatenated in O(log32(n)) time, which is what the relaxed
+// nodes are for. Use a TransientVector for batches of updates
+template <typename T>
+class PersistentVector final : public AurumObject<PersistentVector<T> >,
+                               public Stringifiable<PersistentVector<T> >
+{
+    friend class TransientVector<T>;
+
+public:
+    typedef T ValueType;
+    typedef T value_type;
+    typedef persistent_vector_detail_::RRBConstIterator<T> ConstIterator;
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator Iterator;
+    typedef Iterator iterator;
+
+private:
+    typedef persistent_vector_detail_::RRBTree<T> TreeType;
+
+    TreeType m_tree;
+
+    inline PersistentVector(const TreeType& tree)
+        : m_tree(tree)
+    {
+        // Nothing here
+    }
+
+public:
+    inline PersistentVector()
+        : m_tree()
+    {
+        // Nothing here
+    }
+
+    template <typename InputIterator>
+    inline PersistentVector(const InputIterator& first, const InputIterator& last)
+        : m_tree()
+    {
+        for (auto it = first; it != last; ++it) {
+            m_tree.push_back(*it);
+        }
+    }
+
+    inline PersistentVector(std::initializer_list<T> init_list)
+        : PersistentVector(init_list.begin(), init_list.end())
+    {
+        // Nothing here
+    }
+
+    inline PersistentVector(const PersistentVector& other)
+        : m_tree(other.m_tree)
+    {
+        // Nothing here
+    }
+
+    inline ~PersistentVector()
+    {
+        // Nothing here
+    }
+
+    inline PersistentVector& operator = (const PersistentVector& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_tree = other.m_tree;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_tree.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_tree.size() == 0);
+    }
+
+    inline const T& operator [] (u64 index) const
+    {
+        return m_tree.get(index);
+    }
+
+    inline const T& at(u64 index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range in aurum::PersistentVector::at()");
+        }
+        return m_tree.get(index);
+    }
+
+    inline const T& front() const
+    {
+        return m_tree.get(0);
+    }
+
+    inline const T& back() const
+    {
+        return m_tree.get(size() - 1);
+    }
+
+    inline PersistentVector push_back(const T& value) const
+    {
+        PersistentVector retval(*this);
+        retval.m_tree.push_back(value);
+        return retval;
+    }
+
+    inline PersistentVector pop_back() const
+    {
+        PersistentVector retval(*this);
+        retval.m_tree.pop_back();
+        return retval;
+    }
+
+    inline PersistentVector set(u64 index, const T& value) const
+    {
+        PersistentVector retval(*this);
+        retval.m_tree.set(index, value);
+        return retval;
+    }
+
+    inline PersistentVector concat(const PersistentVector& other) const
+    {
+        PersistentVector retval(*this);
+        retval.m_tree.append(other.m_tree);
+        return retval;
+    }
+
+    inline TransientVector<T> transient() const;
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(&m_tree, 0);
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator(&m_tree, size());
+    }
+
+    inline ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    inline ConstIterator cend() const
+    {
+        return end();
+    }
+
+    inline bool operator == (const PersistentVector& other) const
+    {
+        if (size() != other.size()) {
+            return false;
+        }
+        if (m_tree.shares_root_with(other.m_tree)) {
+            return true;
+        }
+        return std::equal(begin(), end(), other.begin());
+    }
+
+    inline bool operator != (const PersistentVector& other) const
+    {
+        return (!(*this == other));
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "PersistentVector<" << type_name<T>() << "> with "
+             << size() << " elements:" << std::endl << "<<";
+        as::IterableStringifier<PersistentVector, T> iter_stringifier;
+        sstr << iter_stringifier(*this, verbosity) << ">>";
+        return sstr.str();
+    }
+};
+
+// The mutable counterpart of a PersistentVector, for batches of
+// updates. Nodes created by (or copied into) a transient are updated
+// in place, so a batch of n pushes costs about as much as pushing
+// onto a Vector. persistent() takes a constant time snapshot, after
+// which the transient may still be used: it simply copies any
+// node shared with a snapshot before updating it.
+// Iterators and references into a transient are invalidated by
+// any update
+template <typename T>
+class TransientVector final : public AurumObject<TransientVector<T> >,
+                              public Stringifiable<TransientVector<T> >
+{
+public:
+    typedef T ValueType;
+    typedef T value_type;
+    typedef persistent_vector_detail_::RRBConstIterator<T> ConstIterator;
+    typedef ConstIterator const_iterator;
+
+private:
+    typedef persistent_vector_detail_::RRBTree<T> TreeType;
+
+    TreeType m_tree;
+
+public:
+    inline TransientVector()
+        : m_tree()
+    {
+        // Nothing here
+    }
+
+    inline explicit TransientVector(const PersistentVector<T>& persistent_vector)
+        : m_tree(persistent_vector.m_tree)
+    {
+        // Nothing here
+    }
+
+    inline TransientVector(const TransientVector& other)
+        : m_tree(other.m_tree)
+    {
+        // Nothing here
+    }
+
+    inline ~TransientVector()
+    {
+        // Nothing here
+    }
+
+    inline TransientVector& operator = (const TransientVector& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_tree = other.m_tree;
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return m_tree.size();
+    }
+
+    inline bool empty() const
+    {
+        return (m_tree.size() == 0);
+    }
+
+    inline const T& operator [] (u64 index) const
+    {
+        return m_tree.get(index);
+    }
+
+    inline void push_back(const T& value)
+    {
+        m_tree.push_back(value);
+    }
+
+    inline void pop_back()
+    {
+        m_tree.pop_back();
+    }
+
+    inline void set(u64 index, const T& value)
+    {
+        m_tree.set(index, value);
+    }
+
+    inline void append(const PersistentVector<T>& other)
+    {
+        m_tree.append(other.m_tree);
+    }
+
+    inline void clear()
+    {
+        m_tree.clear();
+    }
+
+    inline PersistentVector<T> persistent() const
+    {
+        return PersistentVector<T>(m_tree);
+    }
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(&m_tree, 0);
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator(&m_tree, size());
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "TransientVector<" << type_name<T>() << "> with "
+             << size() << " elements:" << std::endl << "<<";
+        as::IterableStringifier<TransientVector, T> iter_stringifier;
+        sstr << iter_stringifier(*this, verbosity) << ">>";
+        return sstr.str();
+    }
+};
+
+template <typename T>
+inline TransientVector<T> PersistentVector<T>::transient() const
+{
+    return TransientVector<T>(*this);
+}
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_PERSISTENT_VECTOR_HPP_ */
+
+//
+// PersistentVector.hpp ends here
@@ -43,6 +43,8 @@
 #include <utility>
 
 #include "MultiWayHeap.hpp"
+#include "IndexedHeap.hpp"
+#include "RadixHeap.hpp"
 #include "../comparisons/Comparators.hpp"
 
 namespace aurum {
@@ -70,9 +72,7 @@ public:
     inline PriorityQueue(const InputIterator& first, const InputIterator& last)
         : PriorityQueue()
     {
-        for (auto it = first; it != last; ++it) {
-            m_heap.insert(*it);
-        }
+        m_heap.heapify(first, last);
     }
 
     inline PriorityQueue(PriorityQueue&& other)
@@ -101,7 +101,9 @@ public:
         return m_heap.get_min();
     }
 
-    inline void push(const T& value)
+    // returns whatever the heap returns on insertion,
+    // i.e., a handle for indexed heaps and nothing otherwise
+    inline decltype(auto) push(const T& value)
     {
         return m_heap.insert(value);
     }
@@ -115,8 +117,56 @@ public:
     {
         std::swap(m_heap, other.m_heap);
     }
+
+    // the following are only available when the underlying
+    // heap hands out handles, see IndexedHeap.hpp
+
+    template <typename H = HeapType>
+    inline typename H::HandleType top_handle() const
+    {
+        return m_heap.get_min_handle();
+    }
+
+    template <typename H = HeapType>
+    inline bool contains(typename H::HandleType handle) const
+    {
+        return m_heap.contains(handle);
+    }
+
+    template <typename H = HeapType>
+    inline const T& get_value(typename H::HandleType handle) const
+    {
+        return m_heap.get_value(handle);
+    }
+
+    template <typename H = HeapType>
+    inline void decrease_key(typename H::HandleType handle, const T& new_value)
+    {
+        m_heap.decrease_key(handle, new_value);
+    }
+
+    template <typename H = HeapType>
+    inline void increase_key(typename H::HandleType handle, const T& new_value)
+    {
+        m_heap.increase_key(handle, new_value);
+    }
+
+    template <typename H = HeapType>
+    inline void update_key(typename H::HandleType handle, const T& new_value)
+    {
+        m_heap.update_key(handle, new_value);
+    }
+
+    template <typename H = HeapType>
+    inline void erase(typename H::HandleType handle)
+    {
+        m_heap.erase(handle);
+    }
 };
 
+template <typename T, typename Comparator = acmp::Lesser<T> >
+using IndexedPriorityQueue = PriorityQueue<T, Comparator, IndexedQuaternaryHeap<T, Comparator> >;
+
 namespace priority_queue_detail_ {
 
 template <typename Key, typename Value, typename Comparator = std::less<Key> >
@@ -158,6 +208,20 @@ template <typename Value>
 using doublePriorityQueue = PriorityQueue<std::pair<double, Value>,
                                           priority_queue_detail_::PairComparator<double, Value> >;
 
+// monotone priority queues on integral keys, see RadixHeap.hpp
+template <typename T>
+using RadixPriorityQueue = PriorityQueue<T, acmp::Lesser<T>, RadixHeap<T> >;
+
+template <typename Value>
+using u32RadixPriorityQueue = PriorityQueue<std::pair<u32, Value>,
+                                            priority_queue_detail_::PairComparator<u32, Value>,
+                                            PairRadixHeap<u32, Value> >;
+
+template <typename Value>
+using u64RadixPriorityQueue = PriorityQueue<std::pair<u64, Value>,
+                                            priority_queue_detail_::PairComparator<u64, Value>,
+                                            PairRadixHeap<u64, Value> >;
+
 
 } /* end namespace aurum */
 } /* end namespace containers */
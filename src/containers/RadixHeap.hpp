@@ -0,0 +1,305 @@
+// RadixHeap.hpp ---
+//
+// Filename: RadixHeap.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:21:27 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_RADIX_HEAP_HPP_
+#define AURUM_CONTAINERS_RADIX_HEAP_HPP_
+
+#include <type_traits>
+#include <utility>
+
+#include "../basetypes/AurumErrors.hpp"
+#include "Vector.hpp"
+
+namespace aurum {
+namespace containers {
+namespace radix_heap_detail_ {
+
+namespace acd = aurum::containers::radix_heap_detail_;
+
+// maps an integral key onto an unsigned key with the same ordering
+template <typename KeyType>
+static inline typename std::make_unsigned<KeyType>::type to_radix_key(KeyType key)
+{
+    typedef typename std::make_unsigned<KeyType>::type UnsignedKeyType;
+    if (std::is_signed<KeyType>::value) {
+        return (static_cast<UnsignedKeyType>(key) ^
+                (static_cast<UnsignedKeyType>(1) << ((sizeof(KeyType) * 8) - 1)));
+    } else {
+        return static_cast<UnsignedKeyType>(key);
+    }
+}
+
+// key extractors: the heap is ordered on the (integral) key
+// that the extractor pulls out of each element
+
+template <typename T>
+class IdentityKey
+{
+public:
+    typedef typename std::make_unsigned<T>::type KeyType;
+
+    inline KeyType operator () (const T& value) const
+    {
+        return to_radix_key(value);
+    }
+};
+
+template <typename Key, typename Value>
+class PairFirstKey
+{
+public:
+    typedef typename std::make_unsigned<Key>::type KeyType;
+
+    inline KeyType operator () (const std::pair<Key, Value>& value) const
+    {
+        return to_radix_key(value.first);
+    }
+};
+
+// A radix heap, i.e., a monotone priority queue on integral keys.
+// Keys inserted into a non-empty heap must not be less than the key
+// of the most recent minimum obtained from the heap (via get_min() or
+// delete_min()), which is the case for event queues keyed on time
+// and for Dijkstra's algorithm with non-negative integer weights.
+// In exchange, insertion is O(1), and delete_min() is O(log C)
+// amortized, where C is the range of the keys, with no comparisons
+// between elements on insertion at all.
+//
+// Element e lives in bucket 0 if its key equals the last minimum,
+// and in bucket i if the most significant bit in which the keys
+// differ is bit (i - 1). When bucket 0 runs dry, the smallest non
+// empty bucket is split, and each of its elements moves to a lower
+// bucket, which can happen at most (number of key bits) times.
+template <typename T, typename KeyExtractor>
+class RadixHeap : public AurumObject<acd::RadixHeap<T, KeyExtractor> >
+{
+public:
+    typedef typename KeyExtractor::KeyType KeyType;
+
+private:
+    static_assert(std::is_unsigned<KeyType>::value,
+                  "Radix heaps can only be ordered on unsigned keys");
+    static constexpr u32 sc_num_key_bits = sizeof(KeyType) * 8;
+    static constexpr u32 sc_num_buckets = sc_num_key_bits + 1;
+
+    // mutable, because the minimum is only pinned down lazily,
+    // when it is asked for
+    mutable Vector<T> m_buckets[sc_num_buckets];
+    // bit (i - 1) is set iff bucket i is non-empty, for i > 0
+    mutable u64 m_occupancy;
+    mutable KeyType m_last;
+    u64 m_size;
+
+    inline u32 get_bucket_index(KeyType key) const __attribute__ ((__always_inline__))
+    {
+        const u64 diff = static_cast<u64>(key ^ m_last);
+        return (diff == 0 ? 0 : (64 - __builtin_clzll(diff)));
+    }
+
+    inline void add_to_bucket(T&& value, KeyType key) const
+    {
+        auto const bucket_index = get_bucket_index(key);
+        m_buckets[bucket_index].push_back(std::move(value));
+        if (bucket_index != 0) {
+            m_occupancy |= (1ull << (bucket_index - 1));
+        }
+    }
+
+    // refills bucket 0, if it is empty and the heap is not
+    inline void pull() const
+    {
+        if (m_buckets[0].size() > 0 || m_occupancy == 0) {
+            return;
+        }
+
+        KeyExtractor key_extractor;
+        const u32 bucket_index = __builtin_ctzll(m_occupancy) + 1;
+        auto& bucket = m_buckets[bucket_index];
+        m_occupancy &= ~(1ull << (bucket_index - 1));
+
+        KeyType new_last = key_extractor(bucket[0]);
+        for (u64 i = 1, last = bucket.size(); i < last; ++i) {
+            new_last = std::min(new_last, key_extractor(bucket[i]));
+        }
+        m_last = new_last;
+
+        // every element now differs from m_last in a lower bit
+        // than bucket_index - 1, so it moves to a lower bucket
+        while (bucket.size() > 0) {
+            T value = std::move(bucket.back());
+            bucket.pop_back();
+            auto const key = key_extractor(value);
+            add_to_bucket(std::move(value), key);
+        }
+    }
+
+public:
+    inline RadixHeap()
+        : m_occupancy(0), m_last(0), m_size(0)
+    {
+        // Nothing here
+    }
+
+    inline RadixHeap(const RadixHeap& other)
+        : m_occupancy(other.m_occupancy), m_last(other.m_last), m_size(other.m_size)
+    {
+        for (u32 i = 0; i < sc_num_buckets; ++i) {
+            m_buckets[i] = other.m_buckets[i];
+        }
+    }
+
+    inline RadixHeap(RadixHeap&& other)
+        : RadixHeap()
+    {
+        for (u32 i = 0; i < sc_num_buckets; ++i) {
+            std::swap(m_buckets[i], other.m_buckets[i]);
+        }
+        std::swap(m_occupancy, other.m_occupancy);
+        std::swap(m_last, other.m_last);
+        std::swap(m_size, other.m_size);
+    }
+
+    inline ~RadixHeap()
+    {
+        // Nothing here
+    }
+
+    inline RadixHeap& operator = (const RadixHeap& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        for (u32 i = 0; i < sc_num_buckets; ++i) {
+            m_buckets[i] = other.m_buckets[i];
+        }
+        m_occupancy = other.m_occupancy;
+        m_last = other.m_last;
+        m_size = other.m_size;
+        return *this;
+    }
+
+    inline RadixHeap& operator = (RadixHeap&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        for (u32 i = 0; i < sc_num_buckets; ++i) {
+            std::swap(m_buckets[i], other.m_buckets[i]);
+        }
+        std::swap(m_occupancy, other.m_occupancy);
+        std::swap(m_last, other.m_last);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+
+    inline u64 get_size() const
+    {
+        return m_size;
+    }
+
+    inline const T& get_min() const
+    {
+        pull();
+        return m_buckets[0].back();
+    }
+
+    inline void delete_min()
+    {
+        pull();
+        m_buckets[0].pop_back();
+        --m_size;
+    }
+
+    inline void insert(const T& new_elem)
+    {
+        KeyExtractor key_extractor;
+        auto const key = key_extractor(new_elem);
+        if (m_size == 0) {
+            // nothing to be consistent with, start afresh
+            m_last = 0;
+        }
+        AURUM_ASSERT_WITH_MSG(key >= m_last, "Keys inserted into a radix heap must not be "
+                              "less than the last minimum obtained from it");
+        T value = new_elem;
+        add_to_bucket(std::move(value), key);
+        ++m_size;
+    }
+
+    template <typename InputIterator>
+    inline void heapify(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            insert(*it);
+        }
+    }
+
+    // the last minimum, which is a lower bound on the keys
+    // which can be inserted into the heap
+    inline KeyType get_last_key() const
+    {
+        return m_last;
+    }
+
+    inline void clear()
+    {
+        for (u32 i = 0; i < sc_num_buckets; ++i) {
+            m_buckets[i].clear();
+        }
+        m_occupancy = 0;
+        m_last = 0;
+        m_size = 0;
+    }
+};
+
+} /* end namespace radix_heap_detail_ */
+
+template <typename T, typename KeyExtractor = radix_heap_detail_::IdentityKey<T> >
+using RadixHeap = radix_heap_detail_::RadixHeap<T, KeyExtractor>;
+
+template <typename Key, typename Value>
+using PairRadixHeap = radix_heap_detail_::RadixHeap<std::pair<Key, Value>,
+                                                    radix_heap_detail_::PairFirstKey<Key, Value> >;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_RADIX_HEAP_HPP_ */
+
+//
+// RadixHeap.hpp ends here
@@ -0,0 +1,476 @@
+// RankSelectBitVector.cpp ---
+//
+// Filename: RankSelectBitVector.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:40:07 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include <sstream>
+#include <algorithm>
+#include <utility>
+
+#include "../basetypes/AurumErrors.hpp"
+#include "../io/AurumIOException.hpp"
+
+#include "RankSelectBitVector.hpp"
+#include "BitSetKernels.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace bsd = aurum::containers::bit_set_detail_;
+namespace aio = aurum::io;
+
+namespace rank_select_detail_ {
+
+// "RSBV" followed by a format version
+static constexpr u64 sc_image_magic = 0x0000000156425352ull;
+
+// layout of the header, in words
+static constexpr u64 sc_magic_index = 0;
+static constexpr u64 sc_num_bits_index = 1;
+static constexpr u64 sc_num_ones_index = 2;
+static constexpr u64 sc_num_words_index = 3;
+static constexpr u64 sc_num_l0_index = 4;
+static constexpr u64 sc_num_l1_index = 5;
+static constexpr u64 sc_num_samples_index = 6;
+static constexpr u64 sc_header_size = 8;
+
+static constexpr u64 sc_bits_per_l0 = (1ull << 32);
+static constexpr u64 sc_bits_per_l1 = 2048;
+static constexpr u64 sc_words_per_l1 = sc_bits_per_l1 / 64;
+static constexpr u64 sc_bits_per_l2 = 512;
+static constexpr u64 sc_words_per_l2 = sc_bits_per_l2 / 64;
+static constexpr u64 sc_l1_per_l0 = sc_bits_per_l0 / sc_bits_per_l1;
+static constexpr u64 sc_ones_per_sample = 8192;
+// bounds the number of bits in a header, so that
+// the image size computed from it cannot overflow
+static constexpr u64 sc_max_num_bits = (1ull << 62);
+// words reserved up front when reading an image from a stream
+static constexpr u64 sc_max_words_reserved = (1ull << 16);
+
+static inline u64 get_num_words(u64 num_bits)
+{
+    return ((num_bits + 63) / 64);
+}
+
+static inline u64 get_num_l0(u64 num_bits)
+{
+    return ((num_bits / sc_bits_per_l0) + 1);
+}
+
+// one more than strictly needed, so that rank1(size()) needs no
+// special casing
+static inline u64 get_num_l1(u64 num_bits)
+{
+    return ((num_bits / sc_bits_per_l1) + 1);
+}
+
+static inline u64 get_num_samples(u64 num_ones)
+{
+    return ((num_ones + sc_ones_per_sample - 1) / sc_ones_per_sample);
+}
+
+static inline u64 get_image_size(u64 num_bits, u64 num_ones)
+{
+    return (sc_header_size + get_num_words(num_bits) + get_num_l0(num_bits) +
+            get_num_l1(num_bits) + get_num_samples(num_ones));
+}
+
+static inline u64 get_l2_count(u64 l1_entry, u64 index)
+{
+    return ((l1_entry >> (32 + (10 * index))) & 0x3FF);
+}
+
+// checks the header of an image of image_size words,
+// throws if it is inconsistent
+static inline void validate_header(const u64* header, u64 image_size)
+{
+    if (image_size < sc_header_size || header[sc_magic_index] != sc_image_magic) {
+        throw aio::AurumIOException("Not a serialized RankSelectBitVector");
+    }
+    const u64 num_bits = header[sc_num_bits_index];
+    const u64 num_ones = header[sc_num_ones_index];
+    if (num_bits > sc_max_num_bits || num_ones > num_bits ||
+        header[sc_num_words_index] != get_num_words(num_bits) ||
+        header[sc_num_l0_index] != get_num_l0(num_bits) ||
+        header[sc_num_l1_index] != get_num_l1(num_bits) ||
+        header[sc_num_samples_index] != get_num_samples(num_ones) ||
+        get_image_size(num_bits, num_ones) != image_size) {
+        throw aio::AurumIOException("Inconsistent header in serialized RankSelectBitVector");
+    }
+}
+
+} /* end namespace rank_select_detail_ */
+
+namespace rsd = aurum::containers::rank_select_detail_;
+
+RankSelectBitVector::RankSelectBitVector()
+    : m_storage(), m_image(nullptr)
+{
+    build(nullptr, 0);
+}
+
+RankSelectBitVector::RankSelectBitVector(const BitSet& bit_set)
+    : m_storage(), m_image(nullptr)
+{
+    build(bit_set.get_words(), bit_set.size());
+}
+
+RankSelectBitVector::RankSelectBitVector(const RankSelectBitVector& other)
+    : m_storage(other.m_storage), m_image(nullptr)
+{
+    attach(m_storage.size() > 0 ? m_storage.data() : other.m_image);
+}
+
+RankSelectBitVector::RankSelectBitVector(RankSelectBitVector&& other)
+    : m_storage(), m_image(nullptr)
+{
+    *this = std::move(other);
+}
+
+RankSelectBitVector::~RankSelectBitVector()
+{
+    // Nothing here
+}
+
+RankSelectBitVector& RankSelectBitVector::operator = (const RankSelectBitVector& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    m_storage = other.m_storage;
+    attach(m_storage.size() > 0 ? m_storage.data() : other.m_image);
+    return *this;
+}
+
+RankSelectBitVector& RankSelectBitVector::operator = (RankSelectBitVector&& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    std::swap(m_storage, other.m_storage);
+    attach(m_storage.size() > 0 ? m_storage.data() : other.m_image);
+    // other may now point into our storage
+    other.m_storage.clear();
+    other.build(nullptr, 0);
+    return *this;
+}
+
+void RankSelectBitVector::build(const u64* words, u64 num_bits)
+{
+    const u64 num_words = rsd::get_num_words(num_bits);
+    const u64 num_ones = bsd::popcount_words(words, num_words);
+    const u64 num_l0 = rsd::get_num_l0(num_bits);
+    const u64 num_l1 = rsd::get_num_l1(num_bits);
+    const u64 num_samples = rsd::get_num_samples(num_ones);
+
+    Vector<u64> storage(rsd::get_image_size(num_bits, num_ones), 0);
+    u64* image = storage.data();
+    image[rsd::sc_magic_index] = rsd::sc_image_magic;
+    image[rsd::sc_num_bits_index] = num_bits;
+    image[rsd::sc_num_ones_index] = num_ones;
+    image[rsd::sc_num_words_index] = num_words;
+    image[rsd::sc_num_l0_index] = num_l0;
+    image[rsd::sc_num_l1_index] = num_l1;
+    image[rsd::sc_num_samples_index] = num_samples;
+
+    u64* const image_words = image + rsd::sc_header_size;
+    u64* const l0_counts = image_words + num_words;
+    u64* const l1_entries = l0_counts + num_l0;
+    u64* const samples = l1_entries + num_l1;
+
+    std::copy(words, words + num_words, image_words);
+    if (num_words > 0) {
+        image_words[num_words - 1] &= bsd::get_last_word_mask(num_bits);
+    }
+
+    u64 total = 0;
+    u64 next_sample = 0;
+    for (u64 block = 0; block < num_l1; ++block) {
+        if (block % rsd::sc_l1_per_l0 == 0) {
+            l0_counts[block / rsd::sc_l1_per_l0] = total;
+        }
+
+        u64 entry = total - l0_counts[block / rsd::sc_l1_per_l0];
+        u64 block_count = 0;
+        const u64 first_word = block * rsd::sc_words_per_l1;
+        for (u64 sub_block = 0; sub_block < 4; ++sub_block) {
+            const u64 start = std::min(num_words, first_word + (sub_block * rsd::sc_words_per_l2));
+            const u64 end = std::min(num_words, start + rsd::sc_words_per_l2);
+            const u64 count = bsd::popcount_words(image_words + start, end - start);
+            if (sub_block < 3) {
+                entry |= (count << (32 + (10 * sub_block)));
+            }
+            block_count += count;
+        }
+        l1_entries[block] = entry;
+
+        while (next_sample < num_samples &&
+               next_sample * rsd::sc_ones_per_sample < total + block_count) {
+            samples[next_sample++] = block;
+        }
+        total += block_count;
+    }
+
+    m_storage = std::move(storage);
+    attach(m_storage.data());
+}
+
+void RankSelectBitVector::attach(const u64* image)
+{
+    m_image = image;
+    m_num_bits = image[rsd::sc_num_bits_index];
+    m_num_ones = image[rsd::sc_num_ones_index];
+    m_words = image + rsd::sc_header_size;
+    m_l0_counts = m_words + image[rsd::sc_num_words_index];
+    m_l1_entries = m_l0_counts + image[rsd::sc_num_l0_index];
+    m_select_samples = m_l1_entries + image[rsd::sc_num_l1_index];
+    m_num_select_samples = image[rsd::sc_num_samples_index];
+}
+
+RankSelectBitVector RankSelectBitVector::map(const void* image, u64 size_in_bytes)
+{
+    if ((reinterpret_cast<u64>(image) % sizeof(u64)) != 0 || size_in_bytes % sizeof(u64) != 0) {
+        throw aio::AurumIOException("Misaligned RankSelectBitVector image");
+    }
+    auto const words = static_cast<const u64*>(image);
+    rsd::validate_header(words, size_in_bytes / sizeof(u64));
+
+    RankSelectBitVector retval;
+    retval.m_storage.clear();
+    retval.attach(words);
+    return retval;
+}
+
+inline u64 RankSelectBitVector::get_block_rank(u64 block) const
+{
+    return (m_l0_counts[block / rsd::sc_l1_per_l0] + (m_l1_entries[block] & 0xFFFFFFFFull));
+}
+
+u64 RankSelectBitVector::size() const
+{
+    return m_num_bits;
+}
+
+u64 RankSelectBitVector::count_ones() const
+{
+    return m_num_ones;
+}
+
+u64 RankSelectBitVector::count_zeros() const
+{
+    return (m_num_bits - m_num_ones);
+}
+
+bool RankSelectBitVector::test(u64 bit_num) const
+{
+    AURUM_ASSERT(bit_num < m_num_bits);
+    return ((m_words[bit_num / 64] & (1ull << (bit_num % 64))) != 0);
+}
+
+bool RankSelectBitVector::operator [] (u64 bit_num) const
+{
+    return test(bit_num);
+}
+
+u64 RankSelectBitVector::rank1(u64 bit_num) const
+{
+    AURUM_ASSERT(bit_num <= m_num_bits);
+
+    const u64 block = bit_num / rsd::sc_bits_per_l1;
+    const u64 entry = m_l1_entries[block];
+    u64 retval = get_block_rank(block);
+
+    const u64 sub_block = (bit_num % rsd::sc_bits_per_l1) / rsd::sc_bits_per_l2;
+    for (u64 i = 0; i < sub_block; ++i) {
+        retval += rsd::get_l2_count(entry, i);
+    }
+
+    // at most seven whole words and a partial one
+    const u64 last_word = bit_num / 64;
+    for (u64 i = bit_num / rsd::sc_bits_per_l2 * rsd::sc_words_per_l2; i < last_word; ++i) {
+        retval += __builtin_popcountll(m_words[i]);
+    }
+    if (bit_num % 64 != 0) {
+        retval += __builtin_popcountll(m_words[last_word] & ((1ull << (bit_num % 64)) - 1));
+    }
+    return retval;
+}
+
+u64 RankSelectBitVector::rank0(u64 bit_num) const
+{
+    return (bit_num - rank1(bit_num));
+}
+
+u64 RankSelectBitVector::select1(u64 rank) const
+{
+    AURUM_ASSERT(rank < m_num_ones);
+
+    // the samples bound the blocks that can hold the one,
+    // binary search for the last block starting at or before it
+    const u64 sample = rank / rsd::sc_ones_per_sample;
+    u64 low = m_select_samples[sample];
+    u64 high = (sample + 1 < m_num_select_samples ?
+                m_select_samples[sample + 1] : m_num_bits / rsd::sc_bits_per_l1);
+    while (low < high) {
+        const u64 mid = low + ((high - low + 1) / 2);
+        if (get_block_rank(mid) <= rank) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+
+    const u64 block = low;
+    const u64 entry = m_l1_entries[block];
+    rank -= get_block_rank(block);
+
+    u64 sub_block = 0;
+    for (; sub_block < 3; ++sub_block) {
+        const u64 count = rsd::get_l2_count(entry, sub_block);
+        if (rank < count) {
+            break;
+        }
+        rank -= count;
+    }
+
+    for (u64 i = (block * rsd::sc_words_per_l1) + (sub_block * rsd::sc_words_per_l2); ; ++i) {
+        const u64 count = __builtin_popcountll(m_words[i]);
+        if (rank < count) {
+            return ((i * 64) + bsd::select_in_word(m_words[i], rank));
+        }
+        rank -= count;
+    }
+}
+
+const void* RankSelectBitVector::get_image() const
+{
+    return m_image;
+}
+
+u64 RankSelectBitVector::get_image_size_in_bytes() const
+{
+    return (rsd::get_image_size(m_num_bits, m_num_ones) * sizeof(u64));
+}
+
+u64 RankSelectBitVector::get_overhead_in_bytes() const
+{
+    return (get_image_size_in_bytes() - (rsd::get_num_words(m_num_bits) * sizeof(u64)));
+}
+
+void RankSelectBitVector::serialize(std::ostream& out_stream) const
+{
+    // the image is written out little endian word by word, which
+    // is byte for byte the in memory image on little endian hosts
+    const u64 image_size = rsd::get_image_size(m_num_bits, m_num_ones);
+    char buffer[sizeof(u64)];
+    for (u64 i = 0; i < image_size; ++i) {
+        for (u32 j = 0; j < sizeof(u64); ++j) {
+            buffer[j] = static_cast<char>(m_image[i] >> (8 * j));
+        }
+        out_stream.write(buffer, sizeof(u64));
+    }
+}
+
+static inline u64 read_word(std::istream& in_stream)
+{
+    unsigned char buffer[sizeof(u64)];
+    in_stream.read(reinterpret_cast<char*>(buffer), sizeof(u64));
+    if (!in_stream) {
+        throw aio::AurumIOException("Unexpected end of stream while reading "
+                                    "a RankSelectBitVector");
+    }
+    u64 retval = 0;
+    for (u32 i = 0; i < sizeof(u64); ++i) {
+        retval |= (static_cast<u64>(buffer[i]) << (8 * i));
+    }
+    return retval;
+}
+
+void RankSelectBitVector::deserialize(std::istream& in_stream)
+{
+    u64 header[rsd::sc_header_size];
+    for (u64 i = 0; i < rsd::sc_header_size; ++i) {
+        header[i] = read_word(in_stream);
+    }
+    if (header[rsd::sc_magic_index] != rsd::sc_image_magic) {
+        throw aio::AurumIOException("Not a serialized RankSelectBitVector");
+    }
+    if (header[rsd::sc_num_bits_index] > rsd::sc_max_num_bits ||
+        header[rsd::sc_num_ones_index] > header[rsd::sc_num_bits_index]) {
+        throw aio::AurumIOException("Inconsistent header in serialized RankSelectBitVector");
+    }
+    const u64 image_size = rsd::get_image_size(header[rsd::sc_num_bits_index],
+                                               header[rsd::sc_num_ones_index]);
+    rsd::validate_header(header, image_size);
+
+    // a consistent header can still claim more than the stream
+    // holds, so the storage grows with the words actually read
+    Vector<u64> storage;
+    storage.reserve(std::min(image_size, rsd::sc_header_size + rsd::sc_max_words_reserved));
+    for (u64 i = 0; i < image_size; ++i) {
+        storage.push_back(i < rsd::sc_header_size ? header[i] : read_word(in_stream));
+    }
+
+    m_storage = std::move(storage);
+    attach(m_storage.data());
+}
+
+std::string RankSelectBitVector::as_string(i64 verbosity) const
+{
+    std::ostringstream sstr;
+    sstr << "RankSelectBitVector with " << m_num_bits << " bits, "
+         << m_num_ones << " ones";
+    if (verbosity > 0) {
+        sstr << ": {";
+        bool first = true;
+        for (u64 i = 0; i < m_num_ones; ++i) {
+            if (!first) {
+                sstr << ", ";
+            }
+            first = false;
+            sstr << select1(i);
+        }
+        sstr << "}";
+    }
+    return sstr.str();
+}
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+//
+// RankSelectBitVector.cpp ends here
@@ -0,0 +1,144 @@
+// RankSelectBitVector.hpp ---
+//
+// Filename: RankSelectBitVector.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:40:07 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_RANK_SELECT_BIT_VECTOR_HPP_
+#define AURUM_CONTAINERS_RANK_SELECT_BIT_VECTOR_HPP_
+
+#include <istream>
+#include <ostream>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+
+#include "Vector.hpp"
+#include "BitSet.hpp"
+
+namespace aurum {
+namespace containers {
+
+// An immutable bit vector with constant time rank and near constant
+// time select, using a poppy style directory, which costs about 3%
+// on top of the bits themselves:
+// - an absolute count of the ones before every 2^32 bits (L0),
+// - one word for every 2048 bits, holding the count of ones
+//   since the enclosing L0 boundary in its lower 32 bits, and the
+//   counts of the first three 512 bit sub-blocks in three 10 bit
+//   fields above that (L1/L2),
+// - the index of the 2048 bit block holding every 8192nd one,
+//   which bounds the search done by select.
+//
+// All of this lives in a single array of u64 words, whose layout
+// is also the serialized format:
+//   header (magic, number of bits, number of ones, and the sizes of
+//   each of the sections), bits, L0, L1/L2, select samples
+// So a serialized bit vector can be memory mapped and used in place
+// via map(), on a little endian host.
+class RankSelectBitVector final : public AurumObject<RankSelectBitVector>,
+                                  public Stringifiable<RankSelectBitVector>
+{
+private:
+    // owns the image, unless this is a view of an external one
+    Vector<u64> m_storage;
+    const u64* m_image;
+
+    u64 m_num_bits;
+    u64 m_num_ones;
+    const u64* m_words;
+    const u64* m_l0_counts;
+    const u64* m_l1_entries;
+    const u64* m_select_samples;
+    u64 m_num_select_samples;
+
+    void build(const u64* words, u64 num_bits);
+    // sets up the section pointers from the header of image
+    void attach(const u64* image);
+    // the number of ones before the 2048 bit block
+    u64 get_block_rank(u64 block) const;
+
+public:
+    RankSelectBitVector();
+    explicit RankSelectBitVector(const BitSet& bit_set);
+    RankSelectBitVector(const RankSelectBitVector& other);
+    RankSelectBitVector(RankSelectBitVector&& other);
+    ~RankSelectBitVector();
+
+    RankSelectBitVector& operator = (const RankSelectBitVector& other);
+    RankSelectBitVector& operator = (RankSelectBitVector&& other);
+
+    // a view of a serialized image of size_in_bytes bytes, which
+    // must be 8 byte aligned and must outlive the view (and its
+    // copies). Throws an AurumIOException if the image is malformed
+    static RankSelectBitVector map(const void* image, u64 size_in_bytes);
+
+    u64 size() const;
+    u64 count_ones() const;
+    u64 count_zeros() const;
+
+    bool test(u64 bit_num) const;
+    bool operator [] (u64 bit_num) const;
+
+    // the number of ones (resp. zeros) in [0, bit_num),
+    // for bit_num in [0, size()]
+    u64 rank1(u64 bit_num) const;
+    u64 rank0(u64 bit_num) const;
+    // the position of the one with the given rank (zero based),
+    // rank must be less than count_ones()
+    u64 select1(u64 rank) const;
+
+    // the serialized image, which is what gets mapped by map()
+    const void* get_image() const;
+    u64 get_image_size_in_bytes() const;
+    // space used by the directory and samples, over and above the bits
+    u64 get_overhead_in_bytes() const;
+
+    void serialize(std::ostream& out_stream) const;
+    // replaces the contents of this bit vector, throws an
+    // AurumIOException on malformed or truncated input
+    void deserialize(std::istream& in_stream);
+
+    std::string as_string(i64 verbosity) const;
+};
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_RANK_SELECT_BIT_VECTOR_HPP_ */
+
+//
+// RankSelectBitVector.hpp ends here
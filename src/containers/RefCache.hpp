@@ -40,68 +40,600 @@
 #if !defined AURUM_CONTAINERS_REF_CACHE_HPP_
 #define AURUM_CONTAINERS_REF_CACHE_HPP_
 
+#include <tuple>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <utility>
+#include <type_traits>
+
+#include <AurumConfig.h>
+
 #include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
 #include "../basetypes/EComparable.hpp"
 #include "../basetypes/Hashable.hpp"
 #include "../basetypes/RefCountable.hpp"
 #include "../memory/ManagedPointer.hpp"
 #include "../allocators/MemoryManager.hpp"
+#include "../allocators/SmallBlockAllocator.hpp"
 #include "../hashing/Hashers.hpp"
 #include "../comparisons/Comparators.hpp"
 
 #include "HashTable.hpp"
+#include "Vector.hpp"
 
 namespace aurum {
 namespace containers {
+
+// Counters for tuning a RefCache. The counters are all zero unless
+// the cache gathers statistics (see the STATISTICS parameter of
+// RefCache), the size and capacity are always filled in
+struct RefCacheStatistics : public Stringifiable<RefCacheStatistics>
+{
+    // calls to get() which found an existing object
+    u64 m_hits;
+    // calls to get() which inserted a new object
+    u64 m_misses;
+    u64 m_objects_constructed;
+    // objects constructed only to find an equal object in the
+    // cache, for types that cannot be looked up by their
+    // construction arguments
+    u64 m_objects_discarded;
+    // incremental collections, one per get() which had work to do
+    u64 m_gc_steps;
+    // calls to garbage_collect()
+    u64 m_full_gcs;
+    u64 m_objects_collected;
+    // time spent collecting, in both kinds of collections
+    double m_gc_seconds;
+    // the number of objects in, and the capacity of, the table
+    u64 m_size;
+    u64 m_capacity;
+
+    inline RefCacheStatistics()
+        : m_hits(0), m_misses(0), m_objects_constructed(0), m_objects_discarded(0),
+          m_gc_steps(0), m_full_gcs(0), m_objects_collected(0), m_gc_seconds(0.0),
+          m_size(0), m_capacity(0)
+    {
+        // Nothing here
+    }
+
+    inline double get_hit_ratio() const
+    {
+        const u64 lookups = m_hits + m_misses;
+        return (lookups == 0 ? 0.0 : (double)m_hits / lookups);
+    }
+
+    inline double get_load_factor() const
+    {
+        return (m_capacity == 0 ? 0.0 : (double)m_size / m_capacity);
+    }
+
+    inline double get_objects_collected_per_gc() const
+    {
+        const u64 num_gcs = m_gc_steps + m_full_gcs;
+        return (num_gcs == 0 ? 0.0 : (double)m_objects_collected / num_gcs);
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "RefCacheStatistics { hits: " << m_hits << ", misses: " << m_misses
+             << ", hit ratio: " << get_hit_ratio()
+             << ", size: " << m_size << ", capacity: " << m_capacity
+             << ", load factor: " << get_load_factor();
+        if (verbosity > 0) {
+            sstr << ", objects constructed: " << m_objects_constructed
+                 << ", objects discarded: " << m_objects_discarded
+                 << ", gc steps: " << m_gc_steps << ", full gcs: " << m_full_gcs
+                 << ", objects collected: " << m_objects_collected
+                 << ", objects collected per gc: " << get_objects_collected_per_gc()
+                 << ", gc time: " << m_gc_seconds << "s";
+        }
+        sstr << " }";
+        return sstr.str();
+    }
+};
+
 namespace ref_cache_detail_ {
 
 namespace ac = aurum::containers;
 namespace am = aurum::memory;
 namespace aa = aurum::allocators;
 
+template <typename T>
+using DefaultHashFunction = aurum::hashing::DeepHasher<const T*, 1>;
+template <typename T>
+using DefaultEqualsFunction = aurum::comparisons::DeepEqualTo<const T*, 1>;
+
+// The arguments that an object of type U would be constructed
+// from, used to probe the cache without constructing the object.
+// U opts into this by providing
+//   static u64 compute_hash_value_for(const ArgTypes&... args);
+//   static bool equal_to_args(const T& object, const ArgTypes&... args);
+// where the former returns what compute_hash_value() would return on
+// U(args...), and the latter is true iff object equals U(args...)
+template <typename T, typename U, typename... ArgTypes>
+class ConstructionKey
+{
+private:
+    std::tuple<const ArgTypes&...> m_args;
+    u64 m_hash_value;
+
+    template <std::size_t... INDICES>
+    inline u64 compute_hash_value(std::index_sequence<INDICES...> unused) const
+    {
+        return U::get_hash_value_for(U::compute_hash_value_for(std::get<INDICES>(m_args)...));
+    }
+
+    template <std::size_t... INDICES>
+    inline bool equal_to(const T& object, std::index_sequence<INDICES...> unused) const
+    {
+        return U::equal_to_args(object, std::get<INDICES>(m_args)...);
+    }
+
+public:
+    explicit inline ConstructionKey(const ArgTypes&... args)
+        : m_args(args...),
+          m_hash_value(compute_hash_value(std::index_sequence_for<ArgTypes...>()))
+    {
+        // Nothing here
+    }
+
+    inline u64 get_hash_value() const
+    {
+        return m_hash_value;
+    }
+
+    inline bool matches(const T& object) const
+    {
+        return equal_to(object, std::index_sequence_for<ArgTypes...>());
+    }
+};
+
+// true_type iff U can be looked up by the construction arguments
+template <typename T, typename U, typename... ArgTypes>
+class HasConstructionKey
+{
+private:
+    template <typename V>
+    static auto test(int unused)
+        -> decltype((void)V::compute_hash_value_for(std::declval<const ArgTypes&>()...),
+                    (void)V::equal_to_args(std::declval<const T&>(),
+                                           std::declval<const ArgTypes&>()...),
+                    std::true_type());
+
+    template <typename V>
+    static std::false_type test(...);
+
+public:
+    typedef decltype(test<U>(0)) type;
+};
+
+// true_type iff T can enumerate the cached objects it holds references
+// to, by providing
+//   template <typename FuncType> void for_each_cached_child(FuncType&& func) const;
+// which calls func(const T*) on each of them
+template <typename T>
+class HasCachedChildren
+{
+private:
+    template <typename V>
+    static auto test(int unused)
+        -> decltype(std::declval<const V&>().for_each_cached_child(std::declval<void (*)(const V*)>()),
+                    std::true_type());
+
+    template <typename V>
+    static std::false_type test(...);
+
+public:
+    typedef decltype(test<T>(0)) type;
+};
+
+// true_type iff T can be constructed in a RefCountableStorage
+template <typename T>
+class CanUseStorage
+{
+private:
+    template <typename V>
+    static auto test(int unused)
+        -> decltype(std::declval<const V&>().set_in_storage_(), std::true_type());
+
+    template <typename V>
+    static std::false_type test(...);
+
+public:
+    typedef decltype(test<T>(0)) type;
+};
+
+// Pooled storage for the objects of a RefCache: objects are carved
+// out of the chunks of a small block allocator, and go back to it
+// when they die. The storage outlives the cache if objects created
+// in it do, and destroys itself when the last of them dies
+class PooledStorage final : public RefCountableStorage
+{
+private:
+    aa::SmallBlockAllocator m_allocator;
+    u64 m_num_blocks;
+    bool m_owner_released;
+
+    inline void destroy()
+    {
+        aa::deallocate_object_raw(this, sizeof(PooledStorage));
+    }
+
+public:
+    inline PooledStorage()
+        : m_allocator(), m_num_blocks(0), m_owner_released(false)
+    {
+        // Nothing here
+    }
+
+    virtual ~PooledStorage()
+    {
+        // Nothing here
+    }
+
+    inline void* allocate_block(u64 block_size)
+    {
+        auto retval = m_allocator.allocate(block_size);
+        ++m_num_blocks;
+        return retval;
+    }
+
+    virtual void release_block(void* block, u64 block_size) override
+    {
+        m_allocator.deallocate(block, block_size);
+        --m_num_blocks;
+        if (m_owner_released && m_num_blocks == 0) {
+            destroy();
+        }
+    }
+
+    // called by the cache when it goes away
+    inline void release_owner()
+    {
+        m_owner_released = true;
+        if (m_num_blocks == 0) {
+            destroy();
+        } else {
+            m_allocator.garbage_collect();
+        }
+    }
+
+    // returns chunks that hold no live objects to the memory manager
+    inline void garbage_collect()
+    {
+        m_allocator.garbage_collect();
+    }
+
+    inline u64 get_bytes_claimed() const
+    {
+        return m_allocator.get_bytes_claimed();
+    }
+};
+
+// caches gather statistics by default only when configured
+// with AURUM_CFG_STATISTICS_ENABLED_
+#if defined AURUM_CFG_STATISTICS_ENABLED_
+static constexpr bool sc_default_statistics = true;
+#else /* !AURUM_CFG_STATISTICS_ENABLED_ */
+static constexpr bool sc_default_statistics = false;
+#endif /* AURUM_CFG_STATISTICS_ENABLED_ */
+
+// adds the time from its construction to its destruction
+// to the collection time in the statistics
+template <bool ENABLED>
+class GCTimer
+{
+private:
+    RefCacheStatistics& m_statistics;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    explicit inline GCTimer(RefCacheStatistics& statistics)
+        : m_statistics(statistics), m_start(std::chrono::steady_clock::now())
+    {
+        // Nothing here
+    }
+
+    inline ~GCTimer()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_statistics.m_gc_seconds += std::chrono::duration<double>(elapsed).count();
+    }
+};
+
+template <>
+class GCTimer<false>
+{
+public:
+    explicit inline GCTimer(RefCacheStatistics& statistics)
+    {
+        // Nothing here
+    }
+};
+
+// hashes the pointers in the cache with the hash function of the
+// cache, and construction keys with their precomputed hash values
+template <typename T, typename HashFunction>
+class KeyHasher
+{
+public:
+    inline u64 operator () (const T* const& object) const
+    {
+        HashFunction hash_fun;
+        return hash_fun(object);
+    }
+
+    template <typename U, typename... ArgTypes>
+    inline u64 operator () (const ConstructionKey<T, U, ArgTypes...>& key) const
+    {
+        return key.get_hash_value();
+    }
+};
+
 template <typename T, typename HashFunction, typename EqualsFunction>
+class KeyEqualTo
+{
+public:
+    inline bool operator () (const T* const& object1, const T* const& object2) const
+    {
+        EqualsFunction equals_fun;
+        return equals_fun(object1, object2);
+    }
+
+    template <typename U, typename... ArgTypes>
+    inline bool operator () (const T* const& object,
+                             const ConstructionKey<T, U, ArgTypes...>& key) const
+    {
+        HashFunction hash_fun;
+        return (hash_fun(object) == key.get_hash_value() && key.matches(*object));
+    }
+};
+
+// STATISTICS selects whether the cache gathers statistics, which
+// costs a few increments per call to get(), see RefCacheStatistics
+template <typename T, typename HashFunction, typename EqualsFunction, bool STATISTICS>
 class RefCache
-    : public AurumObject<ac::ref_cache_detail_::RefCache<T, HashFunction, EqualsFunction> >
+    : public AurumObject<ac::ref_cache_detail_::RefCache<T, HashFunction, EqualsFunction,
+                                                         STATISTICS> >
 {
     // ensure that the type is ref countable
     static_assert(IsRefCountable<T>::value,
                   "RefCaches can only be created with RefCountable types.");
 
 private:
-    RestrictedHashTable<T*, HashFunction, EqualsFunction> m_hash_table;
+    typedef KeyHasher<T, HashFunction> KeyHasherType;
+    typedef KeyEqualTo<T, HashFunction, EqualsFunction> KeyEqualToType;
+
+    // lookups by construction arguments rely on the hash and equality
+    // defined by the objects, so they are used only when the cache
+    // hashes and compares with the defaults
+    static constexpr bool sc_can_use_construction_keys =
+        (std::is_same<HashFunction, DefaultHashFunction<T> >::value &&
+         std::is_same<EqualsFunction, DefaultEqualsFunction<T> >::value);
+
+    typedef RestrictedHashTable<T*, KeyHasherType, KeyEqualToType> HashTableType;
+    typedef typename HashTableType::Iterator TableIterator;
+    typedef typename HasCachedChildren<T>::type HasChildrenType;
+    typedef typename CanUseStorage<T>::type CanUseStorageType;
+
+    // The collector is incremental: every call to get() does a bounded
+    // amount of work, over three sets of objects:
+    // 1. The worklist, which holds the children of collected objects,
+    //    if T can enumerate them (see HasCachedChildren), as these are
+    //    the objects that a collection may have left unreferenced.
+    // 2. The nursery, which holds recently created objects, oldest first.
+    //    Most objects die young, so each one is examined once, after
+    //    m_nursery_capacity more objects have been created, and is
+    //    left to the sweeps if it is still referenced.
+    // 3. A sweep over the whole table, which is started once the cache
+    //    grows past m_next_gc_limit, and proceeds a few entries per call.
+    //    Objects which a rehash moves behind the sweep are left to the
+    //    next sweep.
+    // Objects on the worklist and in the nursery hold a reference, so
+    // that they stay alive until they have been examined.
+    HashTableType m_hash_table;
+    Vector<const T*> m_worklist;
+    Vector<const T*> m_nursery;
+    u64 m_nursery_head;
+    u64 m_nursery_capacity;
+    u64 m_sweep_index;
+    bool m_sweep_active;
+    bool m_collected_in_sweep;
+    bool m_in_erase_sequence;
     u64 m_next_gc_limit;
     float m_growth_factor;
+    // the storage objects are constructed in, or nullptr
+    // if they are allocated individually
+    PooledStorage* m_storage;
+    RefCacheStatistics m_statistics;
     static constexpr float sc_default_growth_factor = 1.5f;
     static constexpr u64 sc_initial_gc_limit = 128;
+    static constexpr u64 sc_default_nursery_capacity = 256;
+    // number of objects examined per call to get()
+    static constexpr u64 sc_gc_work_per_get = 32;
 
-    inline void do_gc()
+    inline void pin_children(const T* object, std::true_type has_children)
     {
-        m_hash_table.begin_multi_erase_sequence();
+        object->for_each_cached_child([this](const T* child) -> void
+                                      {
+                                          child->inc_ref_();
+                                          m_worklist.push_back(child);
+                                      });
+    }
 
-        bool deleted_this_iteration;
+    inline void pin_children(const T* object, std::false_type has_children)
+    {
+        return;
+    }
+
+    // removes the object from the cache and deletes it
+    inline void collect(const TableIterator& position)
+    {
+        const T* object = *position;
+        if (!m_in_erase_sequence) {
+            m_hash_table.begin_multi_erase_sequence();
+            m_in_erase_sequence = true;
+        }
+        m_hash_table.erase(position);
+        if (STATISTICS) {
+            ++m_statistics.m_objects_collected;
+        }
+        // the children are pinned before the object releases them
+        pin_children(object, HasChildrenType());
+        object->dec_ref_();
+    }
 
-        do {
-            deleted_this_iteration = false;
-            for (auto it = m_hash_table.begin(), last = m_hash_table.end(); it != last; ++it) {
-                if ((*it)->get_ref_count_() == 1) {
-                    deleted_this_iteration = true;
-                    delete (*it);
-                    m_hash_table.erase(it);
-                }
+    // collects the object if the cache and the pin are the only
+    // references to it, and releases the pin
+    inline void examine(const T* candidate)
+    {
+        if (candidate->get_ref_count_() == 2) {
+            auto it = m_hash_table.find(candidate);
+            if (it != m_hash_table.end() && (*it) == candidate) {
+                collect(it);
             }
-        } while (deleted_this_iteration);
+        }
+        candidate->dec_ref_();
+    }
 
-        m_hash_table.end_multi_erase_sequence();
+    inline u64 get_nursery_size() const
+    {
+        return (m_nursery.size() - m_nursery_head);
     }
 
-    inline void try_gc()
+    inline void examine_nursery_head()
     {
-        if (m_hash_table.size() >= m_next_gc_limit) {
-            do_gc();
-            m_next_gc_limit = (u64)ceilf((float)m_hash_table.size() * m_growth_factor);
-        } else {
+        examine(m_nursery[m_nursery_head++]);
+        if (m_nursery_head == m_nursery.size()) {
+            m_nursery.clear();
+            m_nursery_head = 0;
+        } else if (m_nursery_head >= m_nursery.size() / 2 && m_nursery_head >= sc_default_nursery_capacity) {
+            m_nursery.erase(m_nursery.begin(), m_nursery.begin() + m_nursery_head);
+            m_nursery_head = 0;
+        }
+    }
+
+    inline void end_erase_sequence()
+    {
+        if (m_in_erase_sequence) {
+            m_in_erase_sequence = false;
+            m_hash_table.end_multi_erase_sequence();
+        }
+    }
+
+    inline void start_sweep()
+    {
+        m_sweep_active = true;
+        m_sweep_index = 0;
+        m_collected_in_sweep = false;
+    }
+
+    inline void finish_sweep()
+    {
+        // without a worklist, the objects released by this sweep are
+        // only found by sweeping again
+        if (m_collected_in_sweep && !HasChildrenType::value) {
+            start_sweep();
             return;
         }
+        m_sweep_active = false;
+        m_next_gc_limit = (u64)ceilf((float)m_hash_table.size() * m_growth_factor);
+    }
+
+    // examines up to work entries of the table, returns the
+    // work left over
+    inline u64 sweep_step(u64 work)
+    {
+        auto it = m_hash_table.begin_at(m_sweep_index);
+        auto last = m_hash_table.end();
+        for (; work > 0 && it != last; --work, ++it) {
+            if ((*it)->get_ref_count_() == 1) {
+                collect(it);
+                m_collected_in_sweep = true;
+            }
+        }
+        if (it == last) {
+            finish_sweep();
+        } else {
+            m_sweep_index = m_hash_table.get_index_for_entry(it.get_current());
+        }
+        return work;
+    }
+
+    inline bool has_gc_work() const
+    {
+        return (m_worklist.size() > 0 || get_nursery_size() > m_nursery_capacity ||
+                m_sweep_active || m_hash_table.size() >= m_next_gc_limit);
+    }
+
+    inline void gc_step()
+    {
+        GCTimer<STATISTICS> timer(m_statistics);
+        if (STATISTICS) {
+            ++m_statistics.m_gc_steps;
+        }
+        u64 work = sc_gc_work_per_get;
+
+        for (; work > 0 && m_worklist.size() > 0; --work) {
+            auto candidate = m_worklist.back();
+            m_worklist.pop_back();
+            examine(candidate);
+        }
+        for (; work > 0 && get_nursery_size() > m_nursery_capacity; --work) {
+            examine_nursery_head();
+        }
+        if (!m_sweep_active && m_hash_table.size() >= m_next_gc_limit) {
+            start_sweep();
+        }
+        if (m_sweep_active) {
+            // a sweep must keep up with insertions, so
+            // it always gets to look at some entries
+            sweep_step(std::max(work, (u64)1));
+        }
+
+        end_erase_sequence();
+    }
+
+    inline void drain_worklist()
+    {
+        while (m_worklist.size() > 0) {
+            auto candidate = m_worklist.back();
+            m_worklist.pop_back();
+            examine(candidate);
+        }
+    }
+
+    // a full collection, which leaves only referenced objects in the cache
+    inline void do_gc()
+    {
+        GCTimer<STATISTICS> timer(m_statistics);
+        if (STATISTICS) {
+            ++m_statistics.m_full_gcs;
+        }
+        drain_worklist();
+        while (get_nursery_size() > 0) {
+            examine_nursery_head();
+        }
+        drain_worklist();
+
+        start_sweep();
+        while (m_sweep_active) {
+            sweep_step(m_hash_table.capacity() + 1);
+            drain_worklist();
+        }
+
+        end_erase_sequence();
+    }
+
+    inline void try_gc()
+    {
+        if (has_gc_work()) {
+            gc_step();
+        }
     }
 
 public:
@@ -109,9 +641,13 @@ public:
     typedef am::ManagedConstPointer<T> CRefType;
 
     inline RefCache()
-        : m_hash_table(),
+        : m_hash_table(), m_worklist(), m_nursery(), m_nursery_head(0),
+          m_nursery_capacity(sc_default_nursery_capacity),
+          m_sweep_index(0), m_sweep_active(false), m_collected_in_sweep(false),
+          m_in_erase_sequence(false),
           m_next_gc_limit(sc_initial_gc_limit),
-          m_growth_factor(sc_default_growth_factor)
+          m_growth_factor(sc_default_growth_factor),
+          m_storage(nullptr), m_statistics()
     {
         // Nothing here
     }
@@ -128,43 +664,211 @@ public:
         // everything. If anyone is still holding
         // refs, then they ought to be via managed ptrs
         // and should be deleted eventually
+        for (auto const& ptr : m_worklist) {
+            ptr->dec_ref_();
+        }
+        for (u64 i = m_nursery_head; i < m_nursery.size(); ++i) {
+            m_nursery[i]->dec_ref_();
+        }
         for (auto const& ptr : m_hash_table) {
             ptr->dec_ref_();
         }
 
         m_hash_table.clear();
+
+        if (m_storage != nullptr) {
+            m_storage->release_owner();
+        }
     }
 
+private:
     template <typename U, typename... ArgTypes>
-    inline U* get(ArgTypes&&... args)
+    inline U* construct_in_storage(ArgTypes&&... args)
     {
-        static_assert(std::is_convertible<U*, T*>::value,
-                      "RefCache: Cannot call get on unrelated type.");
+        static_assert(alignof(U) <= alignof(RefCountableStorageHeader),
+                      "RefCache: Type is over-aligned for pooled storage.");
 
-        try_gc();
+        const u64 block_size = sizeof(RefCountableStorageHeader) + sizeof(U);
+        auto header = static_cast<RefCountableStorageHeader*>(m_storage->allocate_block(block_size));
+        header->m_storage = m_storage;
+        header->m_block_size = block_size;
+
+        U* retval;
+        try {
+            retval = ::new (header + 1) U(std::forward<ArgTypes>(args)...);
+        } catch (...) {
+            m_storage->release_block(header, block_size);
+            throw;
+        }
+        retval->set_in_storage_();
+        return retval;
+    }
+
+    template <typename U, typename... ArgTypes>
+    inline U* construct(std::true_type can_use_storage, ArgTypes&&... args)
+    {
+        if (m_storage != nullptr) {
+            return construct_in_storage<U>(std::forward<ArgTypes>(args)...);
+        }
+        return new U(std::forward<ArgTypes>(args)...);
+    }
 
-        auto new_object = new U(std::forward<ArgTypes>(args)...);
+    template <typename U, typename... ArgTypes>
+    inline U* construct(std::false_type can_use_storage, ArgTypes&&... args)
+    {
+        return new U(std::forward<ArgTypes>(args)...);
+    }
+
+    // destroys an object that was never handed out, wherever it lives
+    static inline void discard(const T* object)
+    {
+        object->inc_ref_();
+        object->dec_ref_();
+    }
+
+    template <typename U>
+    inline U* insert_new(U* new_object)
+    {
+        new_object->inc_ref_();
+        bool unused;
+        m_hash_table.insert(new_object, unused);
+        if (m_nursery_capacity > 0) {
+            new_object->inc_ref_();
+            m_nursery.push_back(new_object);
+        }
+        return new_object;
+    }
+
+    // probes with the construction arguments, and constructs
+    // an object only if there is no equal object in the cache
+    template <typename U, typename... ArgTypes>
+    inline U* get_(std::true_type use_construction_key, ArgTypes&&... args)
+    {
+        ConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...> key(args...);
+
+        auto it = m_hash_table.find(key);
+        if (it != m_hash_table.end()) {
+            if (STATISTICS) {
+                ++m_statistics.m_hits;
+            }
+            return static_cast<U*>(*it);
+        }
+        if (STATISTICS) {
+            ++m_statistics.m_misses;
+            ++m_statistics.m_objects_constructed;
+        }
+        return insert_new(construct<U>(CanUseStorageType(), std::forward<ArgTypes>(args)...));
+    }
+
+    // constructs an object to probe with, and deletes it if an
+    // equal object is already in the cache
+    template <typename U, typename... ArgTypes>
+    inline U* get_(std::false_type use_construction_key, ArgTypes&&... args)
+    {
+        auto new_object = construct<U>(CanUseStorageType(), std::forward<ArgTypes>(args)...);
+        if (STATISTICS) {
+            ++m_statistics.m_objects_constructed;
+        }
 
         auto it = m_hash_table.find(new_object);
         if (it == m_hash_table.end()) {
-            new_object->inc_ref_();
-            bool unused;
-            m_hash_table.insert(new_object, unused);
-            return new_object;
+            if (STATISTICS) {
+                ++m_statistics.m_misses;
+            }
+            return insert_new(new_object);
         } else {
-            delete new_object;
+            if (STATISTICS) {
+                ++m_statistics.m_hits;
+                ++m_statistics.m_objects_discarded;
+            }
+            discard(new_object);
             return (*it);
         }
     }
 
+public:
+    // returns the cached object equal to U(args...), constructing
+    // it only if there is none. Types which can be hashed and
+    // compared on their construction arguments (see ConstructionKey)
+    // are looked up without constructing anything
+    template <typename U, typename... ArgTypes>
+    inline U* get(ArgTypes&&... args)
+    {
+        static_assert(std::is_convertible<U*, T*>::value,
+                      "RefCache: Cannot call get on unrelated type.");
+
+        try_gc();
+
+        typedef typename HasConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...>::type
+            HasKeyType;
+        typedef std::integral_constant<bool, (HasKeyType::value && sc_can_use_construction_keys)>
+            UseKeyType;
+        return get_<U>(UseKeyType(), std::forward<ArgTypes>(args)...);
+    }
+
     inline u64 size() const
     {
         return m_hash_table.size();
     }
 
+    // collects everything that is not referenced from outside the
+    // cache, in one go
     inline void garbage_collect()
     {
         do_gc();
+        if (m_storage != nullptr) {
+            m_storage->garbage_collect();
+        }
+    }
+
+    // Constructs objects created from here on in pooled storage owned
+    // by the cache, which keeps objects of similar sizes together, and
+    // makes creating and destroying them cheaper. Memory that becomes
+    // free is returned a chunk at a time, by garbage_collect().
+    // Only types that derive from RefCountable can be pooled; for
+    // other types this has no effect.
+    inline void set_pooled_storage(bool use_pooled_storage)
+    {
+        if (!CanUseStorageType::value) {
+            return;
+        }
+        if (use_pooled_storage && m_storage == nullptr) {
+            m_storage = aa::allocate_object_raw<PooledStorage>();
+        } else if (!use_pooled_storage && m_storage != nullptr) {
+            // objects already in the storage keep it alive
+            m_storage->release_owner();
+            m_storage = nullptr;
+        }
+    }
+
+    inline bool is_pooled_storage() const
+    {
+        return (m_storage != nullptr);
+    }
+
+    // bytes held by the pooled storage, zero if there is none
+    inline u64 get_pooled_bytes_claimed() const
+    {
+        return (m_storage != nullptr ? m_storage->get_bytes_claimed() : 0);
+    }
+
+    // the number of objects created after an object is created,
+    // before it is examined. Zero disables the nursery, leaving
+    // young objects to the sweeps
+    inline void set_nursery_capacity(u64 nursery_capacity)
+    {
+        m_nursery_capacity = nursery_capacity;
+        if (m_nursery_capacity == 0) {
+            while (get_nursery_size() > 0) {
+                examine_nursery_head();
+            }
+            end_erase_sequence();
+        }
+    }
+
+    inline u64 get_nursery_capacity() const
+    {
+        return m_nursery_capacity;
     }
 
     inline void set_growth_factor(float new_growth_factor)
@@ -180,15 +884,34 @@ public:
     {
         return m_growth_factor;
     }
+
+    static constexpr bool is_statistics_enabled()
+    {
+        return STATISTICS;
+    }
+
+    inline RefCacheStatistics get_statistics() const
+    {
+        RefCacheStatistics retval = m_statistics;
+        retval.m_size = m_hash_table.size();
+        retval.m_capacity = m_hash_table.capacity();
+        return retval;
+    }
+
+    inline void reset_statistics()
+    {
+        m_statistics = RefCacheStatistics();
+    }
 };
 
 } /* end namespace detail_ */
 
 // exported typedefs for convenience
 template <typename T,
-          typename HashFunction = aurum::hashing::DeepHasher<const T*, 1>,
-          typename EqualsFunction = aurum::comparisons::DeepEqualTo<const T*, 1> >
-using RefCache = ref_cache_detail_::RefCache<T, HashFunction, EqualsFunction>;
+          typename HashFunction = ref_cache_detail_::DefaultHashFunction<T>,
+          typename EqualsFunction = ref_cache_detail_::DefaultEqualsFunction<T>,
+          bool STATISTICS = ref_cache_detail_::sc_default_statistics>
+using RefCache = ref_cache_detail_::RefCache<T, HashFunction, EqualsFunction, STATISTICS>;
 
 } /* end namespace containers */
 } /* end namespace aurum */
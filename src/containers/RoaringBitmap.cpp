@@ -0,0 +1,1464 @@
+// RoaringBitmap.cpp ---
+//
+// Filename: RoaringBitmap.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:34:40 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include <sstream>
+#include <algorithm>
+#include <utility>
+
+#include "../basetypes/AurumErrors.hpp"
+#include "../io/AurumIOException.hpp"
+
+#include "RoaringBitmap.hpp"
+#include "BitSetKernels.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace bsd = aurum::containers::bit_set_detail_;
+namespace aio = aurum::io;
+
+namespace roaring_detail_ {
+
+typedef RoaringContainerType ContainerType;
+
+constexpr u32 RoaringContainer::sc_max_array_cardinality;
+constexpr u32 RoaringContainer::sc_num_bitmap_words;
+
+static constexpr u32 sc_roaring_magic = 0x314d4252; // "RBM1"
+
+// helpers for the serialized form, which is little endian
+template <typename T>
+static inline void write_value(std::ostream& out_stream, T value)
+{
+    char buffer[sizeof(T)];
+    for (u32 i = 0; i < sizeof(T); ++i) {
+        buffer[i] = static_cast<char>(static_cast<u64>(value) >> (8 * i));
+    }
+    out_stream.write(buffer, sizeof(T));
+}
+
+template <typename T>
+static inline T read_value(std::istream& in_stream)
+{
+    unsigned char buffer[sizeof(T)];
+    in_stream.read(reinterpret_cast<char*>(buffer), sizeof(T));
+    if (!in_stream) {
+        throw aio::AurumIOException("Unexpected end of stream while reading a RoaringBitmap");
+    }
+    u64 retval = 0;
+    for (u32 i = 0; i < sizeof(T); ++i) {
+        retval |= (static_cast<u64>(buffer[i]) << (8 * i));
+    }
+    return static_cast<T>(retval);
+}
+
+static inline void set_bit(Vector<u64>& words, u32 bit_num)
+{
+    words[bit_num / 64] |= (1ull << (bit_num % 64));
+}
+
+static inline void clear_bit(Vector<u64>& words, u32 bit_num)
+{
+    words[bit_num / 64] &= ~(1ull << (bit_num % 64));
+}
+
+static inline bool test_bit(const Vector<u64>& words, u32 bit_num)
+{
+    return (((words[bit_num / 64] >> (bit_num % 64)) & 1) != 0);
+}
+
+// sets the bits in [first, last]
+static inline void set_bit_range(Vector<u64>& words, u32 first, u32 last)
+{
+    const u32 first_word = first / 64;
+    const u32 last_word = last / 64;
+    const u64 first_mask = (~(u64)0 << (first % 64));
+    const u64 last_mask = (~(u64)0 >> (63 - (last % 64)));
+
+    if (first_word == last_word) {
+        words[first_word] |= (first_mask & last_mask);
+        return;
+    }
+    words[first_word] |= first_mask;
+    for (u32 i = first_word + 1; i < last_word; ++i) {
+        words[i] = ~(u64)0;
+    }
+    words[last_word] |= last_mask;
+}
+
+// out = op(a, b) for sorted arrays a and b,
+// where op is one of the std::set_* algorithms
+template <typename SetOperation>
+static inline void merge_arrays(const Vector<u16>& a, const Vector<u16>& b,
+                                Vector<u16>& out, const SetOperation& set_operation)
+{
+    out.resize(a.size() + b.size());
+    auto out_end = set_operation(a.data(), a.data() + a.size(),
+                                 b.data(), b.data() + b.size(), out.data());
+    out.resize(out_end - out.data());
+}
+
+// a view of a container as an array or a bitmap, which copies
+// (and converts) the container only if it is a run container
+class DenseView
+{
+private:
+    RoaringContainer m_scratch;
+    const RoaringContainer* m_container;
+
+public:
+    inline DenseView(const RoaringContainer& container)
+        : m_scratch(), m_container(&container)
+    {
+        if (container.get_type() == ContainerType::Run) {
+            m_scratch = container;
+            m_scratch.materialize();
+            m_container = &m_scratch;
+        }
+    }
+
+    inline const RoaringContainer& get() const
+    {
+        return *m_container;
+    }
+};
+
+RoaringContainer::RoaringContainer()
+    : RoaringContainer(0)
+{
+    // Nothing here
+}
+
+RoaringContainer::RoaringContainer(u16 key)
+    : m_key(key), m_type(ContainerType::Array), m_cardinality(0),
+      m_values(), m_words()
+{
+    // Nothing here
+}
+
+RoaringContainer::RoaringContainer(const RoaringContainer& other)
+    : m_key(other.m_key), m_type(other.m_type), m_cardinality(other.m_cardinality),
+      m_values(other.m_values), m_words(other.m_words)
+{
+    // Nothing here
+}
+
+RoaringContainer::RoaringContainer(RoaringContainer&& other)
+    : RoaringContainer()
+{
+    std::swap(m_key, other.m_key);
+    std::swap(m_type, other.m_type);
+    std::swap(m_cardinality, other.m_cardinality);
+    std::swap(m_values, other.m_values);
+    std::swap(m_words, other.m_words);
+}
+
+RoaringContainer::~RoaringContainer()
+{
+    // Nothing here
+}
+
+RoaringContainer& RoaringContainer::operator = (const RoaringContainer& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    m_key = other.m_key;
+    m_type = other.m_type;
+    m_cardinality = other.m_cardinality;
+    m_values = other.m_values;
+    m_words = other.m_words;
+    return *this;
+}
+
+RoaringContainer& RoaringContainer::operator = (RoaringContainer&& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    std::swap(m_key, other.m_key);
+    std::swap(m_type, other.m_type);
+    std::swap(m_cardinality, other.m_cardinality);
+    std::swap(m_values, other.m_values);
+    std::swap(m_words, other.m_words);
+    return *this;
+}
+
+u16 RoaringContainer::get_key() const
+{
+    return m_key;
+}
+
+ContainerType RoaringContainer::get_type() const
+{
+    return m_type;
+}
+
+u32 RoaringContainer::get_cardinality() const
+{
+    return m_cardinality;
+}
+
+void RoaringContainer::convert_to_bitmap()
+{
+    Vector<u64> words((u64)sc_num_bitmap_words, 0);
+    if (m_type == ContainerType::Array) {
+        for (auto value : m_values) {
+            set_bit(words, value);
+        }
+    } else if (m_type == ContainerType::Run) {
+        for (u64 i = 0, last = m_values.size(); i < last; i += 2) {
+            set_bit_range(words, m_values[i], m_values[i] + m_values[i + 1]);
+        }
+    } else {
+        return;
+    }
+    m_values.clear();
+    std::swap(m_words, words);
+    m_type = ContainerType::Bitmap;
+}
+
+void RoaringContainer::convert_to_array()
+{
+    Vector<u16> values;
+    values.reserve(m_cardinality);
+    if (m_type == ContainerType::Bitmap) {
+        for (u32 i = 0; i < sc_num_bitmap_words; ++i) {
+            for (auto word = m_words[i]; word != 0; word &= (word - 1)) {
+                values.push_back((i * 64) + __builtin_ctzll(word));
+            }
+        }
+        m_words.clear();
+    } else if (m_type == ContainerType::Run) {
+        for (u64 i = 0, last = m_values.size(); i < last; i += 2) {
+            for (u32 j = 0; j <= m_values[i + 1]; ++j) {
+                values.push_back(m_values[i] + j);
+            }
+        }
+    } else {
+        return;
+    }
+    std::swap(m_values, values);
+    m_type = ContainerType::Array;
+}
+
+void RoaringContainer::materialize()
+{
+    if (m_type != ContainerType::Run) {
+        return;
+    }
+    if (m_cardinality > sc_max_array_cardinality) {
+        convert_to_bitmap();
+    } else {
+        convert_to_array();
+    }
+}
+
+void RoaringContainer::normalize()
+{
+    if (m_type == ContainerType::Array && m_cardinality > sc_max_array_cardinality) {
+        convert_to_bitmap();
+    } else if (m_type == ContainerType::Bitmap && m_cardinality <= sc_max_array_cardinality) {
+        convert_to_array();
+    }
+}
+
+u32 RoaringContainer::get_num_runs() const
+{
+    if (m_type == ContainerType::Run) {
+        return (m_values.size() / 2);
+    }
+
+    u32 retval = 0;
+    if (m_type == ContainerType::Array) {
+        for (u64 i = 0, last = m_values.size(); i < last; ++i) {
+            if (i == 0 || m_values[i] != m_values[i - 1] + 1) {
+                ++retval;
+            }
+        }
+        return retval;
+    }
+
+    // a run starts wherever a set bit is preceded by a clear bit
+    u64 carry = 0;
+    for (u32 i = 0; i < sc_num_bitmap_words; ++i) {
+        auto const word = m_words[i];
+        retval += __builtin_popcountll(word & ~((word << 1) | carry));
+        carry = (word >> 63);
+    }
+    return retval;
+}
+
+bool RoaringContainer::add(u16 value)
+{
+    materialize();
+
+    if (m_type == ContainerType::Array) {
+        auto const position = std::lower_bound(m_values.data(),
+                                               m_values.data() + m_values.size(),
+                                               value) - m_values.data();
+        if ((u64)position < m_values.size() && m_values[position] == value) {
+            return false;
+        }
+        if (m_cardinality < sc_max_array_cardinality) {
+            m_values.push_back(value);
+            std::rotate(m_values.data() + position, m_values.data() + m_values.size() - 1,
+                        m_values.data() + m_values.size());
+            ++m_cardinality;
+            return true;
+        }
+        convert_to_bitmap();
+    }
+
+    if (test_bit(m_words, value)) {
+        return false;
+    }
+    set_bit(m_words, value);
+    ++m_cardinality;
+    return true;
+}
+
+bool RoaringContainer::remove(u16 value)
+{
+    if (!contains(value)) {
+        return false;
+    }
+    materialize();
+
+    if (m_type == ContainerType::Array) {
+        auto const position = std::lower_bound(m_values.data(),
+                                               m_values.data() + m_values.size(),
+                                               value);
+        std::rotate(position, position + 1, m_values.data() + m_values.size());
+        m_values.pop_back();
+    } else {
+        clear_bit(m_words, value);
+    }
+    --m_cardinality;
+    normalize();
+    return true;
+}
+
+bool RoaringContainer::contains(u16 value) const
+{
+    switch (m_type) {
+    case ContainerType::Array:
+        return std::binary_search(m_values.data(), m_values.data() + m_values.size(), value);
+    case ContainerType::Bitmap:
+        return test_bit(m_words, value);
+    default: {
+        // find the last run which starts at or before value
+        u64 low = 0, high = m_values.size() / 2;
+        while (low < high) {
+            auto const mid = (low + high) / 2;
+            if (m_values[2 * mid] <= value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return (low > 0 && value - m_values[2 * (low - 1)] <= m_values[(2 * (low - 1)) + 1]);
+    }
+    }
+}
+
+void RoaringContainer::add_range(u16 first, u16 last)
+{
+    if (m_cardinality == 0) {
+        m_words.clear();
+        m_values.clear();
+        m_values.push_back(first);
+        m_values.push_back(last - first);
+        m_type = ContainerType::Run;
+        m_cardinality = (u32)last - first + 1;
+        return;
+    }
+
+    materialize();
+    const u32 range_size = (u32)last - first + 1;
+
+    if (m_type == ContainerType::Array &&
+        m_cardinality + range_size <= sc_max_array_cardinality) {
+        Vector<u16> range;
+        range.reserve(range_size);
+        for (u32 i = first; i <= last; ++i) {
+            range.push_back(i);
+        }
+        Vector<u16> values;
+        merge_arrays(m_values, range, values,
+                     std::set_union<const u16*, const u16*, u16*>);
+        std::swap(m_values, values);
+        m_cardinality = m_values.size();
+        return;
+    }
+
+    convert_to_bitmap();
+    set_bit_range(m_words, first, last);
+    m_cardinality = bsd::popcount_words(m_words.data(), sc_num_bitmap_words);
+    // the range may have overlapped the values we had
+    normalize();
+}
+
+u32 RoaringContainer::rank(u16 value) const
+{
+    switch (m_type) {
+    case ContainerType::Array:
+        return (std::upper_bound(m_values.data(), m_values.data() + m_values.size(), value) -
+                m_values.data());
+    case ContainerType::Bitmap: {
+        const u32 word_index = value / 64;
+        u32 retval = bsd::popcount_words(m_words.data(), word_index);
+        auto const mask = (~(u64)0 >> (63 - (value % 64)));
+        return (retval + __builtin_popcountll(m_words[word_index] & mask));
+    }
+    default: {
+        u32 retval = 0;
+        for (u64 i = 0, last = m_values.size(); i < last && m_values[i] <= value; i += 2) {
+            retval += std::min((u32)m_values[i + 1], (u32)value - m_values[i]) + 1;
+        }
+        return retval;
+    }
+    }
+}
+
+u16 RoaringContainer::select(u32 index) const
+{
+    switch (m_type) {
+    case ContainerType::Array:
+        return m_values[index];
+    case ContainerType::Bitmap: {
+        for (u32 i = 0; i < sc_num_bitmap_words; ++i) {
+            auto word = m_words[i];
+            const u32 word_count = __builtin_popcountll(word);
+            if (index < word_count) {
+                // drop the lowest index set bits of the word
+                for (u32 j = 0; j < index; ++j) {
+                    word &= (word - 1);
+                }
+                return (i * 64) + __builtin_ctzll(word);
+            }
+            index -= word_count;
+        }
+        AURUM_UNREACHABLE_CODE();
+        return 0;
+    }
+    default: {
+        for (u64 i = 0, last = m_values.size(); i < last; i += 2) {
+            const u32 run_length = (u32)m_values[i + 1] + 1;
+            if (index < run_length) {
+                return m_values[i] + index;
+            }
+            index -= run_length;
+        }
+        AURUM_UNREACHABLE_CODE();
+        return 0;
+    }
+    }
+}
+
+u32 RoaringContainer::find_next(u32 value) const
+{
+    const u32 none = 0x10000;
+    if (value >= none) {
+        return none;
+    }
+
+    switch (m_type) {
+    case ContainerType::Array: {
+        auto position = std::lower_bound(m_values.data(), m_values.data() + m_values.size(),
+                                         (u16)value);
+        return (position == m_values.data() + m_values.size() ? none : *position);
+    }
+    case ContainerType::Bitmap: {
+        auto word_index = value / 64;
+        auto const word = m_words[word_index] & (~(u64)0 << (value % 64));
+        if (word != 0) {
+            return (word_index * 64) + __builtin_ctzll(word);
+        }
+        word_index = bsd::find_nonzero_word(m_words.data(), word_index + 1,
+                                            sc_num_bitmap_words);
+        if (word_index == sc_num_bitmap_words) {
+            return none;
+        }
+        return (word_index * 64) + __builtin_ctzll(m_words[word_index]);
+    }
+    default: {
+        for (u64 i = 0, last = m_values.size(); i < last; i += 2) {
+            const u32 run_last = (u32)m_values[i] + m_values[i + 1];
+            if (value <= run_last) {
+                return std::max(value, (u32)m_values[i]);
+            }
+        }
+        return none;
+    }
+    }
+}
+
+bool RoaringContainer::equals(const RoaringContainer& other) const
+{
+    if (m_key != other.m_key || m_cardinality != other.m_cardinality) {
+        return false;
+    }
+    DenseView view1(*this);
+    DenseView view2(other);
+    auto const& container1 = view1.get();
+    auto const& container2 = view2.get();
+
+    // both are normalized, so the same cardinality implies the same type
+    if (container1.m_type == ContainerType::Array) {
+        return std::equal(container1.m_values.data(),
+                          container1.m_values.data() + m_cardinality,
+                          container2.m_values.data());
+    }
+    return std::equal(container1.m_words.data(),
+                      container1.m_words.data() + sc_num_bitmap_words,
+                      container2.m_words.data());
+}
+
+u64 RoaringContainer::get_size_in_bytes() const
+{
+    switch (m_type) {
+    case ContainerType::Array:
+        return (2 * m_cardinality);
+    case ContainerType::Bitmap:
+        return (8 * sc_num_bitmap_words);
+    default:
+        return (4 * get_num_runs());
+    }
+}
+
+bool RoaringContainer::run_optimize()
+{
+    const u64 num_runs = get_num_runs();
+    const u64 run_bytes = 4 * num_runs;
+    const u64 dense_bytes = (m_cardinality <= sc_max_array_cardinality ?
+                             2 * m_cardinality : 8 * sc_num_bitmap_words);
+
+    if (run_bytes >= dense_bytes) {
+        materialize();
+        return false;
+    }
+    if (m_type == ContainerType::Run) {
+        return true;
+    }
+
+    Vector<u16> runs;
+    runs.reserve(2 * num_runs);
+    for (u32 value = find_next(0); value < 0x10000; ) {
+        u32 run_last = value;
+        while (run_last + 1 < 0x10000 && contains(run_last + 1)) {
+            ++run_last;
+        }
+        runs.push_back(value);
+        runs.push_back(run_last - value);
+        value = find_next(run_last + 1);
+    }
+
+    m_words.clear();
+    std::swap(m_values, runs);
+    m_type = ContainerType::Run;
+    return true;
+}
+
+void RoaringContainer::release()
+{
+    m_values.clear();
+    m_words.clear();
+    m_cardinality = 0;
+    m_type = ContainerType::Array;
+}
+
+RoaringContainer RoaringContainer::apply_and(const RoaringContainer& a,
+                                             const RoaringContainer& b)
+{
+    DenseView view_a(a);
+    DenseView view_b(b);
+    auto const& dense_a = view_a.get();
+    auto const& dense_b = view_b.get();
+    RoaringContainer retval(a.m_key);
+
+    if (dense_a.m_type == ContainerType::Bitmap && dense_b.m_type == ContainerType::Bitmap) {
+        retval.m_type = ContainerType::Bitmap;
+        retval.m_words.resize(sc_num_bitmap_words);
+        bsd::apply_words<bsd::AndOp>(retval.m_words.data(), dense_a.m_words.data(),
+                                     dense_b.m_words.data(), sc_num_bitmap_words);
+        retval.m_cardinality = bsd::popcount_words(retval.m_words.data(), sc_num_bitmap_words);
+        retval.normalize();
+        return retval;
+    }
+
+    if (dense_a.m_type == ContainerType::Array && dense_b.m_type == ContainerType::Array) {
+        merge_arrays(dense_a.m_values, dense_b.m_values, retval.m_values,
+                     std::set_intersection<const u16*, const u16*, u16*>);
+        retval.m_cardinality = retval.m_values.size();
+        return retval;
+    }
+
+    // one of each: filter the array through the bitmap
+    auto const& array = (dense_a.m_type == ContainerType::Array ? dense_a : dense_b);
+    auto const& bitmap = (dense_a.m_type == ContainerType::Array ? dense_b : dense_a);
+    retval.m_values.reserve(array.m_cardinality);
+    for (auto value : array.m_values) {
+        if (test_bit(bitmap.m_words, value)) {
+            retval.m_values.push_back(value);
+        }
+    }
+    retval.m_cardinality = retval.m_values.size();
+    return retval;
+}
+
+RoaringContainer RoaringContainer::apply_or(const RoaringContainer& a,
+                                            const RoaringContainer& b)
+{
+    DenseView view_a(a);
+    DenseView view_b(b);
+    auto const& dense_a = view_a.get();
+    auto const& dense_b = view_b.get();
+    RoaringContainer retval(a.m_key);
+
+    if (dense_a.m_type == ContainerType::Bitmap && dense_b.m_type == ContainerType::Bitmap) {
+        retval.m_type = ContainerType::Bitmap;
+        retval.m_words.resize(sc_num_bitmap_words);
+        bsd::apply_words<bsd::OrOp>(retval.m_words.data(), dense_a.m_words.data(),
+                                    dense_b.m_words.data(), sc_num_bitmap_words);
+        retval.m_cardinality = bsd::popcount_words(retval.m_words.data(), sc_num_bitmap_words);
+        return retval;
+    }
+
+    if (dense_a.m_type == ContainerType::Array && dense_b.m_type == ContainerType::Array) {
+        merge_arrays(dense_a.m_values, dense_b.m_values, retval.m_values,
+                     std::set_union<const u16*, const u16*, u16*>);
+        retval.m_cardinality = retval.m_values.size();
+        retval.normalize();
+        return retval;
+    }
+
+    auto const& array = (dense_a.m_type == ContainerType::Array ? dense_a : dense_b);
+    auto const& bitmap = (dense_a.m_type == ContainerType::Array ? dense_b : dense_a);
+    retval = bitmap;
+    retval.m_key = a.m_key;
+    for (auto value : array.m_values) {
+        if (!test_bit(retval.m_words, value)) {
+            set_bit(retval.m_words, value);
+            ++retval.m_cardinality;
+        }
+    }
+    return retval;
+}
+
+RoaringContainer RoaringContainer::apply_xor(const RoaringContainer& a,
+                                             const RoaringContainer& b)
+{
+    DenseView view_a(a);
+    DenseView view_b(b);
+    auto const& dense_a = view_a.get();
+    auto const& dense_b = view_b.get();
+    RoaringContainer retval(a.m_key);
+
+    if (dense_a.m_type == ContainerType::Bitmap && dense_b.m_type == ContainerType::Bitmap) {
+        retval.m_type = ContainerType::Bitmap;
+        retval.m_words.resize(sc_num_bitmap_words);
+        bsd::apply_words<bsd::XorOp>(retval.m_words.data(), dense_a.m_words.data(),
+                                     dense_b.m_words.data(), sc_num_bitmap_words);
+        retval.m_cardinality = bsd::popcount_words(retval.m_words.data(), sc_num_bitmap_words);
+        retval.normalize();
+        return retval;
+    }
+
+    if (dense_a.m_type == ContainerType::Array && dense_b.m_type == ContainerType::Array) {
+        merge_arrays(dense_a.m_values, dense_b.m_values, retval.m_values,
+                     std::set_symmetric_difference<const u16*, const u16*, u16*>);
+        retval.m_cardinality = retval.m_values.size();
+        retval.normalize();
+        return retval;
+    }
+
+    auto const& array = (dense_a.m_type == ContainerType::Array ? dense_a : dense_b);
+    auto const& bitmap = (dense_a.m_type == ContainerType::Array ? dense_b : dense_a);
+    retval = bitmap;
+    retval.m_key = a.m_key;
+    for (auto value : array.m_values) {
+        if (test_bit(retval.m_words, value)) {
+            clear_bit(retval.m_words, value);
+            --retval.m_cardinality;
+        } else {
+            set_bit(retval.m_words, value);
+            ++retval.m_cardinality;
+        }
+    }
+    retval.normalize();
+    return retval;
+}
+
+RoaringContainer RoaringContainer::apply_and_not(const RoaringContainer& a,
+                                                 const RoaringContainer& b)
+{
+    DenseView view_a(a);
+    DenseView view_b(b);
+    auto const& dense_a = view_a.get();
+    auto const& dense_b = view_b.get();
+    RoaringContainer retval(a.m_key);
+
+    if (dense_a.m_type == ContainerType::Bitmap && dense_b.m_type == ContainerType::Bitmap) {
+        retval.m_type = ContainerType::Bitmap;
+        retval.m_words.resize(sc_num_bitmap_words);
+        bsd::apply_words<bsd::AndNotOp>(retval.m_words.data(), dense_a.m_words.data(),
+                                        dense_b.m_words.data(), sc_num_bitmap_words);
+        retval.m_cardinality = bsd::popcount_words(retval.m_words.data(), sc_num_bitmap_words);
+        retval.normalize();
+        return retval;
+    }
+
+    if (dense_a.m_type == ContainerType::Array && dense_b.m_type == ContainerType::Array) {
+        merge_arrays(dense_a.m_values, dense_b.m_values, retval.m_values,
+                     std::set_difference<const u16*, const u16*, u16*>);
+        retval.m_cardinality = retval.m_values.size();
+        return retval;
+    }
+
+    if (dense_a.m_type == ContainerType::Array) {
+        retval.m_values.reserve(dense_a.m_cardinality);
+        for (auto value : dense_a.m_values) {
+            if (!test_bit(dense_b.m_words, value)) {
+                retval.m_values.push_back(value);
+            }
+        }
+        retval.m_cardinality = retval.m_values.size();
+        return retval;
+    }
+
+    retval = dense_a;
+    for (auto value : dense_b.m_values) {
+        if (test_bit(retval.m_words, value)) {
+            clear_bit(retval.m_words, value);
+            --retval.m_cardinality;
+        }
+    }
+    retval.normalize();
+    return retval;
+}
+
+bool RoaringContainer::intersects(const RoaringContainer& a, const RoaringContainer& b)
+{
+    DenseView view_a(a);
+    DenseView view_b(b);
+    auto const& dense_a = view_a.get();
+    auto const& dense_b = view_b.get();
+
+    if (dense_a.m_type == ContainerType::Bitmap && dense_b.m_type == ContainerType::Bitmap) {
+        return !bsd::all_zero_words<bsd::AndOp>(dense_a.m_words.data(), dense_b.m_words.data(),
+                                                sc_num_bitmap_words);
+    }
+
+    if (dense_a.m_type == ContainerType::Array && dense_b.m_type == ContainerType::Array) {
+        u64 i = 0, j = 0;
+        const u64 size_a = dense_a.m_values.size();
+        const u64 size_b = dense_b.m_values.size();
+        while (i < size_a && j < size_b) {
+            if (dense_a.m_values[i] < dense_b.m_values[j]) {
+                ++i;
+            } else if (dense_b.m_values[j] < dense_a.m_values[i]) {
+                ++j;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto const& array = (dense_a.m_type == ContainerType::Array ? dense_a : dense_b);
+    auto const& bitmap = (dense_a.m_type == ContainerType::Array ? dense_b : dense_a);
+    for (auto value : array.m_values) {
+        if (test_bit(bitmap.m_words, value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RoaringContainer::serialize(std::ostream& out_stream) const
+{
+    write_value<u16>(out_stream, m_key);
+    write_value<u08>(out_stream, (u08)m_type);
+    write_value<u32>(out_stream, m_cardinality);
+
+    switch (m_type) {
+    case ContainerType::Array:
+        for (auto value : m_values) {
+            write_value<u16>(out_stream, value);
+        }
+        break;
+    case ContainerType::Bitmap:
+        for (auto word : m_words) {
+            write_value<u64>(out_stream, word);
+        }
+        break;
+    case ContainerType::Run:
+        write_value<u32>(out_stream, m_values.size() / 2);
+        for (auto value : m_values) {
+            write_value<u16>(out_stream, value);
+        }
+        break;
+    }
+}
+
+void RoaringContainer::deserialize(std::istream& in_stream)
+{
+    release();
+    m_key = read_value<u16>(in_stream);
+    auto const type = read_value<u08>(in_stream);
+    const u32 cardinality = read_value<u32>(in_stream);
+
+    if (cardinality == 0 || cardinality > 0x10000) {
+        throw aio::AurumIOException("Invalid cardinality in serialized RoaringBitmap");
+    }
+
+    if (type == (u08)ContainerType::Array) {
+        if (cardinality > sc_max_array_cardinality) {
+            throw aio::AurumIOException("Invalid array container in serialized RoaringBitmap");
+        }
+        m_values.reserve(cardinality);
+        for (u32 i = 0; i < cardinality; ++i) {
+            auto const value = read_value<u16>(in_stream);
+            if (i > 0 && value <= m_values.back()) {
+                throw aio::AurumIOException("Unsorted array container in serialized "
+                                            "RoaringBitmap");
+            }
+            m_values.push_back(value);
+        }
+        m_type = ContainerType::Array;
+    } else if (type == (u08)ContainerType::Bitmap) {
+        m_words.reserve(sc_num_bitmap_words);
+        for (u32 i = 0; i < sc_num_bitmap_words; ++i) {
+            m_words.push_back(read_value<u64>(in_stream));
+        }
+        if (cardinality <= sc_max_array_cardinality ||
+            bsd::popcount_words(m_words.data(), sc_num_bitmap_words) != cardinality) {
+            throw aio::AurumIOException("Invalid bitmap container in serialized RoaringBitmap");
+        }
+        m_type = ContainerType::Bitmap;
+    } else if (type == (u08)ContainerType::Run) {
+        const u32 num_runs = read_value<u32>(in_stream);
+        if (num_runs == 0 || num_runs > 0x8000) {
+            throw aio::AurumIOException("Invalid run container in serialized RoaringBitmap");
+        }
+        u32 total = 0;
+        u32 next_start = 0;
+        m_values.reserve(2 * num_runs);
+        for (u32 i = 0; i < num_runs; ++i) {
+            const u32 start = read_value<u16>(in_stream);
+            const u32 length = read_value<u16>(in_stream);
+            if (start < next_start || start + length > 0xFFFF) {
+                throw aio::AurumIOException("Invalid run container in serialized "
+                                            "RoaringBitmap");
+            }
+            m_values.push_back(start);
+            m_values.push_back(length);
+            total += length + 1;
+            // runs must be disjoint and not adjacent
+            next_start = start + length + 2;
+        }
+        if (total != cardinality) {
+            throw aio::AurumIOException("Invalid run container in serialized RoaringBitmap");
+        }
+        m_type = ContainerType::Run;
+    } else {
+        throw aio::AurumIOException("Invalid container type in serialized RoaringBitmap");
+    }
+
+    m_cardinality = cardinality;
+}
+
+} /* end namespace roaring_detail_ */
+
+// Implementation of RoaringBitmap::ConstIterator
+RoaringBitmap::ConstIterator::ConstIterator()
+    : m_bitmap(nullptr), m_container_index(0), m_value(0)
+{
+    // Nothing here
+}
+
+RoaringBitmap::ConstIterator::ConstIterator(const RoaringBitmap* bitmap,
+                                            u64 container_index, u32 value)
+    : m_bitmap(bitmap), m_container_index(container_index), m_value(value)
+{
+    // Nothing here
+}
+
+RoaringBitmap::ConstIterator::ConstIterator(const ConstIterator& other)
+    : m_bitmap(other.m_bitmap), m_container_index(other.m_container_index),
+      m_value(other.m_value)
+{
+    // Nothing here
+}
+
+RoaringBitmap::ConstIterator::~ConstIterator()
+{
+    // Nothing here
+}
+
+RoaringBitmap::ConstIterator&
+RoaringBitmap::ConstIterator::operator = (const ConstIterator& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    m_bitmap = other.m_bitmap;
+    m_container_index = other.m_container_index;
+    m_value = other.m_value;
+    return *this;
+}
+
+bool RoaringBitmap::ConstIterator::operator == (const ConstIterator& other) const
+{
+    return (m_bitmap == other.m_bitmap &&
+            m_container_index == other.m_container_index &&
+            m_value == other.m_value);
+}
+
+bool RoaringBitmap::ConstIterator::operator != (const ConstIterator& other) const
+{
+    return !(*this == other);
+}
+
+// moves to the first value at or after the lower 16 bits of
+// m_value in the current container, or on to the next container
+void RoaringBitmap::ConstIterator::advance_to_valid()
+{
+    auto const& containers = m_bitmap->m_containers;
+    u32 low_bits = (m_value & 0xFFFF);
+
+    while (m_container_index < containers.size()) {
+        auto const& container = containers[m_container_index];
+        auto const next = container.find_next(low_bits);
+        if (next <= 0xFFFF) {
+            m_value = (((u32)container.get_key() << 16) | next);
+            return;
+        }
+        ++m_container_index;
+        low_bits = 0;
+    }
+    m_value = 0;
+}
+
+RoaringBitmap::ConstIterator& RoaringBitmap::ConstIterator::operator ++ ()
+{
+    if ((m_value & 0xFFFF) == 0xFFFF) {
+        ++m_container_index;
+        m_value = 0;
+    } else {
+        ++m_value;
+    }
+    advance_to_valid();
+    return *this;
+}
+
+RoaringBitmap::ConstIterator RoaringBitmap::ConstIterator::operator ++ (int unused)
+{
+    auto retval = *this;
+    ++(*this);
+    return retval;
+}
+
+const u32& RoaringBitmap::ConstIterator::operator * () const
+{
+    return m_value;
+}
+
+const u32* RoaringBitmap::ConstIterator::operator -> () const
+{
+    return &m_value;
+}
+
+// Implementation of RoaringBitmap
+RoaringBitmap::RoaringBitmap()
+    : m_containers()
+{
+    // Nothing here
+}
+
+RoaringBitmap::RoaringBitmap(std::initializer_list<u32> init_list)
+    : RoaringBitmap(init_list.begin(), init_list.end())
+{
+    // Nothing here
+}
+
+RoaringBitmap::RoaringBitmap(const RoaringBitmap& other)
+    : m_containers(other.m_containers)
+{
+    // Nothing here
+}
+
+RoaringBitmap::RoaringBitmap(RoaringBitmap&& other)
+    : m_containers()
+{
+    std::swap(m_containers, other.m_containers);
+}
+
+RoaringBitmap::~RoaringBitmap()
+{
+    clear();
+}
+
+RoaringBitmap& RoaringBitmap::operator = (const RoaringBitmap& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    clear();
+    m_containers = other.m_containers;
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator = (RoaringBitmap&& other)
+{
+    if (&other == this) {
+        return *this;
+    }
+    std::swap(m_containers, other.m_containers);
+    return *this;
+}
+
+u64 RoaringBitmap::find_container(u16 key) const
+{
+    u64 low = 0, high = m_containers.size();
+    while (low < high) {
+        auto const mid = (low + high) / 2;
+        if (m_containers[mid].get_key() < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+RoaringBitmap::ContainerType& RoaringBitmap::get_or_create_container(u16 key)
+{
+    auto const index = find_container(key);
+    if (index < m_containers.size() && m_containers[index].get_key() == key) {
+        return m_containers[index];
+    }
+    m_containers.push_back(ContainerType(key));
+    std::rotate(m_containers.data() + index,
+                m_containers.data() + m_containers.size() - 1,
+                m_containers.data() + m_containers.size());
+    return m_containers[index];
+}
+
+void RoaringBitmap::erase_container(u64 index)
+{
+    std::rotate(m_containers.data() + index, m_containers.data() + index + 1,
+                m_containers.data() + m_containers.size());
+    // pop_back() does not destroy, so free the storage here
+    m_containers.back().release();
+    m_containers.pop_back();
+}
+
+bool RoaringBitmap::add(u32 value)
+{
+    return get_or_create_container(value >> 16).add(value & 0xFFFF);
+}
+
+void RoaringBitmap::add_range(u32 first, u32 last)
+{
+    if (first > last) {
+        return;
+    }
+    for (u64 key = (first >> 16); key <= (last >> 16); ++key) {
+        const u32 range_first = (key == (first >> 16) ? (first & 0xFFFF) : 0);
+        const u32 range_last = (key == (last >> 16) ? (last & 0xFFFF) : 0xFFFF);
+        get_or_create_container(key).add_range(range_first, range_last);
+    }
+}
+
+bool RoaringBitmap::remove(u32 value)
+{
+    auto const index = find_container(value >> 16);
+    if (index == m_containers.size() || m_containers[index].get_key() != (value >> 16)) {
+        return false;
+    }
+    auto retval = m_containers[index].remove(value & 0xFFFF);
+    if (m_containers[index].get_cardinality() == 0) {
+        erase_container(index);
+    }
+    return retval;
+}
+
+bool RoaringBitmap::contains(u32 value) const
+{
+    auto const index = find_container(value >> 16);
+    if (index == m_containers.size() || m_containers[index].get_key() != (value >> 16)) {
+        return false;
+    }
+    return m_containers[index].contains(value & 0xFFFF);
+}
+
+u64 RoaringBitmap::cardinality() const
+{
+    u64 retval = 0;
+    for (auto const& container : m_containers) {
+        retval += container.get_cardinality();
+    }
+    return retval;
+}
+
+bool RoaringBitmap::empty() const
+{
+    return (m_containers.size() == 0);
+}
+
+void RoaringBitmap::clear()
+{
+    for (auto& container : m_containers) {
+        container.release();
+    }
+    m_containers.clear();
+}
+
+u64 RoaringBitmap::rank(u32 value) const
+{
+    u64 retval = 0;
+    for (auto const& container : m_containers) {
+        if (container.get_key() < (value >> 16)) {
+            retval += container.get_cardinality();
+        } else {
+            if (container.get_key() == (value >> 16)) {
+                retval += container.rank(value & 0xFFFF);
+            }
+            break;
+        }
+    }
+    return retval;
+}
+
+u32 RoaringBitmap::select(u64 index) const
+{
+    for (auto const& container : m_containers) {
+        if (index < container.get_cardinality()) {
+            return (((u32)container.get_key() << 16) | container.select(index));
+        }
+        index -= container.get_cardinality();
+    }
+    AURUM_UNREACHABLE_CODE();
+    return 0;
+}
+
+u32 RoaringBitmap::get_min() const
+{
+    return select(0);
+}
+
+u32 RoaringBitmap::get_max() const
+{
+    auto const& container = m_containers.back();
+    return (((u32)container.get_key() << 16) |
+            container.select(container.get_cardinality() - 1));
+}
+
+RoaringBitmap& RoaringBitmap::operator &= (const RoaringBitmap& other)
+{
+    *this = (*this & other);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator |= (const RoaringBitmap& other)
+{
+    *this = (*this | other);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator ^= (const RoaringBitmap& other)
+{
+    *this = (*this ^ other);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator -= (const RoaringBitmap& other)
+{
+    *this = (*this - other);
+    return *this;
+}
+
+RoaringBitmap RoaringBitmap::operator & (const RoaringBitmap& other) const
+{
+    RoaringBitmap retval;
+    u64 i = 0, j = 0;
+    const u64 size1 = m_containers.size(), size2 = other.m_containers.size();
+
+    while (i < size1 && j < size2) {
+        auto const key1 = m_containers[i].get_key();
+        auto const key2 = other.m_containers[j].get_key();
+        if (key1 < key2) {
+            ++i;
+        } else if (key2 < key1) {
+            ++j;
+        } else {
+            auto container = ContainerType::apply_and(m_containers[i], other.m_containers[j]);
+            if (container.get_cardinality() != 0) {
+                retval.m_containers.push_back(std::move(container));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return retval;
+}
+
+RoaringBitmap RoaringBitmap::operator | (const RoaringBitmap& other) const
+{
+    RoaringBitmap retval;
+    u64 i = 0, j = 0;
+    const u64 size1 = m_containers.size(), size2 = other.m_containers.size();
+    retval.m_containers.reserve(std::max(size1, size2));
+
+    while (i < size1 || j < size2) {
+        if (j == size2 || (i < size1 && m_containers[i].get_key() <
+                           other.m_containers[j].get_key())) {
+            retval.m_containers.push_back(m_containers[i++]);
+        } else if (i == size1 || other.m_containers[j].get_key() <
+                   m_containers[i].get_key()) {
+            retval.m_containers.push_back(other.m_containers[j++]);
+        } else {
+            retval.m_containers.push_back(ContainerType::apply_or(m_containers[i++],
+                                                                  other.m_containers[j++]));
+        }
+    }
+    return retval;
+}
+
+RoaringBitmap RoaringBitmap::operator ^ (const RoaringBitmap& other) const
+{
+    RoaringBitmap retval;
+    u64 i = 0, j = 0;
+    const u64 size1 = m_containers.size(), size2 = other.m_containers.size();
+
+    while (i < size1 || j < size2) {
+        if (j == size2 || (i < size1 && m_containers[i].get_key() <
+                           other.m_containers[j].get_key())) {
+            retval.m_containers.push_back(m_containers[i++]);
+        } else if (i == size1 || other.m_containers[j].get_key() <
+                   m_containers[i].get_key()) {
+            retval.m_containers.push_back(other.m_containers[j++]);
+        } else {
+            auto container = ContainerType::apply_xor(m_containers[i++],
+                                                      other.m_containers[j++]);
+            if (container.get_cardinality() != 0) {
+                retval.m_containers.push_back(std::move(container));
+            }
+        }
+    }
+    return retval;
+}
+
+RoaringBitmap RoaringBitmap::operator - (const RoaringBitmap& other) const
+{
+    RoaringBitmap retval;
+    u64 j = 0;
+    const u64 size2 = other.m_containers.size();
+
+    for (auto const& container : m_containers) {
+        while (j < size2 && other.m_containers[j].get_key() < container.get_key()) {
+            ++j;
+        }
+        if (j == size2 || other.m_containers[j].get_key() != container.get_key()) {
+            retval.m_containers.push_back(container);
+            continue;
+        }
+        auto difference = ContainerType::apply_and_not(container, other.m_containers[j]);
+        if (difference.get_cardinality() != 0) {
+            retval.m_containers.push_back(std::move(difference));
+        }
+    }
+    return retval;
+}
+
+bool RoaringBitmap::intersects(const RoaringBitmap& other) const
+{
+    u64 i = 0, j = 0;
+    const u64 size1 = m_containers.size(), size2 = other.m_containers.size();
+
+    while (i < size1 && j < size2) {
+        auto const key1 = m_containers[i].get_key();
+        auto const key2 = other.m_containers[j].get_key();
+        if (key1 < key2) {
+            ++i;
+        } else if (key2 < key1) {
+            ++j;
+        } else if (ContainerType::intersects(m_containers[i++], other.m_containers[j++])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RoaringBitmap::is_subset_of(const RoaringBitmap& other) const
+{
+    u64 j = 0;
+    const u64 size2 = other.m_containers.size();
+
+    for (auto const& container : m_containers) {
+        while (j < size2 && other.m_containers[j].get_key() < container.get_key()) {
+            ++j;
+        }
+        if (j == size2 || other.m_containers[j].get_key() != container.get_key() ||
+            container.get_cardinality() > other.m_containers[j].get_cardinality()) {
+            return false;
+        }
+        if (ContainerType::apply_and_not(container,
+                                         other.m_containers[j]).get_cardinality() != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RoaringBitmap::operator == (const RoaringBitmap& other) const
+{
+    if (m_containers.size() != other.m_containers.size()) {
+        return false;
+    }
+    for (u64 i = 0, last = m_containers.size(); i < last; ++i) {
+        if (!m_containers[i].equals(other.m_containers[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RoaringBitmap::operator != (const RoaringBitmap& other) const
+{
+    return !(*this == other);
+}
+
+bool RoaringBitmap::run_optimize()
+{
+    bool retval = false;
+    for (auto& container : m_containers) {
+        retval = container.run_optimize() || retval;
+    }
+    return retval;
+}
+
+u64 RoaringBitmap::get_size_in_bytes() const
+{
+    u64 retval = 0;
+    for (auto const& container : m_containers) {
+        retval += container.get_size_in_bytes();
+    }
+    return retval;
+}
+
+RoaringBitmap::ConstIterator RoaringBitmap::begin() const
+{
+    ConstIterator retval(this, 0, 0);
+    retval.advance_to_valid();
+    return retval;
+}
+
+RoaringBitmap::ConstIterator RoaringBitmap::end() const
+{
+    return ConstIterator(this, m_containers.size(), 0);
+}
+
+RoaringBitmap::ConstIterator RoaringBitmap::cbegin() const
+{
+    return begin();
+}
+
+RoaringBitmap::ConstIterator RoaringBitmap::cend() const
+{
+    return end();
+}
+
+void RoaringBitmap::serialize(std::ostream& out_stream) const
+{
+    roaring_detail_::write_value<u32>(out_stream, roaring_detail_::sc_roaring_magic);
+    roaring_detail_::write_value<u32>(out_stream, m_containers.size());
+    for (auto const& container : m_containers) {
+        container.serialize(out_stream);
+    }
+}
+
+void RoaringBitmap::deserialize(std::istream& in_stream)
+{
+    clear();
+    if (roaring_detail_::read_value<u32>(in_stream) != roaring_detail_::sc_roaring_magic) {
+        throw aio::AurumIOException("Stream does not contain a serialized RoaringBitmap");
+    }
+    const u32 num_containers = roaring_detail_::read_value<u32>(in_stream);
+    if (num_containers > 0x10000) {
+        throw aio::AurumIOException("Invalid number of containers in serialized "
+                                    "RoaringBitmap");
+    }
+
+    RoaringBitmap result;
+    result.m_containers.reserve(num_containers);
+    for (u32 i = 0; i < num_containers; ++i) {
+        ContainerType container;
+        container.deserialize(in_stream);
+        if (i > 0 && container.get_key() <= result.m_containers.back().get_key()) {
+            throw aio::AurumIOException("Unsorted containers in serialized RoaringBitmap");
+        }
+        result.m_containers.push_back(std::move(container));
+    }
+    *this = std::move(result);
+}
+
+std::string RoaringBitmap::as_string(i64 verbosity) const
+{
+    std::ostringstream sstr;
+    sstr << "RoaringBitmap with " << cardinality() << " values: {";
+    bool first = true;
+    for (auto value : *this) {
+        if (!first) {
+            sstr << ", ";
+        }
+        first = false;
+        sstr << value;
+    }
+    sstr << "}";
+    return sstr.str();
+}
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+//
+// RoaringBitmap.cpp ends here
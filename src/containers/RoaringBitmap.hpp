@@ -0,0 +1,275 @@
+// RoaringBitmap.hpp ---
+//
+// Filename: RoaringBitmap.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:34:40 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_ROARING_BITMAP_HPP_
+#define AURUM_CONTAINERS_ROARING_BITMAP_HPP_
+
+#include <istream>
+#include <ostream>
+#include <iterator>
+#include <initializer_list>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+
+#include "Vector.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace roaring_detail_ {
+
+enum class RoaringContainerType : u08 {
+    Array, Bitmap, Run
+};
+
+class DenseView;
+
+// Holds the values of a RoaringBitmap which share the upper 16 bits
+// (the key), in one of three representations:
+// Array: the sorted lower 16 bits, used for at most 4096 values.
+// Bitmap: a 65536 bit bitmap, used for more than 4096 values.
+// Run: sorted (start, length - 1) pairs, only produced by add_range()
+// and run_optimize(), and converted back to one of the other two
+// representations as soon as the container is modified.
+class RoaringContainer final
+{
+    friend class DenseView;
+
+private:
+    typedef RoaringContainerType ContainerType;
+
+    u16 m_key;
+    ContainerType m_type;
+    u32 m_cardinality;
+    // Array and Run representations
+    Vector<u16> m_values;
+    // Bitmap representation
+    Vector<u64> m_words;
+
+    void convert_to_bitmap();
+    void convert_to_array();
+    // converts a run container to an array or a bitmap
+    void materialize();
+    // picks array or bitmap according to the cardinality
+    void normalize();
+    u32 get_num_runs() const;
+
+public:
+    static constexpr u32 sc_max_array_cardinality = 4096;
+    static constexpr u32 sc_num_bitmap_words = 1024;
+
+    RoaringContainer();
+    RoaringContainer(u16 key);
+    RoaringContainer(const RoaringContainer& other);
+    RoaringContainer(RoaringContainer&& other);
+    ~RoaringContainer();
+
+    RoaringContainer& operator = (const RoaringContainer& other);
+    RoaringContainer& operator = (RoaringContainer&& other);
+
+    u16 get_key() const;
+    ContainerType get_type() const;
+    u32 get_cardinality() const;
+
+    bool add(u16 value);
+    bool remove(u16 value);
+    bool contains(u16 value) const;
+    // adds [first, last]
+    void add_range(u16 first, u16 last);
+    // number of values <= value
+    u32 rank(u16 value) const;
+    // the index-th smallest value, index must be less than the cardinality
+    u16 select(u32 index) const;
+    // smallest value >= value, or a value > 0xFFFF if none
+    u32 find_next(u32 value) const;
+    bool equals(const RoaringContainer& other) const;
+    // memory used by the values in the current representation
+    u64 get_size_in_bytes() const;
+    // converts to a run container if that is smaller, returns true
+    // iff the container is a run container afterwards
+    bool run_optimize();
+    void release();
+
+    static RoaringContainer apply_and(const RoaringContainer& a, const RoaringContainer& b);
+    static RoaringContainer apply_or(const RoaringContainer& a, const RoaringContainer& b);
+    static RoaringContainer apply_xor(const RoaringContainer& a, const RoaringContainer& b);
+    static RoaringContainer apply_and_not(const RoaringContainer& a, const RoaringContainer& b);
+    static bool intersects(const RoaringContainer& a, const RoaringContainer& b);
+
+    void serialize(std::ostream& out_stream) const;
+    void deserialize(std::istream& in_stream);
+};
+
+} /* end namespace roaring_detail_ */
+
+// A compressed bitmap over the u32 space, in the style of Roaring
+// bitmaps: values are partitioned on their upper 16 bits, and each
+// partition is stored as a sorted array, a plain bitmap, or a list of
+// runs, whichever suits it. Sparse and clustered sets are thus
+// compact, and set algebra works a partition at a time, with the
+// dense partitions handled by the word level bit set kernels.
+class RoaringBitmap final : public AurumObject<RoaringBitmap>,
+                            public Stringifiable<RoaringBitmap>
+{
+private:
+    typedef roaring_detail_::RoaringContainer ContainerType;
+
+    // sorted on the key
+    Vector<ContainerType> m_containers;
+
+    // index of the container with the key, or of the position where
+    // it would be inserted
+    u64 find_container(u16 key) const;
+    ContainerType& get_or_create_container(u16 key);
+    void erase_container(u64 index);
+
+public:
+    class ConstIterator : public std::iterator<std::forward_iterator_tag, u32, i64,
+                                               const u32*, const u32&>
+    {
+        friend class RoaringBitmap;
+
+    private:
+        const RoaringBitmap* m_bitmap;
+        u64 m_container_index;
+        u32 m_value;
+
+        ConstIterator(const RoaringBitmap* bitmap, u64 container_index, u32 value);
+        void advance_to_valid();
+
+    public:
+        ConstIterator();
+        ConstIterator(const ConstIterator& other);
+        ~ConstIterator();
+
+        ConstIterator& operator = (const ConstIterator& other);
+
+        bool operator == (const ConstIterator& other) const;
+        bool operator != (const ConstIterator& other) const;
+
+        ConstIterator& operator ++ ();
+        ConstIterator operator ++ (int unused);
+        const u32& operator * () const;
+        const u32* operator -> () const;
+    };
+
+    typedef ConstIterator Iterator;
+
+    RoaringBitmap();
+    RoaringBitmap(std::initializer_list<u32> init_list);
+    template <typename InputIterator>
+    inline RoaringBitmap(const InputIterator& first, const InputIterator& last)
+        : RoaringBitmap()
+    {
+        for (auto it = first; it != last; ++it) {
+            add(*it);
+        }
+    }
+    RoaringBitmap(const RoaringBitmap& other);
+    RoaringBitmap(RoaringBitmap&& other);
+    ~RoaringBitmap();
+
+    RoaringBitmap& operator = (const RoaringBitmap& other);
+    RoaringBitmap& operator = (RoaringBitmap&& other);
+
+    // returns true iff the value was not already present
+    bool add(u32 value);
+    // adds [first, last]
+    void add_range(u32 first, u32 last);
+    // returns true iff the value was present
+    bool remove(u32 value);
+    bool contains(u32 value) const;
+
+    u64 cardinality() const;
+    bool empty() const;
+    void clear();
+
+    // number of values <= value
+    u64 rank(u32 value) const;
+    // the index-th smallest value; index must be less than cardinality()
+    u32 select(u64 index) const;
+    u32 get_min() const;
+    u32 get_max() const;
+
+    RoaringBitmap& operator &= (const RoaringBitmap& other);
+    RoaringBitmap& operator |= (const RoaringBitmap& other);
+    RoaringBitmap& operator ^= (const RoaringBitmap& other);
+    RoaringBitmap& operator -= (const RoaringBitmap& other);
+
+    RoaringBitmap operator & (const RoaringBitmap& other) const;
+    RoaringBitmap operator | (const RoaringBitmap& other) const;
+    RoaringBitmap operator ^ (const RoaringBitmap& other) const;
+    RoaringBitmap operator - (const RoaringBitmap& other) const;
+
+    bool intersects(const RoaringBitmap& other) const;
+    bool is_subset_of(const RoaringBitmap& other) const;
+
+    bool operator == (const RoaringBitmap& other) const;
+    bool operator != (const RoaringBitmap& other) const;
+
+    // converts partitions to runs where that saves space,
+    // returns true iff any partition is stored as runs afterwards
+    bool run_optimize();
+    // memory used by the values, excluding fixed overheads
+    u64 get_size_in_bytes() const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+    // a portable (little endian) binary representation,
+    // which can be written to and read from FilteredStreams,
+    // to get compression and the like
+    void serialize(std::ostream& out_stream) const;
+    // replaces the contents of this bitmap, throws an
+    // AurumIOException on malformed or truncated input
+    void deserialize(std::istream& in_stream);
+
+    std::string as_string(i64 verbosity) const;
+};
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_ROARING_BITMAP_HPP_ */
+
+//
+// RoaringBitmap.hpp ends here
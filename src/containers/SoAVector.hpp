@@ -0,0 +1,565 @@
+// SoAVector.hpp ---
+//
+// Filename: SoAVector.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:41:42 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_SOA_VECTOR_HPP_
+#define AURUM_CONTAINERS_SOA_VECTOR_HPP_
+
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
+#include <string>
+#include <sstream>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/Stringifiable.hpp"
+
+#include "Vector.hpp"
+#include "TupleUtils.hpp"
+
+namespace aurum {
+namespace containers {
+namespace soa_vector_detail_ {
+
+// A proxy iterator over an SoAVector, dereferencing yields a tuple
+// of references into the columns, so it works with range based for
+// loops and the algorithms which read or assign through iterators,
+// but not with the ones that need to swap two elements
+template <typename ContainerType, bool ISCONST>
+class SoAIterator
+    : public std::iterator<std::random_access_iterator_tag,
+                           typename ContainerType::ValueType, i64, void,
+                           typename std::conditional<ISCONST,
+                                                     typename ContainerType::ConstRefType,
+                                                     typename ContainerType::RefType>::type>
+{
+    friend class SoAIterator<ContainerType, !ISCONST>;
+
+private:
+    typedef typename std::conditional<ISCONST, const ContainerType*,
+                                      ContainerType*>::type ContainerPtrType;
+    typedef typename std::conditional<ISCONST, typename ContainerType::ConstRefType,
+                                      typename ContainerType::RefType>::type RefType;
+
+    ContainerPtrType m_container;
+    u64 m_index;
+
+public:
+    SoAIterator()
+        : m_container(nullptr), m_index(0)
+    {
+        // Nothing here
+    }
+
+    SoAIterator(ContainerPtrType container, u64 index)
+        : m_container(container), m_index(index)
+    {
+        // Nothing here
+    }
+
+    SoAIterator(const SoAIterator& other)
+        : m_container(other.m_container), m_index(other.m_index)
+    {
+        // Nothing here
+    }
+
+    template <bool OISCONST>
+    SoAIterator(const SoAIterator<ContainerType, OISCONST>& other)
+        : m_container(other.m_container), m_index(other.m_index)
+    {
+        static_assert(((!OISCONST) || ISCONST),
+                      "Cannot construct non-const iterator from const iterator");
+    }
+
+    ~SoAIterator()
+    {
+        // Nothing here
+    }
+
+    inline SoAIterator& operator = (const SoAIterator& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_container = other.m_container;
+        m_index = other.m_index;
+        return *this;
+    }
+
+    inline RefType operator * () const
+    {
+        return (*m_container)[m_index];
+    }
+
+    inline RefType operator [] (i64 n) const
+    {
+        return (*m_container)[m_index + n];
+    }
+
+    // the position of the element this iterator refers to
+    inline u64 get_index() const
+    {
+        return m_index;
+    }
+
+    template <bool OISCONST>
+    inline bool operator == (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (m_index == other.m_index && m_container == other.m_container);
+    }
+
+    template <bool OISCONST>
+    inline bool operator != (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (!(*this == other));
+    }
+
+    template <bool OISCONST>
+    inline bool operator < (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (m_index < other.m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool operator <= (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (m_index <= other.m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool operator > (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (m_index > other.m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool operator >= (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return (m_index >= other.m_index);
+    }
+
+    inline SoAIterator& operator ++ ()
+    {
+        ++m_index;
+        return *this;
+    }
+
+    inline SoAIterator operator ++ (int unused)
+    {
+        auto retval = *this;
+        ++m_index;
+        return retval;
+    }
+
+    inline SoAIterator& operator -- ()
+    {
+        --m_index;
+        return *this;
+    }
+
+    inline SoAIterator operator -- (int unused)
+    {
+        auto retval = *this;
+        --m_index;
+        return retval;
+    }
+
+    inline SoAIterator& operator += (i64 n)
+    {
+        m_index += n;
+        return *this;
+    }
+
+    inline SoAIterator& operator -= (i64 n)
+    {
+        m_index -= n;
+        return *this;
+    }
+
+    inline SoAIterator operator + (i64 n) const
+    {
+        return SoAIterator(m_container, m_index + n);
+    }
+
+    inline SoAIterator operator - (i64 n) const
+    {
+        return SoAIterator(m_container, m_index - n);
+    }
+
+    template <bool OISCONST>
+    inline i64 operator - (const SoAIterator<ContainerType, OISCONST>& other) const
+    {
+        return ((i64)m_index - (i64)other.m_index);
+    }
+};
+
+template <typename ContainerType, bool ISCONST>
+static inline SoAIterator<ContainerType, ISCONST>
+operator + (i64 n, const SoAIterator<ContainerType, ISCONST>& iter)
+{
+    return (iter + n);
+}
+
+} /* end namespace soa_vector_detail_ */
+
+// A vector of tuples, stored as a struct of arrays: each field of
+// the tuple lives in its own contiguous column, so that a loop
+// touching a few of the fields only pulls those into the cache,
+// and loops over a single column (see get_column()) can be
+// vectorized by the compiler.
+// Elements are accessed as tuples of references into the columns.
+template <typename... Ts>
+class SoAVector final : public AurumObject<SoAVector<Ts...> >,
+                        public Stringifiable<SoAVector<Ts...> >
+{
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+
+public:
+    typedef std::tuple<Ts...> ValueType;
+    typedef ValueType value_type;
+    typedef std::tuple<Ts&...> RefType;
+    typedef std::tuple<const Ts&...> ConstRefType;
+
+    typedef soa_vector_detail_::SoAIterator<SoAVector, false> Iterator;
+    typedef Iterator iterator;
+    typedef soa_vector_detail_::SoAIterator<SoAVector, true> ConstIterator;
+    typedef ConstIterator const_iterator;
+
+    template <u64 INDEX>
+    using ColumnType = typename std::tuple_element<INDEX, ValueType>::type;
+
+    static constexpr u64 sc_num_columns = sizeof...(Ts);
+
+private:
+    std::tuple<Vector<Ts>...> m_columns;
+
+public:
+    SoAVector()
+        : m_columns()
+    {
+        // Nothing here
+    }
+
+    explicit SoAVector(u64 size)
+        : m_columns()
+    {
+        resize(size);
+    }
+
+    SoAVector(std::initializer_list<ValueType> init_list)
+        : m_columns()
+    {
+        reserve(init_list.size());
+        for (auto const& value : init_list) {
+            push_back(value);
+        }
+    }
+
+    SoAVector(const SoAVector& other)
+        : m_columns(other.m_columns)
+    {
+        // Nothing here
+    }
+
+    SoAVector(SoAVector&& other)
+        : m_columns()
+    {
+        std::swap(m_columns, other.m_columns);
+    }
+
+    ~SoAVector()
+    {
+        // Nothing here
+    }
+
+    inline SoAVector& operator = (const SoAVector& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_columns = other.m_columns;
+        return *this;
+    }
+
+    inline SoAVector& operator = (SoAVector&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        std::swap(m_columns, other.m_columns);
+        return *this;
+    }
+
+    inline u64 size() const
+    {
+        return std::get<0>(m_columns).size();
+    }
+
+    inline bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    inline u64 capacity() const
+    {
+        return std::get<0>(m_columns).capacity();
+    }
+
+    inline void reserve(u64 new_capacity)
+    {
+        tuple_foreach(m_columns,
+                      [=] (auto& column) -> void
+                      {
+                          column.reserve(new_capacity);
+                      });
+    }
+
+    inline void resize(u64 new_size)
+    {
+        tuple_foreach(m_columns,
+                      [=] (auto& column) -> void
+                      {
+                          column.resize(new_size);
+                      });
+    }
+
+    inline void clear()
+    {
+        tuple_foreach(m_columns,
+                      [] (auto& column) -> void
+                      {
+                          column.clear();
+                      });
+    }
+
+    inline void push_back(const ValueType& value)
+    {
+        tuple_zip_foreach(m_columns, value,
+                          [] (auto& column, auto const& field) -> void
+                          {
+                              column.push_back(field);
+                          });
+    }
+
+    inline void push_back(ValueType&& value)
+    {
+        tuple_zip_foreach(m_columns, std::move(value),
+                          [] (auto& column, auto&& field) -> void
+                          {
+                              column.push_back(std::move(field));
+                          });
+    }
+
+    template <typename... ArgTypes>
+    inline void emplace_back(ArgTypes&&... args)
+    {
+        static_assert(sizeof...(ArgTypes) == sizeof...(Ts),
+                      "emplace_back needs exactly one argument per column");
+        tuple_zip_foreach(m_columns, std::forward_as_tuple(std::forward<ArgTypes>(args)...),
+                          [] (auto& column, auto&& field) -> void
+                          {
+                              column.push_back(std::forward<decltype(field)>(field));
+                          });
+    }
+
+    inline void pop_back()
+    {
+        tuple_foreach(m_columns,
+                      [] (auto& column) -> void
+                      {
+                          column.pop_back();
+                      });
+    }
+
+    inline void swap_elements(u64 index1, u64 index2)
+    {
+        tuple_foreach(m_columns,
+                      [=] (auto& column) -> void
+                      {
+                          std::swap(column[index1], column[index2]);
+                      });
+    }
+
+    // removes the element at index in constant time, by moving
+    // the last element into its place
+    inline void erase_unordered(u64 index)
+    {
+        tuple_foreach(m_columns,
+                      [=] (auto& column) -> void
+                      {
+                          column[index] = std::move(column.back());
+                          column.pop_back();
+                      });
+    }
+
+    inline RefType operator [] (u64 index)
+    {
+        return expand_tuple_and_apply(m_columns,
+                                      [=] (auto&... columns) -> RefType
+                                      {
+                                          return RefType(columns[index]...);
+                                      });
+    }
+
+    inline ConstRefType operator [] (u64 index) const
+    {
+        return expand_tuple_and_apply(m_columns,
+                                      [=] (auto const&... columns) -> ConstRefType
+                                      {
+                                          return ConstRefType(columns[index]...);
+                                      });
+    }
+
+    inline RefType front()
+    {
+        return (*this)[0];
+    }
+
+    inline ConstRefType front() const
+    {
+        return (*this)[0];
+    }
+
+    inline RefType back()
+    {
+        return (*this)[size() - 1];
+    }
+
+    inline ConstRefType back() const
+    {
+        return (*this)[size() - 1];
+    }
+
+    // a copy of the element at index
+    inline ValueType get_value(u64 index) const
+    {
+        return ValueType((*this)[index]);
+    }
+
+    // per column access, valid until the next operation that
+    // changes the size or capacity of this vector
+    template <u64 INDEX>
+    inline ColumnType<INDEX>* get_column()
+    {
+        return std::get<INDEX>(m_columns).data();
+    }
+
+    template <u64 INDEX>
+    inline const ColumnType<INDEX>* get_column() const
+    {
+        return std::get<INDEX>(m_columns).data();
+    }
+
+    template <u64 INDEX>
+    inline ColumnType<INDEX>& get(u64 index)
+    {
+        return std::get<INDEX>(m_columns)[index];
+    }
+
+    template <u64 INDEX>
+    inline const ColumnType<INDEX>& get(u64 index) const
+    {
+        return std::get<INDEX>(m_columns)[index];
+    }
+
+    inline Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+
+    inline Iterator end()
+    {
+        return Iterator(this, size());
+    }
+
+    inline ConstIterator begin() const
+    {
+        return ConstIterator(this, 0);
+    }
+
+    inline ConstIterator end() const
+    {
+        return ConstIterator(this, size());
+    }
+
+    inline ConstIterator cbegin() const
+    {
+        return begin();
+    }
+
+    inline ConstIterator cend() const
+    {
+        return end();
+    }
+
+    inline bool operator == (const SoAVector& other) const
+    {
+        return (m_columns == other.m_columns);
+    }
+
+    inline bool operator != (const SoAVector& other) const
+    {
+        return (!(m_columns == other.m_columns));
+    }
+
+    std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << "SoAVector with " << size() << " elements in "
+             << sc_num_columns << " columns:" << std::endl;
+        tuple_foreach(m_columns,
+                      [&] (auto const& column) -> void
+                      {
+                          sstr << column.to_string(verbosity) << std::endl;
+                      });
+        return sstr.str();
+    }
+};
+
+template <typename... Ts>
+constexpr u64 SoAVector<Ts...>::sc_num_columns;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_SOA_VECTOR_HPP_ */
+
+//
+// SoAVector.hpp ends here
@@ -38,26 +38,57 @@
 #if !defined AURUM_CONTAINERS_STATIC_BIT_SET_HPP_
 #define AURUM_CONTAINERS_STATIC_BIT_SET_HPP_
 
-#include <cstring>
-#include <utility>
+#include <initializer_list>
 #include <string>
 #include <sstream>
 
-#include "../basetypes/AurumBase.hpp"
 #include "../basetypes/AurumTypes.hpp"
-#include "../allocators/MemoryManager.hpp"
+#include "../basetypes/Stringifiable.hpp"
 
 namespace aurum {
 namespace containers {
 
+// A bit set whose size is fixed at compile time. The bits are
+// stored least significant bit first in u64 words, and the bits
+// beyond SIZE in the last word are always kept zero.
+// Construction and all the non-stringifying operations are
+// constexpr, so masks can be built at compile time. Since the
+// number of words is a compile time constant, the word loops are
+// fully unrolled by the compiler, and for sizes such as 128, 256 or
+// 512 bits they are lowered to SSE/AVX operations, depending
+// on the target flags.
 template <u64 SIZE>
 class StaticBitSet final : public AurumObject<aurum::containers::StaticBitSet<SIZE> >,
                            public Stringifiable<aurum::containers::StaticBitSet<SIZE> >
 {
 private:
     static constexpr u64 sc_num_bits = SIZE;
-    static constexpr u64 sc_num_bytes = (SIZE + 7) / 8;
-    u08 m_bit_array[sc_num_bytes];
+    static constexpr u64 sc_num_words = (SIZE == 0 ? 1 : (SIZE + 63) / 64);
+    static constexpr u64 sc_last_word_mask =
+        (SIZE == 0 ? (u64)0 : (SIZE % 64 == 0 ? ~(u64)0 : (((u64)1 << (SIZE % 64)) - 1)));
+
+    u64 m_words[sc_num_words];
+
+    static constexpr u64 get_mask(u64 bit_num)
+    {
+        return ((u64)1 << (bit_num % 64));
+    }
+
+    constexpr void clear_unused_bits()
+    {
+        m_words[sc_num_words - 1] &= sc_last_word_mask;
+    }
+
+    constexpr i32 compare(const StaticBitSet& other) const
+    {
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            const u64 diff = m_words[i] ^ other.m_words[i];
+            if (diff != 0) {
+                return ((m_words[i] & (diff & -diff)) != 0 ? 1 : -1);
+            }
+        }
+        return 0;
+    }
 
 public:
     class BitRef
@@ -111,7 +142,7 @@ public:
 
         inline bool operator != (const BitRef& other) const
         {
-            return ((bool)(*this) == (bool)(other));
+            return ((bool)(*this) != (bool)(other));
         }
 
         inline bool operator == (bool value) const
@@ -138,161 +169,292 @@ public:
         }
     };
 
-    inline StaticBitSet()
-        : StaticBitSet(false)
+    constexpr StaticBitSet()
+        : m_words()
     {
         // Nothing here
     }
 
-    inline StaticBitSet(bool initial_value)
+    constexpr StaticBitSet(bool initial_value)
+        : m_words()
     {
-        memset(m_bit_array, (initial_value ? 0xFF : 0), sc_num_bits / 8);
         if (initial_value) {
-            if (sc_num_bits % 8 != 0) {
-                u08 mask = 0;
-                for (u32 i = 0; i < sc_num_bits % 8; ++i) {
-                    mask >>= 1;
-                    mask |= (u08)0x80;
-                }
-                m_bit_array[sc_num_bits / 8] |= mask;
-            }
+            set();
         }
     }
 
-    inline StaticBitSet(const StaticBitSet& other)
+    constexpr StaticBitSet(const StaticBitSet& other) = default;
+    ~StaticBitSet() = default;
+    constexpr StaticBitSet& operator = (const StaticBitSet& other) = default;
+
+    // returns a bit set with exactly the bits in bit_nums set
+    static constexpr StaticBitSet from_bits(std::initializer_list<u64> bit_nums)
     {
-        memcpy(m_bit_array, other.m_bit_array, sc_num_bytes);
+        StaticBitSet retval;
+        for (auto bit_num : bit_nums) {
+            retval.set(bit_num);
+        }
+        return retval;
     }
 
-    inline ~StaticBitSet()
+    // returns a bit set with the bits in [first, last) set
+    static constexpr StaticBitSet from_range(u64 first, u64 last)
     {
-        // Nothing here
+        StaticBitSet retval;
+        retval.set_range(first, last);
+        return retval;
     }
 
-    inline StaticBitSet& operator = (const StaticBitSet& other)
+    constexpr bool operator == (const StaticBitSet& other) const
     {
-        if (&other == this) {
-            return *this;
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            if (m_words[i] != other.m_words[i]) {
+                return false;
+            }
         }
-        memcpy(m_bit_array, other.m_bit_array, sc_num_bytes);
-        return *this;
+        return true;
+    }
+
+    constexpr bool operator != (const StaticBitSet& other) const
+    {
+        return (!(*this == other));
+    }
+
+    constexpr bool operator < (const StaticBitSet& other) const
+    {
+        return (compare(other) < 0);
+    }
+
+    constexpr bool operator > (const StaticBitSet& other) const
+    {
+        return (compare(other) > 0);
     }
 
+    constexpr bool operator <= (const StaticBitSet& other) const
+    {
+        return (compare(other) <= 0);
+    }
 
-    inline bool operator == (const StaticBitSet& other) const
+    constexpr bool operator >= (const StaticBitSet& other) const
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) == 0);
+        return (compare(other) >= 0);
     }
 
-    inline bool operator != (const StaticBitSet& other) const
+    constexpr void set(u64 bit_num)
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) != 0);
+        m_words[bit_num / 64] |= get_mask(bit_num);
     }
 
-    inline bool operator < (const StaticBitSet& other) const
+    constexpr bool test(u64 bit_num) const
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) < 0);
+        return ((m_words[bit_num / 64] & get_mask(bit_num)) != 0);
     }
 
-    inline bool operator > (const StaticBitSet& other) const
+    constexpr void clear(u64 bit_num)
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) > 0);
+        m_words[bit_num / 64] &= ~get_mask(bit_num);
     }
 
-    inline bool operator <= (const StaticBitSet& other) const
+    // returns the value of bit before flip
+    constexpr bool flip(u64 bit_num)
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) <= 0);
+        const bool retval = test(bit_num);
+        m_words[bit_num / 64] ^= get_mask(bit_num);
+        return retval;
     }
 
-    inline bool operator >= (const StaticBitSet& other) const
+    // sets the bits in [first, last)
+    constexpr void set_range(u64 first, u64 last)
     {
-        return (memcmp(m_bit_array, other.m_bit_array, sc_num_bytes) >= 0);
+        for (; first < last && first % 64 != 0; ++first) {
+            set(first);
+        }
+        for (; first + 64 <= last; first += 64) {
+            m_words[first / 64] = ~(u64)0;
+        }
+        for (; first < last; ++first) {
+            set(first);
+        }
     }
 
-    inline void set(u64 bit_num)
+    // Gang set, clear and flip
+    constexpr void set()
     {
-        u64 offset = bit_num / 8;
-        const u64 bit_num_mod_8 = bit_num % 8;
-        u08 mask = 0x80;
-        if (bit_num_mod_8 != 0) {
-            mask >>= (bit_num_mod_8);
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] = ~(u64)0;
         }
-        m_bit_array[offset] |= mask;
+        clear_unused_bits();
     }
 
-    inline bool test(u64 bit_num) const
+    constexpr void clear()
     {
-        u64 offset = bit_num / 8;
-        const u32 bit_num_mod_8 = bit_num % 8;
-        u08 mask = 0x80;
-        if (bit_num_mod_8 != 0) {
-            mask >>= (bit_num_mod_8);
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] = 0;
         }
-        return (((m_bit_array[offset] & mask) == 0) ? false : true);
     }
 
-    inline void clear(u64 bit_num)
+    constexpr void flip()
     {
-        u64 offset = bit_num / 8;
-        const u32 bit_num_mod_8 = bit_num % 8;
-        u08 mask = 0x80;
-        if (bit_num_mod_8 != 0) {
-            mask >>= (bit_num_mod_8);
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] = ~m_words[i];
         }
-        m_bit_array[offset] &= (~mask);
+        clear_unused_bits();
     }
 
-    // returns the value of bit before flip
-    inline bool flip(u64 bit_num)
+    // set algebra
+    constexpr StaticBitSet& operator &= (const StaticBitSet& other)
+    {
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] &= other.m_words[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticBitSet& operator |= (const StaticBitSet& other)
     {
-        u32 offset = bit_num / 8;
-        const u32 bit_num_mod_8 = bit_num % 8;
-        u08 mask = 0x80;
-        if (bit_num_mod_8 != 0) {
-            mask >>= (bit_num_mod_8);
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] |= other.m_words[i];
         }
-        bool retval = (((m_bit_array[offset] & mask) == 0) ? false : true);
-        if (retval) {
-            m_bit_array[offset] &= (~mask);
-        } else {
-            m_bit_array[offset] |= mask;
+        return *this;
+    }
+
+    constexpr StaticBitSet& operator ^= (const StaticBitSet& other)
+    {
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] ^= other.m_words[i];
         }
+        return *this;
+    }
+
+    // set difference
+    constexpr StaticBitSet& operator -= (const StaticBitSet& other)
+    {
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            m_words[i] &= ~other.m_words[i];
+        }
+        return *this;
+    }
+
+    constexpr StaticBitSet operator & (const StaticBitSet& other) const
+    {
+        StaticBitSet retval(*this);
+        retval &= other;
         return retval;
     }
 
-    // Gang set, clear and flip
-    inline void set()
-    {
-        memset(m_bit_array, 0xFF, sc_num_bits / 8);
-        // take care of the last few bits.
-        if (sc_num_bits % 8 != 0) {
-            u32 mask = 0;
-            for (u32 i = 0; i < sc_num_bits % 8; ++i) {
-                mask >>= 1;
-                mask |= (u08)0x80;
+    constexpr StaticBitSet operator | (const StaticBitSet& other) const
+    {
+        StaticBitSet retval(*this);
+        retval |= other;
+        return retval;
+    }
+
+    constexpr StaticBitSet operator ^ (const StaticBitSet& other) const
+    {
+        StaticBitSet retval(*this);
+        retval ^= other;
+        return retval;
+    }
+
+    constexpr StaticBitSet operator - (const StaticBitSet& other) const
+    {
+        StaticBitSet retval(*this);
+        retval -= other;
+        return retval;
+    }
+
+    constexpr StaticBitSet operator ~ () const
+    {
+        StaticBitSet retval(*this);
+        retval.flip();
+        return retval;
+    }
+
+    // number of set bits
+    constexpr u64 count() const
+    {
+        u64 retval = 0;
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            retval += __builtin_popcountll(m_words[i]);
+        }
+        return retval;
+    }
+
+    constexpr bool any() const
+    {
+        u64 accumulated = 0;
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            accumulated |= m_words[i];
+        }
+        return (accumulated != 0);
+    }
+
+    constexpr bool none() const
+    {
+        return (!any());
+    }
+
+    constexpr bool all() const
+    {
+        for (u64 i = 0; i + 1 < sc_num_words; ++i) {
+            if (m_words[i] != ~(u64)0) {
+                return false;
             }
-            m_bit_array[sc_num_bits / 8] |= mask;
         }
+        return (m_words[sc_num_words - 1] == sc_last_word_mask);
     }
 
-    inline void clear()
+    constexpr bool is_subset_of(const StaticBitSet& other) const
     {
-        memset(m_bit_array, 0, (sc_num_bits + 7) / 8);
+        u64 accumulated = 0;
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            accumulated |= (m_words[i] & ~other.m_words[i]);
+        }
+        return (accumulated == 0);
     }
 
-    inline void flip()
+    constexpr bool intersects(const StaticBitSet& other) const
     {
-        for (u64 i = 0; i < sc_num_bits / 8; ++i) {
-            m_bit_array[i] = (~(m_bit_array[i]));
+        u64 accumulated = 0;
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            accumulated |= (m_words[i] & other.m_words[i]);
         }
-        // take care of the last few bits with
-        // explicit calls
-        for (u32 i = 0; i < sc_num_bits % 8; ++i) {
-            flip(((sc_num_bits / 8) * 8) + i);
+        return (accumulated != 0);
+    }
+
+    // iteration over the set bits, both return size() if there
+    // are no more set bits:
+    // for (auto i = bs.find_first(); i < bs.size(); i = bs.find_next(i)) { ... }
+    constexpr u64 find_first() const
+    {
+        for (u64 i = 0; i < sc_num_words; ++i) {
+            if (m_words[i] != 0) {
+                return ((i * 64) + __builtin_ctzll(m_words[i]));
+            }
         }
+        return sc_num_bits;
+    }
+
+    constexpr u64 find_next(u64 bit_num) const
+    {
+        ++bit_num;
+        if (bit_num >= sc_num_bits) {
+            return sc_num_bits;
+        }
+
+        const u64 word = m_words[bit_num / 64] & (~(u64)0 << (bit_num % 64));
+        if (word != 0) {
+            return (((bit_num / 64) * 64) + __builtin_ctzll(word));
+        }
+        for (u64 i = (bit_num / 64) + 1; i < sc_num_words; ++i) {
+            if (m_words[i] != 0) {
+                return ((i * 64) + __builtin_ctzll(m_words[i]));
+            }
+        }
+        return sc_num_bits;
     }
 
-    inline bool operator [] (u64 bit_num) const
+    constexpr bool operator [] (u64 bit_num) const
     {
         return test(bit_num);
     }
@@ -302,28 +464,44 @@ public:
         return BitRef(this, bit_num);
     }
 
-    inline u64 size() const
+    constexpr u64 size() const
     {
         return sc_num_bits;
     }
 
+    constexpr const u64* get_words() const
+    {
+        return m_words;
+    }
+
+    static constexpr u64 get_word_count()
+    {
+        return sc_num_words;
+    }
+
     inline std::string as_string(i64 verbosity) const
     {
         std::ostringstream sstr;
-        sstr << "StaticBitSet<" << SIZE << ">:" << std::endl;
-        sstr << "{" << std::endl;
-        for (u64 i = 0; i < sc_num_bits; ++i) {
-            if (test(i)) {
-                sstr << " " << i << " -> 1" << std::endl;
-            } else {
-                sstr << " " << i << " -> 0" << std::endl;
-            }
+        sstr << "StaticBitSet<" << SIZE << ">: {";
+        bool first = true;
+        for (auto i = find_first(); i < sc_num_bits; i = find_next(i)) {
+            sstr << (first ? " " : ", ") << i;
+            first = false;
         }
         sstr << " }";
         return sstr.str();
     }
 };
 
+template <u64 SIZE>
+constexpr u64 StaticBitSet<SIZE>::sc_num_bits;
+
+template <u64 SIZE>
+constexpr u64 StaticBitSet<SIZE>::sc_num_words;
+
+template <u64 SIZE>
+constexpr u64 StaticBitSet<SIZE>::sc_last_word_mask;
+
 } /* end namespace containers */
 } /* end namespace aurum */
 
@@ -70,6 +70,28 @@ apply_on_index_(TupleType&& the_tuple,
     fun_object(std::get<INDEX>(std::forward<TupleType>(the_tuple)));
 }
 
+template <u64 INDEX, typename TupleType1, typename TupleType2, typename FuncType>
+inline typename std::enable_if<INDEX == (std::size_t)0, void>::type
+zip_apply_on_index_(TupleType1&& tuple1, TupleType2&& tuple2,
+                    FuncType&& fun_object)
+{
+    fun_object(std::get<INDEX>(std::forward<TupleType1>(tuple1)),
+               std::get<INDEX>(std::forward<TupleType2>(tuple2)));
+}
+
+template <u64 INDEX, typename TupleType1, typename TupleType2, typename FuncType>
+inline typename std::enable_if<INDEX != (std::size_t)0, void>::type
+zip_apply_on_index_(TupleType1&& tuple1, TupleType2&& tuple2,
+                    FuncType&& fun_object)
+{
+    zip_apply_on_index_<INDEX-1>(std::forward<TupleType1>(tuple1),
+                                 std::forward<TupleType2>(tuple2),
+                                 std::forward<FuncType>(fun_object));
+
+    fun_object(std::get<INDEX>(std::forward<TupleType1>(tuple1)),
+               std::get<INDEX>(std::forward<TupleType2>(tuple2)));
+}
+
 template <typename TupleType, typename FuncType, std::size_t... INDEX>
 decltype(auto) expand_tuple_and_apply_helper_(TupleType&& the_tuple,
                                               FuncType&& fun_object,
@@ -88,6 +110,20 @@ void tuple_foreach(TupleType&& the_tuple, FuncType&& fun_object)
                                            std::forward<FuncType>(fun_object));
 }
 
+// applies fun_object to the corresponding elements of two
+// tuples of the same size, in order
+template <typename TupleType1, typename TupleType2, typename FuncType>
+void tuple_zip_foreach(TupleType1&& tuple1, TupleType2&& tuple2, FuncType&& fun_object)
+{
+    constexpr auto TUPLE_SIZE = std::tuple_size<typename std::decay<TupleType1>::type>::value;
+    static_assert(TUPLE_SIZE ==
+                  std::tuple_size<typename std::decay<TupleType2>::type>::value,
+                  "tuple_zip_foreach needs tuples of the same size");
+    detail_::zip_apply_on_index_<TUPLE_SIZE-1>(std::forward<TupleType1>(tuple1),
+                                               std::forward<TupleType2>(tuple2),
+                                               std::forward<FuncType>(fun_object));
+}
+
 template <typename TupleType, typename FuncType>
 inline decltype(auto)
 expand_tuple_and_apply(TupleType&& the_tuple, FuncType&& fun_object)
@@ -221,8 +221,8 @@ public:
     inline void set_special_values_(const std::true_type& is_pointer_type,
                                     const std::false_type& is_managed_pointer)
     {
-        set_deleted_value(std::make_pair((const MappedKeyType)0x1, MappedValueType()));
-        set_nonused_value(std::make_pair((const MappedKeyType)0x0, MappedValueType()));
+        set_deleted_value((MappedKeyType)0x1);
+        set_nonused_value((MappedKeyType)0x0);
     }
 
     inline void set_special_values_(const std::false_type& is_pointer_type,
@@ -234,10 +234,8 @@ public:
     inline void set_special_values_(const std::false_type& is_pointer_type,
                                     const std::true_type& is_managed_pointer)
     {
-        MappedKeyType deleted_value((typename MappedKeyType::RawPointerType)0x1);
-        MappedKeyType nonused_value((typename MappedKeyType::RawPointerType)0x0);
-        set_deleted_value(std::make_pair((const MappedKeyType)deleted_value, MappedValueType()));
-        set_nonused_value(std::make_pair((const MappedKeyType)nonused_value, MappedValueType()));
+        set_deleted_value(MappedKeyType::get_deleted_marker_());
+        set_nonused_value(MappedKeyType::get_nonused_marker_());
     }
 
     inline void set_special_values_()
@@ -0,0 +1,1329 @@
+// UnrolledDList.hpp ---
+//
+// Filename: UnrolledDList.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:03:18 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_UNROLLED_DLIST_HPP_
+#define AURUM_CONTAINERS_UNROLLED_DLIST_HPP_
+
+#include <algorithm>
+#include <initializer_list>
+#include <iomanip>
+#include <sstream>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/AurumErrors.hpp"
+#include "../basetypes/Stringifiable.hpp"
+#include "../allocators/MemoryManager.hpp"
+#include "../allocators/PoolAllocator.hpp"
+#include "../stringification/Stringifiers.hpp"
+
+#include "UnrolledDListTypes.hpp"
+
+namespace aurum {
+namespace containers {
+
+namespace aa = aurum::allocators;
+namespace ac = aurum::containers;
+namespace as = aurum::stringification;
+
+// An unrolled doubly linked list: each node holds up to
+// sc_node_capacity elements, sized so that a node occupies
+// (roughly) NODEBYTES bytes. Traversals, sorts and merges then
+// walk mostly contiguous memory. The interface mirrors DListBase,
+// except that iterators into a node are invalidated by insertions
+// and erasures which touch that node.
+template <typename T, bool USEPOOLS, u32 NODEBYTES>
+class UnrolledDListBase final
+    : public AurumObject<ac::UnrolledDListBase<T, USEPOOLS, NODEBYTES> >,
+      public Stringifiable<UnrolledDListBase<T, USEPOOLS, NODEBYTES> >
+{
+public:
+    static constexpr u32 sc_node_capacity =
+        unrolled_dlist_detail_::UnrolledDListNodeCapacity<T, NODEBYTES>::value;
+
+    typedef T ValueType;
+    typedef T value_type;
+    typedef T* PtrType;
+    typedef const T* ConstPtrType;
+    typedef T& RefType;
+    typedef const T& ConstRefType;
+
+    typedef unrolled_dlist_detail_::Iterator<T, sc_node_capacity> Iterator;
+    typedef Iterator iterator;
+    typedef unrolled_dlist_detail_::ConstIterator<T, sc_node_capacity> ConstIterator;
+    typedef ConstIterator const_iterator;
+    typedef std::reverse_iterator<iterator> ReverseIterator;
+    typedef ReverseIterator reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> ConstReverseIterator;
+    typedef ConstReverseIterator const_reverse_iterator;
+
+private:
+    typedef unrolled_dlist_detail_::UnrolledDListNodeBase NodeBaseType;
+    typedef unrolled_dlist_detail_::UnrolledDListNode<T, sc_node_capacity> NodeType;
+    typedef aurum::containers::UnrolledDListBase<T, USEPOOLS, NODEBYTES> MyType;
+
+    template <typename, bool, u32> friend class ac::UnrolledDListBase;
+
+public:
+    static const u64 sc_node_size;
+
+private:
+    aa::PoolAllocator* m_pool_allocator;
+    u64 m_size;
+    NodeBaseType m_root;
+    bool m_pool_owned;
+
+    static inline T* values_of(NodeBaseType* node)
+    {
+        return static_cast<NodeType*>(node)->get_values();
+    }
+
+    // moves count elements from src into the (uninitialized) dst
+    static inline void move_elements(T* dst, T* src, u32 count)
+    {
+        for (u32 i = 0; i < count; ++i) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+
+    // opens up a hole at index, in a node with count elements
+    static inline void open_hole(T* values, u32 index, u32 count)
+    {
+        for (u32 i = count; i > index; --i) {
+            new (values + i) T(std::move(values[i - 1]));
+            values[i - 1].~T();
+        }
+    }
+
+    // closes the (already destroyed) slot at index,
+    // in a node which had count elements
+    static inline void close_hole(T* values, u32 index, u32 count)
+    {
+        for (u32 i = index + 1; i < count; ++i) {
+            new (values + i - 1) T(std::move(values[i]));
+            values[i].~T();
+        }
+    }
+
+    inline NodeType* allocate_node()
+    {
+        if (USEPOOLS) {
+            if (m_pool_allocator == nullptr) {
+                m_pool_allocator = aa::allocate_object_raw<aa::PoolAllocator>(sizeof(NodeType));
+            }
+            return NodeType::construct(m_pool_allocator->allocate());
+        } else {
+            return NodeType::construct(aa::allocate_raw(sizeof(NodeType)));
+        }
+    }
+
+    // the elements of the node must already have been destroyed
+    inline void deallocate_node(NodeBaseType* node)
+    {
+        if (USEPOOLS) {
+            aa::deallocate(*(m_pool_allocator), static_cast<NodeType*>(node));
+        } else {
+            aa::deallocate_object_raw(static_cast<NodeType*>(node), sizeof(NodeType));
+        }
+    }
+
+    static inline void link_after(NodeBaseType* position, NodeBaseType* node)
+    {
+        node->m_prev = position;
+        node->m_next = position->m_next;
+        position->m_next->m_prev = node;
+        position->m_next = node;
+    }
+
+    static inline void unlink(NodeBaseType* node)
+    {
+        node->m_prev->m_next = node->m_next;
+        node->m_next->m_prev = node->m_prev;
+    }
+
+    inline void destroy_node(NodeBaseType* node)
+    {
+        auto values = values_of(node);
+        for (u32 i = 0, last = node->m_count; i < last; ++i) {
+            values[i].~T();
+        }
+        node->m_count = 0;
+        deallocate_node(node);
+    }
+
+    // splits node so that the elements at and after index
+    // move into a fresh node linked right after it
+    inline NodeBaseType* split_node(NodeBaseType* node, u32 index)
+    {
+        auto new_node = allocate_node();
+        link_after(node, new_node);
+        move_elements(values_of(new_node), values_of(node) + index, node->m_count - index);
+        new_node->m_count = node->m_count - index;
+        node->m_count = index;
+        return new_node;
+    }
+
+    template <typename... ArgTypes>
+    inline Iterator construct_in_node(NodeBaseType* node, u32 index, ArgTypes&&... args)
+    {
+        AURUM_ASSERT(node->m_count < sc_node_capacity);
+
+        auto values = values_of(node);
+        open_hole(values, index, node->m_count);
+        new (values + index) T(std::forward<ArgTypes>(args)...);
+        ++(node->m_count);
+        ++m_size;
+        return Iterator(node, index);
+    }
+
+    // constructs a new element before (node, index)
+    template <typename... ArgTypes>
+    inline Iterator construct_at(NodeBaseType* node, u32 index, ArgTypes&&... args)
+    {
+        if (index == 0) {
+            // try to append to the previous node first
+            auto prev = node->m_prev;
+            if (prev != &m_root && prev->m_count < sc_node_capacity) {
+                return construct_in_node(prev, prev->m_count, std::forward<ArgTypes>(args)...);
+            }
+            if (node == &m_root || node->m_count == sc_node_capacity) {
+                auto new_node = allocate_node();
+                link_after(prev, new_node);
+                return construct_in_node(new_node, 0, std::forward<ArgTypes>(args)...);
+            }
+        }
+
+        if (node->m_count < sc_node_capacity) {
+            return construct_in_node(node, index, std::forward<ArgTypes>(args)...);
+        }
+
+        // full node, split it in half
+        const u32 half = sc_node_capacity / 2;
+        auto new_node = split_node(node, half);
+        if (index <= half) {
+            return construct_in_node(node, index, std::forward<ArgTypes>(args)...);
+        } else {
+            return construct_in_node(new_node, index - half, std::forward<ArgTypes>(args)...);
+        }
+    }
+
+    // destroys the element at (node, index) and returns an
+    // iterator to the element that followed it
+    inline Iterator erase_at(NodeBaseType* node, u32 index)
+    {
+        auto values = values_of(node);
+        values[index].~T();
+        close_hole(values, index, node->m_count);
+        --(node->m_count);
+        --m_size;
+
+        if (node->m_count == 0) {
+            auto next = node->m_next;
+            unlink(node);
+            deallocate_node(node);
+            return Iterator(next, 0);
+        }
+
+        // fold the next node into this one if both are sparse
+        auto next = node->m_next;
+        if (next != &m_root &&
+            node->m_count + next->m_count <= (3 * sc_node_capacity) / 4) {
+            move_elements(values + node->m_count, values_of(next), next->m_count);
+            node->m_count += next->m_count;
+            next->m_count = 0;
+            unlink(next);
+            deallocate_node(next);
+            return Iterator(node, index);
+        }
+
+        if (index == node->m_count) {
+            return Iterator(node->m_next, 0);
+        }
+        return Iterator(node, index);
+    }
+
+    inline NodeBaseType* last_node_with_room()
+    {
+        auto last = m_root.m_prev;
+        if (last == &m_root || last->m_count == sc_node_capacity) {
+            auto new_node = allocate_node();
+            link_after(last, new_node);
+            return new_node;
+        }
+        return last;
+    }
+
+    template <typename... ArgTypes>
+    inline void construct_back(ArgTypes&&... args)
+    {
+        auto node = last_node_with_room();
+        new (values_of(node) + node->m_count) T(std::forward<ArgTypes>(args)...);
+        ++(node->m_count);
+        ++m_size;
+    }
+
+    inline void construct_fill_back(u64 n, const ValueType& value)
+    {
+        for (u64 i = 0; i < n; ++i) {
+            construct_back(value);
+        }
+    }
+
+    template <typename InputIterator>
+    inline void construct_range_back(const InputIterator& first, const InputIterator& last)
+    {
+        for (auto it = first; it != last; ++it) {
+            construct_back(*it);
+        }
+    }
+
+    // takes over the nodes of other, which must not share
+    // nodes with this list. The list is assumed to be empty
+    inline void take_nodes(MyType& other)
+    {
+        if (other.m_root.m_next == &(other.m_root)) {
+            m_root.m_next = &m_root;
+            m_root.m_prev = &m_root;
+        } else {
+            m_root.m_next = other.m_root.m_next;
+            m_root.m_prev = other.m_root.m_prev;
+            m_root.m_next->m_prev = &m_root;
+            m_root.m_prev->m_next = &m_root;
+        }
+        m_size = other.m_size;
+
+        other.m_root.m_next = &(other.m_root);
+        other.m_root.m_prev = &(other.m_root);
+        other.m_size = 0;
+    }
+
+    inline void swap_nodes(MyType& other)
+    {
+        NodeBaseType temp_root;
+        auto temp_size = m_size;
+
+        // temp_root <- this
+        if (!empty()) {
+            temp_root.m_next = m_root.m_next;
+            temp_root.m_prev = m_root.m_prev;
+            temp_root.m_next->m_prev = &temp_root;
+            temp_root.m_prev->m_next = &temp_root;
+        }
+
+        take_nodes(other);
+
+        // other <- temp_root
+        if (temp_root.m_next != &temp_root) {
+            other.m_root.m_next = temp_root.m_next;
+            other.m_root.m_prev = temp_root.m_prev;
+            other.m_root.m_next->m_prev = &(other.m_root);
+            other.m_root.m_prev->m_next = &(other.m_root);
+        }
+        other.m_size = temp_size;
+    }
+
+    // refills the nodes of this list (which must contain no
+    // live elements) from buffer, packing each node fully.
+    // Surplus nodes are released, and nodes are allocated as needed.
+    inline void refill_from_buffer(T* buffer, u64 num_elements)
+    {
+        auto node = m_root.m_next;
+        u64 consumed = 0;
+
+        while (consumed < num_elements) {
+            if (node == &m_root) {
+                node = allocate_node();
+                link_after(m_root.m_prev, node);
+            }
+            auto num_to_move = (u32)std::min((u64)sc_node_capacity, num_elements - consumed);
+            move_elements(values_of(node), buffer + consumed, num_to_move);
+            node->m_count = num_to_move;
+            consumed += num_to_move;
+            node = node->m_next;
+        }
+
+        while (node != &m_root) {
+            auto next = node->m_next;
+            unlink(node);
+            deallocate_node(node);
+            node = next;
+        }
+        m_size = num_elements;
+    }
+
+    // streams through the list, keeping only the elements for
+    // which keep(last_kept_ptr, element) is true. Kept elements
+    // are packed towards the front, so that the list ends up
+    // densely packed
+    template <typename KeepPredicate>
+    inline void compact(KeepPredicate keep)
+    {
+        if (empty()) {
+            return;
+        }
+
+        auto write_node = m_root.m_next;
+        u32 write_index = 0;
+        T* last_kept = nullptr;
+        u64 num_kept = 0;
+
+        for (auto read_node = m_root.m_next; read_node != &m_root;
+             read_node = read_node->m_next) {
+            auto read_values = values_of(read_node);
+            for (u32 i = 0, last = read_node->m_count; i < last; ++i) {
+                if (!keep(static_cast<const T*>(last_kept),
+                          static_cast<const T&>(read_values[i]))) {
+                    read_values[i].~T();
+                    continue;
+                }
+
+                if (write_index == sc_node_capacity) {
+                    write_node->m_count = sc_node_capacity;
+                    write_node = write_node->m_next;
+                    write_index = 0;
+                }
+
+                auto write_slot = values_of(write_node) + write_index;
+                if (write_slot != read_values + i) {
+                    new (write_slot) T(std::move(read_values[i]));
+                    read_values[i].~T();
+                }
+                last_kept = write_slot;
+                ++write_index;
+                ++num_kept;
+            }
+        }
+
+        // release everything after the last write position
+        auto first_free = write_node->m_next;
+        write_node->m_count = write_index;
+        if (write_index == 0) {
+            first_free = write_node;
+        }
+
+        auto new_last = first_free->m_prev;
+        for (auto node = first_free; node != &m_root; ) {
+            auto next = node->m_next;
+            deallocate_node(node);
+            node = next;
+        }
+        new_last->m_next = &m_root;
+        m_root.m_prev = new_last;
+        m_size = num_kept;
+    }
+
+public:
+    UnrolledDListBase()
+        : m_pool_allocator(nullptr), m_size(0),
+          m_root(&(this->m_root), &(this->m_root)), m_pool_owned(true)
+    {
+        // Nothing here
+    }
+
+    // the pool must not go away as long as the list is alive,
+    // and must have been created with a block size of sc_node_size
+    explicit UnrolledDListBase(aa::PoolAllocator* pool_allocator)
+        : UnrolledDListBase()
+    {
+        static_assert(USEPOOLS,
+                      "Cannot construct non-pooled UnrolledDList with a "
+                      "user provided pool allocator");
+        m_pool_allocator = pool_allocator;
+        m_pool_owned = false;
+    }
+
+    explicit UnrolledDListBase(u64 n)
+        : UnrolledDListBase(n, ValueType())
+    {
+        // Nothing here
+    }
+
+    UnrolledDListBase(u64 n, const ValueType& value)
+        : UnrolledDListBase()
+    {
+        construct_fill_back(n, value);
+    }
+
+    template <typename InputIterator>
+    UnrolledDListBase(const InputIterator& first, const InputIterator& last)
+        : UnrolledDListBase()
+    {
+        construct_range_back(first, last);
+    }
+
+    template <typename InputIterator>
+    UnrolledDListBase(const InputIterator& first, const InputIterator& last,
+                      aa::PoolAllocator* pool_allocator)
+        : UnrolledDListBase(pool_allocator)
+    {
+        construct_range_back(first, last);
+    }
+
+    UnrolledDListBase(const UnrolledDListBase& other)
+        : UnrolledDListBase(other.begin(), other.end())
+    {
+        // Nothing here
+    }
+
+    UnrolledDListBase(UnrolledDListBase&& other)
+        : UnrolledDListBase()
+    {
+        std::swap(m_pool_allocator, other.m_pool_allocator);
+        std::swap(m_pool_owned, other.m_pool_owned);
+        take_nodes(other);
+    }
+
+    template <bool OUSEPOOLS>
+    UnrolledDListBase(const ac::UnrolledDListBase<T, OUSEPOOLS, NODEBYTES>& other)
+        : UnrolledDListBase(other.begin(), other.end())
+    {
+        // Nothing here
+    }
+
+    UnrolledDListBase(std::initializer_list<ValueType> init_list)
+        : UnrolledDListBase(init_list.begin(), init_list.end())
+    {
+        // Nothing here
+    }
+
+    UnrolledDListBase(std::initializer_list<ValueType> init_list,
+                      aa::PoolAllocator* pool_allocator)
+        : UnrolledDListBase(init_list.begin(), init_list.end(), pool_allocator)
+    {
+        // Nothing here
+    }
+
+    inline void reset()
+    {
+        for (auto node = m_root.m_next; node != &m_root; ) {
+            auto next_node = node->m_next;
+            destroy_node(node);
+            node = next_node;
+        }
+
+        if (USEPOOLS && m_pool_allocator != nullptr) {
+            if (m_pool_owned) {
+                aa::deallocate_object_raw(m_pool_allocator,
+                                          sizeof(aa::PoolAllocator));
+                m_pool_allocator = nullptr;
+            }
+        }
+        m_root.m_next = &m_root;
+        m_root.m_prev = &m_root;
+        m_size = 0;
+    }
+
+    ~UnrolledDListBase()
+    {
+        reset();
+    }
+
+    template <typename InputIterator>
+    inline void assign(const InputIterator& first, const InputIterator& last)
+    {
+        reset();
+        construct_range_back(first, last);
+    }
+
+    template <bool OUSEPOOLS>
+    inline void assign(const ac::UnrolledDListBase<T, OUSEPOOLS, NODEBYTES>& other)
+    {
+        assign(other.begin(), other.end());
+    }
+
+    void assign(u64 n, const ValueType& value)
+    {
+        reset();
+        construct_fill_back(n, value);
+    }
+
+    void assign(std::initializer_list<ValueType> init_list)
+    {
+        assign(init_list.begin(), init_list.end());
+    }
+
+    inline UnrolledDListBase& operator = (const UnrolledDListBase& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        assign(other);
+        return *this;
+    }
+
+    template <bool OUSEPOOLS>
+    inline UnrolledDListBase&
+    operator = (const ac::UnrolledDListBase<T, OUSEPOOLS, NODEBYTES>& other)
+    {
+        assign(other);
+        return *this;
+    }
+
+    inline UnrolledDListBase& operator = (UnrolledDListBase&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+
+        reset();
+        std::swap(m_pool_allocator, other.m_pool_allocator);
+        std::swap(m_pool_owned, other.m_pool_owned);
+        swap_nodes(other);
+        return *this;
+    }
+
+    inline UnrolledDListBase& operator = (std::initializer_list<ValueType> init_list)
+    {
+        assign(init_list);
+        return *this;
+    }
+
+    Iterator begin() noexcept
+    {
+        return Iterator(m_root.m_next, 0);
+    }
+
+    ConstIterator begin() const noexcept
+    {
+        return ConstIterator(m_root.m_next, 0);
+    }
+
+    Iterator end() noexcept
+    {
+        return Iterator(&m_root, 0);
+    }
+
+    ConstIterator end() const noexcept
+    {
+        return ConstIterator(const_cast<NodeBaseType*>(&m_root), 0);
+    }
+
+    ConstIterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept
+    {
+        return end();
+    }
+
+    ReverseIterator rbegin() noexcept
+    {
+        return ReverseIterator(end());
+    }
+
+    ReverseIterator rend() noexcept
+    {
+        return ReverseIterator(begin());
+    }
+
+    ConstReverseIterator rbegin() const noexcept
+    {
+        return ConstReverseIterator(end());
+    }
+
+    ConstReverseIterator rend() const noexcept
+    {
+        return ConstReverseIterator(begin());
+    }
+
+    ConstReverseIterator crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    ConstReverseIterator crend() const noexcept
+    {
+        return rend();
+    }
+
+    bool empty() const noexcept
+    {
+        return (m_size == 0);
+    }
+
+    u64 size() const noexcept
+    {
+        return m_size;
+    }
+
+    u64 max_size() const noexcept
+    {
+        return UINT64_MAX;
+    }
+
+    RefType front()
+    {
+        return values_of(m_root.m_next)[0];
+    }
+
+    ConstRefType front() const
+    {
+        return values_of(m_root.m_next)[0];
+    }
+
+    RefType back()
+    {
+        return values_of(m_root.m_prev)[m_root.m_prev->m_count - 1];
+    }
+
+    ConstRefType back() const
+    {
+        return values_of(m_root.m_prev)[m_root.m_prev->m_count - 1];
+    }
+
+    template <typename... ArgTypes>
+    void emplace_front(ArgTypes&&... args)
+    {
+        construct_at(m_root.m_next, 0, std::forward<ArgTypes>(args)...);
+    }
+
+    void push_front(const ValueType& value)
+    {
+        construct_at(m_root.m_next, 0, value);
+    }
+
+    void push_front(ValueType&& value)
+    {
+        construct_at(m_root.m_next, 0, std::move(value));
+    }
+
+    void pop_front()
+    {
+        if (empty()) {
+            return;
+        }
+        erase_at(m_root.m_next, 0);
+    }
+
+    template <typename... ArgTypes>
+    void emplace_back(ArgTypes&&... args)
+    {
+        construct_back(std::forward<ArgTypes>(args)...);
+    }
+
+    void push_back(const ValueType& value)
+    {
+        construct_back(value);
+    }
+
+    void push_back(ValueType&& value)
+    {
+        construct_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        if (empty()) {
+            return;
+        }
+        auto last = m_root.m_prev;
+        erase_at(last, last->m_count - 1);
+    }
+
+    template <typename... ArgTypes>
+    Iterator emplace(const ConstIterator& position, ArgTypes&&... args)
+    {
+        return construct_at(position.get_node(), position.get_index(),
+                            std::forward<ArgTypes>(args)...);
+    }
+
+    Iterator insert(const ConstIterator& position, const ValueType& value)
+    {
+        return construct_at(position.get_node(), position.get_index(), value);
+    }
+
+    Iterator insert(const ConstIterator& position, ValueType&& value)
+    {
+        return construct_at(position.get_node(), position.get_index(), std::move(value));
+    }
+
+    Iterator insert(const ConstIterator& position, u64 n, const ValueType& value)
+    {
+        Iterator it(position.get_node(), position.get_index());
+        for (u64 i = 0; i < n; ++i) {
+            it = construct_at(it.get_node(), it.get_index(), value);
+            ++it;
+        }
+        for (u64 i = 0; i < n; ++i) {
+            --it;
+        }
+        return it;
+    }
+
+    template <typename InputIterator>
+    Iterator insert(const ConstIterator& position,
+                    const InputIterator& first,
+                    const InputIterator& last)
+    {
+        Iterator it(position.get_node(), position.get_index());
+        u64 num_inserted = 0;
+        for (auto value_it = first; value_it != last; ++value_it) {
+            it = construct_at(it.get_node(), it.get_index(), *value_it);
+            ++it;
+            ++num_inserted;
+        }
+        for (u64 i = 0; i < num_inserted; ++i) {
+            --it;
+        }
+        return it;
+    }
+
+    Iterator insert(const ConstIterator& position,
+                    std::initializer_list<ValueType> init_list)
+    {
+        return insert(position, init_list.begin(), init_list.end());
+    }
+
+    Iterator erase(const ConstIterator& position)
+    {
+        if (empty()) {
+            return begin();
+        }
+        return erase_at(position.get_node(), position.get_index());
+    }
+
+    Iterator erase(const ConstIterator& first, const ConstIterator& last)
+    {
+        u64 num_to_erase = 0;
+        for (auto it = first; it != last; ++it) {
+            ++num_to_erase;
+        }
+        Iterator retval(first.get_node(), first.get_index());
+        for (u64 i = 0; i < num_to_erase; ++i) {
+            retval = erase_at(retval.get_node(), retval.get_index());
+        }
+        return retval;
+    }
+
+    void swap(UnrolledDListBase& other)
+    {
+        std::swap(m_pool_allocator, other.m_pool_allocator);
+        std::swap(m_pool_owned, other.m_pool_owned);
+        swap_nodes(other);
+    }
+
+    void resize(u64 n)
+    {
+        resize(n, ValueType());
+    }
+
+    void resize(u64 n, const ValueType& value)
+    {
+        if (n == 0) {
+            reset();
+            return;
+        }
+        while (m_size > n) {
+            pop_back();
+        }
+        if (m_size < n) {
+            construct_fill_back(n - m_size, value);
+        }
+    }
+
+    void clear()
+    {
+        reset();
+    }
+
+    void splice(const ConstIterator& position, UnrolledDListBase& other)
+    {
+        splice(position, std::move(other));
+    }
+
+    // nodes are relinked when both lists allocate from the same place,
+    // otherwise the elements are moved over
+    void splice(const ConstIterator& position, UnrolledDListBase&& other)
+    {
+        if (other.empty() || &other == this) {
+            return;
+        }
+
+        if (USEPOOLS && m_pool_allocator != other.m_pool_allocator) {
+            Iterator it(position.get_node(), position.get_index());
+            for (auto node = other.m_root.m_next; node != &(other.m_root);
+                 node = node->m_next) {
+                auto values = values_of(node);
+                for (u32 i = 0, last = node->m_count; i < last; ++i) {
+                    it = construct_at(it.get_node(), it.get_index(), std::move(values[i]));
+                    ++it;
+                }
+            }
+            other.clear();
+            return;
+        }
+
+        auto position_node = position.get_node();
+        if (position.get_index() != 0) {
+            position_node = split_node(position_node, position.get_index());
+        }
+
+        auto before = position_node->m_prev;
+        before->m_next = other.m_root.m_next;
+        other.m_root.m_next->m_prev = before;
+        position_node->m_prev = other.m_root.m_prev;
+        other.m_root.m_prev->m_next = position_node;
+
+        m_size += other.m_size;
+        other.m_root.m_next = &(other.m_root);
+        other.m_root.m_prev = &(other.m_root);
+        other.m_size = 0;
+    }
+
+    // other must be a different list
+    void splice(const ConstIterator& position, UnrolledDListBase& other,
+                const ConstIterator& element)
+    {
+        splice(position, std::move(other), element);
+    }
+
+    void splice(const ConstIterator& position, UnrolledDListBase&& other,
+                const ConstIterator& element)
+    {
+        insert(position, std::move(*Iterator(element.get_node(), element.get_index())));
+        other.erase(element);
+    }
+
+    void splice(const ConstIterator& position, UnrolledDListBase& other,
+                const ConstIterator& first, const ConstIterator& last)
+    {
+        splice(position, std::move(other), first, last);
+    }
+
+    void splice(const ConstIterator& position, UnrolledDListBase&& other,
+                const ConstIterator& first, const ConstIterator& last)
+    {
+        if (first == last || other.empty()) {
+            return;
+        }
+        if (first == other.begin() && last == other.end()) {
+            splice(position, std::move(other));
+            return;
+        }
+        insert(position, first, last);
+        other.erase(first, last);
+    }
+
+    void remove(const ValueType& value)
+    {
+        compact([&] (const T* last_kept, const T& element) -> bool
+                {
+                    return !(element == value);
+                });
+    }
+
+    template <typename UnaryPredicate>
+    void remove_if(UnaryPredicate predicate)
+    {
+        compact([&] (const T* last_kept, const T& element) -> bool
+                {
+                    return !predicate(element);
+                });
+    }
+
+    void unique()
+    {
+        std::equal_to<ValueType> equals_func;
+        unique(equals_func);
+    }
+
+    template <typename BinaryPredicate>
+    void unique(BinaryPredicate predicate)
+    {
+        compact([&] (const T* last_kept, const T& element) -> bool
+                {
+                    return (last_kept == nullptr || !predicate(*last_kept, element));
+                });
+    }
+
+    void merge(UnrolledDListBase& other)
+    {
+        merge(std::move(other));
+    }
+
+    void merge(UnrolledDListBase&& other)
+    {
+        std::less<ValueType> less_func;
+        merge(std::move(other), less_func);
+    }
+
+    template <typename Comparator>
+    void merge(UnrolledDListBase& other, Comparator comparator)
+    {
+        merge(std::move(other), comparator);
+    }
+
+    // streams both lists into freshly packed nodes, releasing
+    // the source nodes as soon as they have been drained
+    template <typename Comparator>
+    void merge(UnrolledDListBase&& other, Comparator comparator)
+    {
+        if (other.empty() || &other == this) {
+            return;
+        }
+
+        NodeBaseType merged_root;
+        NodeBaseType* out_node = &merged_root;
+        u32 out_index = sc_node_capacity;
+
+        auto this_node = m_root.m_next;
+        auto other_node = other.m_root.m_next;
+        u32 this_index = 0;
+        u32 other_index = 0;
+        auto const total_size = m_size + other.m_size;
+
+        while (this_node != &m_root || other_node != &(other.m_root)) {
+            bool take_other;
+            if (this_node == &m_root) {
+                take_other = true;
+            } else if (other_node == &(other.m_root)) {
+                take_other = false;
+            } else {
+                take_other = comparator(values_of(other_node)[other_index],
+                                        values_of(this_node)[this_index]);
+            }
+
+            if (out_index == sc_node_capacity) {
+                if (out_node != &merged_root) {
+                    out_node->m_count = sc_node_capacity;
+                }
+                auto new_node = allocate_node();
+                link_after(merged_root.m_prev, new_node);
+                out_node = new_node;
+                out_index = 0;
+            }
+
+            auto out_slot = values_of(out_node) + out_index;
+            ++out_index;
+
+            if (take_other) {
+                auto source = values_of(other_node) + other_index;
+                new (out_slot) T(std::move(*source));
+                source->~T();
+                if (++other_index == other_node->m_count) {
+                    auto next = other_node->m_next;
+                    other_node->m_count = 0;
+                    other.deallocate_node(other_node);
+                    other_node = next;
+                    other_index = 0;
+                }
+            } else {
+                auto source = values_of(this_node) + this_index;
+                new (out_slot) T(std::move(*source));
+                source->~T();
+                if (++this_index == this_node->m_count) {
+                    auto next = this_node->m_next;
+                    this_node->m_count = 0;
+                    deallocate_node(this_node);
+                    this_node = next;
+                    this_index = 0;
+                }
+            }
+        }
+        out_node->m_count = out_index;
+
+        other.m_root.m_next = &(other.m_root);
+        other.m_root.m_prev = &(other.m_root);
+        other.m_size = 0;
+
+        m_root.m_next = merged_root.m_next;
+        m_root.m_prev = merged_root.m_prev;
+        m_root.m_next->m_prev = &m_root;
+        m_root.m_prev->m_next = &m_root;
+        m_size = total_size;
+    }
+
+    void sort()
+    {
+        std::less<ValueType> less_func;
+        sort(less_func);
+    }
+
+    // moves the elements into one contiguous buffer, sorts that
+    // (stably) and repacks the nodes from it
+    template <typename Comparator>
+    void sort(Comparator comparator)
+    {
+        auto const num_elements = m_size;
+        if (num_elements <= 1) {
+            return;
+        }
+
+        auto buffer = aa::allocate_uarray_raw<T>(num_elements);
+        u64 num_gathered = 0;
+        for (auto node = m_root.m_next; node != &m_root; node = node->m_next) {
+            move_elements(buffer + num_gathered, values_of(node), node->m_count);
+            num_gathered += node->m_count;
+            node->m_count = 0;
+        }
+
+        std::stable_sort(buffer, buffer + num_elements, comparator);
+        refill_from_buffer(buffer, num_elements);
+        aa::deallocate_uarray_raw(buffer, num_elements);
+    }
+
+    void reverse() noexcept
+    {
+        if (m_size <= 1) {
+            return;
+        }
+
+        auto cur_node = m_root.m_next;
+        while (cur_node != &m_root) {
+            auto next_node = cur_node->m_next;
+            std::swap(cur_node->m_next, cur_node->m_prev);
+            auto values = values_of(cur_node);
+            std::reverse(values, values + cur_node->m_count);
+            cur_node = next_node;
+        }
+
+        std::swap(m_root.m_next, m_root.m_prev);
+    }
+
+    // functions not part of stl
+    inline void garbage_collect()
+    {
+        if (!USEPOOLS || m_pool_allocator == nullptr) {
+            return;
+        }
+        m_pool_allocator->garbage_collect();
+    }
+
+    // Use with caution. Mucking about with
+    // the pool can cause list corruption or worse!
+    inline aa::PoolAllocator* get_pool() const
+    {
+        if (!USEPOOLS) {
+            return nullptr;
+        }
+        return m_pool_allocator;
+    }
+
+    static constexpr u32 get_node_capacity()
+    {
+        return sc_node_capacity;
+    }
+
+    Iterator find(const ValueType& value)
+    {
+        for (auto it = begin(), last = end(); it != last; ++it) {
+            if (*it == value) {
+                return it;
+            }
+        }
+        return end();
+    }
+
+    ConstIterator find(const ValueType& value) const
+    {
+        for (auto it = cbegin(), last = cend(); it != last; ++it) {
+            if (*it == value) {
+                return it;
+            }
+        }
+        return cend();
+    }
+
+    template <typename UnaryPredicate>
+    Iterator find(UnaryPredicate predicate)
+    {
+        for (auto it = begin(), last = end(); it != last; ++it) {
+            if (predicate(*it)) {
+                return it;
+            }
+        }
+        return end();
+    }
+
+    template <typename UnaryPredicate>
+    ConstIterator find(UnaryPredicate predicate) const
+    {
+        for (auto it = begin(), last = end(); it != last; ++it) {
+            if (predicate(*it)) {
+                return it;
+            }
+        }
+        return end();
+    }
+
+    template <bool OUSEPOOLS>
+    inline i64 compare(const UnrolledDListBase<T, OUSEPOOLS, NODEBYTES>& other) const
+    {
+        return compare(other, std::less<T>());
+    }
+
+    template <bool OUSEPOOLS, typename BinaryPredicate>
+    inline i64 compare(const UnrolledDListBase<T, OUSEPOOLS, NODEBYTES>& other,
+                       BinaryPredicate predicate) const
+    {
+        auto diff = (i64)size() - (i64)other.size();
+        if (diff != 0) {
+            return diff;
+        }
+
+        auto it1 = begin();
+        auto it2 = other.begin();
+
+        auto end1 = end();
+        auto end2 = other.end();
+
+        while (it1 != end1 && it2 != end2) {
+            if (predicate(*it1, *it2)) {
+                return -1;
+            } else if (predicate(*it2, *it1)) {
+                return 1;
+            }
+
+            ++it1;
+            ++it2;
+        }
+
+        return 0;
+    }
+
+    inline std::string as_string(i64 verbosity) const
+    {
+        std::ostringstream sstr;
+        sstr << (USEPOOLS ? "Pooled " : "Unpooled ") << "UnrolledDListBase<"
+             << type_name<T>() << "> with " << size() << " elements:"
+             << std::endl;
+
+        as::IterableStringifier<MyType, T> iter_stringifier;
+        sstr << "<<" << iter_stringifier(*this, verbosity) << ">>";
+
+        return sstr.str();
+    }
+};
+
+template <typename T, bool USEPOOLS, u32 NODEBYTES>
+constexpr u32 UnrolledDListBase<T, USEPOOLS, NODEBYTES>::sc_node_capacity;
+
+template <typename T, bool USEPOOLS, u32 NODEBYTES>
+const u64 UnrolledDListBase<T, USEPOOLS, NODEBYTES>::sc_node_size =
+    sizeof(typename UnrolledDListBase<T, USEPOOLS, NODEBYTES>::NodeType);
+
+// relational operators for unrolled dlists
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator == (const UnrolledDListBase<T, UP1, NB>& list1,
+                                const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) == 0);
+}
+
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator != (const UnrolledDListBase<T, UP1, NB>& list1,
+                                const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) != 0);
+}
+
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator < (const UnrolledDListBase<T, UP1, NB>& list1,
+                               const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) < 0);
+}
+
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator > (const UnrolledDListBase<T, UP1, NB>& list1,
+                               const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) > 0);
+}
+
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator <= (const UnrolledDListBase<T, UP1, NB>& list1,
+                                const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) <= 0);
+}
+
+template <typename T, bool UP1, bool UP2, u32 NB>
+static inline bool operator >= (const UnrolledDListBase<T, UP1, NB>& list1,
+                                const UnrolledDListBase<T, UP2, NB>& list2)
+{
+    return (list1.compare(list2) >= 0);
+}
+
+// Some useful typedefs. Nodes default to two cache lines
+template <typename T, u32 NODEBYTES = 128>
+using PoolUnrolledDList = UnrolledDListBase<T, true, NODEBYTES>;
+
+template <typename T, u32 NODEBYTES = 128>
+using UnrolledDList = UnrolledDListBase<T, false, NODEBYTES>;
+
+template <typename T, u32 NODEBYTES = 128>
+using MPtrUnrolledDList =
+    UnrolledDListBase<typename std::conditional<IsRefCountable<T>::value,
+                                                memory::ManagedPointer<T>, T*>::type,
+                      false, NODEBYTES>;
+
+template <typename T, u32 NODEBYTES = 128>
+using PoolMPtrUnrolledDList =
+    UnrolledDListBase<typename std::conditional<IsRefCountable<T>::value,
+                                                memory::ManagedPointer<T>, T*>::type,
+                      true, NODEBYTES>;
+
+typedef PoolUnrolledDList<u08> u08PoolUnrolledDList;
+typedef PoolUnrolledDList<u16> u16PoolUnrolledDList;
+typedef PoolUnrolledDList<u32> u32PoolUnrolledDList;
+typedef PoolUnrolledDList<u64> u64PoolUnrolledDList;
+typedef PoolUnrolledDList<i08> i08PoolUnrolledDList;
+typedef PoolUnrolledDList<i16> i16PoolUnrolledDList;
+typedef PoolUnrolledDList<i32> i32PoolUnrolledDList;
+typedef PoolUnrolledDList<i64> i64PoolUnrolledDList;
+
+typedef UnrolledDList<u08> u08UnrolledDList;
+typedef UnrolledDList<u16> u16UnrolledDList;
+typedef UnrolledDList<u32> u32UnrolledDList;
+typedef UnrolledDList<u64> u64UnrolledDList;
+typedef UnrolledDList<i08> i08UnrolledDList;
+typedef UnrolledDList<i16> i16UnrolledDList;
+typedef UnrolledDList<i32> i32UnrolledDList;
+typedef UnrolledDList<i64> i64UnrolledDList;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_UNROLLED_DLIST_HPP_ */
+
+//
+// UnrolledDList.hpp ends here
@@ -0,0 +1,298 @@
+// UnrolledDListTypes.hpp ---
+//
+// Filename: UnrolledDListTypes.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:03:18 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_UNROLLED_DLIST_TYPES_HPP_
+#define AURUM_CONTAINERS_UNROLLED_DLIST_TYPES_HPP_
+
+#include <iterator>
+#include <type_traits>
+
+#include "../basetypes/AurumBase.hpp"
+
+namespace aurum {
+namespace containers {
+
+template <typename T, bool USEPOOLS, u32 NODEBYTES> class UnrolledDListBase;
+
+namespace unrolled_dlist_detail_ {
+
+namespace ac = aurum::containers;
+
+// The root of an unrolled list is a node base with no elements
+// so that iterators at end() always look like (root, 0)
+struct UnrolledDListNodeBase
+{
+    UnrolledDListNodeBase* m_next;
+    UnrolledDListNodeBase* m_prev;
+    u32 m_count;
+
+    inline UnrolledDListNodeBase()
+        : m_next(this), m_prev(this), m_count(0)
+    {
+        // Nothing here
+    }
+
+    inline UnrolledDListNodeBase(UnrolledDListNodeBase* next, UnrolledDListNodeBase* prev)
+        : m_next(next), m_prev(prev), m_count(0)
+    {
+        // Nothing here
+    }
+
+    UnrolledDListNodeBase(const UnrolledDListNodeBase& other) = delete;
+    UnrolledDListNodeBase& operator = (const UnrolledDListNodeBase& other) = delete;
+
+    inline ~UnrolledDListNodeBase()
+    {
+        // Nothing here
+    }
+};
+
+// Number of elements that fit into a node of NODEBYTES bytes,
+// but never fewer than four, so that splits and merges make sense
+template <typename T, u32 NODEBYTES>
+struct UnrolledDListNodeCapacity
+{
+    static constexpr u32 sc_raw_capacity =
+        (NODEBYTES > sizeof(UnrolledDListNodeBase) ?
+         (u32)((NODEBYTES - sizeof(UnrolledDListNodeBase)) / sizeof(T)) : 0);
+
+    static constexpr u32 value = (sc_raw_capacity < 4 ? 4 : sc_raw_capacity);
+};
+
+template <typename T, u32 CAPACITY>
+struct UnrolledDListNode : public UnrolledDListNodeBase
+{
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type StorageType;
+
+    StorageType m_values[CAPACITY];
+
+    inline UnrolledDListNode() = delete;
+    inline UnrolledDListNode(const UnrolledDListNode& other) = delete;
+    inline UnrolledDListNode(UnrolledDListNode&& other) = delete;
+    inline UnrolledDListNode& operator = (const UnrolledDListNode& other) = delete;
+    inline UnrolledDListNode& operator = (UnrolledDListNode&& other) = delete;
+
+    inline ~UnrolledDListNode()
+    {
+        // Nothing here
+    }
+
+    inline T* get_values()
+    {
+        return reinterpret_cast<T*>(m_values);
+    }
+
+    inline const T* get_values() const
+    {
+        return reinterpret_cast<const T*>(m_values);
+    }
+
+    static inline UnrolledDListNode* construct(void* mem_ptr)
+    {
+        UnrolledDListNode* node_ptr = static_cast<UnrolledDListNode*>(mem_ptr);
+        node_ptr->m_next = nullptr;
+        node_ptr->m_prev = nullptr;
+        node_ptr->m_count = 0;
+        return node_ptr;
+    }
+};
+
+// An iterator is a (node, index) pair. Unlike DList iterators,
+// these are invalidated by insertions and erasures which touch
+// the node that they point into
+template <typename T, u32 CAPACITY, bool ISCONST>
+class IteratorBase
+    : public std::iterator<std::bidirectional_iterator_tag, T, i64,
+                           typename std::conditional<ISCONST, const T*, T*>::type,
+                           typename std::conditional<ISCONST, const T&, T&>::type>
+{
+    template <typename, bool, u32> friend class ac::UnrolledDListBase;
+    friend class ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY, true>;
+    friend class ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY, false>;
+
+private:
+    typedef UnrolledDListNode<T, CAPACITY> NodeType;
+    typedef UnrolledDListNodeBase NodeBaseType;
+    typedef typename std::conditional<ISCONST, const T&, T&>::type ValRefType;
+    typedef typename std::conditional<ISCONST, const T*, T*>::type ValPtrType;
+
+    inline NodeBaseType* get_node() const
+    {
+        return m_node;
+    }
+
+    inline u32 get_index() const
+    {
+        return m_index;
+    }
+
+    NodeBaseType* m_node;
+    u32 m_index;
+
+public:
+    inline IteratorBase()
+        : m_node(nullptr), m_index(0)
+    {
+        // Nothing here
+    }
+
+    inline IteratorBase(NodeBaseType* node, u32 index)
+        : m_node(node), m_index(index)
+    {
+        // Nothing here
+    }
+
+    inline IteratorBase(const IteratorBase& other)
+        : m_node(other.m_node), m_index(other.m_index)
+    {
+        // Nothing here
+    }
+
+    template <bool OISCONST>
+    inline IteratorBase(const ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY,
+                                                                      OISCONST>& other)
+        : m_node(other.m_node), m_index(other.m_index)
+    {
+        static_assert(((!OISCONST) || ISCONST),
+                      "Cannot construct const iterator "
+                      "from non-const iterator");
+    }
+
+    inline ~IteratorBase()
+    {
+        // Nothing here
+    }
+
+    inline IteratorBase& operator = (const IteratorBase& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        m_node = other.m_node;
+        m_index = other.m_index;
+        return *this;
+    }
+
+    template <bool OISCONST>
+    inline IteratorBase&
+    operator = (const ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY, OISCONST>& other)
+    {
+        static_assert(((!OISCONST) || ISCONST),
+                      "Cannot assign const iterator "
+                      "to non-const iterator");
+        m_node = other.m_node;
+        m_index = other.m_index;
+        return *this;
+    }
+
+    inline IteratorBase& operator ++ ()
+    {
+        if (++m_index >= m_node->m_count) {
+            m_node = m_node->m_next;
+            m_index = 0;
+        }
+        return *this;
+    }
+
+    inline IteratorBase operator ++ (int unused)
+    {
+        auto retval = *this;
+        ++(*this);
+        return retval;
+    }
+
+    inline IteratorBase& operator -- ()
+    {
+        if (m_index == 0) {
+            m_node = m_node->m_prev;
+            m_index = m_node->m_count - 1;
+        } else {
+            --m_index;
+        }
+        return *this;
+    }
+
+    inline IteratorBase operator -- (int unused)
+    {
+        auto retval = *this;
+        --(*this);
+        return retval;
+    }
+
+    inline ValRefType operator * () const
+    {
+        return static_cast<NodeType*>(m_node)->get_values()[m_index];
+    }
+
+    inline ValPtrType operator -> () const
+    {
+        return (static_cast<NodeType*>(m_node)->get_values() + m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool
+    operator == (const ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY,
+                                                                OISCONST>& other) const
+    {
+        return (m_node == other.m_node && m_index == other.m_index);
+    }
+
+    template <bool OISCONST>
+    inline bool
+    operator != (const ac::unrolled_dlist_detail_::IteratorBase<T, CAPACITY,
+                                                                OISCONST>& other) const
+    {
+        return (m_node != other.m_node || m_index != other.m_index);
+    }
+};
+
+template <typename T, u32 CAPACITY>
+using Iterator = IteratorBase<T, CAPACITY, false>;
+
+template <typename T, u32 CAPACITY>
+using ConstIterator = IteratorBase<T, CAPACITY, true>;
+
+} /* end namespace unrolled_dlist_detail_ */
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_UNROLLED_DLIST_TYPES_HPP_ */
+
+//
+// UnrolledDListTypes.hpp ends here
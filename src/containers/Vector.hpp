@@ -803,6 +803,7 @@ public:
             if (new_size > get_capacity()) {
                 expand(new_size);
             }
+            set_size(new_size);
             std::fill_n(begin() + old_size, (new_size - old_size), value);
         }
         return;
@@ -0,0 +1,200 @@
+// WeakRefCache.hpp ---
+//
+// Filename: WeakRefCache.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:09:06 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_CONTAINERS_WEAK_REF_CACHE_HPP_
+#define AURUM_CONTAINERS_WEAK_REF_CACHE_HPP_
+
+#include <utility>
+#include <type_traits>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "../basetypes/RefCountable.hpp"
+#include "../memory/ManagedPointer.hpp"
+
+#include "RefCache.hpp"
+#include "HashTable.hpp"
+
+namespace aurum {
+namespace containers {
+namespace weak_ref_cache_detail_ {
+
+namespace am = aurum::memory;
+namespace rcd = aurum::containers::ref_cache_detail_;
+
+// A RefCache which holds weak references to its objects: an object
+// is removed from the cache when the last managed pointer to it is
+// released, just before it is destroyed. There is thus no garbage to
+// collect, and no sweeps, at the cost of registering each object
+// with its weak reference control when it enters the cache.
+// The objects must derive from RefCountable<T>. A cache notifies its
+// objects when it goes away, so objects may outlive the cache
+template <typename T, typename HashFunction, typename EqualsFunction>
+class WeakRefCache final
+    : public AurumObject<WeakRefCache<T, HashFunction, EqualsFunction> >
+{
+    static_assert(std::is_base_of<RefCountable<T>, T>::value,
+                  "WeakRefCaches can only be created with types derived from RefCountable.");
+
+private:
+    typedef rcd::KeyHasher<T, HashFunction> KeyHasherType;
+    typedef rcd::KeyEqualTo<T, HashFunction, EqualsFunction> KeyEqualToType;
+    typedef RestrictedHashTable<T*, KeyHasherType, KeyEqualToType> HashTableType;
+
+    static constexpr bool sc_can_use_construction_keys =
+        (std::is_same<HashFunction, rcd::DefaultHashFunction<T> >::value &&
+         std::is_same<EqualsFunction, rcd::DefaultEqualsFunction<T> >::value);
+
+    HashTableType m_hash_table;
+
+    static inline void expire_entry(void* context, const void* object)
+    {
+        auto cache = static_cast<WeakRefCache*>(context);
+        auto as_ref_countable = static_cast<const RefCountable<T>*>(object);
+        auto expired_object = const_cast<T*>(static_cast<const T*>(as_ref_countable));
+
+        auto it = cache->m_hash_table.find(expired_object);
+        if (it != cache->m_hash_table.end() && (*it) == expired_object) {
+            cache->m_hash_table.erase(it);
+        }
+    }
+
+    template <typename U>
+    inline am::ManagedPointer<U> insert_new(U* new_object)
+    {
+        bool unused;
+        m_hash_table.insert(new_object, unused);
+        new_object->get_weak_reference_control_()->set_expiry_handler(&expire_entry, this);
+        return am::ManagedPointer<U>(new_object);
+    }
+
+    // probes with the construction arguments, and constructs
+    // an object only if there is no equal object in the cache
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get_(std::true_type use_construction_key, ArgTypes&&... args)
+    {
+        rcd::ConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...> key(args...);
+
+        auto it = m_hash_table.find(key);
+        if (it != m_hash_table.end()) {
+            return am::ManagedPointer<U>(static_cast<U*>(*it));
+        }
+        return insert_new(new U(std::forward<ArgTypes>(args)...));
+    }
+
+    // constructs an object to probe with, and deletes it if an
+    // equal object is already in the cache
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get_(std::false_type use_construction_key, ArgTypes&&... args)
+    {
+        auto new_object = new U(std::forward<ArgTypes>(args)...);
+
+        auto it = m_hash_table.find(new_object);
+        if (it == m_hash_table.end()) {
+            return insert_new(new_object);
+        }
+        am::ManagedPointer<U> retval(static_cast<U*>(*it));
+        delete new_object;
+        return retval;
+    }
+
+public:
+    typedef am::ManagedPointer<T> RefType;
+    typedef am::ManagedConstPointer<T> CRefType;
+
+    inline WeakRefCache()
+        : m_hash_table()
+    {
+        // Nothing here
+    }
+
+    // the objects know the cache by its address
+    WeakRefCache(const WeakRefCache& other) = delete;
+    WeakRefCache(WeakRefCache&& other) = delete;
+    WeakRefCache& operator = (const WeakRefCache& other) = delete;
+    WeakRefCache& operator = (WeakRefCache&& other) = delete;
+
+    inline ~WeakRefCache()
+    {
+        for (auto const& ptr : m_hash_table) {
+            ptr->get_weak_reference_control_()->set_expiry_handler(nullptr, nullptr);
+        }
+        m_hash_table.clear();
+    }
+
+    // returns the cached object equal to U(args...), constructing
+    // it only if there is none. Objects that are constructed are
+    // referenced only by the returned pointer, so they leave the
+    // cache as soon as it, and its copies, are gone
+    template <typename U, typename... ArgTypes>
+    inline am::ManagedPointer<U> get(ArgTypes&&... args)
+    {
+        static_assert(std::is_convertible<U*, T*>::value,
+                      "WeakRefCache: Cannot call get on unrelated type.");
+
+        typedef typename rcd::HasConstructionKey<T, U, typename std::remove_reference<ArgTypes>::type...>::type
+            HasKeyType;
+        typedef std::integral_constant<bool, (HasKeyType::value && sc_can_use_construction_keys)>
+            UseKeyType;
+        return get_<U>(UseKeyType(), std::forward<ArgTypes>(args)...);
+    }
+
+    // the number of live objects in the cache
+    inline u64 size() const
+    {
+        return m_hash_table.size();
+    }
+};
+
+template <typename T, typename HashFunction, typename EqualsFunction>
+constexpr bool WeakRefCache<T, HashFunction, EqualsFunction>::sc_can_use_construction_keys;
+
+} /* end namespace weak_ref_cache_detail_ */
+
+template <typename T,
+          typename HashFunction = ref_cache_detail_::DefaultHashFunction<T>,
+          typename EqualsFunction = ref_cache_detail_::DefaultEqualsFunction<T> >
+using WeakRefCache = weak_ref_cache_detail_::WeakRefCache<T, HashFunction, EqualsFunction>;
+
+} /* end namespace containers */
+} /* end namespace aurum */
+
+#endif /* AURUM_CONTAINERS_WEAK_REF_CACHE_HPP_ */
+
+//
+// WeakRefCache.hpp ends here
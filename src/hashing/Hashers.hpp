@@ -170,18 +170,33 @@ public:
 template <typename T>
 class Hasher<am::ManagedPointer<T> >
 {
+public:
     inline u64 operator () (const am::ManagedPointer<T>& managed_ptr) const
     {
-        return aurum_hash<void*>(static_cast<void*>(managed_ptr->get_raw_pointer()));
+        return aurum_hash<void*>(static_cast<void*>(managed_ptr.get_raw_pointer()));
     }
 };
 
 template <typename T>
 class Hasher<am::ManagedConstPointer<T> >
 {
+public:
     inline u64 operator () (const am::ManagedConstPointer<T>& managed_ptr) const
     {
-        return aurum_hash<const void*>(static_cast<const void*>(managed_ptr->get_raw_pointer()));
+        return aurum_hash<const void*>(static_cast<const void*>(managed_ptr.get_raw_pointer()));
+    }
+};
+
+// tagged pointers hash their pointers along with their tags
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+class Hasher<am::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+{
+public:
+    inline u64
+    operator () (const am::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>&
+                 managed_ptr) const
+    {
+        return aurum_hash(managed_ptr.get_packed_value());
     }
 };
 
@@ -251,7 +266,9 @@ public:
     }
 };
 
-// Deep hashes for pointers
+// Deep hashes for pointers. Pointees that are Hashable are hashed
+// with their cached hash values, so deep hashes of shared structures
+// only compute the hash of each shared object once
 template <typename T, u64 NUM_DEREFS_ALLOWED>
 class DeepHasher : public Hasher<T>
 {};
@@ -299,6 +316,26 @@ class DeepHasher<memory::ManagedConstPointer<T>, NUM_DEREFS_ALLOWED>
     : public DeepHasher<T*, NUM_DEREFS_ALLOWED>
 {};
 
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+class DeepHasher<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>, 0>
+    : public Hasher<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER> >
+{};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER, u64 NUM_DEREFS_ALLOWED>
+class DeepHasher<memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>,
+                 NUM_DEREFS_ALLOWED>
+{
+public:
+    inline u64
+    operator () (const memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>&
+                 managed_ptr) const
+    {
+        DeepHasher<T, NUM_DEREFS_ALLOWED-1> sub_hasher;
+        return ((sub_hasher(*managed_ptr) * detail_::sc_hash_multiplier) ^
+                aurum_hash(managed_ptr.get_tag()));
+    }
+};
+
 template <typename T1, typename T2, u64 NUM_DEREFS_ALLOWED>
 class DeepHasher<std::pair<T1, T2>, NUM_DEREFS_ALLOWED>
 {
@@ -306,7 +343,7 @@ private:
     typedef std::pair<T1, T2> PairType;
 
 public:
-    inline bool operator () (const PairType& object) const
+    inline u64 operator () (const PairType& object) const
     {
         DeepHasher<T1, NUM_DEREFS_ALLOWED> hasher1;
         DeepHasher<T2, NUM_DEREFS_ALLOWED> hasher2;
@@ -341,7 +378,7 @@ private:
         auto const& elem = std::get<INDEX>(the_tuple);
 
         accumulator = (accumulator * detail_::sc_hash_multiplier) ^ sub_hasher(elem);
-        return;
+        compute_hash<INDEX+1>(the_tuple, accumulator);
     }
 
 public:
@@ -0,0 +1,158 @@
+// AtomicManagedPointer.hpp ---
+//
+// Filename: AtomicManagedPointer.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:12:02 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_MEMORY_ATOMIC_MANAGED_POINTER_HPP_
+#define AURUM_MEMORY_ATOMIC_MANAGED_POINTER_HPP_
+
+#include <atomic>
+
+#include "../basetypes/AurumTraits.hpp"
+#include "ManagedPointer.hpp"
+#include "EpochReclamation.hpp"
+
+namespace aurum {
+namespace memory {
+
+// A managed pointer that can be read by many threads while others
+// replace it. The cell holds one reference to its object. Readers
+// pin an epoch, with an EpochGuard, and use the object through the
+// raw pointer that load() returns, without any reference counting,
+// for as long as the guard lives. A store() retires the reference
+// to the object it replaces, which is released only once every
+// reader that could have seen the object has unpinned. The objects
+// must be safe to release on any thread
+template <typename T>
+class AtomicManagedPointer
+{
+    static_assert(IsAtomicRefCountable<T>::value || IsBiasedRefCountable<T>::value,
+                  "AtomicManagedPointers can only be created with types derived "
+                  "from AtomicRefCountable or BiasedRefCountable.");
+
+private:
+    std::atomic<T*> m_ptr;
+
+    static inline void release_object(const void* object)
+    {
+        static_cast<const T*>(object)->dec_ref_();
+    }
+
+    static inline T* acquire_object(T* object)
+    {
+        if (object != nullptr) {
+            object->inc_ref_();
+        }
+        return object;
+    }
+
+    static inline void retire_object(T* object)
+    {
+        if (object != nullptr) {
+            EpochReclamation::retire(object, &release_object);
+        }
+    }
+
+public:
+    inline AtomicManagedPointer()
+        : m_ptr(nullptr)
+    {
+        // Nothing here
+    }
+
+    inline AtomicManagedPointer(const ManagedPointer<T>& managed_ptr)
+        : m_ptr(acquire_object(managed_ptr.get_raw_pointer()))
+    {
+        // Nothing here
+    }
+
+    AtomicManagedPointer(const AtomicManagedPointer& other) = delete;
+    AtomicManagedPointer(AtomicManagedPointer&& other) = delete;
+    AtomicManagedPointer& operator = (const AtomicManagedPointer& other) = delete;
+    AtomicManagedPointer& operator = (AtomicManagedPointer&& other) = delete;
+
+    // readers may still be using the object
+    inline ~AtomicManagedPointer()
+    {
+        retire_object(m_ptr.load(std::memory_order_relaxed));
+    }
+
+    // the object is valid for as long as the guard is alive
+    inline T* load(const EpochGuard& guard) const
+    {
+        return m_ptr.load(std::memory_order_acquire);
+    }
+
+    // takes a reference to the current object, for use
+    // beyond the scope of an EpochGuard
+    inline ManagedPointer<T> get() const
+    {
+        EpochGuard guard;
+        return ManagedPointer<T>(load(guard));
+    }
+
+    inline void store(const ManagedPointer<T>& managed_ptr)
+    {
+        auto new_object = acquire_object(managed_ptr.get_raw_pointer());
+        retire_object(m_ptr.exchange(new_object, std::memory_order_acq_rel));
+    }
+
+    // stores the new object only if the current object is expected,
+    // returns whether it did
+    inline bool compare_and_store(const T* expected, const ManagedPointer<T>& managed_ptr)
+    {
+        auto new_object = acquire_object(managed_ptr.get_raw_pointer());
+        auto expected_object = const_cast<T*>(expected);
+        if (m_ptr.compare_exchange_strong(expected_object, new_object,
+                                          std::memory_order_acq_rel)) {
+            retire_object(expected_object);
+            return true;
+        }
+        if (new_object != nullptr) {
+            new_object->dec_ref_();
+        }
+        return false;
+    }
+};
+
+} /* end namespace memory */
+} /* end namespace aurum */
+
+#endif /* AURUM_MEMORY_ATOMIC_MANAGED_POINTER_HPP_ */
+
+//
+// AtomicManagedPointer.hpp ends here
@@ -0,0 +1,233 @@
+// EpochReclamation.cpp ---
+//
+// Filename: EpochReclamation.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:12:02 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "EpochReclamation.hpp"
+
+namespace aurum {
+namespace memory {
+
+namespace {
+
+struct RetiredObject
+{
+    const void* m_object;
+    EpochReclamation::ReclaimFunction m_reclaim_fun;
+    u64 m_epoch;
+};
+
+// the number of objects a thread retires between collections
+static constexpr u64 sc_collect_interval = 64;
+
+// The threads that can pin, and the objects retired by threads
+// that exited before those objects could be reclaimed
+class ThreadRegistry
+{
+private:
+    std::mutex m_mutex;
+    std::vector<EpochReclamation::ThreadState*> m_threads;
+    std::vector<RetiredObject> m_orphans;
+
+public:
+    ThreadRegistry()
+        : m_mutex(), m_threads(), m_orphans()
+    {
+        // Nothing here
+    }
+
+    void add_thread(EpochReclamation::ThreadState* state)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_threads.push_back(state);
+    }
+
+    void remove_thread(EpochReclamation::ThreadState* state,
+                       const std::vector<RetiredObject>& retired_objects)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_threads.erase(std::find(m_threads.begin(), m_threads.end(), state));
+        m_orphans.insert(m_orphans.end(), retired_objects.begin(), retired_objects.end());
+    }
+
+    // advances the global epoch, unless some thread is
+    // still pinned in an earlier one
+    void try_advance(std::atomic<u64>& global_epoch)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        auto epoch = global_epoch.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (auto state : m_threads) {
+            // pairs with the releases in pin() and unpin(): what the thread
+            // did in earlier epochs happens before the epoch advances
+            auto pinned_epoch = state->m_pinned_epoch.load(std::memory_order_acquire);
+            if (pinned_epoch != 0 && pinned_epoch != epoch) {
+                return;
+            }
+        }
+        global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+    }
+
+    std::vector<RetiredObject> take_reclaimable_orphans(u64 epoch)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        std::vector<RetiredObject> retval;
+        auto it = std::stable_partition(m_orphans.begin(), m_orphans.end(),
+                                        [&] (const RetiredObject& retired_object) -> bool
+                                        {
+                                            return (retired_object.m_epoch + 2 > epoch);
+                                        });
+        retval.assign(it, m_orphans.end());
+        m_orphans.erase(it, m_orphans.end());
+        return retval;
+    }
+
+    bool has_orphans()
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        return (m_orphans.size() > 0);
+    }
+};
+
+static inline ThreadRegistry& get_thread_registry()
+{
+    static ThreadRegistry s_registry;
+    return s_registry;
+}
+
+// The objects retired by a thread. The thread is registered when
+// this is created, and its leftover objects handed to the registry
+// when it exits
+class ThreadHook
+{
+private:
+    EpochReclamation::ThreadState* m_state;
+
+public:
+    std::vector<RetiredObject> m_retired_objects;
+    u64 m_num_retired_since_collect;
+
+    explicit ThreadHook(EpochReclamation::ThreadState* state)
+        : m_state(state), m_retired_objects(), m_num_retired_since_collect(0)
+    {
+        get_thread_registry().add_thread(m_state);
+        m_state->m_registered = true;
+    }
+
+    ~ThreadHook()
+    {
+        get_thread_registry().remove_thread(m_state, m_retired_objects);
+        m_state->m_registered = false;
+    }
+};
+
+static inline ThreadHook& get_thread_hook(EpochReclamation::ThreadState* state)
+{
+    static thread_local ThreadHook s_hook(state);
+    return s_hook;
+}
+
+static inline void reclaim_objects(const std::vector<RetiredObject>& retired_objects)
+{
+    for (auto const& retired_object : retired_objects) {
+        retired_object.m_reclaim_fun(retired_object.m_object);
+    }
+}
+
+} /* end anonymous namespace */
+
+void EpochReclamation::register_current_thread(ThreadState* state)
+{
+    get_thread_hook(state);
+}
+
+void EpochReclamation::retire(const void* object, ReclaimFunction reclaim_fun)
+{
+    auto& hook = get_thread_hook(&get_current_thread_state());
+    auto epoch = get_global_epoch().load(std::memory_order_seq_cst);
+    hook.m_retired_objects.push_back(RetiredObject { object, reclaim_fun, epoch });
+    if (++hook.m_num_retired_since_collect >= sc_collect_interval) {
+        collect();
+    }
+}
+
+void EpochReclamation::collect()
+{
+    auto& hook = get_thread_hook(&get_current_thread_state());
+    auto& registry = get_thread_registry();
+    hook.m_num_retired_since_collect = 0;
+
+    registry.try_advance(get_global_epoch());
+    auto epoch = get_global_epoch().load(std::memory_order_seq_cst);
+
+    // reclaiming objects may retire others, so the reclaimable
+    // ones are taken out before any of them are reclaimed
+    auto& retired_objects = hook.m_retired_objects;
+    auto it = std::stable_partition(retired_objects.begin(), retired_objects.end(),
+                                    [&] (const RetiredObject& retired_object) -> bool
+                                    {
+                                        return (retired_object.m_epoch + 2 > epoch);
+                                    });
+    std::vector<RetiredObject> reclaimable_objects(it, retired_objects.end());
+    retired_objects.erase(it, retired_objects.end());
+
+    reclaim_objects(reclaimable_objects);
+    reclaim_objects(registry.take_reclaimable_orphans(epoch));
+}
+
+void EpochReclamation::synchronize()
+{
+    auto& hook = get_thread_hook(&get_current_thread_state());
+    while (true) {
+        collect();
+        if (hook.m_retired_objects.size() == 0 && !get_thread_registry().has_orphans()) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+} /* end namespace memory */
+} /* end namespace aurum */
+
+//
+// EpochReclamation.cpp ends here
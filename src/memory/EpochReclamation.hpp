@@ -0,0 +1,164 @@
+// EpochReclamation.hpp ---
+//
+// Filename: EpochReclamation.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:12:02 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_MEMORY_EPOCH_RECLAMATION_HPP_
+#define AURUM_MEMORY_EPOCH_RECLAMATION_HPP_
+
+#include <atomic>
+
+#include "../basetypes/AurumTypes.hpp"
+
+namespace aurum {
+namespace memory {
+
+// Epoch based reclamation of objects that are read concurrently
+// without taking references to them. Readers pin the current epoch
+// for as long as they use such objects. Writers unlink objects from
+// wherever readers can find them, and retire them, along with a
+// function to reclaim them. The global epoch advances only when
+// every pinned thread has observed it, so an object retired in epoch
+// e is no longer in use once the global epoch reaches e + 2, at
+// which point it is reclaimed by whichever thread notices it first.
+// Pinning and unpinning touch only the calling thread's state.
+class EpochReclamation
+{
+public:
+    typedef void (*ReclaimFunction)(const void* object);
+
+    struct ThreadState
+    {
+        // the epoch the thread is pinned in, zero when it is not pinned
+        std::atomic<u64> m_pinned_epoch;
+        u64 m_pin_depth;
+        bool m_registered;
+
+        constexpr ThreadState()
+            : m_pinned_epoch(0), m_pin_depth(0), m_registered(false)
+        {
+            // Nothing here
+        }
+    };
+
+private:
+    static void register_current_thread(ThreadState* state);
+
+    static inline std::atomic<u64>& get_global_epoch()
+    {
+        static std::atomic<u64> s_global_epoch(1);
+        return s_global_epoch;
+    }
+
+    static inline ThreadState& get_current_thread_state()
+    {
+        static thread_local ThreadState s_state;
+        return s_state;
+    }
+
+public:
+    // pins are counted, nested pins are cheap
+    static inline void pin()
+    {
+        auto& state = get_current_thread_state();
+        if (state.m_pin_depth++ > 0) {
+            return;
+        }
+        if (!state.m_registered) {
+            register_current_thread(&state);
+        }
+        state.m_pinned_epoch.store(get_global_epoch().load(std::memory_order_relaxed),
+                                   std::memory_order_release);
+        // the pin must be visible before any reads of shared objects
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    static inline void unpin()
+    {
+        auto& state = get_current_thread_state();
+        if (--state.m_pin_depth == 0) {
+            state.m_pinned_epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    static inline bool is_pinned()
+    {
+        return (get_current_thread_state().m_pin_depth > 0);
+    }
+
+    // the object must already be unreachable for readers that pin
+    // from here on. It is reclaimed by calling reclaim_fun on it
+    static void retire(const void* object, ReclaimFunction reclaim_fun);
+
+    // advances the epoch if possible, and reclaims whatever the
+    // calling thread, or exited threads, retired and is now safe
+    // to reclaim. retire() does this every so often on its own
+    static void collect();
+
+    // waits until everything retired so far by the calling thread
+    // and by exited threads has been reclaimed. The calling thread
+    // must not be pinned, and other threads must unpin eventually
+    static void synchronize();
+};
+
+// Pins the calling thread for the lifetime of the guard
+class EpochGuard
+{
+public:
+    inline EpochGuard()
+    {
+        EpochReclamation::pin();
+    }
+
+    EpochGuard(const EpochGuard& other) = delete;
+    EpochGuard(EpochGuard&& other) = delete;
+    EpochGuard& operator = (const EpochGuard& other) = delete;
+    EpochGuard& operator = (EpochGuard&& other) = delete;
+
+    inline ~EpochGuard()
+    {
+        EpochReclamation::unpin();
+    }
+};
+
+} /* end namespace memory */
+} /* end namespace aurum */
+
+#endif /* AURUM_MEMORY_EPOCH_RECLAMATION_HPP_ */
+
+//
+// EpochReclamation.hpp ends here
@@ -40,6 +40,7 @@
 #if !defined AURUM_MEMORY_MANAGED_POINTER_HPP_
 #define AURUM_MEMORY_MANAGED_POINTER_HPP_
 
+#include <ostream>
 #include <type_traits>
 #include <utility>
 
@@ -68,6 +69,9 @@ public:
     static const T* const pointer_sentinel;
 
 private:
+    template <typename U, bool OTHERCONSTPOINTER>
+    friend class ManagedPointerBase;
+
     RawPointerType m_ptr;
 
     template <typename U, bool OTHERCONSTPOINTER>
@@ -80,6 +84,11 @@ private:
 public:
     static const ManagedPointerBase null_pointer;
 
+    // the values which mark deleted and unused entries
+    // in hash tables of managed pointers
+    static inline ManagedPointerBase get_deleted_marker_();
+    static inline ManagedPointerBase get_nonused_marker_();
+
     // Default constructor
     inline ManagedPointerBase();
 
@@ -192,6 +201,20 @@ inline i64 ManagedPointerBase<T, CONSTPOINTER>::compare_(const U* other_raw_ptr)
                  reinterpret_cast<const char*>(other_raw_ptr));
 }
 
+template <typename T, bool CONSTPOINTER>
+inline ManagedPointerBase<T, CONSTPOINTER>
+ManagedPointerBase<T, CONSTPOINTER>::get_deleted_marker_()
+{
+    return ManagedPointerBase((RawPointerType)0x1);
+}
+
+template <typename T, bool CONSTPOINTER>
+inline ManagedPointerBase<T, CONSTPOINTER>
+ManagedPointerBase<T, CONSTPOINTER>::get_nonused_marker_()
+{
+    return null_pointer;
+}
+
 template <typename T, bool CONSTPOINTER>
 inline ManagedPointerBase<T, CONSTPOINTER>::ManagedPointerBase()
     : m_ptr(nullptr)
@@ -246,7 +269,8 @@ ManagedPointerBase<T, CONSTPOINTER>::ManagedPointerBase
                   "Cannot convert a const managed pointer into a non-const "
                   "managed pointer");
 
-    std::swap(m_ptr, other_managed_ptr.m_ptr);
+    m_ptr = other_managed_ptr.m_ptr;
+    other_managed_ptr.m_ptr = nullptr;
 }
 
 template <typename T, bool CONSTPOINTER>
@@ -287,13 +311,17 @@ ManagedPointerBase<T, CONSTPOINTER>::operator = (const ManagedPointerBase& other
     if (&other_managed_ptr == this) {
         return *this;
     }
-    if (m_ptr >= pointer_sentinel) {
-        m_ptr->dec_ref_();
-        m_ptr = nullptr;
+    // take the new reference first, in case both point to the same
+    // object, or the other pointer lives in the object we release
+    auto new_ptr = other_managed_ptr.m_ptr;
+    if (new_ptr >= pointer_sentinel) {
+        new_ptr->inc_ref_();
+    }
+    auto old_ptr = m_ptr;
+    m_ptr = new_ptr;
+    if (old_ptr >= pointer_sentinel) {
+        old_ptr->dec_ref_();
     }
-
-    m_ptr = other_managed_ptr.m_ptr;
-    m_ptr->inc_ref_();
     return *this;
 }
 
@@ -307,15 +335,20 @@ ManagedPointerBase<T, CONSTPOINTER>::operator =
                   "Cannot convert a const managed pointer into a non-const "
                   "managed pointer");
 
-    if (&other_managed_ptr == this) {
+    if (static_cast<const void*>(&other_managed_ptr) == static_cast<const void*>(this)) {
         return *this;
     }
-    if (m_ptr >= pointer_sentinel) {
-        m_ptr->dec_ref_();
-        m_ptr = nullptr;
+    // take the new reference first, in case both point to the same
+    // object, or the other pointer lives in the object we release
+    auto new_ptr = other_managed_ptr.m_ptr;
+    if (new_ptr >= pointer_sentinel) {
+        new_ptr->inc_ref_();
+    }
+    auto old_ptr = m_ptr;
+    m_ptr = new_ptr;
+    if (old_ptr >= pointer_sentinel) {
+        old_ptr->dec_ref_();
     }
-    m_ptr = other_managed_ptr.m_ptr;
-    m_ptr->inc_ref_();
     return *this;
 }
 
@@ -326,12 +359,13 @@ ManagedPointerBase<T, CONSTPOINTER>::operator = (ManagedPointerBase&& other_mana
     if (&other_managed_ptr == this) {
         return *this;
     }
-    if (m_ptr >= pointer_sentinel) {
-        m_ptr->dec_ref_();
-        m_ptr = nullptr;
-    }
+    // the other pointer may live in the object we release
+    auto old_ptr = m_ptr;
     m_ptr = other_managed_ptr.m_ptr;
-    m_ptr->inc_ref_();
+    other_managed_ptr.m_ptr = nullptr;
+    if (old_ptr >= pointer_sentinel) {
+        old_ptr->dec_ref_();
+    }
     return *this;
 }
 
@@ -345,10 +379,16 @@ ManagedPointerBase<T, CONSTPOINTER>::operator =
                   "Cannot convert a const managed pointer into a non-const "
                   "managed pointer");
 
-    if (&other_managed_ptr == this) {
+    if (static_cast<const void*>(&other_managed_ptr) == static_cast<const void*>(this)) {
         return *this;
     }
-    std::swap(m_ptr, other_managed_ptr.m_ptr);
+    // the other pointer may live in the object we release
+    auto old_ptr = m_ptr;
+    m_ptr = other_managed_ptr.m_ptr;
+    other_managed_ptr.m_ptr = nullptr;
+    if (old_ptr >= pointer_sentinel) {
+        old_ptr->dec_ref_();
+    }
     return *this;
 }
 
@@ -357,12 +397,14 @@ inline ManagedPointerBase<T, CONSTPOINTER>&
 ManagedPointerBase<T, CONSTPOINTER>::operator =
 (RawPointerType raw_pointer)
 {
-    if (m_ptr >= pointer_sentinel) {
-        m_ptr->dec_ref_();
+    // the raw pointer may point into the object we release
+    if (raw_pointer >= pointer_sentinel) {
+        raw_pointer->inc_ref_();
     }
+    auto old_ptr = m_ptr;
     m_ptr = raw_pointer;
-    if (m_ptr >= pointer_sentinel) {
-        m_ptr->inc_ref_();
+    if (old_ptr >= pointer_sentinel) {
+        old_ptr->dec_ref_();
     }
     return (*this);
 }
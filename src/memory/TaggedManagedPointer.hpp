@@ -0,0 +1,407 @@
+// TaggedManagedPointer.hpp ---
+//
+// Filename: TaggedManagedPointer.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:23:18 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_MEMORY_TAGGED_MANAGED_POINTER_HPP_
+#define AURUM_MEMORY_TAGGED_MANAGED_POINTER_HPP_
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "../basetypes/AurumTypes.hpp"
+#include "ManagedPointer.hpp"
+
+namespace aurum {
+namespace memory {
+namespace detail_ {
+
+// A managed pointer that packs a small tag into the bits of the
+// pointer that are always zero: the low bits that the alignment of
+// T leaves free, or, for tags of more than those few bits, the top
+// 16 bits of a canonical x86-64 address. A tagged pointer is thus
+// the size of a raw pointer.
+// Tagged pointers are equal when both their pointers and their tags
+// are, and are ordered on their pointers, then their tags.
+// Raw pointers below the ManagedPointer sentinel are kept apart from
+// null pointers with tags. The hash tables mark their deleted and
+// unused entries with two of them, so that null pointers, with any
+// tag, are keys like any other.
+// The layout is only checked when the pointer is used, so that the
+// pointee may be incomplete where the tagged pointer is declared,
+// as with graph nodes that point to other nodes
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+class TaggedManagedPointerBase : private ManagedPointerEBC
+{
+public:
+    typedef typename std::conditional<CONSTPOINTER, const T*, T*>::type RawPointerType;
+    typedef typename std::conditional<CONSTPOINTER, const T&, T&>::type ReferenceType;
+    typedef ManagedPointerBase<T, CONSTPOINTER> ManagedPointerType;
+
+    static const TaggedManagedPointerBase null_pointer;
+
+private:
+    template <typename U, u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    friend class TaggedManagedPointerBase;
+
+    u64 m_packed_value;
+
+    // the allocators only guarantee an alignment of eight bytes,
+    // whatever the alignment of T
+    static inline constexpr u64 get_num_alignment_bits_()
+    {
+        return (alignof(T) < sizeof(u64) ?
+                (u64)__builtin_ctzll(alignof(T)) : (u64)__builtin_ctzll(sizeof(u64)));
+    }
+
+    static inline constexpr bool is_tag_in_high_bits_()
+    {
+        static_assert(NUM_TAG_BITS > 0, "Tagged pointers need at least one tag bit.");
+#if defined __x86_64__
+        static_assert(NUM_TAG_BITS <= get_num_alignment_bits_() || NUM_TAG_BITS <= 16,
+                      "Tagged pointers can only hold tags of up to 16 bits.");
+#else /* !__x86_64__ */
+        static_assert(NUM_TAG_BITS <= get_num_alignment_bits_(),
+                      "The alignment of the pointee leaves too few bits for the tag.");
+#endif /* __x86_64__ */
+        return (NUM_TAG_BITS > get_num_alignment_bits_());
+    }
+
+    static inline constexpr u64 get_tag_shift_()
+    {
+        return (is_tag_in_high_bits_() ? 48 : 0);
+    }
+
+    static inline constexpr u64 get_tag_mask_()
+    {
+        return (((1ull << NUM_TAG_BITS) - 1) << get_tag_shift_());
+    }
+
+    // whether the raw pointer is one of the markers below the
+    // sentinel (see get_deleted_marker_() and get_nonused_marker_())
+    static inline bool is_marker_(u64 raw_pointer)
+    {
+        return (raw_pointer != 0 &&
+                raw_pointer < (u64)ManagedPointerType::pointer_sentinel);
+    }
+
+    // whether the pointer bits are those of a marker moved past the
+    // tag bits. No object lives this low in the address space either
+    static inline bool is_packed_marker_(u64 pointer_bits)
+    {
+        return (pointer_bits != 0 &&
+                pointer_bits < ((u64)ManagedPointerType::pointer_sentinel <<
+                                get_num_alignment_bits_()));
+    }
+
+    static inline u64 pack_(RawPointerType raw_pointer, u64 tag)
+    {
+        auto pointer_bits = (u64)raw_pointer;
+        // markers would overlap the low tag bits, and, say, 0x1 would
+        // be a null pointer with a tag of one, so they are moved past
+        // the tag bits, where no pointer to an object can be
+        if (!is_tag_in_high_bits_() && is_marker_(pointer_bits)) {
+            pointer_bits <<= get_num_alignment_bits_();
+        }
+        return (pointer_bits | ((tag << get_tag_shift_()) & get_tag_mask_()));
+    }
+
+    static inline RawPointerType unpack_(u64 packed_value)
+    {
+        if (is_tag_in_high_bits_()) {
+            // restore the sign extension of bit 47
+            return (RawPointerType)(u64)((i64)(packed_value << 16) >> 16);
+        }
+        auto pointer_bits = (packed_value & ~get_tag_mask_());
+        if (is_packed_marker_(pointer_bits)) {
+            pointer_bits >>= get_num_alignment_bits_();
+        }
+        return (RawPointerType)pointer_bits;
+    }
+
+    static inline void inc_ref_(RawPointerType raw_pointer)
+    {
+        if (raw_pointer >= ManagedPointerType::pointer_sentinel) {
+            raw_pointer->inc_ref_();
+        }
+    }
+
+    static inline void dec_ref_(RawPointerType raw_pointer)
+    {
+        if (raw_pointer >= ManagedPointerType::pointer_sentinel) {
+            raw_pointer->dec_ref_();
+        }
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline i64 compare_(const TaggedManagedPointerBase<T, OTHERNUMTAGBITS, OTHERCONSTPOINTER>&
+                        other) const
+    {
+        auto ptr_difference = (i64)(reinterpret_cast<const char*>(get_raw_pointer()) -
+                                    reinterpret_cast<const char*>(other.get_raw_pointer()));
+        if (ptr_difference != 0) {
+            return ptr_difference;
+        }
+        return ((i64)get_tag() - (i64)other.get_tag());
+    }
+
+public:
+    // a null pointer with a tag of zero is a key, so
+    // unused entries are marked with a marker as well
+    static inline TaggedManagedPointerBase get_deleted_marker_()
+    {
+        return TaggedManagedPointerBase((RawPointerType)0x1);
+    }
+
+    static inline TaggedManagedPointerBase get_nonused_marker_()
+    {
+        return TaggedManagedPointerBase((RawPointerType)0x2);
+    }
+
+    inline TaggedManagedPointerBase()
+        : m_packed_value(0)
+    {
+        // Nothing here
+    }
+
+    inline TaggedManagedPointerBase(RawPointerType raw_pointer, u64 tag = 0)
+        : m_packed_value(pack_(raw_pointer, tag))
+    {
+        inc_ref_(raw_pointer);
+    }
+
+    template <bool OTHERCONSTPOINTER>
+    inline TaggedManagedPointerBase(const ManagedPointerBase<T, OTHERCONSTPOINTER>& managed_ptr,
+                                    u64 tag = 0)
+        : TaggedManagedPointerBase(managed_ptr.get_raw_pointer(), tag)
+    {
+        static_assert((!OTHERCONSTPOINTER || CONSTPOINTER),
+                      "Cannot convert a const managed pointer into a non-const "
+                      "tagged managed pointer");
+    }
+
+    inline TaggedManagedPointerBase(const TaggedManagedPointerBase& other)
+        : m_packed_value(other.m_packed_value)
+    {
+        inc_ref_(get_raw_pointer());
+    }
+
+    template <bool OTHERCONSTPOINTER>
+    inline TaggedManagedPointerBase(const TaggedManagedPointerBase<T, NUM_TAG_BITS,
+                                    OTHERCONSTPOINTER>& other)
+        : m_packed_value(other.m_packed_value)
+    {
+        static_assert((!OTHERCONSTPOINTER || CONSTPOINTER),
+                      "Cannot convert a const managed pointer into a non-const "
+                      "managed pointer");
+        inc_ref_(get_raw_pointer());
+    }
+
+    inline TaggedManagedPointerBase(TaggedManagedPointerBase&& other)
+        : m_packed_value(other.m_packed_value)
+    {
+        other.m_packed_value = 0;
+    }
+
+    inline ~TaggedManagedPointerBase()
+    {
+        dec_ref_(get_raw_pointer());
+    }
+
+    inline TaggedManagedPointerBase& operator = (const TaggedManagedPointerBase& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        // take the new reference first, in case both point to the same
+        // object, or the other pointer lives in the object we release
+        auto new_packed_value = other.m_packed_value;
+        auto old_pointer = get_raw_pointer();
+        inc_ref_(other.get_raw_pointer());
+        m_packed_value = new_packed_value;
+        dec_ref_(old_pointer);
+        return *this;
+    }
+
+    inline TaggedManagedPointerBase& operator = (TaggedManagedPointerBase&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        // the other pointer may live in the object we release
+        auto old_pointer = get_raw_pointer();
+        m_packed_value = other.m_packed_value;
+        other.m_packed_value = 0;
+        dec_ref_(old_pointer);
+        return *this;
+    }
+
+    // the tag is cleared along with the old pointer
+    inline TaggedManagedPointerBase& operator = (RawPointerType raw_pointer)
+    {
+        auto old_pointer = get_raw_pointer();
+        inc_ref_(raw_pointer);
+        m_packed_value = pack_(raw_pointer, 0);
+        dec_ref_(old_pointer);
+        return *this;
+    }
+
+    inline RawPointerType get_raw_pointer() const
+    {
+        return unpack_(m_packed_value);
+    }
+
+    inline u64 get_tag() const
+    {
+        return ((m_packed_value & get_tag_mask_()) >> get_tag_shift_());
+    }
+
+    inline void set_tag(u64 tag)
+    {
+        m_packed_value = pack_(get_raw_pointer(), tag);
+    }
+
+    // the pointer and the tag, as stored
+    inline u64 get_packed_value() const
+    {
+        return m_packed_value;
+    }
+
+    inline ManagedPointerType get_managed_pointer() const
+    {
+        return ManagedPointerType(get_raw_pointer());
+    }
+
+    inline RawPointerType operator -> () const
+    {
+        return get_raw_pointer();
+    }
+
+    inline ReferenceType operator * () const
+    {
+        return *(get_raw_pointer());
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator == (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                             OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) == 0);
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator != (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                             OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) != 0);
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator < (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                            OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) < 0);
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator <= (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                             OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) <= 0);
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator > (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                            OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) > 0);
+    }
+
+    template <u64 OTHERNUMTAGBITS, bool OTHERCONSTPOINTER>
+    inline bool operator >= (const TaggedManagedPointerBase<T, OTHERNUMTAGBITS,
+                             OTHERCONSTPOINTER>& other) const
+    {
+        return (compare_(other) >= 0);
+    }
+
+    inline bool is_null() const
+    {
+        return (get_raw_pointer() == nullptr);
+    }
+
+    inline bool operator ! () const
+    {
+        return is_null();
+    }
+
+    inline operator bool () const
+    {
+        return !is_null();
+    }
+};
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+const TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>
+TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>::null_pointer;
+
+} /* end namespace detail_ */
+
+template <typename T, u64 NUM_TAG_BITS>
+using TaggedManagedPointer = detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, false>;
+
+template <typename T, u64 NUM_TAG_BITS>
+using TaggedManagedConstPointer = detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, true>;
+
+} /* end namespace memory */
+
+template <typename T, u64 NUM_TAG_BITS, bool CONSTPOINTER>
+static inline std::ostream&
+operator << (std::ostream& out_stream,
+             const memory::detail_::TaggedManagedPointerBase<T, NUM_TAG_BITS, CONSTPOINTER>&
+             managed_ptr)
+{
+    out_stream << managed_ptr.get_raw_pointer() << "/" << managed_ptr.get_tag();
+    return out_stream;
+}
+
+} /* end namespace aurum */
+
+#endif /* AURUM_MEMORY_TAGGED_MANAGED_POINTER_HPP_ */
+
+//
+// TaggedManagedPointer.hpp ends here
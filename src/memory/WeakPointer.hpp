@@ -0,0 +1,163 @@
+// WeakPointer.hpp ---
+//
+// Filename: WeakPointer.hpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:09:06 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#if !defined AURUM_MEMORY_WEAK_POINTER_HPP_
+#define AURUM_MEMORY_WEAK_POINTER_HPP_
+
+#include <utility>
+
+#include "../basetypes/RefCountable.hpp"
+
+#include "ManagedPointer.hpp"
+
+namespace aurum {
+namespace memory {
+
+// A reference to a RefCountable object which does not keep the object
+// alive. lock() returns a managed pointer to the object if it is still
+// alive, and a null managed pointer once it has expired
+template <typename T>
+class WeakPointer
+{
+private:
+    T* m_object;
+    WeakReferenceControl* m_control;
+
+    inline void release()
+    {
+        if (m_control != nullptr) {
+            m_control->dec_weak_ref();
+        }
+        m_object = nullptr;
+        m_control = nullptr;
+    }
+
+public:
+    inline WeakPointer()
+        : m_object(nullptr), m_control(nullptr)
+    {
+        // Nothing here
+    }
+
+    inline WeakPointer(T* object)
+        : m_object(object), m_control(nullptr)
+    {
+        if (m_object != nullptr) {
+            m_control = m_object->get_weak_reference_control_();
+            m_control->inc_weak_ref();
+        }
+    }
+
+    inline WeakPointer(const ManagedPointer<T>& managed_ptr)
+        : WeakPointer(managed_ptr.get_raw_pointer())
+    {
+        // Nothing here
+    }
+
+    inline WeakPointer(const WeakPointer& other)
+        : m_object(other.m_object), m_control(other.m_control)
+    {
+        if (m_control != nullptr) {
+            m_control->inc_weak_ref();
+        }
+    }
+
+    inline WeakPointer(WeakPointer&& other)
+        : m_object(other.m_object), m_control(other.m_control)
+    {
+        other.m_object = nullptr;
+        other.m_control = nullptr;
+    }
+
+    inline ~WeakPointer()
+    {
+        release();
+    }
+
+    inline WeakPointer& operator = (const WeakPointer& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        if (other.m_control != nullptr) {
+            other.m_control->inc_weak_ref();
+        }
+        release();
+        m_object = other.m_object;
+        m_control = other.m_control;
+        return *this;
+    }
+
+    inline WeakPointer& operator = (WeakPointer&& other)
+    {
+        if (&other == this) {
+            return *this;
+        }
+        release();
+        std::swap(m_object, other.m_object);
+        std::swap(m_control, other.m_control);
+        return *this;
+    }
+
+    inline bool is_expired() const
+    {
+        return (m_control == nullptr || m_control->is_expired());
+    }
+
+    inline ManagedPointer<T> lock() const
+    {
+        if (is_expired()) {
+            return ManagedPointer<T>();
+        }
+        return ManagedPointer<T>(m_object);
+    }
+
+    inline void reset()
+    {
+        release();
+    }
+};
+
+} /* end namespace memory */
+} /* end namespace aurum */
+
+#endif /* AURUM_MEMORY_WEAK_POINTER_HPP_ */
+
+//
+// WeakPointer.hpp ends here
@@ -0,0 +1,194 @@
+// AtomicManagedPointerTests.cpp ---
+//
+// Filename: AtomicManagedPointerTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:12:02 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/memory/AtomicManagedPointer.hpp"
+#include "../../src/memory/EpochReclamation.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/basetypes/RefCountable.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define TEST_NUM_READERS 4
+#define TEST_NUM_STORES 20000
+
+using aurum::i64;
+using aurum::u64;
+
+using aurum::AtomicRefCountable;
+using aurum::memory::ManagedPointer;
+using aurum::memory::AtomicManagedPointer;
+using aurum::memory::EpochGuard;
+using aurum::memory::EpochReclamation;
+
+namespace atomic_managed_pointer_testing {
+
+// a table whose entries are all the same while it is alive,
+// and scribbled over when it is destroyed
+class Table : public AtomicRefCountable<Table>
+{
+private:
+    std::vector<i64> m_entries;
+
+public:
+    static std::atomic<i64> num_tables_alive;
+
+    explicit Table(i64 value)
+        : m_entries(16, value)
+    {
+        ++num_tables_alive;
+    }
+
+    ~Table()
+    {
+        std::fill(m_entries.begin(), m_entries.end(), -1);
+        --num_tables_alive;
+    }
+
+    i64 get_value() const
+    {
+        return m_entries[0];
+    }
+
+    bool is_consistent() const
+    {
+        for (auto entry : m_entries) {
+            if (entry != m_entries[0] || entry < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+std::atomic<i64> Table::num_tables_alive(0);
+
+} /* end namespace atomic_managed_pointer_testing */
+
+using atomic_managed_pointer_testing::Table;
+
+TEST(AtomicManagedPointerTest, Basic)
+{
+    auto num_alive_before = Table::num_tables_alive.load();
+    {
+        AtomicManagedPointer<Table> cell(new Table(1));
+        ManagedPointer<Table> first = cell.get();
+        EXPECT_EQ(1, first->get_value());
+        EXPECT_EQ(2, first->get_ref_count_());
+
+        {
+            EpochGuard guard;
+            auto table = cell.load(guard);
+            EXPECT_EQ(first.get_raw_pointer(), table);
+
+            cell.store(new Table(2));
+            first = nullptr;
+            // the replaced table lives on while we are pinned
+            EpochReclamation::collect();
+            EXPECT_EQ(num_alive_before + 2, Table::num_tables_alive.load());
+            EXPECT_TRUE(table->is_consistent());
+            EXPECT_EQ(1, table->get_value());
+            EXPECT_EQ(2, cell.load(guard)->get_value());
+        }
+        EpochReclamation::synchronize();
+        EXPECT_EQ(num_alive_before + 1, Table::num_tables_alive.load());
+
+        auto second = cell.get();
+        EXPECT_FALSE(cell.compare_and_store(nullptr, new Table(3)));
+        EXPECT_TRUE(cell.compare_and_store(second.get_raw_pointer(), new Table(4)));
+        EXPECT_EQ(4, cell.get()->get_value());
+    }
+    EpochReclamation::synchronize();
+    EXPECT_EQ(num_alive_before, Table::num_tables_alive.load());
+}
+
+// readers keep reading the table while a writer keeps replacing it
+TEST(AtomicManagedPointerTest, ConcurrentReaders)
+{
+    auto num_alive_before = Table::num_tables_alive.load();
+    {
+        AtomicManagedPointer<Table> cell(new Table(0));
+        std::atomic<bool> done(false);
+        std::atomic<u64> num_inconsistent(0);
+
+        std::vector<std::thread> readers;
+        for (u64 i = 0; i < TEST_NUM_READERS; ++i) {
+            readers.push_back(std::thread([&] () -> void
+                                          {
+                                              i64 last_value = 0;
+                                              while (!done.load()) {
+                                                  EpochGuard guard;
+                                                  auto table = cell.load(guard);
+                                                  if (!table->is_consistent() ||
+                                                      table->get_value() < last_value) {
+                                                      ++num_inconsistent;
+                                                  }
+                                                  last_value = table->get_value();
+                                              }
+                                          }));
+        }
+
+        // the writer exits with objects still retired
+        std::thread writer([&] () -> void
+                           {
+                               for (i64 i = 1; i <= TEST_NUM_STORES; ++i) {
+                                   cell.store(new Table(i));
+                               }
+                           });
+        writer.join();
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        EXPECT_EQ(0u, num_inconsistent.load());
+        EXPECT_EQ(TEST_NUM_STORES, cell.get()->get_value());
+        EpochReclamation::synchronize();
+        EXPECT_EQ(num_alive_before + 1, Table::num_tables_alive.load());
+    }
+    EpochReclamation::synchronize();
+    EXPECT_EQ(num_alive_before, Table::num_tables_alive.load());
+}
+
+//
+// AtomicManagedPointerTests.cpp ends here
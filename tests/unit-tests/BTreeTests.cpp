@@ -0,0 +1,418 @@
+// BTreeTests.cpp ---
+//
+// Filename: BTreeTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:09:13 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/BTree.hpp"
+
+#include <utility>
+#include <random>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using aurum::u32;
+using aurum::u64;
+using aurum::i64;
+
+using aurum::containers::BTreeMap;
+using aurum::containers::BTreeSet;
+using aurum::containers::u64BTreeSet;
+
+using testing::Types;
+
+const u64 max_insertion_value = (1 << 14);
+const u64 max_test_iterations = (1 << 3);
+
+template <typename MapType>
+static inline bool test_equal(const MapType& aurum_map, const std::map<u64, u64>& std_map)
+{
+    if (aurum_map.size() != std_map.size()) {
+        return false;
+    }
+
+    auto it1 = aurum_map.begin();
+    auto it2 = std_map.begin();
+    auto end1 = aurum_map.end();
+    auto end2 = std_map.end();
+
+    while (it1 != end1 && it2 != end2) {
+        if (it1->first != it2->first || it1->second != it2->second) {
+            return false;
+        }
+        ++it1;
+        ++it2;
+    }
+    if (it1 != end1 || it2 != end2) {
+        return false;
+    }
+
+    // walk backwards as well, to check the leaf links
+    auto rit1 = aurum_map.rbegin();
+    auto rit2 = std_map.rbegin();
+    while (rit2 != std_map.rend()) {
+        if (rit1->first != rit2->first) {
+            return false;
+        }
+        ++rit1;
+        ++rit2;
+    }
+    return (rit1 == aurum_map.rend());
+}
+
+template <typename MapType>
+class BTreeMapTest : public ::testing::Test
+{
+protected:
+    BTreeMapTest() {}
+    virtual ~BTreeMapTest() {}
+};
+
+TYPED_TEST_CASE_P(BTreeMapTest);
+
+TYPED_TEST_P(BTreeMapTest, Constructor)
+{
+    typedef TypeParam MapType;
+
+    MapType map1(
+        {
+            {1, 43}, {2, 44}, {3, 45}, {4, 46}, {5, 47},
+            {6, 48}, {7, 49}, {8, 50}, {9, 51}, {10, 52}
+        });
+
+    EXPECT_EQ(10ull, map1.size());
+
+    auto it1 = map1.begin();
+    for (u64 i = 0; i < 10; ++i) {
+        EXPECT_EQ(i+1, it1->first);
+        EXPECT_EQ(i+1+42, it1->second);
+        ++it1;
+    }
+    EXPECT_TRUE(it1 == map1.end());
+
+    MapType map2 = map1;
+    EXPECT_EQ(10ull, map2.size());
+    EXPECT_EQ(map1, map2);
+
+    MapType map3 = std::move(map2);
+    EXPECT_EQ(0ull, map2.size());
+    EXPECT_TRUE(map2.begin() == map2.end());
+    EXPECT_EQ(10ull, map3.size());
+    EXPECT_EQ(map1, map3);
+
+    // unsorted input with duplicates, the first occurrence wins
+    std::vector<std::pair<u64, u64> > input;
+    for (u64 i = 0; i < 1000; ++i) {
+        input.push_back(std::make_pair((i * 7919) % 500, i));
+    }
+    MapType map4(input.begin(), input.end());
+    EXPECT_EQ(500ull, map4.size());
+    std::map<u64, u64> std_map;
+    for (auto const& kv : input) {
+        std_map.insert(kv);
+    }
+    EXPECT_TRUE(test_equal(map4, std_map));
+}
+
+TYPED_TEST_P(BTreeMapTest, Assignment)
+{
+    typedef TypeParam MapType;
+
+    MapType map1;
+    map1 = { {1, 43}, {2, 44}, {3, 45}, {4, 46}, {5, 47},
+             {6, 48}, {7, 49}, {8, 50}, {9, 51}, {10, 52} };
+    EXPECT_EQ(10ull, map1.size());
+
+    MapType map2;
+    for (u64 i = 0; i < 5000; ++i) {
+        map2[i] = i;
+    }
+    map2 = map1;
+    EXPECT_EQ(map1, map2);
+
+    MapType map3;
+    map3 = std::move(map2);
+    EXPECT_EQ(0ull, map2.size());
+    EXPECT_EQ(map1, map3);
+
+    map2[100] = 100;
+    map2.swap(map3);
+    EXPECT_EQ(map1, map2);
+    EXPECT_EQ(1ull, map3.size());
+    EXPECT_EQ(100ull, map3.begin()->first);
+
+    std::vector<std::pair<const u64, u64> > sorted_input;
+    for (u64 i = 0; i < 10000; ++i) {
+        sorted_input.push_back(std::make_pair(i * 2, i));
+    }
+    map3.assign_sorted(sorted_input.begin(), sorted_input.end());
+    EXPECT_EQ(10000ull, map3.size());
+    u64 i = 0;
+    for (auto const& kv : map3) {
+        EXPECT_EQ(i * 2, kv.first);
+        EXPECT_EQ(i, kv.second);
+        ++i;
+    }
+
+    // the tree must remain usable after a bulk load
+    for (u64 j = 0; j < 20000; j += 3) {
+        map3.erase(j);
+    }
+    for (u64 j = 1; j < 20000; j += 4) {
+        map3[j] = j;
+    }
+    std::map<u64, u64> std_map;
+    for (u64 j = 0; j < 10000; ++j) {
+        if ((j * 2) % 3 != 0) {
+            std_map[j * 2] = j;
+        }
+    }
+    for (u64 j = 1; j < 20000; j += 4) {
+        std_map[j] = j;
+    }
+    EXPECT_TRUE(test_equal(map3, std_map));
+}
+
+TYPED_TEST_P(BTreeMapTest, Functional)
+{
+    typedef TypeParam MapType;
+
+    MapType aurum_map;
+    std::map<u64, u64> std_map;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1);
+    std::uniform_int_distribution<u64> key_distribution(0, max_insertion_value);
+
+    for (u64 i = 0; i < max_test_iterations; ++i) {
+        std_map.clear();
+        aurum_map.clear();
+
+        for (u64 j = 0; j < max_insertion_value; ++j) {
+            auto key = key_distribution(generator);
+            std_map[key] = j;
+            aurum_map[key] = j;
+            EXPECT_EQ(std_map.size(), aurum_map.size());
+        }
+
+        EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+        for (u64 j = 0; j < max_insertion_value; ++j) {
+            auto flip = (distribution(generator) == 1);
+            if (flip) {
+                EXPECT_EQ(std_map.erase(j), aurum_map.erase(j));
+            }
+        }
+
+        EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+        for (u64 j = 0; j < max_insertion_value; ++j) {
+            auto it1 = aurum_map.find(j);
+            auto it2 = std_map.find(j);
+            if (it2 == std_map.end()) {
+                EXPECT_TRUE(it1 == aurum_map.end());
+                EXPECT_EQ(0ull, aurum_map.count(j));
+            } else {
+                ASSERT_TRUE(it1 != aurum_map.end());
+                EXPECT_EQ(it2->second, it1->second);
+            }
+        }
+
+        // erase everything through iterators
+        auto it = aurum_map.begin();
+        while (it != aurum_map.end()) {
+            auto next_key = it->first;
+            it = aurum_map.erase(it);
+            std_map.erase(next_key);
+            if (it != aurum_map.end()) {
+                EXPECT_EQ(std_map.begin()->first, it->first);
+            }
+        }
+        EXPECT_TRUE(aurum_map.empty());
+        EXPECT_EQ(0u, aurum_map.get_height());
+    }
+}
+
+TYPED_TEST_P(BTreeMapTest, RangeQueries)
+{
+    typedef TypeParam MapType;
+
+    MapType aurum_map;
+    std::map<u64, u64> std_map;
+    for (u64 i = 0; i < 4096; ++i) {
+        aurum_map.insert(std::make_pair(i * 4, i));
+        std_map.insert(std::make_pair(i * 4, i));
+    }
+
+    for (u64 key = 0; key < 4096 * 4 + 8; ++key) {
+        auto lb1 = aurum_map.lower_bound(key);
+        auto lb2 = std_map.lower_bound(key);
+        auto ub1 = aurum_map.upper_bound(key);
+        auto ub2 = std_map.upper_bound(key);
+
+        if (lb2 == std_map.end()) {
+            EXPECT_TRUE(lb1 == aurum_map.end());
+        } else {
+            ASSERT_TRUE(lb1 != aurum_map.end());
+            EXPECT_EQ(lb2->first, lb1->first);
+        }
+
+        if (ub2 == std_map.end()) {
+            EXPECT_TRUE(ub1 == aurum_map.end());
+        } else {
+            ASSERT_TRUE(ub1 != aurum_map.end());
+            EXPECT_EQ(ub2->first, ub1->first);
+        }
+    }
+
+    // scan a range
+    u64 expected = 100;
+    for (auto it = aurum_map.lower_bound(399), last = aurum_map.upper_bound(800);
+         it != last; ++it) {
+        EXPECT_EQ(expected * 4, it->first);
+        ++expected;
+    }
+    EXPECT_EQ(201ull, expected);
+
+    auto range = aurum_map.equal_range(400);
+    EXPECT_EQ(400ull, range.first->first);
+    EXPECT_EQ(404ull, range.second->first);
+
+    // erase a range
+    auto first = aurum_map.lower_bound(1000);
+    auto last = aurum_map.lower_bound(3000);
+    auto it = aurum_map.erase(first, last);
+    EXPECT_EQ(3000ull, it->first);
+    std_map.erase(std_map.lower_bound(1000), std_map.lower_bound(3000));
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+    aurum_map.erase(aurum_map.lower_bound(10000), aurum_map.end());
+    std_map.erase(std_map.lower_bound(10000), std_map.end());
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+}
+
+TYPED_TEST_P(BTreeMapTest, Stringification)
+{
+    typedef TypeParam MapType;
+
+    MapType the_map;
+    the_map[2000] = 2042;
+    the_map[0] = 42;
+    the_map[1] = 43;
+
+    EXPECT_EQ("BTreeMap<unsigned long, unsigned long> with 3 elements:\n"
+              "<<{0 |--> 42}, {1 |--> 43}, {2000 |--> 2042}>>",
+              the_map.to_string());
+}
+
+REGISTER_TYPED_TEST_CASE_P(BTreeMapTest,
+                           Constructor,
+                           Assignment,
+                           Functional,
+                           RangeQueries,
+                           Stringification);
+
+// the 64 byte variant has tiny nodes, which makes for deep trees
+// and exercises splits, borrows and merges at every level
+typedef Types<BTreeMap<u64, u64>,
+              BTreeMap<u64, u64, aurum::comparisons::Lesser<u64>, 64> > BTreeMapImplementations;
+
+INSTANTIATE_TYPED_TEST_CASE_P(BTreeMapTests, BTreeMapTest, BTreeMapImplementations);
+
+TEST(BTreeSetTest, Functional)
+{
+    u64BTreeSet aurum_set;
+    std::set<u64> std_set;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, max_insertion_value);
+
+    for (u64 i = 0; i < max_insertion_value; ++i) {
+        auto value = distribution(generator);
+        auto result1 = aurum_set.insert(value);
+        auto result2 = std_set.insert(value);
+        EXPECT_EQ(result2.second, result1.second);
+        EXPECT_EQ(value, *(result1.first));
+    }
+
+    for (u64 i = 0; i < max_insertion_value; i += 2) {
+        EXPECT_EQ(std_set.erase(i), aurum_set.erase(i));
+    }
+
+    ASSERT_EQ(std_set.size(), aurum_set.size());
+    EXPECT_TRUE(std::equal(std_set.begin(), std_set.end(), aurum_set.begin()));
+
+    u64BTreeSet other_set(aurum_set);
+    EXPECT_EQ(aurum_set, other_set);
+    other_set.erase(*(other_set.begin()));
+    EXPECT_NE(aurum_set, other_set);
+    EXPECT_LT(other_set, aurum_set);
+
+    BTreeSet<std::string> string_set = { "def", "abc", "ghi", "abc" };
+    EXPECT_EQ(3ull, string_set.size());
+    auto set_string = string_set.to_string();
+    EXPECT_EQ(0ull, set_string.find("BTreeSet<"));
+    EXPECT_NE(std::string::npos, set_string.find("with 3 elements:\n<<abc, def, ghi>>"));
+}
+
+TEST(BTreeMapTest, Performance)
+{
+    BTreeMap<u64, u64> aurum_map;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1);
+
+    for (u64 j = 0; j < (1 << 2); ++j) {
+        aurum_map.clear();
+
+        for (u64 i = 0; i < 64 * max_insertion_value; ++i) {
+            aurum_map[i] = i + 42;
+        }
+
+        for (u64 i = 0; i < 64 * max_insertion_value; ++i) {
+            if (distribution(generator) == 1) {
+                aurum_map.erase(i);
+            }
+        }
+    }
+}
+
+//
+// BTreeTests.cpp ends here
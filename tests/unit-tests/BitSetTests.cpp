@@ -0,0 +1,229 @@
+// BitSetTests.cpp ---
+//
+// Filename: BitSetTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:24:50 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/BitSet.hpp"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define MAX_TEST_SIZE (1 << 12)
+#define NUM_TEST_ITERATIONS (1 << 6)
+#define PERF_TEST_NUM_BITS ((u64)(1 << 22))
+#define PERF_TEST_ITERATIONS ((u64)(1 << 8))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::BitSet;
+
+static inline BitSet make_random_bit_set(u64 num_bits, std::vector<bool>& model,
+                                         std::default_random_engine& generator,
+                                         u32 one_in = 3)
+{
+    std::uniform_int_distribution<u32> distribution(0, one_in - 1);
+    BitSet retval(num_bits);
+    model.assign(num_bits, false);
+    for (u64 i = 0; i < num_bits; ++i) {
+        if (distribution(generator) == 0) {
+            retval.set(i);
+            model[i] = true;
+        }
+    }
+    return retval;
+}
+
+static inline bool test_equal(const BitSet& bit_set, const std::vector<bool>& model)
+{
+    if (bit_set.size() != model.size()) {
+        return false;
+    }
+    for (u64 i = 0; i < model.size(); ++i) {
+        if (bit_set.test(i) != model[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(BitSetTest, Basic)
+{
+    BitSet empty;
+    EXPECT_EQ(0ul, empty.size());
+    EXPECT_EQ(0ul, empty.count());
+    EXPECT_TRUE(empty.none());
+    EXPECT_TRUE(empty.all());
+    EXPECT_EQ(0ul, empty.find_first());
+
+    for (u64 size : { 1ul, 63ul, 64ul, 65ul, 127ul, 128ul, 129ul, 1000ul }) {
+        BitSet ones(size, true);
+        EXPECT_EQ(size, ones.count());
+        EXPECT_TRUE(ones.all());
+
+        BitSet zeros(size);
+        EXPECT_EQ(0ul, zeros.count());
+        EXPECT_TRUE(zeros.none());
+        EXPECT_EQ(size, zeros.find_first());
+
+        // flipping must not spill into the bits past the end
+        zeros.flip();
+        EXPECT_EQ(ones, zeros);
+        EXPECT_EQ(ones, ~BitSet(size));
+
+        EXPECT_TRUE(ones.flip(size - 1));
+        EXPECT_FALSE(ones.test(size - 1));
+        EXPECT_FALSE(ones.flip(size - 1));
+        ones[0] = false;
+        EXPECT_FALSE(ones[0]);
+        EXPECT_EQ(size - 1, ones.count());
+        EXPECT_TRUE(ones < zeros);
+        EXPECT_TRUE(zeros > ones);
+    }
+
+    BitSet bit_set(100);
+    bit_set.set(3);
+    bit_set.set(64);
+    bit_set.set(99);
+    EXPECT_EQ("BitSet with 100 bits: {3, 64, 99}", bit_set.to_string());
+
+    bit_set.resize_and_clear(200);
+    EXPECT_EQ(200ul, bit_set.size());
+    EXPECT_TRUE(bit_set.none());
+    bit_set.resize_and_clear(0);
+    EXPECT_EQ(0ul, bit_set.size());
+}
+
+TEST(BitSetTest, FindAndCount)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, MAX_TEST_SIZE);
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        std::vector<bool> model;
+        const u64 size = distribution(generator);
+        // sparse sets, so that runs of zero words get skipped
+        auto bit_set = make_random_bit_set(size, model, generator, 1 + (i % 300));
+        EXPECT_TRUE(test_equal(bit_set, model));
+
+        std::vector<u64> expected_bits;
+        for (u64 j = 0; j < size; ++j) {
+            if (model[j]) {
+                expected_bits.push_back(j);
+            }
+        }
+
+        std::vector<u64> actual_bits;
+        for (auto j = bit_set.find_first(); j < bit_set.size(); j = bit_set.find_next(j)) {
+            actual_bits.push_back(j);
+        }
+
+        EXPECT_EQ(expected_bits, actual_bits);
+        EXPECT_EQ(expected_bits.size(), bit_set.count());
+        EXPECT_EQ(expected_bits.size() != 0, bit_set.any());
+    }
+}
+
+TEST(BitSetTest, SetAlgebra)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, MAX_TEST_SIZE);
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        const u64 size = distribution(generator);
+        std::vector<bool> model1, model2;
+        auto set1 = make_random_bit_set(size, model1, generator);
+        auto set2 = make_random_bit_set(size, model2, generator);
+
+        std::vector<bool> and_model(size), or_model(size), xor_model(size), diff_model(size);
+        bool subset = true;
+        bool intersects = false;
+        for (u64 j = 0; j < size; ++j) {
+            and_model[j] = model1[j] && model2[j];
+            or_model[j] = model1[j] || model2[j];
+            xor_model[j] = model1[j] != model2[j];
+            diff_model[j] = model1[j] && !model2[j];
+            subset = subset && (!model1[j] || model2[j]);
+            intersects = intersects || and_model[j];
+        }
+
+        EXPECT_TRUE(test_equal(set1 & set2, and_model));
+        EXPECT_TRUE(test_equal(set1 | set2, or_model));
+        EXPECT_TRUE(test_equal(set1 ^ set2, xor_model));
+        EXPECT_TRUE(test_equal(set1 - set2, diff_model));
+
+        EXPECT_EQ(subset, set1.is_subset_of(set2));
+        EXPECT_EQ(intersects, set1.intersects(set2));
+        EXPECT_TRUE((set1 & set2).is_subset_of(set1));
+        EXPECT_TRUE(set1.is_subset_of(set1 | set2));
+        EXPECT_FALSE((set1 - set2).intersects(set2));
+
+        auto set3 = set1;
+        set3 |= set2;
+        EXPECT_EQ(set1 | set2, set3);
+        set3 -= set2;
+        EXPECT_EQ(set1 - set2, set3);
+        set3 ^= set1;
+        EXPECT_EQ(set1 & set2, set3);
+        set3 &= set2;
+        EXPECT_EQ(set1 & set2, set3);
+    }
+}
+
+TEST(BitSetTest, PerfTest)
+{
+    std::default_random_engine generator;
+    std::vector<bool> model1, model2;
+    auto set1 = make_random_bit_set(PERF_TEST_NUM_BITS, model1, generator);
+    auto set2 = make_random_bit_set(PERF_TEST_NUM_BITS, model2, generator);
+    BitSet accumulator(PERF_TEST_NUM_BITS);
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_ITERATIONS; ++i) {
+        accumulator |= set1;
+        accumulator -= set2;
+        accumulator ^= set2;
+        total += accumulator.count();
+    }
+
+    EXPECT_LT(0ul, total);
+}
+
+//
+// BitSetTests.cpp ends here
@@ -0,0 +1,371 @@
+// BoundedCacheTests.cpp ---
+//
+// Filename: BoundedCacheTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:55:38 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/BoundedCache.hpp"
+
+#include <cmath>
+#include <list>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 16)
+#define NUM_THREADS 4
+#define PERF_TEST_NUM_KEYS ((u64)(1 << 16))
+#define PERF_TEST_CAPACITY ((u64)(1 << 10))
+#define PERF_TEST_NUM_LOOKUPS ((u64)(1 << 21))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::BoundedCache;
+using aurum::containers::ConcurrentBoundedCache;
+using aurum::containers::LRUCachePolicy;
+using aurum::containers::ClockCachePolicy;
+using aurum::containers::TinyLFUCachePolicy;
+
+class StringLengthSize
+{
+public:
+    inline u64 operator () (u32 key, const std::string& value) const
+    {
+        return value.length();
+    }
+};
+
+TEST(BoundedCacheTest, LRU)
+{
+    BoundedCache<u32, u32> cache(3);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_TRUE(cache.find(1) == nullptr);
+
+    EXPECT_TRUE(cache.insert(1, 10));
+    EXPECT_TRUE(cache.insert(2, 20));
+    EXPECT_TRUE(cache.insert(3, 30));
+    EXPECT_EQ(10u, *cache.find(1));
+    EXPECT_TRUE(cache.insert(4, 40));
+
+    // 2 was the least recently used
+    EXPECT_EQ(3ul, cache.size());
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_EQ(30u, *cache.peek(3));
+
+    // peek does not count as a use, so 3 goes next
+    EXPECT_TRUE(cache.insert(5, 50));
+    EXPECT_FALSE(cache.contains(3));
+
+    EXPECT_TRUE(cache.insert(1, 11));
+    EXPECT_EQ(11u, *cache.find(1));
+    EXPECT_EQ(3ul, cache.size());
+
+    auto const& statistics = cache.get_statistics();
+    EXPECT_EQ(2ul, statistics.m_hits);
+    EXPECT_EQ(1ul, statistics.m_misses);
+    EXPECT_EQ(5ul, statistics.m_insertions);
+    EXPECT_EQ(2ul, statistics.m_evictions);
+
+    EXPECT_TRUE(cache.erase(4));
+    EXPECT_FALSE(cache.erase(4));
+    cache.set_capacity(1);
+    EXPECT_EQ(1ul, cache.size());
+    EXPECT_TRUE(cache.contains(1));
+
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(0ul, cache.get_used_capacity());
+    EXPECT_TRUE(cache.insert(2, 20));
+    EXPECT_EQ("BoundedCache<unsigned int, unsigned int> with 1 elements, using 1 of 1:\n"
+              "<<\n  {2 |--> 20}\n>>", cache.to_string());
+}
+
+TEST(BoundedCacheTest, Clock)
+{
+    BoundedCache<u32, u32, ClockCachePolicy> cache(3);
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(3, 30);
+    cache.find(1);
+    cache.find(3);
+
+    // 1 and 3 get a second chance
+    cache.insert(4, 40);
+    EXPECT_FALSE(cache.contains(2));
+    cache.insert(5, 50);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_EQ(3ul, cache.size());
+}
+
+TEST(BoundedCacheTest, AgainstModel)
+{
+    // an LRU cache against a list in order of use
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u32> op_distribution(0, 9);
+    std::uniform_int_distribution<u32> key_distribution(0, 255);
+
+    const u64 capacity = 64;
+    BoundedCache<u32, u32> cache(capacity);
+    std::list<std::pair<u32, u32> > model;
+
+    auto model_find = [&](u32 key) {
+        for (auto it = model.begin(); it != model.end(); ++it) {
+            if (it->first == key) {
+                return it;
+            }
+        }
+        return model.end();
+    };
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        const u32 op = op_distribution(generator);
+        const u32 key = key_distribution(generator);
+        auto it = model_find(key);
+        if (op < 5) {
+            auto value = cache.find(key);
+            ASSERT_EQ(it != model.end(), value != nullptr);
+            if (it != model.end()) {
+                EXPECT_EQ(it->second, *value);
+                model.splice(model.begin(), model, it);
+            }
+        } else if (op < 9) {
+            EXPECT_TRUE(cache.insert(key, i));
+            if (it != model.end()) {
+                model.erase(it);
+            }
+            model.emplace_front(key, i);
+            if (model.size() > capacity) {
+                model.pop_back();
+            }
+        } else {
+            EXPECT_EQ(it != model.end(), cache.erase(key));
+            if (it != model.end()) {
+                model.erase(it);
+            }
+        }
+        ASSERT_EQ(model.size(), cache.size());
+    }
+
+    for (auto const& entry : model) {
+        EXPECT_EQ(entry.second, *cache.peek(entry.first));
+    }
+}
+
+TEST(BoundedCacheTest, SizeFunction)
+{
+    BoundedCache<u32, std::string, LRUCachePolicy, StringLengthSize> cache(10);
+    EXPECT_TRUE(cache.insert(1, "abcd"));
+    EXPECT_TRUE(cache.insert(2, "efgh"));
+    EXPECT_EQ(8ul, cache.get_used_capacity());
+
+    // too large to ever fit
+    EXPECT_FALSE(cache.insert(3, "01234567890"));
+    EXPECT_EQ(1ul, cache.get_statistics().m_rejections);
+
+    // evicts both of the others
+    EXPECT_TRUE(cache.insert(3, "0123456789"));
+    EXPECT_EQ(1ul, cache.size());
+    EXPECT_EQ(10ul, cache.get_used_capacity());
+
+    EXPECT_TRUE(cache.insert(4, "ab"));
+    EXPECT_TRUE(cache.insert(5, "cd"));
+    EXPECT_FALSE(cache.contains(3));
+    // growing an entry evicts the others, but not the entry itself
+    EXPECT_TRUE(cache.insert(4, "abcdefghi"));
+    EXPECT_TRUE(cache.contains(4));
+    EXPECT_FALSE(cache.contains(5));
+    EXPECT_EQ(9ul, cache.get_used_capacity());
+}
+
+TEST(BoundedCacheTest, SizedAdmission)
+{
+    BoundedCache<u32, std::string, TinyLFUCachePolicy, StringLengthSize> cache(10);
+    for (u32 key = 1; key <= 5; ++key) {
+        EXPECT_TRUE(cache.insert(key, "ab"));
+    }
+    // all but 1 are used more often than the large entry
+    for (u32 i = 0; i < 3; ++i) {
+        for (u32 key = 2; key <= 5; ++key) {
+            cache.find(key);
+        }
+    }
+    for (u32 i = 0; i < 2; ++i) {
+        EXPECT_TRUE(cache.find(9) == nullptr);
+    }
+
+    // the large entry beats the first victim, but not the second
+    EXPECT_FALSE(cache.insert(9, "0123456789"));
+    EXPECT_FALSE(cache.contains(9));
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(4ul, cache.size());
+    EXPECT_EQ(1ul, cache.get_statistics().m_evictions);
+    EXPECT_EQ(1ul, cache.get_statistics().m_rejections);
+
+    // clearing the cache keeps the statistics
+    cache.clear();
+    EXPECT_TRUE(cache.empty());
+    EXPECT_EQ(5ul, cache.get_statistics().m_insertions);
+    cache.reset_statistics();
+    EXPECT_EQ(0ul, cache.get_statistics().m_insertions);
+}
+
+TEST(BoundedCacheTest, Memoization)
+{
+    BoundedCache<u32, u64> cache(128);
+    u32 num_computations = 0;
+    std::function<u64(u32)> fibonacci = [&](u32 n) -> u64 {
+        ++num_computations;
+        if (n < 2) {
+            return n;
+        }
+        return (cache.get_or_compute(n - 1, fibonacci) + cache.get_or_compute(n - 2, fibonacci));
+    };
+
+    EXPECT_EQ(12586269025ul, cache.get_or_compute(50, fibonacci));
+    EXPECT_EQ(51u, num_computations);
+    EXPECT_EQ(12586269025ul, cache.get_or_compute(50, fibonacci));
+    EXPECT_EQ(51u, num_computations);
+}
+
+TEST(BoundedCacheTest, TinyLFU)
+{
+    // a hot set which fits in the cache, with scans of one-off keys
+    // in between: LRU gets flushed by every scan, TinyLFU does not
+    // admit the scanned keys
+    BoundedCache<u32, u32, LRUCachePolicy> lru_cache(100);
+    BoundedCache<u32, u32, TinyLFUCachePolicy> tiny_lfu_cache(100);
+    u32 next_scan_key = 1000;
+
+    for (u32 round = 0; round < 50; ++round) {
+        for (u32 key = 0; key < 80; ++key) {
+            lru_cache.get_or_compute(key, [](u32 key) { return key; });
+            tiny_lfu_cache.get_or_compute(key, [](u32 key) { return key; });
+        }
+        for (u32 i = 0; i < 200; ++i, ++next_scan_key) {
+            lru_cache.get_or_compute(next_scan_key, [](u32 key) { return key; });
+            tiny_lfu_cache.get_or_compute(next_scan_key, [](u32 key) { return key; });
+        }
+    }
+
+    auto lru_hits = lru_cache.get_statistics().m_hits;
+    auto tiny_lfu_hits = tiny_lfu_cache.get_statistics().m_hits;
+    EXPECT_EQ(0ul, lru_hits);
+    EXPECT_LT(80ul * 40, tiny_lfu_hits);
+    EXPECT_LT(0ul, tiny_lfu_cache.get_statistics().m_rejections);
+}
+
+TEST(BoundedCacheTest, Concurrent)
+{
+    ConcurrentBoundedCache<u32, u64> cache(1000, 8);
+    EXPECT_EQ(8u, cache.get_num_shards());
+
+    std::vector<std::thread> threads;
+    std::vector<u32> num_errors(NUM_THREADS, 0);
+    for (u32 i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&cache, &num_errors, i]() {
+                std::default_random_engine generator(i);
+                std::uniform_int_distribution<u32> distribution(0, 3000);
+                for (u32 j = 0; j < NUM_TEST_ITERATIONS / 4; ++j) {
+                    const u32 key = distribution(generator);
+                    auto value = cache.get_or_compute(key, [](u32 key) { return (u64)key * key; });
+                    if (value != (u64)key * key) {
+                        ++num_errors[i];
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto errors : num_errors) {
+        EXPECT_EQ(0u, errors);
+    }
+    EXPECT_GE(1000ul, cache.size());
+    auto statistics = cache.get_statistics();
+    EXPECT_EQ((u64)NUM_THREADS * NUM_TEST_ITERATIONS / 4,
+              statistics.m_hits + statistics.m_misses);
+    EXPECT_LT(0ul, statistics.m_hits);
+
+    u64 value;
+    cache.insert(5000, 1);
+    EXPECT_TRUE(cache.find(5000, value));
+    EXPECT_EQ(1ul, value);
+    EXPECT_TRUE(cache.erase(5000));
+    EXPECT_FALSE(cache.contains(5000));
+}
+
+template <typename CacheType>
+static inline void run_zipf_workload(const char* name, const std::vector<u32>& keys)
+{
+    CacheType cache(PERF_TEST_CAPACITY);
+    u64 total = 0;
+    for (auto key : keys) {
+        total += cache.get_or_compute(key, [](u32 key) { return key; });
+    }
+    printf("%s: hit ratio %.3f\n", name, cache.get_statistics().get_hit_ratio());
+    EXPECT_LT(0ul, total);
+}
+
+TEST(BoundedCacheTest, PerfTest)
+{
+    // lookups of keys with a zipfian distribution
+    std::vector<double> weights(PERF_TEST_NUM_KEYS);
+    for (u64 i = 0; i < PERF_TEST_NUM_KEYS; ++i) {
+        weights[i] = 1.0 / std::pow(i + 1, 0.9);
+    }
+    std::default_random_engine generator;
+    std::discrete_distribution<u32> distribution(weights.begin(), weights.end());
+    std::vector<u32> keys(PERF_TEST_NUM_LOOKUPS);
+    for (auto& key : keys) {
+        key = distribution(generator);
+    }
+
+    run_zipf_workload<BoundedCache<u32, u32, LRUCachePolicy> >("LRU", keys);
+    run_zipf_workload<BoundedCache<u32, u32, ClockCachePolicy> >("CLOCK", keys);
+    run_zipf_workload<BoundedCache<u32, u32, TinyLFUCachePolicy> >("TinyLFU", keys);
+}
+
+//
+// BoundedCacheTests.cpp ends here
@@ -0,0 +1,266 @@
+// ConcurrentRefCacheTests.cpp ---
+//
+// Filename: ConcurrentRefCacheTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 03:44:19 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/ConcurrentRefCache.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/basetypes/Hashable.hpp"
+#include "../../src/basetypes/EComparable.hpp"
+#include "../../src/basetypes/RefCountable.hpp"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#define TEST_NUM_THREADS 4
+#define TEST_NUM_LEAVES 32
+#define TEST_NUM_ROUNDS 64
+
+using aurum::i64;
+using aurum::u32;
+using aurum::u64;
+
+using aurum::AurumObject;
+using aurum::AtomicRefCountable;
+using aurum::Hashable;
+using aurum::EComparable;
+using aurum::memory::ManagedConstPointer;
+using aurum::containers::ConcurrentRefCache;
+
+// a binary term with a value, the leaves have null children
+class Term : public AurumObject<Term>,
+             public AtomicRefCountable<Term>,
+             public Hashable<Term>,
+             public EComparable<Term>
+{
+private:
+    typedef ManagedConstPointer<Term> TermRef;
+    typedef AurumObject<Term> ObjectBase;
+
+    static std::atomic<i64> num_terms_alive;
+
+    i64 m_value;
+    TermRef m_left;
+    TermRef m_right;
+
+public:
+    void* operator new (std::size_t sz)
+    {
+        ++num_terms_alive;
+        return ObjectBase::operator new(sz);
+    }
+
+    void operator delete (void* ptr, std::size_t sz)
+    {
+        --num_terms_alive;
+        ObjectBase::operator delete(ptr, sz);
+    }
+
+    static i64 get_num_terms_alive()
+    {
+        return num_terms_alive;
+    }
+
+    Term(i64 value, const TermRef& left, const TermRef& right)
+        : m_value(value), m_left(left), m_right(right)
+    {
+        // computed here, so that other threads only read it
+        hash();
+    }
+
+    // the children are canonical, so they are hashed and
+    // compared on their addresses
+    static u64 compute_hash_value_for(i64 value, const TermRef& left, const TermRef& right)
+    {
+        u64 retval = (u64)value * 0x9E3779B97F4A7C15ull;
+        retval = (retval ^ (u64)left.get_raw_pointer()) * 0x100000001b3ull;
+        retval = (retval ^ (u64)right.get_raw_pointer()) * 0x100000001b3ull;
+        return retval;
+    }
+
+    static bool equal_to_args(const Term& term, i64 value,
+                              const TermRef& left, const TermRef& right)
+    {
+        return (term.m_value == value && term.m_left == left && term.m_right == right);
+    }
+
+    u64 compute_hash_value() const
+    {
+        return compute_hash_value_for(m_value, m_left, m_right);
+    }
+
+    bool equal_to(const Term& other) const
+    {
+        return equal_to_args(other, m_value, other.m_left, other.m_right) &&
+            equal_to_args(*this, other.m_value, other.m_left, other.m_right);
+    }
+};
+
+std::atomic<i64> Term::num_terms_alive(0);
+
+typedef ConcurrentRefCache<Term> TermCache;
+typedef ManagedConstPointer<Term> TermRef;
+
+TEST(ConcurrentRefCacheTest, Basic)
+{
+    {
+        TermCache the_cache(4);
+        EXPECT_EQ(4u, the_cache.get_num_shards());
+
+        TermRef one = the_cache.get<Term>(1, TermRef(), TermRef());
+        TermRef two = the_cache.get<Term>(2, TermRef(), TermRef());
+        TermRef sum = the_cache.get<Term>(0, one, two);
+        EXPECT_EQ(3u, the_cache.size());
+        EXPECT_EQ(one, the_cache.get<Term>(1, TermRef(), TermRef()));
+        EXPECT_EQ(sum, the_cache.get<Term>(0, one, two));
+        EXPECT_NE(sum, the_cache.get<Term>(0, two, one));
+        EXPECT_EQ(4u, the_cache.size());
+
+        // the reversed sum, and then the sum and its children
+        the_cache.garbage_collect();
+        EXPECT_EQ(3u, the_cache.size());
+        sum = nullptr;
+        one = nullptr;
+        two = nullptr;
+        the_cache.garbage_collect();
+        EXPECT_EQ(0u, the_cache.size());
+        EXPECT_EQ(0, Term::get_num_terms_alive());
+    }
+    EXPECT_EQ(0, Term::get_num_terms_alive());
+}
+
+TEST(ConcurrentRefCacheTest, CanonicalInstances)
+{
+    TermCache the_cache;
+    std::vector<std::vector<const Term*> > results(TEST_NUM_THREADS);
+
+    {
+        std::vector<std::thread> threads;
+        for (u32 t = 0; t < TEST_NUM_THREADS; ++t) {
+            threads.emplace_back([&, t]() -> void
+                                 {
+                                     std::default_random_engine generator(t);
+                                     std::vector<u64> order(TEST_NUM_LEAVES * TEST_NUM_LEAVES);
+                                     for (u64 i = 0; i < order.size(); ++i) {
+                                         order[i] = i;
+                                     }
+                                     // every thread builds the same terms, in a different order
+                                     std::shuffle(order.begin(), order.end(), generator);
+
+                                     std::vector<TermRef> terms(order.size());
+                                     for (auto i : order) {
+                                         TermRef left = the_cache.get<Term>((i64)(i / TEST_NUM_LEAVES),
+                                                                            TermRef(), TermRef());
+                                         TermRef right = the_cache.get<Term>((i64)(i % TEST_NUM_LEAVES),
+                                                                             TermRef(), TermRef());
+                                         terms[i] = the_cache.get<Term>(-1, left, right);
+                                     }
+                                     for (auto const& term : terms) {
+                                         results[t].push_back(term.get_raw_pointer());
+                                     }
+                                 });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (u32 t = 1; t < TEST_NUM_THREADS; ++t) {
+        EXPECT_EQ(results[0], results[t]);
+    }
+
+    the_cache.garbage_collect();
+    EXPECT_EQ(0u, the_cache.size());
+    EXPECT_EQ(0, Term::get_num_terms_alive());
+}
+
+TEST(ConcurrentRefCacheTest, ConcurrentCollection)
+{
+    TermCache the_cache(8);
+    std::atomic<bool> done(false);
+    std::atomic<u64> num_mismatches(0);
+
+    // collects while the others build and drop terms
+    std::thread collector([&]() -> void
+                          {
+                              while (!done) {
+                                  the_cache.garbage_collect();
+                                  std::this_thread::yield();
+                              }
+                          });
+
+    std::vector<std::thread> threads;
+    for (u32 t = 0; t < TEST_NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() -> void
+                             {
+                                 std::default_random_engine generator(t);
+                                 std::uniform_int_distribution<i64> distribution(0, TEST_NUM_LEAVES - 1);
+                                 TermRef kept = the_cache.get<Term>((i64)t, TermRef(), TermRef());
+
+                                 for (u64 round = 0; round < TEST_NUM_ROUNDS; ++round) {
+                                     TermRef chain = kept;
+                                     for (u64 i = 0; i < TEST_NUM_LEAVES; ++i) {
+                                         TermRef leaf = the_cache.get<Term>(distribution(generator),
+                                                                            TermRef(), TermRef());
+                                         chain = the_cache.get<Term>(-1, chain, leaf);
+                                     }
+                                     // the kept term stays the canonical one
+                                     if (kept != the_cache.get<Term>((i64)t, TermRef(), TermRef())) {
+                                         ++num_mismatches;
+                                     }
+                                 }
+                             });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    collector.join();
+
+    EXPECT_EQ(0u, num_mismatches);
+    the_cache.garbage_collect();
+    EXPECT_EQ(0u, the_cache.size());
+    EXPECT_EQ(0, Term::get_num_terms_alive());
+}
+
+//
+// ConcurrentRefCacheTests.cpp ends here
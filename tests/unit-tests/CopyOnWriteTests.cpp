@@ -0,0 +1,187 @@
+// CopyOnWriteTests.cpp ---
+//
+// Filename: CopyOnWriteTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:50:46 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/CopyOnWrite.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define NUM_THREADS 4
+#define NUM_TEST_ELEMENTS ((u64)(1 << 12))
+#define PERF_TEST_NUM_ELEMENTS ((u64)(1 << 16))
+#define PERF_TEST_NUM_COPIES ((u64)(1 << 10))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::Vector;
+using aurum::containers::CopyOnWriteVector;
+using aurum::containers::CopyOnWriteUnorderedMap;
+
+TEST(CopyOnWriteTest, Vector)
+{
+    CopyOnWriteVector<u32> vector1;
+    EXPECT_TRUE(vector1.empty());
+    EXPECT_FALSE(vector1.is_shared());
+
+    for (u32 i = 0; i < 100; ++i) {
+        vector1.get_mutable().push_back(i);
+    }
+
+    auto vector2 = vector1;
+    auto vector3 = vector2;
+    EXPECT_TRUE(vector1.shares_with(vector3));
+    EXPECT_EQ(3ul, vector1.get_share_count());
+    EXPECT_EQ(&(vector1.get()), &(vector2.get()));
+    EXPECT_EQ(vector1, vector2);
+
+    // the first mutation clones, subsequent ones don't
+    vector2.get_mutable()[0] = 42;
+    EXPECT_FALSE(vector1.shares_with(vector2));
+    EXPECT_EQ(2ul, vector1.get_share_count());
+    EXPECT_FALSE(vector2.is_shared());
+    auto data = &(vector2.get());
+    vector2.get_mutable().push_back(100);
+    EXPECT_EQ(data, &(vector2.get()));
+
+    EXPECT_EQ(0u, vector1.get()[0]);
+    EXPECT_EQ(0u, (*vector3)[0]);
+    EXPECT_EQ(42u, vector2.get()[0]);
+    EXPECT_EQ(101ul, vector2.size());
+    EXPECT_EQ(100ul, vector3->size());
+    EXPECT_NE(vector1, vector2);
+
+    vector3 = vector2;
+    EXPECT_TRUE(vector3.shares_with(vector2));
+    EXPECT_FALSE(vector1.is_shared());
+
+    vector1 = Vector<u32>({ 7, 7, 7 });
+    EXPECT_EQ(3ul, vector1.size());
+    EXPECT_EQ(7u, vector1.get()[2]);
+}
+
+TEST(CopyOnWriteTest, UnorderedMap)
+{
+    CopyOnWriteUnorderedMap<u32, u32> map1;
+    for (u32 i = 0; i < 100; ++i) {
+        map1.get_mutable()[i] = i;
+    }
+
+    auto map2 = map1;
+    map2.get_mutable().erase(0u);
+    map2.get_mutable()[1] = 42;
+
+    EXPECT_EQ(100ul, map1.size());
+    EXPECT_EQ(99ul, map2.size());
+    EXPECT_EQ(1u, map1->at(1));
+    EXPECT_EQ(42u, map2->at(1));
+    EXPECT_TRUE(map1->find(0) != map1->end());
+    EXPECT_TRUE(map2->find(0) == map2->end());
+}
+
+TEST(CopyOnWriteTest, Threads)
+{
+    CopyOnWriteVector<u64> vector;
+    for (u64 i = 0; i < NUM_TEST_ELEMENTS; ++i) {
+        vector.get_mutable().push_back(i);
+    }
+
+    // readers which copy the handle around, and writers which clone
+    // their copy, all concurrently with the owner going away
+    std::vector<u64> sums(NUM_THREADS * 2);
+    std::vector<std::thread> threads;
+    for (u32 i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([vector, &sums, i]() {
+                for (u32 j = 0; j < 64; ++j) {
+                    auto copy = vector;
+                    u64 sum = 0;
+                    for (auto value : copy.get()) {
+                        sum += value;
+                    }
+                    sums[i] = sum;
+                }
+            });
+        threads.emplace_back([vector, &sums, i]() mutable {
+                for (u32 j = 0; j < 64; ++j) {
+                    auto copy = vector;
+                    copy.get_mutable()[0] = j + 1;
+                    sums[NUM_THREADS + i] += copy.get()[0];
+                }
+                vector.get_mutable()[1] = 0;
+            });
+    }
+    vector = CopyOnWriteVector<u64>();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (u32 i = 0; i < NUM_THREADS; ++i) {
+        EXPECT_EQ(NUM_TEST_ELEMENTS * (NUM_TEST_ELEMENTS - 1) / 2, sums[i]);
+        EXPECT_EQ(64ul * 65ul / 2, sums[NUM_THREADS + i]);
+    }
+    EXPECT_TRUE(vector.empty());
+}
+
+TEST(CopyOnWriteTest, PerfTest)
+{
+    // read-only copies of a copy-on-write vector against deep copies
+    Vector<u64> vector;
+    for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+        vector.push_back(i);
+    }
+    CopyOnWriteVector<u64> cow_vector(vector);
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_NUM_COPIES; ++i) {
+        auto copy = cow_vector;
+        total += copy.get()[i];
+    }
+    for (u64 i = 0; i < PERF_TEST_NUM_COPIES; ++i) {
+        auto copy = vector;
+        total -= copy[i];
+    }
+
+    EXPECT_EQ(0ul, total);
+    EXPECT_FALSE(cow_vector.is_shared());
+}
+
+//
+// CopyOnWriteTests.cpp ends here
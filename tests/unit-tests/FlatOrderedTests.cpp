@@ -0,0 +1,349 @@
+// FlatOrderedTests.cpp ---
+//
+// Filename: FlatOrderedTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:13:27 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/FlatOrdered.hpp"
+#include "../../src/containers/BTree.hpp"
+#include "../../src/containers/OrderedMap.hpp"
+
+#include <utility>
+#include <random>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#define PERF_TEST_MAP_SIZE ((u64)(1 << 16))
+#define PERF_TEST_NUM_LOOKUPS ((u64)(1 << 20))
+
+using aurum::u32;
+using aurum::u64;
+using aurum::i64;
+
+using aurum::containers::FlatOrderedMap;
+using aurum::containers::FlatOrderedSet;
+using aurum::containers::EytzingerOrderedMap;
+using aurum::containers::EytzingerOrderedSet;
+using aurum::containers::BTreeMap;
+using aurum::containers::OrderedMap;
+
+using testing::Types;
+
+template <typename MapType>
+static inline bool test_equal(const MapType& aurum_map, const std::map<u64, u64>& std_map)
+{
+    if (aurum_map.size() != std_map.size()) {
+        return false;
+    }
+
+    auto it1 = aurum_map.begin();
+    for (auto const& kv : std_map) {
+        if (it1->first != kv.first || it1->second != kv.second) {
+            return false;
+        }
+        ++it1;
+    }
+    return (it1 == aurum_map.end());
+}
+
+template <typename MapType>
+class FlatOrderedMapTest : public ::testing::Test
+{
+protected:
+    FlatOrderedMapTest() {}
+    virtual ~FlatOrderedMapTest() {}
+};
+
+template <typename MapType>
+class FlatOrderedMapPerfTest : public ::testing::Test
+{
+protected:
+    std::vector<std::pair<u64, u64> > m_random_data;
+    std::vector<u64> m_random_keys;
+
+    FlatOrderedMapPerfTest()
+    {
+        std::default_random_engine generator;
+        std::uniform_int_distribution<u64> distribution(0, PERF_TEST_MAP_SIZE * 4);
+
+        for (u64 i = 0; i < PERF_TEST_MAP_SIZE; ++i) {
+            m_random_data.push_back(std::make_pair(distribution(generator), i));
+        }
+        for (u64 i = 0; i < PERF_TEST_NUM_LOOKUPS; ++i) {
+            m_random_keys.push_back(distribution(generator));
+        }
+    }
+
+    virtual ~FlatOrderedMapPerfTest()
+    {
+        // Nothing here
+    }
+};
+
+TYPED_TEST_CASE_P(FlatOrderedMapTest);
+TYPED_TEST_CASE_P(FlatOrderedMapPerfTest);
+
+TYPED_TEST_P(FlatOrderedMapTest, Constructor)
+{
+    typedef TypeParam MapType;
+
+    MapType map1({ {5, 47}, {3, 45}, {1, 43}, {4, 46}, {2, 44}, {3, 100} });
+    EXPECT_EQ(5ull, map1.size());
+
+    u64 i = 1;
+    for (auto const& kv : map1) {
+        EXPECT_EQ(i, kv.first);
+        EXPECT_EQ(i + 42, kv.second);
+        ++i;
+    }
+
+    MapType map2 = map1;
+    EXPECT_EQ(map1, map2);
+
+    MapType map3 = std::move(map2);
+    EXPECT_EQ(0ull, map2.size());
+    EXPECT_EQ(map1, map3);
+
+    map2 = { {1, 1}, {2, 2} };
+    EXPECT_EQ(2ull, map2.size());
+    map2 = map1;
+    EXPECT_EQ(map1, map2);
+    EXPECT_EQ(3ull, map2.nth(2).first);
+}
+
+TYPED_TEST_P(FlatOrderedMapTest, Functional)
+{
+    typedef TypeParam MapType;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1 << 14);
+
+    std::vector<std::pair<u64, u64> > input;
+    for (u64 i = 0; i < (1 << 13); ++i) {
+        input.push_back(std::make_pair(distribution(generator), i));
+    }
+
+    MapType aurum_map(input.begin(), input.end());
+    std::map<u64, u64> std_map;
+    for (auto const& kv : input) {
+        std_map.insert(kv);
+    }
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+    for (u64 key = 0; key <= (1 << 14) + 1; ++key) {
+        auto it1 = aurum_map.find(key);
+        auto it2 = std_map.find(key);
+        if (it2 == std_map.end()) {
+            EXPECT_TRUE(it1 == aurum_map.end());
+            EXPECT_EQ(0ull, aurum_map.count(key));
+        } else {
+            ASSERT_TRUE(it1 != aurum_map.end());
+            EXPECT_EQ(it2->second, it1->second);
+        }
+
+        auto lb1 = aurum_map.lower_bound(key);
+        auto lb2 = std_map.lower_bound(key);
+        auto ub1 = aurum_map.upper_bound(key);
+        auto ub2 = std_map.upper_bound(key);
+        EXPECT_EQ((i64)std::distance(std_map.begin(), lb2), lb1 - aurum_map.begin());
+        EXPECT_EQ((i64)std::distance(std_map.begin(), ub2), ub1 - aurum_map.begin());
+
+        auto range = aurum_map.equal_range(key);
+        EXPECT_EQ(lb1, range.first);
+        EXPECT_EQ(ub1, range.second);
+    }
+
+    // batched insert of another run, existing values win
+    std::vector<std::pair<u64, u64> > more_input;
+    for (u64 i = 0; i < (1 << 12); ++i) {
+        more_input.push_back(std::make_pair(distribution(generator), i + 1000000));
+    }
+    aurum_map.insert(more_input.begin(), more_input.end());
+    for (auto const& kv : more_input) {
+        std_map.insert(kv);
+    }
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+    // single inserts and erasures, interleaved with lookups so that
+    // any cached search layout has to be rebuilt
+    for (u64 i = 0; i < (1 << 8); ++i) {
+        auto key = distribution(generator);
+        aurum_map[key] = i;
+        std_map[key] = i;
+        EXPECT_EQ(i, aurum_map.at(key));
+
+        key = distribution(generator);
+        EXPECT_EQ(std_map.erase(key), aurum_map.erase(key));
+        EXPECT_TRUE(aurum_map.find(key) == aurum_map.end());
+    }
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+    auto num_erased = aurum_map.erase_if([] (const std::pair<u64, u64>& kv) -> bool
+                                         {
+                                             return (kv.first % 2 == 0);
+                                         });
+    u64 std_num_erased = 0;
+    for (auto it = std_map.begin(); it != std_map.end(); ) {
+        if (it->first % 2 == 0) {
+            it = std_map.erase(it);
+            ++std_num_erased;
+        } else {
+            ++it;
+        }
+    }
+    EXPECT_EQ(std_num_erased, num_erased);
+    EXPECT_TRUE(test_equal(aurum_map, std_map));
+
+    EXPECT_THROW(aurum_map.at(0), std::out_of_range);
+}
+
+TYPED_TEST_P(FlatOrderedMapTest, Stringification)
+{
+    typedef TypeParam MapType;
+
+    MapType the_map;
+    the_map[2000] = 2042;
+    the_map[0] = 42;
+    the_map[1] = 43;
+
+    EXPECT_EQ("FlatOrderedMap<unsigned long, unsigned long> with 3 elements:\n"
+              "<<{0 |--> 42}, {1 |--> 43}, {2000 |--> 2042}>>",
+              the_map.to_string());
+}
+
+TYPED_TEST_P(FlatOrderedMapPerfTest, PerfTest)
+{
+    typedef TypeParam MapType;
+
+    MapType the_map(this->m_random_data.begin(), this->m_random_data.end());
+
+    u64 num_found = 0;
+    for (auto key : this->m_random_keys) {
+        if (the_map.find(key) != the_map.end()) {
+            ++num_found;
+        }
+    }
+    EXPECT_LT(0ull, num_found);
+}
+
+REGISTER_TYPED_TEST_CASE_P(FlatOrderedMapTest,
+                           Constructor,
+                           Functional,
+                           Stringification);
+
+REGISTER_TYPED_TEST_CASE_P(FlatOrderedMapPerfTest,
+                           PerfTest);
+
+typedef Types<FlatOrderedMap<u64, u64>,
+              EytzingerOrderedMap<u64, u64> > FlatOrderedMapImplementations;
+
+typedef Types<FlatOrderedMap<u64, u64>,
+              EytzingerOrderedMap<u64, u64>,
+              BTreeMap<u64, u64>,
+              OrderedMap<u64, u64>,
+              std::map<u64, u64> > FlatOrderedMapPerfImplementations;
+
+INSTANTIATE_TYPED_TEST_CASE_P(FlatOrderedMapTests, FlatOrderedMapTest,
+                              FlatOrderedMapImplementations);
+
+INSTANTIATE_TYPED_TEST_CASE_P(FlatOrderedMapPerfTests, FlatOrderedMapPerfTest,
+                              FlatOrderedMapPerfImplementations);
+
+TEST(FlatOrderedSetTest, Functional)
+{
+    FlatOrderedSet<u64> branchless_set = { 9, 3, 7, 1, 3, 5 };
+    EytzingerOrderedSet<u64> eytzinger_set(branchless_set.begin(), branchless_set.end());
+
+    EXPECT_EQ(5ull, branchless_set.size());
+    EXPECT_EQ(5ull, eytzinger_set.size());
+
+    for (u64 i = 0; i < 12; ++i) {
+        EXPECT_EQ(branchless_set.lower_bound(i) - branchless_set.begin(),
+                  eytzinger_set.lower_bound(i) - eytzinger_set.begin());
+        EXPECT_EQ(branchless_set.upper_bound(i) - branchless_set.begin(),
+                  eytzinger_set.upper_bound(i) - eytzinger_set.begin());
+        EXPECT_EQ(i % 2 == 1 && i < 10 ? 1ull : 0ull, eytzinger_set.count(i));
+    }
+
+    std::vector<u64> run = { 4, 2, 8, 6, 4 };
+    eytzinger_set.insert(run.begin(), run.end());
+    EXPECT_EQ(9ull, eytzinger_set.size());
+    u64 i = 1;
+    for (auto value : eytzinger_set) {
+        EXPECT_EQ(i++, value);
+    }
+    EXPECT_EQ(1ull, eytzinger_set.count(6));
+
+    EXPECT_EQ("FlatOrderedSet<unsigned long> with 5 elements:\n<<1, 3, 5, 7, 9>>",
+              branchless_set.to_string());
+}
+
+TEST(FlatOrderedSetTest, ConcurrentLookups)
+{
+    std::vector<u64> values;
+    for (u64 i = 0; i < 4096; ++i) {
+        values.push_back(2 * i);
+    }
+    EytzingerOrderedSet<u64> eytzinger_set(values.begin(), values.end());
+    eytzinger_set.erase(eytzinger_set.begin());
+    eytzinger_set.insert(1);
+    const EytzingerOrderedSet<u64>& lookup_set = eytzinger_set;
+
+    std::vector<u64> num_found(4, 0);
+    std::vector<std::thread> threads;
+    for (u64 t = 0; t < num_found.size(); ++t) {
+        threads.emplace_back([&lookup_set, &num_found, t]() {
+                for (u64 i = 0; i < 2 * 4096; ++i) {
+                    num_found[t] += lookup_set.count(i);
+                }
+            });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto found : num_found) {
+        EXPECT_EQ(4096ull, found);
+    }
+}
+
+//
+// FlatOrderedTests.cpp ends here
@@ -0,0 +1,210 @@
+// HashableTests.cpp ---
+//
+// Filename: HashableTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:03:52 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/basetypes/Hashable.hpp"
+#include "../../src/basetypes/RefCountable.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/hashing/Hashers.hpp"
+
+#include <chrono>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#define TEST_DAG_DEPTH 64
+#define PERF_TEST_DAG_DEPTH 24
+
+using aurum::i64;
+using aurum::u64;
+
+using aurum::Hashable;
+using aurum::RefCountable;
+using aurum::memory::ManagedConstPointer;
+using aurum::hashing::aurum_hash;
+using aurum::hashing::DeepHasher;
+
+// a binary node, whose children may be shared
+class DagNode : public RefCountable<DagNode>, public Hashable<DagNode>
+{
+private:
+    typedef ManagedConstPointer<DagNode> NodeRef;
+
+    i64 m_value;
+    NodeRef m_left;
+    NodeRef m_right;
+
+    static inline u64 combine(u64 h1, u64 h2)
+    {
+        return ((h1 * 0x100000001b3UL) ^ h2);
+    }
+
+public:
+    static u64 num_hash_computations;
+
+    DagNode(i64 value, const NodeRef& left, const NodeRef& right)
+        : m_value(value), m_left(left), m_right(right)
+    {
+        // Nothing here
+    }
+
+    void set_value(i64 value)
+    {
+        m_value = value;
+        invalidate_hash_value();
+    }
+
+    u64 compute_hash_value() const
+    {
+        ++num_hash_computations;
+        DeepHasher<NodeRef, 1> child_hasher;
+        u64 retval = aurum_hash(m_value);
+        retval = combine(retval, (m_left == nullptr ? 0 : child_hasher(m_left)));
+        retval = combine(retval, (m_right == nullptr ? 0 : child_hasher(m_right)));
+        return retval;
+    }
+
+    // the same hash, recomputed over the whole structure
+    u64 compute_uncached_hash_value() const
+    {
+        u64 retval = aurum_hash(m_value);
+        retval = combine(retval, (m_left == nullptr ? 0 : m_left->compute_uncached_hash_value()));
+        retval = combine(retval, (m_right == nullptr ? 0 : m_right->compute_uncached_hash_value()));
+        return retval;
+    }
+};
+
+u64 DagNode::num_hash_computations = 0;
+
+typedef ManagedConstPointer<DagNode> NodeRef;
+
+// a DAG whose nodes at depth i both point to the node at depth i + 1,
+// so that it has 2^depth paths from the root to the leaf
+static inline NodeRef make_shared_dag(u64 depth)
+{
+    NodeRef retval = new DagNode(0, nullptr, nullptr);
+    for (u64 i = 1; i < depth; ++i) {
+        retval = new DagNode((i64)i, retval, retval);
+    }
+    return retval;
+}
+
+TEST(HashableTest, Memoization)
+{
+    auto root = make_shared_dag(TEST_DAG_DEPTH);
+    EXPECT_FALSE(root->is_hash_value_cached());
+
+    DagNode::num_hash_computations = 0;
+    auto hash_value = root->hash();
+    EXPECT_TRUE(root->is_hash_value_cached());
+    EXPECT_EQ((u64)TEST_DAG_DEPTH, DagNode::num_hash_computations);
+
+    EXPECT_EQ(hash_value, root->hash());
+    EXPECT_EQ(hash_value, aurum_hash(*root));
+    EXPECT_EQ((u64)TEST_DAG_DEPTH, DagNode::num_hash_computations);
+
+    auto small_root = make_shared_dag(8);
+    EXPECT_EQ(DagNode::get_hash_value_for(small_root->compute_uncached_hash_value()),
+              small_root->hash());
+
+    // structurally equal DAGs hash equal
+    auto other_root = make_shared_dag(TEST_DAG_DEPTH);
+    EXPECT_EQ(hash_value, other_root->hash());
+}
+
+TEST(HashableTest, Invalidation)
+{
+    DagNode node(42, nullptr, nullptr);
+    auto hash_value = node.hash();
+    DagNode::num_hash_computations = 0;
+
+    node.set_value(43);
+    EXPECT_FALSE(node.is_hash_value_cached());
+    EXPECT_NE(hash_value, node.hash());
+    EXPECT_EQ(1ul, DagNode::num_hash_computations);
+
+    node.set_value(42);
+    EXPECT_EQ(hash_value, node.hash());
+    EXPECT_EQ(2ul, DagNode::num_hash_computations);
+
+    // copies carry the cached hash value with them
+    DagNode copy(node);
+    EXPECT_TRUE(copy.is_hash_value_cached());
+    EXPECT_EQ(hash_value, copy.hash());
+    EXPECT_EQ(2ul, DagNode::num_hash_computations);
+}
+
+TEST(HashableTest, DeepHashers)
+{
+    auto node1 = make_shared_dag(4);
+    auto node2 = make_shared_dag(5);
+
+    DeepHasher<std::pair<NodeRef, NodeRef>, 1> pair_hasher;
+    DeepHasher<std::tuple<NodeRef, NodeRef, NodeRef>, 1> tuple_hasher;
+
+    // the hashes depend on all the elements, not just the first
+    EXPECT_NE(pair_hasher(std::make_pair(node1, node1)), pair_hasher(std::make_pair(node1, node2)));
+    EXPECT_NE(tuple_hasher(std::make_tuple(node1, node1, node1)),
+              tuple_hasher(std::make_tuple(node1, node1, node2)));
+    EXPECT_EQ(tuple_hasher(std::make_tuple(node1, node2, node1)),
+              tuple_hasher(std::make_tuple(make_shared_dag(4), make_shared_dag(5), node1)));
+
+    // shallow hashes are on the pointers
+    DeepHasher<NodeRef, 0> pointer_hasher;
+    EXPECT_NE(pointer_hasher(node1), pointer_hasher(make_shared_dag(4)));
+}
+
+TEST(HashableTest, PerfTest)
+{
+    auto root = make_shared_dag(PERF_TEST_DAG_DEPTH);
+
+    auto start = std::chrono::steady_clock::now();
+    auto uncached_hash_value = root->compute_uncached_hash_value();
+    auto uncached_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    auto hash_value = root->hash();
+    auto cached_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+    EXPECT_EQ(DagNode::get_hash_value_for(uncached_hash_value), hash_value);
+    printf("hashing a DAG of depth %u: %.6fs uncached, %.6fs cached\n",
+           (unsigned)PERF_TEST_DAG_DEPTH, uncached_time.count(), cached_time.count());
+}
+
+//
+// HashableTests.cpp ends here
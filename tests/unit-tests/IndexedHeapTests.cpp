@@ -0,0 +1,331 @@
+// IndexedHeapTests.cpp ---
+//
+// Filename: IndexedHeapTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:18:24 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/IndexedHeap.hpp"
+#include "../../src/containers/PriorityQueue.hpp"
+
+#include <utility>
+#include <random>
+#include <algorithm>
+#include <set>
+#include <map>
+#include <vector>
+#include <queue>
+
+#include <gtest/gtest.h>
+
+#define MAX_TEST_SIZE (1 << 10)
+#define NUM_TEST_ITERATIONS (1 << 12)
+
+using aurum::u32;
+using aurum::u64;
+using aurum::i64;
+
+using aurum::containers::IndexedMultiWayHeap;
+using aurum::containers::IndexedBinaryHeap;
+using aurum::containers::IndexedQuaternaryHeap;
+using aurum::containers::IndexedPriorityQueue;
+
+using testing::Types;
+
+template <typename HeapType>
+class IndexedHeapTest : public testing::Test
+{
+protected:
+    IndexedHeapTest() {}
+    virtual ~IndexedHeapTest() {}
+};
+
+TYPED_TEST_CASE_P(IndexedHeapTest);
+
+TYPED_TEST_P(IndexedHeapTest, Handles)
+{
+    typedef TypeParam HeapT;
+    HeapT heap;
+
+    EXPECT_EQ(0ul, heap.get_size());
+    EXPECT_FALSE(heap.contains(0));
+
+    auto h0 = heap.insert(42);
+    auto h1 = heap.insert(17);
+    auto h2 = heap.insert(99);
+
+    EXPECT_EQ(0ul, h0);
+    EXPECT_EQ(1ul, h1);
+    EXPECT_EQ(2ul, h2);
+    EXPECT_EQ(3ul, heap.get_size());
+    EXPECT_EQ(17ul, heap.get_min());
+    EXPECT_EQ(h1, heap.get_min_handle());
+    EXPECT_EQ(42ul, heap.get_value(h0));
+    EXPECT_EQ(99ul, heap.get_value(h2));
+
+    heap.delete_min();
+    EXPECT_FALSE(heap.contains(h1));
+    EXPECT_TRUE(heap.contains(h0));
+    EXPECT_EQ(42ul, heap.get_min());
+
+    // the handle of the removed element is recycled
+    auto h3 = heap.insert(5);
+    EXPECT_EQ(h1, h3);
+    EXPECT_EQ(5ul, heap.get_min());
+    EXPECT_EQ(h3, heap.get_min_handle());
+
+    heap.clear();
+    EXPECT_EQ(0ul, heap.get_size());
+    EXPECT_FALSE(heap.contains(h0));
+    EXPECT_EQ(0ul, heap.insert(1));
+}
+
+TYPED_TEST_P(IndexedHeapTest, ChangeKey)
+{
+    typedef TypeParam HeapT;
+    HeapT heap;
+
+    std::vector<u64> handles;
+    for (u64 i = 0; i < 100; ++i) {
+        handles.push_back(heap.insert(1000 + i));
+    }
+
+    heap.decrease_key(handles[57], 3);
+    EXPECT_EQ(3ul, heap.get_min());
+    EXPECT_EQ(handles[57], heap.get_min_handle());
+
+    heap.increase_key(handles[57], 5000);
+    EXPECT_EQ(1000ul, heap.get_min());
+    EXPECT_EQ(handles[0], heap.get_min_handle());
+    EXPECT_EQ(5000ul, heap.get_value(handles[57]));
+
+    heap.update_key(handles[99], 1);
+    EXPECT_EQ(1ul, heap.get_min());
+    heap.update_key(handles[99], 6000);
+    EXPECT_EQ(1000ul, heap.get_min());
+
+    heap.erase(handles[0]);
+    EXPECT_FALSE(heap.contains(handles[0]));
+    EXPECT_EQ(1001ul, heap.get_min());
+    EXPECT_EQ(99ul, heap.get_size());
+
+    // everything comes out in order, with the changed keys last
+    u64 prev = 0;
+    while (heap.get_size() > 2) {
+        EXPECT_LE(prev, heap.get_min());
+        EXPECT_EQ(heap.get_min(), heap.get_value(heap.get_min_handle()));
+        prev = heap.get_min();
+        heap.delete_min();
+    }
+    EXPECT_EQ(5000ul, heap.get_min());
+    heap.delete_min();
+    EXPECT_EQ(6000ul, heap.get_min());
+}
+
+TYPED_TEST_P(IndexedHeapTest, Heapify)
+{
+    typedef TypeParam HeapT;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1 << 12);
+
+    for (u32 test_size = 0; test_size < MAX_TEST_SIZE; test_size = (test_size * 2) + 1) {
+        std::vector<u64> values;
+        for (u32 i = 0; i < test_size; ++i) {
+            values.push_back(distribution(generator));
+        }
+
+        HeapT heap;
+        heap.heapify(values.begin(), values.end());
+        EXPECT_EQ(values.size(), heap.get_size());
+
+        // handles are handed out in input order
+        for (u64 i = 0; i < values.size(); ++i) {
+            EXPECT_EQ(values[i], heap.get_value(i));
+        }
+
+        std::vector<u64> sorted_values(values);
+        std::sort(sorted_values.begin(), sorted_values.end());
+        for (auto value : sorted_values) {
+            EXPECT_EQ(value, heap.get_min());
+            EXPECT_EQ(value, values[heap.get_min_handle()]);
+            heap.delete_min();
+        }
+        EXPECT_EQ(0ul, heap.get_size());
+    }
+}
+
+TYPED_TEST_P(IndexedHeapTest, Functional)
+{
+    typedef TypeParam HeapT;
+    HeapT heap;
+
+    // a model of the heap: (value, handle) pairs in order,
+    // and the value currently associated with each handle
+    std::set<std::pair<u64, u64> > model;
+    std::map<u64, u64> handle_values;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1 << 16);
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        auto const op = distribution(generator) % 6;
+        auto const value = distribution(generator);
+
+        if (model.size() == 0 || (op <= 1 && model.size() < MAX_TEST_SIZE)) {
+            auto handle = heap.insert(value);
+            EXPECT_FALSE(handle_values.find(handle) != handle_values.end());
+            model.insert(std::make_pair(value, handle));
+            handle_values[handle] = value;
+        } else {
+            // pick some live handle
+            auto it = handle_values.lower_bound(distribution(generator) %
+                                                (handle_values.rbegin()->first + 1));
+            auto const handle = it->first;
+            auto const old_value = it->second;
+            model.erase(std::make_pair(old_value, handle));
+
+            if (op == 2) {
+                heap.update_key(handle, value);
+                model.insert(std::make_pair(value, handle));
+                it->second = value;
+            } else if (op == 3) {
+                auto new_value = old_value / 2;
+                heap.decrease_key(handle, new_value);
+                model.insert(std::make_pair(new_value, handle));
+                it->second = new_value;
+            } else if (op == 4) {
+                heap.erase(handle);
+                handle_values.erase(it);
+            } else {
+                model.insert(std::make_pair(old_value, handle));
+                auto const& min = *model.begin();
+                EXPECT_EQ(min.first, heap.get_min());
+                EXPECT_EQ(min.first, heap.get_value(heap.get_min_handle()));
+                handle_values.erase(heap.get_min_handle());
+                model.erase(std::make_pair(heap.get_min(), heap.get_min_handle()));
+                heap.delete_min();
+            }
+        }
+
+        ASSERT_EQ(model.size(), heap.get_size());
+        if (model.size() > 0) {
+            ASSERT_EQ(model.begin()->first, heap.get_min());
+        }
+    }
+
+    for (auto const& kv : handle_values) {
+        EXPECT_TRUE(heap.contains(kv.first));
+        EXPECT_EQ(kv.second, heap.get_value(kv.first));
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(IndexedHeapTest,
+                           Handles,
+                           ChangeKey,
+                           Heapify,
+                           Functional);
+
+typedef Types<IndexedBinaryHeap<u64>,
+              IndexedMultiWayHeap<u64, std::less<u64>, 3>,
+              IndexedQuaternaryHeap<u64>,
+              IndexedMultiWayHeap<u64, std::less<u64>, 8> > IndexedHeapImplementations;
+
+INSTANTIATE_TYPED_TEST_CASE_P(IndexedHeapTemplateTests,
+                              IndexedHeapTest, IndexedHeapImplementations);
+
+// Dijkstra's algorithm with node ids as handles, checked
+// against a lazy-deletion std::priority_queue implementation
+TEST(IndexedPriorityQueueTest, Dijkstra)
+{
+    const u64 num_nodes = 1 << 10;
+    const u64 num_edges = num_nodes * 8;
+    const u64 infinity = UINT64_MAX;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, num_nodes - 1);
+    std::uniform_int_distribution<u64> weight_distribution(1, 1000);
+
+    std::vector<std::vector<std::pair<u64, u64> > > graph(num_nodes);
+    for (u64 i = 0; i < num_edges; ++i) {
+        graph[distribution(generator)].push_back(std::make_pair(distribution(generator),
+                                                                weight_distribution(generator)));
+    }
+
+    std::vector<u64> expected(num_nodes, infinity);
+    {
+        typedef std::pair<u64, u64> DistNode;
+        std::priority_queue<DistNode, std::vector<DistNode>, std::greater<DistNode> > queue;
+        expected[0] = 0;
+        queue.push(std::make_pair(0, 0));
+        while (!queue.empty()) {
+            auto top = queue.top();
+            queue.pop();
+            if (top.first != expected[top.second]) {
+                continue;
+            }
+            for (auto const& edge : graph[top.second]) {
+                if (top.first + edge.second < expected[edge.first]) {
+                    expected[edge.first] = top.first + edge.second;
+                    queue.push(std::make_pair(expected[edge.first], edge.first));
+                }
+            }
+        }
+    }
+
+    std::vector<u64> initial(num_nodes, infinity);
+    initial[0] = 0;
+    IndexedPriorityQueue<u64> queue(initial.begin(), initial.end());
+    std::vector<u64> actual(num_nodes, infinity);
+
+    while (!queue.empty() && queue.top() != infinity) {
+        auto const node = queue.top_handle();
+        auto const dist = queue.top();
+        actual[node] = dist;
+        queue.pop();
+
+        for (auto const& edge : graph[node]) {
+            if (queue.contains(edge.first) &&
+                dist + edge.second < queue.get_value(edge.first)) {
+                queue.decrease_key(edge.first, dist + edge.second);
+            }
+        }
+    }
+
+    EXPECT_EQ(expected, actual);
+}
+
+//
+// IndexedHeapTests.cpp ends here
@@ -0,0 +1,254 @@
+// MultiQueueTests.cpp ---
+//
+// Filename: MultiQueueTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:52:29 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/MultiQueue.hpp"
+
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#define TEST_NUM_THREADS 4
+#define TEST_NUM_ELEMENTS ((u64)(1 << 16))
+#define RANK_TEST_NUM_ELEMENTS ((u64)(1 << 16))
+#define PERF_TEST_NUM_OPS ((u64)(1 << 20))
+#define PERF_TEST_PREFILL ((u64)(1 << 16))
+
+using aurum::i64;
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::MultiQueue;
+
+// counts the elements of a set of keys in [0, size) which are less
+// than a key, to measure the rank of the popped elements
+class FenwickTree
+{
+private:
+    std::vector<u64> m_counts;
+
+public:
+    FenwickTree(u64 size)
+        : m_counts(size + 1, 0)
+    {
+        // Nothing here
+    }
+
+    void add(u64 key, i64 delta)
+    {
+        for (u64 i = key + 1; i < m_counts.size(); i += (i & -i)) {
+            m_counts[i] += delta;
+        }
+    }
+
+    u64 count_less(u64 key) const
+    {
+        u64 retval = 0;
+        for (u64 i = key; i > 0; i -= (i & -i)) {
+            retval += m_counts[i];
+        }
+        return retval;
+    }
+};
+
+static inline std::vector<u64> make_permutation(u64 size)
+{
+    std::vector<u64> retval(size);
+    for (u64 i = 0; i < size; ++i) {
+        retval[i] = i;
+    }
+    std::shuffle(retval.begin(), retval.end(), std::default_random_engine());
+    return retval;
+}
+
+// the mean rank of the popped elements among the elements in the
+// queue, when draining a queue with the given number of heaps
+static inline double get_mean_rank_error(u32 num_threads, u32 queues_per_thread)
+{
+    MultiQueue<u64> queue(num_threads, queues_per_thread);
+    FenwickTree present(RANK_TEST_NUM_ELEMENTS);
+    for (auto key : make_permutation(RANK_TEST_NUM_ELEMENTS)) {
+        queue.push(key);
+        present.add(key, 1);
+    }
+
+    u64 total_rank = 0;
+    u64 key;
+    while (queue.try_pop(key)) {
+        total_rank += present.count_less(key);
+        present.add(key, -1);
+    }
+    return ((double)total_rank / RANK_TEST_NUM_ELEMENTS);
+}
+
+TEST(MultiQueueTest, Basic)
+{
+    MultiQueue<u64> queue(1);
+    u64 value = 42;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(42ul, value);
+    EXPECT_EQ(2u, queue.get_num_queues());
+
+    auto keys = make_permutation(TEST_NUM_ELEMENTS);
+    for (auto key : keys) {
+        queue.push(key);
+    }
+    EXPECT_EQ(TEST_NUM_ELEMENTS, queue.size());
+
+    std::vector<u64> popped;
+    while (queue.try_pop(value)) {
+        popped.push_back(value);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(TEST_NUM_ELEMENTS, popped.size());
+
+    // every element exactly once, and nearly in order
+    u64 num_inversions = 0;
+    for (u64 i = 1; i < popped.size(); ++i) {
+        num_inversions += (popped[i] < popped[i - 1] ? 1 : 0);
+    }
+    EXPECT_LT(num_inversions, TEST_NUM_ELEMENTS / 2);
+    std::sort(popped.begin(), popped.end());
+    for (u64 i = 0; i < popped.size(); ++i) {
+        EXPECT_EQ(i, popped[i]);
+    }
+}
+
+TEST(MultiQueueTest, RankError)
+{
+    // the rank error is proportional to the number of heaps, and is
+    // zero with two heaps, since both get sampled on every pop
+    double previous_error = -1.0;
+    for (u32 num_threads : { 1, 4, 16 }) {
+        auto error = get_mean_rank_error(num_threads, 2);
+        EXPECT_LT(error, num_threads * 2 * 2.0);
+        EXPECT_LT(previous_error, error);
+        previous_error = error;
+    }
+}
+
+TEST(MultiQueueTest, Concurrent)
+{
+    MultiQueue<u64> queue(TEST_NUM_THREADS);
+    std::vector<std::vector<u64> > popped(TEST_NUM_THREADS);
+    std::vector<std::thread> threads;
+
+    // half of the elements are pushed up front, the rest are pushed
+    // concurrently with the pops
+    const u64 elements_per_thread = TEST_NUM_ELEMENTS / TEST_NUM_THREADS;
+    for (u64 i = 0; i < TEST_NUM_ELEMENTS / 2; ++i) {
+        queue.push(i);
+    }
+    for (u32 i = 0; i < TEST_NUM_THREADS; ++i) {
+        threads.emplace_back([&queue, &popped, i, elements_per_thread]() {
+                const u64 first = (TEST_NUM_ELEMENTS / 2) + (i * elements_per_thread / 2);
+                for (u64 j = 0; j < elements_per_thread / 2; ++j) {
+                    queue.push(first + j);
+                    u64 value;
+                    if (queue.try_pop(value)) {
+                        popped[i].push_back(value);
+                    }
+                }
+                u64 value;
+                while (queue.try_pop(value)) {
+                    popped[i].push_back(value);
+                }
+            });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<u64> all_popped;
+    for (auto const& thread_popped : popped) {
+        all_popped.insert(all_popped.end(), thread_popped.begin(), thread_popped.end());
+    }
+    EXPECT_TRUE(queue.empty());
+    ASSERT_EQ(TEST_NUM_ELEMENTS, all_popped.size());
+    std::sort(all_popped.begin(), all_popped.end());
+    for (u64 i = 0; i < all_popped.size(); ++i) {
+        EXPECT_EQ(i, all_popped[i]);
+    }
+}
+
+TEST(MultiQueueTest, PerfTest)
+{
+    // throughput of alternating pushes and pops, with the number of
+    // threads doubling up to the number of hardware threads
+    const u32 max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (u32 num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        MultiQueue<u64> queue(num_threads);
+        std::default_random_engine generator;
+        std::uniform_int_distribution<u64> distribution(0, 1 << 30);
+        for (u64 i = 0; i < PERF_TEST_PREFILL; ++i) {
+            queue.push(distribution(generator));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (u32 i = 0; i < num_threads; ++i) {
+            threads.emplace_back([&queue, num_threads, i]() {
+                    std::default_random_engine generator(i);
+                    std::uniform_int_distribution<u64> distribution(0, 1 << 30);
+                    u64 value;
+                    for (u64 j = 0; j < PERF_TEST_NUM_OPS / num_threads; ++j) {
+                        queue.push(distribution(generator));
+                        queue.try_pop(value);
+                    }
+                });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        printf("MultiQueue with %u threads: %.2f Mops/s, mean rank error %.2f\n",
+               num_threads, (2.0 * PERF_TEST_NUM_OPS) / elapsed.count() / 1e6,
+               get_mean_rank_error(num_threads, 2));
+        EXPECT_EQ(PERF_TEST_PREFILL, queue.size());
+    }
+}
+
+//
+// MultiQueueTests.cpp ends here
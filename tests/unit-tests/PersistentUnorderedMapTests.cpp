@@ -0,0 +1,238 @@
+// PersistentUnorderedMapTests.cpp ---
+//
+// Filename: PersistentUnorderedMapTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:49:36 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/PersistentUnorderedMap.hpp"
+#include "../../src/containers/UnorderedMap.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 14)
+#define MAX_KEY (1 << 12)
+#define PERF_TEST_NUM_ELEMENTS ((u64)(1 << 16))
+#define PERF_TEST_NUM_SNAPSHOTS ((u64)(1 << 8))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::PersistentUnorderedMap;
+using aurum::containers::TransientUnorderedMap;
+using aurum::containers::UnifiedUnorderedMap;
+
+// hashes everything to a handful of values, to exercise collisions
+class BadHasher
+{
+public:
+    inline u64 operator () (u32 value) const
+    {
+        return (value % 4);
+    }
+};
+
+template <typename MapType>
+static inline bool test_equal(const MapType& map,
+                              const std::unordered_map<u32, u32>& model)
+{
+    if (map.size() != model.size()) {
+        return false;
+    }
+    for (auto const& entry : model) {
+        auto value = map.find(entry.first);
+        if (value == nullptr || *value != entry.second) {
+            return false;
+        }
+    }
+    u64 count = 0;
+    for (auto const& entry : map) {
+        auto it = model.find(entry.first);
+        if (it == model.end() || it->second != entry.second) {
+            return false;
+        }
+        ++count;
+    }
+    return (count == model.size());
+}
+
+TEST(PersistentUnorderedMapTest, Basic)
+{
+    PersistentUnorderedMap<std::string, u32> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_EQ(0ul, empty.count("a"));
+    EXPECT_THROW(empty.at("a"), std::out_of_range);
+
+    auto map1 = empty.insert("a", 1).insert("b", 2);
+    EXPECT_EQ(2ul, map1.size());
+    EXPECT_EQ(1u, map1.at("a"));
+    EXPECT_TRUE(empty.empty());
+
+    auto map2 = map1.insert("a", 42);
+    EXPECT_EQ(2ul, map2.size());
+    EXPECT_EQ(1u, map1.at("a"));
+    EXPECT_EQ(42u, map2.at("a"));
+    EXPECT_NE(map1, map2);
+
+    auto map3 = map2.erase("a");
+    EXPECT_EQ(1ul, map3.size());
+    EXPECT_EQ(0ul, map3.count("a"));
+    EXPECT_EQ(2ul, map2.size());
+    EXPECT_EQ(map3, map3.erase("c"));
+
+    PersistentUnorderedMap<std::string, u32> map4 = { { "b", 2 }, { "a", 1 } };
+    EXPECT_EQ(map1, map4);
+}
+
+template <typename MapType>
+static inline void run_against_model(u32 max_key)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u32> op_distribution(0, 9);
+    std::uniform_int_distribution<u32> key_distribution(0, max_key);
+
+    MapType map;
+    std::unordered_map<u32, u32> model;
+    std::vector<MapType> snapshots;
+    std::vector<std::unordered_map<u32, u32> > snapshot_models;
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        const u32 op = op_distribution(generator);
+        const u32 key = key_distribution(generator);
+        if (op < 6) {
+            map = map.insert(key, i);
+            model[key] = i;
+        } else if (op < 9) {
+            map = map.erase(key);
+            model.erase(key);
+        } else {
+            snapshots.push_back(map);
+            snapshot_models.push_back(model);
+        }
+    }
+
+    EXPECT_TRUE(test_equal(map, model));
+    for (u64 i = 0; i < snapshots.size(); ++i) {
+        EXPECT_TRUE(test_equal(snapshots[i], snapshot_models[i]));
+    }
+
+    // erasing everything must leave an empty trie behind
+    for (auto const& entry : model) {
+        map = map.erase(entry.first);
+    }
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.begin() == map.end());
+}
+
+TEST(PersistentUnorderedMapTest, AgainstModel)
+{
+    run_against_model<PersistentUnorderedMap<u32, u32> >(MAX_KEY);
+}
+
+TEST(PersistentUnorderedMapTest, Collisions)
+{
+    run_against_model<PersistentUnorderedMap<u32, u32, BadHasher> >(64);
+}
+
+TEST(PersistentUnorderedMapTest, Transient)
+{
+    PersistentUnorderedMap<u32, u32> base = { { 1, 1 }, { 2, 2 } };
+    auto transient = base.transient();
+    std::unordered_map<u32, u32> model = { { 1, 1 }, { 2, 2 } };
+
+    for (u32 i = 0; i < 10000; ++i) {
+        EXPECT_EQ(i != 1 && i != 2, transient.insert(i, i * 2));
+        model.insert(std::make_pair(i, i * 2));
+    }
+    EXPECT_FALSE(transient.insert_or_assign(1, 100));
+    model[1] = 100;
+    EXPECT_TRUE(test_equal(transient, model));
+    EXPECT_EQ(2ul, base.size());
+    EXPECT_EQ(1u, base.at(1));
+
+    auto snapshot = transient.persistent();
+    auto snapshot_model = model;
+    for (u32 i = 0; i < 10000; i += 2) {
+        EXPECT_TRUE(transient.erase(i));
+        model.erase(i);
+    }
+    EXPECT_FALSE(transient.erase(0));
+    EXPECT_TRUE(test_equal(transient, model));
+    EXPECT_TRUE(test_equal(snapshot, snapshot_model));
+
+    transient.clear();
+    EXPECT_TRUE(transient.empty());
+    EXPECT_EQ(10000ul, snapshot.size());
+}
+
+TEST(PersistentUnorderedMapTest, PerfTest)
+{
+    // a snapshot of a persistent map against a copy of a
+    // UnifiedUnorderedMap, with one update between consecutive snapshots
+    TransientUnorderedMap<u64, u64> transient;
+    UnifiedUnorderedMap<u64, u64> map;
+    for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+        transient.insert(i, i);
+        map[i] = i;
+    }
+
+    auto persistent_map = transient.persistent();
+    std::vector<PersistentUnorderedMap<u64, u64> > snapshots;
+    for (u64 i = 0; i < PERF_TEST_NUM_SNAPSHOTS; ++i) {
+        snapshots.push_back(persistent_map);
+        persistent_map = persistent_map.insert(i, 0);
+    }
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_NUM_SNAPSHOTS; ++i) {
+        UnifiedUnorderedMap<u64, u64> copy(map);
+        map[i] = 0;
+        total += copy[i];
+    }
+
+    EXPECT_EQ(PERF_TEST_NUM_SNAPSHOTS * (PERF_TEST_NUM_SNAPSHOTS - 1) / 2, total);
+    EXPECT_EQ(PERF_TEST_NUM_SNAPSHOTS - 1,
+              snapshots.back().at(PERF_TEST_NUM_SNAPSHOTS - 1));
+    EXPECT_EQ(0ul, persistent_map.at(PERF_TEST_NUM_SNAPSHOTS - 1));
+}
+
+//
+// PersistentUnorderedMapTests.cpp ends here
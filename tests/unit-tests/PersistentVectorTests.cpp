@@ -0,0 +1,264 @@
+// PersistentVectorTests.cpp ---
+//
+// Filename: PersistentVectorTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:49:36 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/PersistentVector.hpp"
+#include "../../src/containers/Vector.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 12)
+#define MAX_TEST_SIZE (1 << 14)
+#define PERF_TEST_NUM_ELEMENTS ((u64)(1 << 16))
+#define PERF_TEST_NUM_SNAPSHOTS ((u64)(1 << 10))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::PersistentVector;
+using aurum::containers::TransientVector;
+using aurum::containers::Vector;
+
+template <typename T>
+static inline bool test_equal(const PersistentVector<T>& vector,
+                              const std::vector<T>& model)
+{
+    if (vector.size() != model.size()) {
+        return false;
+    }
+    for (u64 i = 0; i < model.size(); ++i) {
+        if (!(vector[i] == model[i])) {
+            return false;
+        }
+    }
+    u64 i = 0;
+    for (auto const& value : vector) {
+        if (i >= model.size() || !(value == model[i])) {
+            return false;
+        }
+        ++i;
+    }
+    return (i == model.size());
+}
+
+TEST(PersistentVectorTest, Basic)
+{
+    PersistentVector<u32> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0ul, empty.size());
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_THROW(empty.at(0), std::out_of_range);
+
+    auto v1 = empty.push_back(1).push_back(2).push_back(3);
+    EXPECT_EQ(3ul, v1.size());
+    EXPECT_EQ(1u, v1.front());
+    EXPECT_EQ(3u, v1.back());
+    EXPECT_TRUE(empty.empty());
+
+    auto v2 = v1.set(1, 42);
+    EXPECT_EQ(2u, v1[1]);
+    EXPECT_EQ(42u, v2[1]);
+    EXPECT_NE(v1, v2);
+    EXPECT_EQ(v1, v2.set(1, 2));
+
+    auto v3 = v1.concat(v2);
+    EXPECT_EQ(PersistentVector<u32>({ 1, 2, 3, 1, 42, 3 }), v3);
+    EXPECT_EQ(v1, v3.pop_back().pop_back().pop_back());
+
+    PersistentVector<std::string> strings = { "a", "b" };
+    EXPECT_EQ("b", strings.push_back("c")[1]);
+}
+
+TEST(PersistentVectorTest, AgainstModel)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u32> op_distribution(0, 9);
+    std::uniform_int_distribution<u32> value_distribution;
+
+    PersistentVector<u32> vector;
+    std::vector<u32> model;
+    std::vector<PersistentVector<u32> > snapshots;
+    std::vector<std::vector<u32> > snapshot_models;
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        const u32 op = op_distribution(generator);
+        if (op < 5) {
+            const u32 value = value_distribution(generator);
+            vector = vector.push_back(value);
+            model.push_back(value);
+        } else if (op < 6 && model.size() > 0) {
+            vector = vector.pop_back();
+            model.pop_back();
+        } else if (op < 8 && model.size() > 0) {
+            const u64 index = value_distribution(generator) % model.size();
+            const u32 value = value_distribution(generator);
+            vector = vector.set(index, value);
+            model[index] = value;
+        } else if (op < 9 && snapshots.size() > 0) {
+            const u64 index = value_distribution(generator) % snapshots.size();
+            if (model.size() + snapshot_models[index].size() > MAX_TEST_SIZE) {
+                // concatenating snapshots of itself would grow the
+                // vector exponentially otherwise
+                continue;
+            }
+            vector = vector.concat(snapshots[index]);
+            model.insert(model.end(), snapshot_models[index].begin(),
+                         snapshot_models[index].end());
+        } else {
+            snapshots.push_back(vector);
+            snapshot_models.push_back(model);
+        }
+    }
+
+    EXPECT_TRUE(test_equal(vector, model));
+    // snapshots must be unaffected by the updates after them
+    for (u64 i = 0; i < snapshots.size(); ++i) {
+        EXPECT_TRUE(test_equal(snapshots[i], snapshot_models[i]));
+    }
+}
+
+TEST(PersistentVectorTest, Concat)
+{
+    // many concatenations of small vectors of differing sizes,
+    // so that the tree gets many relaxed nodes
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u32> size_distribution(0, 70);
+
+    PersistentVector<u64> vector;
+    std::vector<u64> model;
+    for (u32 i = 0; i < 512; ++i) {
+        PersistentVector<u64> piece;
+        const u32 size = size_distribution(generator);
+        for (u32 j = 0; j < size; ++j) {
+            piece = piece.push_back(model.size() + j);
+        }
+        for (u32 j = 0; j < size; ++j) {
+            model.push_back(model.size());
+        }
+        if (i % 2 == 0) {
+            vector = vector.concat(piece);
+        } else {
+            // concatenating an empty vector must not change anything
+            vector = vector.concat(piece).concat(PersistentVector<u64>());
+        }
+    }
+    EXPECT_TRUE(test_equal(vector, model));
+
+    auto doubled = vector.concat(vector);
+    model.insert(model.end(), model.begin(), model.end());
+    EXPECT_TRUE(test_equal(doubled, model));
+
+    while (model.size() > 0) {
+        doubled = doubled.pop_back();
+        model.pop_back();
+        if (model.size() % 1000 == 0) {
+            EXPECT_TRUE(test_equal(doubled, model));
+        }
+    }
+    EXPECT_TRUE(doubled.empty());
+}
+
+TEST(PersistentVectorTest, Transient)
+{
+    PersistentVector<u32> base = { 1, 2, 3 };
+    auto transient = base.transient();
+    for (u32 i = 0; i < 10000; ++i) {
+        transient.push_back(i);
+    }
+    transient.set(0, 100);
+    EXPECT_EQ(10003ul, transient.size());
+    EXPECT_EQ(3ul, base.size());
+    EXPECT_EQ(1u, base[0]);
+
+    auto snapshot1 = transient.persistent();
+    transient.set(1, 200);
+    transient.pop_back();
+    auto snapshot2 = transient.persistent();
+
+    EXPECT_EQ(10003ul, snapshot1.size());
+    EXPECT_EQ(100u, snapshot1[0]);
+    EXPECT_EQ(2u, snapshot1[1]);
+    EXPECT_EQ(9999u, snapshot1.back());
+    EXPECT_EQ(10002ul, snapshot2.size());
+    EXPECT_EQ(200u, snapshot2[1]);
+    EXPECT_EQ(9998u, snapshot2.back());
+
+    transient.append(base);
+    EXPECT_EQ(10005ul, transient.size());
+    EXPECT_EQ(3u, transient.persistent().back());
+    transient.clear();
+    EXPECT_EQ(0ul, transient.size());
+    EXPECT_EQ(10002ul, snapshot2.size());
+}
+
+TEST(PersistentVectorTest, PerfTest)
+{
+    // a snapshot of a persistent vector against a copy of a Vector,
+    // with one update between consecutive snapshots
+    auto transient = PersistentVector<u64>().transient();
+    Vector<u64> vector;
+    for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+        transient.push_back(i);
+        vector.push_back(i);
+    }
+
+    auto persistent_vector = transient.persistent();
+    std::vector<PersistentVector<u64> > snapshots;
+    for (u64 i = 0; i < PERF_TEST_NUM_SNAPSHOTS; ++i) {
+        snapshots.push_back(persistent_vector);
+        persistent_vector = persistent_vector.set(i, 0);
+    }
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_NUM_SNAPSHOTS; ++i) {
+        Vector<u64> copy(vector);
+        vector[i] = 0;
+        total += copy[i];
+    }
+
+    EXPECT_EQ(PERF_TEST_NUM_SNAPSHOTS * (PERF_TEST_NUM_SNAPSHOTS - 1) / 2, total);
+    EXPECT_EQ(PERF_TEST_NUM_SNAPSHOTS - 1, snapshots.back()[PERF_TEST_NUM_SNAPSHOTS - 1]);
+    EXPECT_EQ(0ul, persistent_vector[PERF_TEST_NUM_SNAPSHOTS - 1]);
+}
+
+//
+// PersistentVectorTests.cpp ends here
@@ -38,6 +38,8 @@
 #include "../../src/containers/PriorityQueue.hpp"
 #include "../../src/containers/Vector.hpp"
 #include "../../src/containers/MultiWayHeap.hpp"
+#include "../../src/containers/IndexedHeap.hpp"
+#include "../../src/containers/RadixHeap.hpp"
 
 #include <vector>
 #include <utility>
@@ -45,6 +47,8 @@
 #include <cstdlib>
 #include <algorithm>
 #include <queue>
+#include <chrono>
+#include <cstdio>
 
 #include "RCClass.hpp"
 
@@ -54,6 +58,7 @@
 #define NUM_TEST_ITERATIONS (1 << 5)
 #define NUM_INSERT_DELETE_ITERATIONS (1 << 5);
 
+using aurum::u08;
 using aurum::u32;
 using aurum::u64;
 using aurum::i32;
@@ -65,6 +70,13 @@ using aurum::containers::BinaryHeap;
 using aurum::containers::TernaryHeap;
 using aurum::containers::QuaternaryHeap;
 using aurum::containers::MultiWayHeap;
+using aurum::containers::AlignedMultiWayHeap;
+using aurum::containers::CacheAlignedHeap;
+using aurum::containers::IndexedBinaryHeap;
+using aurum::containers::IndexedQuaternaryHeap;
+using aurum::containers::RadixHeap;
+using aurum::containers::RadixPriorityQueue;
+using aurum::containers::u64RadixPriorityQueue;
 using aurum::containers::Vector;
 
 using testing::Types;
@@ -114,8 +126,37 @@ public:
     }
 };
 
+#define MONOTONE_PERF_TEST_QUEUE_SIZE ((u64)(1 << 16))
+#define MONOTONE_PERF_TEST_NUM_OPS ((u64)(1 << 24))
+
+// models an event queue: the earliest event is repeatedly
+// replaced with one that is a small random delay later
+template <typename PrioQueueType>
+class MonotonePrioQueuePerfTest : public testing::Test
+{
+protected:
+    Vector<u64> m_random_delays;
+
+    MonotonePrioQueuePerfTest()
+        : m_random_delays((size_t)MONOTONE_PERF_TEST_QUEUE_SIZE, 0)
+    {
+        std::default_random_engine generator;
+        std::uniform_int_distribution<u64> distribution(0, 1 << 12);
+
+        for (u64 i = 0; i < MONOTONE_PERF_TEST_QUEUE_SIZE; ++i) {
+            m_random_delays[i] = distribution(generator);
+        }
+    }
+
+    virtual ~MonotonePrioQueuePerfTest()
+    {
+        // Nothing here
+    }
+};
+
 TYPED_TEST_CASE_P(PrioQueueTest);
 TYPED_TEST_CASE_P(PrioQueuePerfTest);
+TYPED_TEST_CASE_P(MonotonePrioQueuePerfTest);
 
 TYPED_TEST_P(PrioQueueTest, Constructor)
 {
@@ -201,6 +242,32 @@ TYPED_TEST_P(PrioQueueTest, Functional)
     }
 }
 
+TYPED_TEST_P(PrioQueueTest, RangeConstructor)
+{
+    typedef TypeParam PrioQueueT;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<i64> distribution(0, 1 << 10);
+
+    for (u32 test_size = 0; test_size < MAX_TEST_SIZE; test_size = (test_size * 3) + 1) {
+        std::vector<std::pair<i64, i64> > elems;
+        for (u32 i = 0; i < test_size; ++i) {
+            auto key = distribution(generator);
+            elems.push_back(std::make_pair(key, key));
+        }
+
+        PrioQueueT prio_queue(elems.begin(), elems.end());
+        EXPECT_EQ(elems.size(), prio_queue.size());
+
+        std::sort(elems.begin(), elems.end());
+        for (auto const& elem : elems) {
+            EXPECT_EQ(elem, prio_queue.top());
+            prio_queue.pop();
+        }
+        EXPECT_TRUE(prio_queue.empty());
+    }
+}
+
 TYPED_TEST_P(PrioQueuePerfTest, PerfTest)
 {
     typedef TypeParam PrioQueueT;
@@ -223,13 +290,41 @@ TYPED_TEST_P(PrioQueuePerfTest, PerfTest)
     }
 }
 
+TYPED_TEST_P(MonotonePrioQueuePerfTest, PerfTest)
+{
+    typedef TypeParam PrioQueueT;
+
+    PrioQueueT prio_queue;
+    auto const& delays = this->m_random_delays;
+    const u64 mask = MONOTONE_PERF_TEST_QUEUE_SIZE - 1;
+
+    for (u64 i = 0; i < MONOTONE_PERF_TEST_QUEUE_SIZE; ++i) {
+        prio_queue.push(delays[i]);
+    }
+
+    u64 now = 0;
+    for (u64 i = 0; i < MONOTONE_PERF_TEST_NUM_OPS; ++i) {
+        auto const next = prio_queue.top();
+        EXPECT_LE(now, next);
+        now = next;
+        prio_queue.pop();
+        prio_queue.push(now + delays[(i * 7) & mask]);
+    }
+
+    EXPECT_EQ(MONOTONE_PERF_TEST_QUEUE_SIZE, prio_queue.size());
+}
+
 REGISTER_TYPED_TEST_CASE_P(PrioQueueTest,
                            Constructor,
-                           Functional);
+                           Functional,
+                           RangeConstructor);
 
 REGISTER_TYPED_TEST_CASE_P(PrioQueuePerfTest,
                            PerfTest);
 
+REGISTER_TYPED_TEST_CASE_P(MonotonePrioQueuePerfTest,
+                           PerfTest);
+
 typedef Types<PriorityQueue<std::pair<i64, i64>,
                             i64i64PairCompare,
                             BinaryHeap<std::pair<i64, i64> > >,
@@ -238,7 +333,22 @@ typedef Types<PriorityQueue<std::pair<i64, i64>,
                             TernaryHeap<std::pair<i64, i64> > >,
               PriorityQueue<std::pair<i64, i64>,
                             i64i64PairCompare,
-                            QuaternaryHeap<std::pair<i64, i64> > > >
+                            QuaternaryHeap<std::pair<i64, i64> > >,
+              PriorityQueue<std::pair<i64, i64>,
+                            i64i64PairCompare,
+                            AlignedMultiWayHeap<std::pair<i64, i64>, std::less<std::pair<i64, i64> >, 2> >,
+              PriorityQueue<std::pair<i64, i64>,
+                            i64i64PairCompare,
+                            AlignedMultiWayHeap<std::pair<i64, i64>, std::less<std::pair<i64, i64> >, 8> >,
+              PriorityQueue<std::pair<i64, i64>,
+                            i64i64PairCompare,
+                            CacheAlignedHeap<std::pair<i64, i64> > >,
+              PriorityQueue<std::pair<i64, i64>,
+                            i64i64PairCompare,
+                            IndexedBinaryHeap<std::pair<i64, i64> > >,
+              PriorityQueue<std::pair<i64, i64>,
+                            i64i64PairCompare,
+                            IndexedQuaternaryHeap<std::pair<i64, i64> > > >
 PriorityQueueImplementations;
 
 typedef Types<PriorityQueue<i64, std::less<i64>, BinaryHeap<i64> >,
@@ -248,14 +358,178 @@ typedef Types<PriorityQueue<i64, std::less<i64>, BinaryHeap<i64> >,
               PriorityQueue<i64, std::less<i64>, MultiWayHeap<i64, std::less<i64>, 6> >,
               PriorityQueue<i64, std::less<i64>, MultiWayHeap<i64, std::less<i64>, 7> >,
               PriorityQueue<i64, std::less<i64>, MultiWayHeap<i64, std::less<i64>, 8> >,
+              PriorityQueue<i64, std::less<i64>, AlignedMultiWayHeap<i64, std::less<i64>, 4> >,
+              PriorityQueue<i64, std::less<i64>, CacheAlignedHeap<i64> >,
+              PriorityQueue<i64, std::less<i64>, IndexedQuaternaryHeap<i64> >,
+              PriorityQueue<i64, std::less<i64>, RadixHeap<i64> >,
               std::priority_queue<i64, std::vector<i64>, std::greater<i64> > >
 PriorityQueuePerfImplementations;
 
+typedef Types<PriorityQueue<u64, std::less<u64>, BinaryHeap<u64> >,
+              PriorityQueue<u64, std::less<u64>, QuaternaryHeap<u64> >,
+              PriorityQueue<u64, std::less<u64>, RadixHeap<u64> >,
+              std::priority_queue<u64, std::vector<u64>, std::greater<u64> > >
+MonotonePriorityQueuePerfImplementations;
+
 INSTANTIATE_TYPED_TEST_CASE_P(PrioQueueTemplateTests,
                               PrioQueueTest, PriorityQueueImplementations);
 
 INSTANTIATE_TYPED_TEST_CASE_P(PrioQueuePerfTests,
                               PrioQueuePerfTest, PriorityQueuePerfImplementations);
 
+INSTANTIATE_TYPED_TEST_CASE_P(MonotonePrioQueuePerfTests,
+                              MonotonePrioQueuePerfTest,
+                              MonotonePriorityQueuePerfImplementations);
+
+TEST(RadixHeapTest, Monotone)
+{
+    u64RadixPriorityQueue<u64> prio_queue;
+    std::priority_queue<std::pair<u64, u64>,
+                        std::vector<std::pair<u64, u64> >,
+                        std::greater<std::pair<u64, u64> > > std_prio_queue;
+
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, 1 << 20);
+
+    u64 last_min = 0;
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        u32 num_to_insert = distribution(generator) % MAX_TEST_SIZE;
+        for (u32 j = 0; j < num_to_insert; ++j) {
+            // keys are spread out over a few orders of magnitude
+            auto key = last_min + (distribution(generator) >> (distribution(generator) % 20));
+            prio_queue.push(std::make_pair(key, (u64)j));
+            std_prio_queue.push(std::make_pair(key, (u64)j));
+        }
+
+        u32 num_to_delete = distribution(generator) % (prio_queue.size() + 1);
+        for (u32 j = 0; j < num_to_delete; ++j) {
+            ASSERT_EQ(std_prio_queue.size(), prio_queue.size());
+            // ties between keys can be broken in any order
+            ASSERT_EQ(std_prio_queue.top().first, prio_queue.top().first);
+            last_min = prio_queue.top().first;
+            prio_queue.pop();
+            std_prio_queue.pop();
+        }
+    }
+
+    while (!prio_queue.empty()) {
+        ASSERT_EQ(std_prio_queue.top().first, prio_queue.top().first);
+        prio_queue.pop();
+        std_prio_queue.pop();
+    }
+    EXPECT_TRUE(std_prio_queue.empty());
+}
+
+TEST(RadixHeapTest, SignedKeys)
+{
+    std::vector<i64> keys = { 5, -3, 0, INT64_MIN, 17, -1000000, INT64_MAX, 42, -3 };
+    RadixPriorityQueue<i64> prio_queue(keys.begin(), keys.end());
+
+    std::sort(keys.begin(), keys.end());
+    for (auto key : keys) {
+        EXPECT_EQ(key, prio_queue.top());
+        prio_queue.pop();
+    }
+    EXPECT_TRUE(prio_queue.empty());
+
+    // the heap may start over from any key once it has been drained
+    prio_queue.push(-7);
+    prio_queue.push(-8);
+    EXPECT_EQ(-8, prio_queue.top());
+}
+
+#define ARITY_PERF_TEST_HEAP_SIZE ((u64)(1 << 20))
+#define ARITY_PERF_TEST_NUM_OPS ((u64)(1 << 21))
+
+// a key padded out to SIZE bytes
+template <u32 SIZE>
+struct PaddedKey
+{
+    u64 m_key;
+    u08 m_padding[SIZE - sizeof(u64)];
+
+    inline bool operator < (const PaddedKey& other) const
+    {
+        return (m_key < other.m_key);
+    }
+};
+
+template <>
+struct PaddedKey<4>
+{
+    u32 m_key;
+
+    inline bool operator < (const PaddedKey& other) const
+    {
+        return (m_key < other.m_key);
+    }
+};
+
+template <>
+struct PaddedKey<8>
+{
+    u64 m_key;
+
+    inline bool operator < (const PaddedKey& other) const
+    {
+        return (m_key < other.m_key);
+    }
+};
+
+// seconds taken by a heap of ARITY_PERF_TEST_HEAP_SIZE elements to
+// replace its minimum with a random larger element, repeatedly
+template <typename T, u32 ARITY>
+static inline double time_heap_with_arity()
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u32> distribution(0, 1 << 20);
+    AlignedMultiWayHeap<T, std::less<T>, ARITY> heap;
+
+    std::vector<T> elems(ARITY_PERF_TEST_HEAP_SIZE);
+    for (auto& elem : elems) {
+        elem.m_key = distribution(generator);
+    }
+    heap.heapify(elems.begin(), elems.end());
+
+    auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < ARITY_PERF_TEST_NUM_OPS; ++i) {
+        T elem = heap.get_min();
+        heap.delete_min();
+        elem.m_key += distribution(generator);
+        heap.insert(elem);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(ARITY_PERF_TEST_HEAP_SIZE, heap.get_size());
+    return elapsed.count();
+}
+
+template <u32 SIZE>
+static inline void tune_arity()
+{
+    typedef PaddedKey<SIZE> KeyType;
+    const u32 arities[] = { 2, 4, 8, 16 };
+    const double times[] = { time_heap_with_arity<KeyType, 2>(),
+                             time_heap_with_arity<KeyType, 4>(),
+                             time_heap_with_arity<KeyType, 8>(),
+                             time_heap_with_arity<KeyType, 16>() };
+    u32 best = 0;
+    for (u32 i = 0; i < 4; ++i) {
+        best = (times[i] < times[best] ? i : best);
+    }
+    printf("sizeof(T) = %2u: %.3fs, %.3fs, %.3fs, %.3fs for arity 2, 4, 8, 16; "
+           "best arity %u, cache line arity %u\n",
+           SIZE, times[0], times[1], times[2], times[3], arities[best],
+           aurum::containers::multiway_heap_detail_::get_cache_line_arity<KeyType>());
+}
+
+// picks the best arity of an aligned heap for a range of element sizes
+TEST(MultiWayHeapArityTest, PerfTest)
+{
+    tune_arity<4>();
+    tune_arity<8>();
+    tune_arity<16>();
+    tune_arity<32>();
+}
+
 //
 // PriorityQueueTests.cpp ends here
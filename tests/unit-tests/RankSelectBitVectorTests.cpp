@@ -0,0 +1,234 @@
+// RankSelectBitVectorTests.cpp ---
+//
+// Filename: RankSelectBitVectorTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:40:07 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/RankSelectBitVector.hpp"
+#include "../../src/containers/BitSet.hpp"
+#include "../../src/io/AurumIOException.hpp"
+
+#include <random>
+#include <vector>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 4)
+#define MAX_TEST_SIZE ((u64)(1 << 16))
+#define PERF_TEST_NUM_BITS ((u64)(1 << 26))
+#define PERF_TEST_QUERIES ((u64)(1 << 20))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::BitSet;
+using aurum::containers::RankSelectBitVector;
+namespace aio = aurum::io;
+
+static inline BitSet make_random_bit_set(u64 num_bits, std::default_random_engine& generator,
+                                         u32 one_in)
+{
+    std::uniform_int_distribution<u32> distribution(0, one_in - 1);
+    BitSet retval(num_bits);
+    for (u64 i = 0; i < num_bits; ++i) {
+        if (distribution(generator) == 0) {
+            retval.set(i);
+        }
+    }
+    return retval;
+}
+
+static inline void test_against_bit_set(const RankSelectBitVector& bit_vector,
+                                        const BitSet& bit_set)
+{
+    ASSERT_EQ(bit_set.size(), bit_vector.size());
+    ASSERT_EQ(bit_set.count(), bit_vector.count_ones());
+
+    u64 rank = 0;
+    for (u64 i = 0; i < bit_set.size(); ++i) {
+        ASSERT_EQ(rank, bit_vector.rank1(i));
+        ASSERT_EQ(i - rank, bit_vector.rank0(i));
+        ASSERT_EQ(bit_set.test(i), bit_vector[i]);
+        if (bit_set.test(i)) {
+            ASSERT_EQ(i, bit_vector.select1(rank));
+            ++rank;
+        }
+    }
+    ASSERT_EQ(rank, bit_vector.rank1(bit_set.size()));
+}
+
+TEST(RankSelectBitVectorTest, Basic)
+{
+    RankSelectBitVector empty;
+    EXPECT_EQ(0ul, empty.size());
+    EXPECT_EQ(0ul, empty.count_ones());
+    EXPECT_EQ(0ul, empty.rank1(0));
+
+    BitSet bit_set(5000);
+    bit_set.set(0);
+    bit_set.set(511);
+    bit_set.set(512);
+    bit_set.set(2047);
+    bit_set.set(2048);
+    bit_set.set(4999);
+    RankSelectBitVector bit_vector(bit_set);
+    test_against_bit_set(bit_vector, bit_set);
+    EXPECT_EQ(4999ul, bit_vector.select1(5));
+    EXPECT_EQ("RankSelectBitVector with 5000 bits, 6 ones: {0, 511, 512, 2047, 2048, 4999}",
+              bit_vector.to_string(1));
+
+    auto copy = bit_vector;
+    test_against_bit_set(copy, bit_set);
+    auto moved = std::move(copy);
+    test_against_bit_set(moved, bit_set);
+    EXPECT_EQ(0ul, copy.size());
+}
+
+TEST(RankSelectBitVectorTest, AgainstBitSet)
+{
+    std::default_random_engine generator;
+    std::uniform_int_distribution<u64> distribution(0, MAX_TEST_SIZE);
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        const u64 size = distribution(generator);
+        // from dense to very sparse, so that the select samples
+        // span varying numbers of blocks
+        auto bit_set = make_random_bit_set(size, generator, 1 + (i * i * 8));
+        RankSelectBitVector bit_vector(bit_set);
+        test_against_bit_set(bit_vector, bit_set);
+        // a few percent, plus the header
+        EXPECT_LT(bit_vector.get_overhead_in_bytes(), ((size / 8) * 5 / 100) + 256);
+    }
+
+    BitSet full(100000, true);
+    test_against_bit_set(RankSelectBitVector(full), full);
+}
+
+TEST(RankSelectBitVectorTest, Serialization)
+{
+    std::default_random_engine generator;
+    auto bit_set = make_random_bit_set(40000, generator, 5);
+    RankSelectBitVector bit_vector(bit_set);
+
+    std::ostringstream out_stream;
+    bit_vector.serialize(out_stream);
+    const std::string image = out_stream.str();
+    EXPECT_EQ(bit_vector.get_image_size_in_bytes(), image.size());
+
+    std::istringstream in_stream(image);
+    RankSelectBitVector deserialized;
+    deserialized.deserialize(in_stream);
+    test_against_bit_set(deserialized, bit_set);
+
+    // a mapped view of an aligned copy of the image
+    std::vector<u64> mapped_image(image.size() / sizeof(u64));
+    memcpy(mapped_image.data(), image.data(), image.size());
+    auto mapped = RankSelectBitVector::map(mapped_image.data(), image.size());
+    EXPECT_EQ(static_cast<const void*>(mapped_image.data()), mapped.get_image());
+    test_against_bit_set(mapped, bit_set);
+    auto mapped_copy = mapped;
+    EXPECT_EQ(mapped.get_image(), mapped_copy.get_image());
+
+    EXPECT_THROW(RankSelectBitVector::map(mapped_image.data(), image.size() - 8),
+                 aio::AurumIOException);
+    mapped_image[0] = 0;
+    EXPECT_THROW(RankSelectBitVector::map(mapped_image.data(), image.size()),
+                 aio::AurumIOException);
+
+    std::istringstream truncated_stream(image.substr(0, image.size() - 1));
+    EXPECT_THROW(deserialized.deserialize(truncated_stream), aio::AurumIOException);
+}
+
+// overwrites a word of a serialized image, little endian
+static inline void set_image_word(std::string& image, u64 index, u64 value)
+{
+    for (u64 i = 0; i < sizeof(u64); ++i) {
+        image[(index * sizeof(u64)) + i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+TEST(RankSelectBitVectorTest, CorruptHeaders)
+{
+    RankSelectBitVector bit_vector(BitSet(1000));
+    std::ostringstream out_stream;
+    bit_vector.serialize(out_stream);
+    const std::string image = out_stream.str();
+    RankSelectBitVector deserialized;
+
+    // a consistent header for far more bits than the stream holds
+    const u64 num_bits = (1ull << 40);
+    std::string oversized_image = image;
+    set_image_word(oversized_image, 1, num_bits);
+    set_image_word(oversized_image, 3, (num_bits + 63) / 64);
+    set_image_word(oversized_image, 4, (num_bits >> 32) + 1);
+    set_image_word(oversized_image, 5, (num_bits / 2048) + 1);
+    std::istringstream oversized_stream(oversized_image);
+    EXPECT_THROW(deserialized.deserialize(oversized_stream), aio::AurumIOException);
+
+    // a size whose image size would overflow
+    std::string overflowing_image = image;
+    set_image_word(overflowing_image, 1, ~0ull);
+    set_image_word(overflowing_image, 3, ((~0ull) / 64) + 1);
+    std::istringstream overflowing_stream(overflowing_image);
+    EXPECT_THROW(deserialized.deserialize(overflowing_stream), aio::AurumIOException);
+
+    // the bit vector is still usable after the failed reads
+    std::istringstream in_stream(image);
+    deserialized.deserialize(in_stream);
+    EXPECT_EQ(1000ull, deserialized.size());
+}
+
+TEST(RankSelectBitVectorTest, PerfTest)
+{
+    std::default_random_engine generator;
+    auto bit_set = make_random_bit_set(PERF_TEST_NUM_BITS, generator, 4);
+    RankSelectBitVector bit_vector(bit_set);
+
+    std::uniform_int_distribution<u64> position_distribution(0, PERF_TEST_NUM_BITS);
+    std::uniform_int_distribution<u64> rank_distribution(0, bit_vector.count_ones() - 1);
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_QUERIES; ++i) {
+        total += bit_vector.rank1(position_distribution(generator));
+        total += bit_vector.select1(rank_distribution(generator));
+    }
+    EXPECT_LT(0ul, total);
+}
+
+//
+// RankSelectBitVectorTests.cpp ends here
@@ -76,6 +76,7 @@ class ExprBase : public AurumObject<ExprBase>,
 private:
     // static counters for testing
     static u64 num_objects_alive;
+    static u64 num_objects_allocated;
 
     typedef ManagedConstPointer<ExprBase> ExprRef;
     typedef Vector<ExprRef> ChildVector;
@@ -108,13 +109,12 @@ public:
     // overloads for object counting
     void* operator new (std::size_t sz)
     {
-        ++num_objects_alive;
+        ++num_objects_allocated;
         return ObjectBase::operator new(sz);
     }
 
     void operator delete (void* ptr, std::size_t sz)
     {
-        --num_objects_alive;
         ObjectBase::operator delete(ptr, sz);
     }
 
@@ -126,16 +126,23 @@ public:
         return num_objects_alive;
     }
 
+    static u64 get_num_objects_allocated()
+    {
+        return num_objects_allocated;
+    }
+
     explicit ExprBase(i64 const_value)
         : m_expr_type(ExprType::ConstExpr), m_data()
     {
         m_data.m_const_expr_value = const_value;
+        ++num_objects_alive;
     }
 
     explicit ExprBase(const std::string& var_name)
         : m_expr_type(ExprType::VarExpr), m_data()
     {
         new (&(m_data.m_var_expr_name)) std::string(var_name);
+        ++num_objects_alive;
     }
 
     ExprBase(const std::string& op_name, const ChildVector& children)
@@ -143,6 +150,7 @@ public:
     {
         new (&(m_data.m_op_expr_data.m_op_name)) std::string(op_name);
         new (&(m_data.m_op_expr_data.m_children)) ChildVector(children);
+        ++num_objects_alive;
     }
 
     ExprBase(const std::string& op_name, std::initializer_list<ExprRef> children)
@@ -150,10 +158,12 @@ public:
     {
         new (&(m_data.m_op_expr_data.m_op_name)) std::string(op_name);
         new (&(m_data.m_op_expr_data.m_children)) ChildVector(children);
+        ++num_objects_alive;
     }
 
     virtual ~ExprBase()
     {
+        --num_objects_alive;
         switch (m_expr_type) {
         case ExprType::ConstExpr:
             break;
@@ -231,42 +241,95 @@ public:
         return 0;
     }
 
+    // hash functions on the construction arguments,
+    // for lookups in the cache without construction
+    static u64 compute_hash_value_for(i64 const_value)
+    {
+        auto type_hash = aurum::hashing::integer_hash(0x20000000);
+        aurum::hashing::Hasher<i64> val_hasher;
+        auto val_hash = val_hasher(const_value);
+        return (type_hash ^ val_hash);
+    }
+
+    static u64 compute_hash_value_for(const std::string& var_name)
+    {
+        auto type_hash = aurum::hashing::integer_hash(0x10000000);
+        aurum::hashing::Hasher<std::string> var_hasher;
+        auto var_hash = var_hasher(var_name);
+        return (type_hash ^ var_hash);
+    }
+
+    static u64 compute_hash_value_for(const std::string& op_name, const ChildVector& children)
+    {
+        auto type_hash = aurum::hashing::integer_hash(0x30000000);
+        aurum::hashing::Hasher<std::string> op_hasher;
+        auto op_hash = op_hasher(op_name);
+        auto retval = (type_hash ^ op_hash);
+        for (auto const& child : children) {
+            auto hash_value = child->hash();
+            retval = retval ^ hash_value;
+        }
+        return retval;
+    }
+
     // hash function
     u64 compute_hash_value() const
     {
         switch (m_expr_type) {
         case ExprType::VarExpr:
-        {
-            auto type_hash = aurum::hashing::integer_hash(0x10000000);
-            aurum::hashing::Hasher<std::string> var_hasher;
-            auto var_hash = var_hasher(m_data.m_var_expr_name);
-            return (type_hash ^ var_hash);
+            return compute_hash_value_for(m_data.m_var_expr_name);
+        case ExprType::ConstExpr:
+            return compute_hash_value_for(m_data.m_const_expr_value);
+        case ExprType::OpExpr:
+            return compute_hash_value_for(m_data.m_op_expr_data.m_op_name,
+                                          m_data.m_op_expr_data.m_children);
+        default:
+            return 0;
         }
+    }
 
-        case ExprType::ConstExpr:
-        {
-            auto type_hash = aurum::hashing::integer_hash(0x20000000);
-            aurum::hashing::Hasher<i64> val_hasher;
-            auto val_hash = val_hasher(m_data.m_const_expr_value);
-            return (type_hash ^ val_hash);
+    // for the cache to find the children of collected expressions
+    template <typename FuncType>
+    void for_each_cached_child(FuncType&& func) const
+    {
+        if (m_expr_type != ExprType::OpExpr) {
+            return;
         }
+        for (auto const& child : m_data.m_op_expr_data.m_children) {
+            func(child.get_raw_pointer());
+        }
+    }
 
-        case ExprType::OpExpr:
-        {
-            auto type_hash = aurum::hashing::integer_hash(0x30000000);
-            aurum::hashing::Hasher<std::string> op_hasher;
-            auto op_hash = op_hasher(m_data.m_op_expr_data.m_op_name);
-            auto retval = (type_hash ^ op_hash);
-            auto const& children = m_data.m_op_expr_data.m_children;
-            for (auto const& child : children) {
-                auto hash_value = child->hash();
-                retval = retval ^ hash_value;
-            }
-            return retval;
+    // compare functions on the construction arguments
+    static bool equal_to_args(const ExprBase& expr, i64 const_value)
+    {
+        return (expr.m_expr_type == ExprType::ConstExpr &&
+                expr.m_data.m_const_expr_value == const_value);
+    }
+
+    static bool equal_to_args(const ExprBase& expr, const std::string& var_name)
+    {
+        return (expr.m_expr_type == ExprType::VarExpr &&
+                expr.m_data.m_var_expr_name == var_name);
+    }
+
+    static bool equal_to_args(const ExprBase& expr, const std::string& op_name,
+                              const ChildVector& children)
+    {
+        if (expr.m_expr_type != ExprType::OpExpr ||
+            expr.m_data.m_op_expr_data.m_op_name != op_name) {
+            return false;
         }
-        default:
-            return 0;
+        auto const& expr_children = expr.m_data.m_op_expr_data.m_children;
+        if (expr_children.size() != children.size()) {
+            return false;
         }
+        for (u64 i = 0; i < children.size(); ++i) {
+            if (*(expr_children[i]) != *(children[i])) {
+                return false;
+            }
+        }
+        return true;
     }
 
     // compare function
@@ -336,8 +399,14 @@ public:
 
 // initialization of static class variable
 u64 ExprBase::num_objects_alive = 0;
+u64 ExprBase::num_objects_allocated = 0;
 
 typedef RefCache<ExprBase> ExprCache;
+// gathers statistics, whatever the configuration
+typedef RefCache<ExprBase,
+                 aurum::containers::ref_cache_detail_::DefaultHashFunction<ExprBase>,
+                 aurum::containers::ref_cache_detail_::DefaultEqualsFunction<ExprBase>,
+                 true> StatisticsExprCache;
 typedef ManagedConstPointer<ExprBase> ExprRef;
 typedef aurum::containers::Vector<ExprRef> ExprVector;
 
@@ -375,5 +444,187 @@ TEST(RefCacheTest, BasicOne)
     EXPECT_EQ(var_a_exp, var_a_exp_copy);
 }
 
+TEST(RefCacheTest, AllocationFreeHits)
+{
+    ExprCache the_cache;
+    ExprVector leaves;
+
+    for (i64 i = 0; i < 100; ++i) {
+        leaves.push_back(the_cache.get<ExprBase>(i));
+        leaves.push_back(the_cache.get<ExprBase>("var" + std::to_string(i)));
+    }
+    ExprVector sums;
+    for (u64 i = 0; i + 1 < leaves.size(); ++i) {
+        sums.push_back(the_cache.get<ExprBase>("+", ExprVector { leaves[i], leaves[i + 1] }));
+    }
+
+    auto num_allocated = ExprBase::get_num_objects_allocated();
+    auto num_cached = the_cache.size();
+
+    // every lookup hits, and none of them allocates an expression
+    for (i64 i = 0; i < 100; ++i) {
+        EXPECT_EQ(leaves[2 * i], the_cache.get<ExprBase>(i));
+        EXPECT_EQ(leaves[2 * i + 1], the_cache.get<ExprBase>("var" + std::to_string(i)));
+    }
+    for (u64 i = 0; i + 1 < leaves.size(); ++i) {
+        EXPECT_EQ(sums[i], the_cache.get<ExprBase>("+", ExprVector { leaves[i], leaves[i + 1] }));
+    }
+
+    EXPECT_EQ(num_allocated, ExprBase::get_num_objects_allocated());
+    EXPECT_EQ(num_cached, the_cache.size());
+
+    // misses still construct exactly one object each
+    ExprRef product = the_cache.get<ExprBase>("*", ExprVector { leaves[0], leaves[1] });
+    EXPECT_EQ(num_allocated + 1, ExprBase::get_num_objects_allocated());
+    EXPECT_EQ(product, the_cache.get<ExprBase>("*", ExprVector { leaves[0], leaves[1] }));
+    EXPECT_NE(sums[0], product);
+    EXPECT_EQ(num_allocated + 1, ExprBase::get_num_objects_allocated());
+}
+
+TEST(RefCacheTest, IncrementalCollection)
+{
+    for (u64 nursery_capacity : { 0ul, 16ul, 256ul }) {
+        auto num_alive_before = ExprBase::get_num_objects_alive();
+        ExprCache the_cache;
+        the_cache.set_nursery_capacity(nursery_capacity);
+        EXPECT_EQ(nursery_capacity, the_cache.get_nursery_capacity());
+
+        ExprRef kept = the_cache.get<ExprBase>("kept");
+        {
+            // a deep chain, which only becomes garbage once its root is released
+            ExprRef chain = the_cache.get<ExprBase>((i64)0);
+            for (i64 i = 1; i < 300; ++i) {
+                chain = the_cache.get<ExprBase>("+", ExprVector { chain, the_cache.get<ExprBase>(i) });
+            }
+            EXPECT_LE(300ul, the_cache.size());
+        }
+
+        // unrelated lookups do the collection, a little at a time
+        {
+            ExprVector window(256);
+            for (u64 i = 0; i < 4000; ++i) {
+                EXPECT_EQ(kept, the_cache.get<ExprBase>("kept"));
+                window[i % window.size()] = the_cache.get<ExprBase>("temp" + std::to_string(i));
+            }
+            EXPECT_GT(2000ul, the_cache.size());
+
+            // the chain has been collected, so its leaves need to be created afresh
+            auto num_allocated = ExprBase::get_num_objects_allocated();
+            ExprRef leaf = the_cache.get<ExprBase>((i64)150);
+            EXPECT_EQ(num_allocated + 1, ExprBase::get_num_objects_allocated());
+        }
+
+        ExprBase::EvalMap eval_map;
+        eval_map["kept"] = 42;
+        EXPECT_EQ(42, kept->evaluate(eval_map));
+
+        the_cache.garbage_collect();
+        EXPECT_EQ(1ul, the_cache.size());
+        EXPECT_EQ(num_alive_before + 1, ExprBase::get_num_objects_alive());
+    }
+}
+
+TEST(RefCacheTest, PooledStorage)
+{
+    auto num_alive_before = ExprBase::get_num_objects_alive();
+    ExprRef survivor;
+    {
+        ExprCache the_cache;
+        EXPECT_FALSE(the_cache.is_pooled_storage());
+        EXPECT_EQ(0ul, the_cache.get_pooled_bytes_claimed());
+        the_cache.set_pooled_storage(true);
+        EXPECT_TRUE(the_cache.is_pooled_storage());
+
+        auto num_allocated = ExprBase::get_num_objects_allocated();
+        {
+            ExprVector exprs;
+            for (i64 i = 0; i < 200; ++i) {
+                exprs.push_back(the_cache.get<ExprBase>(i));
+                exprs.push_back(the_cache.get<ExprBase>("var" + std::to_string(i)));
+            }
+            for (u64 i = 0; i < 400; i += 2) {
+                exprs.push_back(the_cache.get<ExprBase>("+", ExprVector { exprs[i], exprs[i + 1] }));
+            }
+            EXPECT_EQ(num_alive_before + 600, ExprBase::get_num_objects_alive());
+            EXPECT_EQ(exprs[0], the_cache.get<ExprBase>((i64)0));
+
+            ExprBase::EvalMap eval_map;
+            eval_map["var7"] = 35;
+            EXPECT_EQ(42, exprs[400 + 7]->evaluate(eval_map));
+
+            survivor = exprs.back();
+        }
+
+        // nothing went through the global allocator
+        EXPECT_EQ(num_allocated, ExprBase::get_num_objects_allocated());
+        EXPECT_LT(0ul, the_cache.get_pooled_bytes_claimed());
+
+        the_cache.garbage_collect();
+        EXPECT_EQ(3ul, the_cache.size());
+        EXPECT_EQ(num_alive_before + 3, ExprBase::get_num_objects_alive());
+        EXPECT_LT(0ul, the_cache.get_pooled_bytes_claimed());
+
+        // chunks are returned once nothing in them is alive
+        survivor = nullptr;
+        the_cache.garbage_collect();
+        EXPECT_EQ(0ul, the_cache.size());
+        EXPECT_EQ(0ul, the_cache.get_pooled_bytes_claimed());
+
+        survivor = the_cache.get<ExprBase>("survivor");
+    }
+
+    // objects outlive the cache, and take the storage with them
+    ExprBase::EvalMap eval_map;
+    eval_map["survivor"] = 7;
+    EXPECT_EQ(7, survivor->evaluate(eval_map));
+    EXPECT_EQ(num_alive_before + 1, ExprBase::get_num_objects_alive());
+    survivor = nullptr;
+    EXPECT_EQ(num_alive_before, ExprBase::get_num_objects_alive());
+}
+
+TEST(RefCacheTest, Statistics)
+{
+    EXPECT_TRUE(StatisticsExprCache::is_statistics_enabled());
+
+    StatisticsExprCache the_cache;
+    {
+        ExprVector leaves;
+        for (i64 i = 0; i < 10; ++i) {
+            leaves.push_back(the_cache.get<ExprBase>(i));
+        }
+        for (i64 i = 0; i < 10; ++i) {
+            EXPECT_EQ(leaves[i], the_cache.get<ExprBase>(i));
+        }
+        ExprRef sum = the_cache.get<ExprBase>("+", ExprVector { leaves[0], leaves[1] });
+        EXPECT_EQ(sum, the_cache.get<ExprBase>("+", ExprVector { leaves[0], leaves[1] }));
+
+        auto statistics = the_cache.get_statistics();
+        EXPECT_EQ(11ul, statistics.m_hits);
+        EXPECT_EQ(11ul, statistics.m_misses);
+        EXPECT_EQ(11ul, statistics.m_objects_constructed);
+        EXPECT_EQ(0ul, statistics.m_objects_discarded);
+        EXPECT_EQ(0ul, statistics.m_full_gcs);
+        EXPECT_EQ(0.5, statistics.get_hit_ratio());
+        EXPECT_EQ(11ul, statistics.m_size);
+        EXPECT_LE(statistics.m_size, statistics.m_capacity);
+        EXPECT_LT(0.0, statistics.get_load_factor());
+        EXPECT_NE(std::string::npos, statistics.to_string().find("hits: 11"));
+        EXPECT_NE(std::string::npos, statistics.to_string(1).find("objects constructed: 11"));
+    }
+
+    the_cache.set_nursery_capacity(0);
+    the_cache.garbage_collect();
+    auto statistics = the_cache.get_statistics();
+    EXPECT_EQ(1ul, statistics.m_full_gcs);
+    EXPECT_EQ(11ul, statistics.m_objects_collected);
+    EXPECT_EQ(0ul, statistics.m_size);
+    EXPECT_LE(0.0, statistics.m_gc_seconds);
+
+    the_cache.reset_statistics();
+    statistics = the_cache.get_statistics();
+    EXPECT_EQ(0ul, statistics.m_hits);
+    EXPECT_EQ(0ul, statistics.m_objects_collected);
+}
+
 //
 // RefCacheTests.cpp ends here
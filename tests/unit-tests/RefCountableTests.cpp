@@ -0,0 +1,344 @@
+// RefCountableTests.cpp ---
+//
+// Filename: RefCountableTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 03:52:47 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/basetypes/RefCountable.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/memory/WeakPointer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define TEST_NUM_THREADS 4
+#define TEST_NUM_OBJECTS 256
+#define TEST_NUM_ROUNDS 64
+#define PERF_TEST_NUM_OPS ((u64)(1 << 24))
+
+using aurum::i64;
+using aurum::u64;
+
+using aurum::RefCountPolicy;
+using aurum::RefCountableWithPolicy;
+using aurum::merge_queued_ref_counts;
+using aurum::memory::ManagedPointer;
+using aurum::memory::ManagedConstPointer;
+using aurum::memory::WeakPointer;
+
+template <RefCountPolicy POLICY>
+class Counted : public RefCountableWithPolicy<Counted<POLICY>, POLICY>
+{
+private:
+    i64 m_value;
+
+public:
+    static std::atomic<i64> num_objects_alive;
+
+    explicit Counted(i64 value)
+        : m_value(value)
+    {
+        ++num_objects_alive;
+    }
+
+    ~Counted()
+    {
+        --num_objects_alive;
+    }
+
+    i64 get_value() const
+    {
+        return m_value;
+    }
+};
+
+template <RefCountPolicy POLICY>
+std::atomic<i64> Counted<POLICY>::num_objects_alive(0);
+
+template <typename T>
+class RefCountPolicyTest : public testing::Test
+{
+    // Nothing here
+};
+
+typedef testing::Types<Counted<RefCountPolicy::NonAtomic>,
+                       Counted<RefCountPolicy::Atomic>,
+                       Counted<RefCountPolicy::Biased> > PolicyTypes;
+
+TYPED_TEST_CASE(RefCountPolicyTest, PolicyTypes);
+
+TYPED_TEST(RefCountPolicyTest, ManagedPointers)
+{
+    typedef TypeParam CountedType;
+    auto num_alive_before = CountedType::num_objects_alive.load();
+    {
+        ManagedPointer<CountedType> ptr1 = new CountedType(42);
+        EXPECT_EQ(1, ptr1->get_ref_count_());
+        ManagedPointer<CountedType> ptr2 = ptr1;
+        ManagedConstPointer<CountedType> cptr = ptr1;
+        EXPECT_EQ(3, ptr1->get_ref_count_());
+
+        ManagedPointer<CountedType> ptr3 = std::move(ptr2);
+        EXPECT_EQ(3, ptr1->get_ref_count_());
+        EXPECT_EQ(42, cptr->get_value());
+
+        ptr3 = new CountedType(43);
+        EXPECT_EQ(2, ptr1->get_ref_count_());
+        EXPECT_EQ(num_alive_before + 2, CountedType::num_objects_alive.load());
+
+        ptr1 = nullptr;
+        EXPECT_EQ(1, cptr->get_ref_count_());
+        cptr = nullptr;
+        EXPECT_EQ(num_alive_before + 1, CountedType::num_objects_alive.load());
+    }
+    EXPECT_EQ(num_alive_before, CountedType::num_objects_alive.load());
+}
+
+// a singly linked list, whose nodes are released by
+// assigning the pointer to a node the node's successor
+class ListNode : public RefCountableWithPolicy<ListNode, RefCountPolicy::NonAtomic>
+{
+public:
+    static i64 num_nodes_alive;
+
+    i64 m_value;
+    ManagedPointer<ListNode> m_next;
+
+    ListNode(i64 value, const ManagedPointer<ListNode>& next)
+        : m_value(value), m_next(next)
+    {
+        ++num_nodes_alive;
+    }
+
+    ~ListNode()
+    {
+        m_value = -1;
+        --num_nodes_alive;
+    }
+};
+
+i64 ListNode::num_nodes_alive = 0;
+
+TEST(ManagedPointerTest, AssignFromReleasedObject)
+{
+    ManagedPointer<ListNode> head;
+    for (i64 i = 0; i < 4; ++i) {
+        head = new ListNode(i, head);
+    }
+    EXPECT_EQ(4, ListNode::num_nodes_alive);
+
+    // copy assignment, from a pointer in the released node
+    head = head->m_next;
+    EXPECT_EQ(3, ListNode::num_nodes_alive);
+    EXPECT_EQ(2, head->m_value);
+
+    // move assignment
+    head = std::move(head->m_next);
+    EXPECT_EQ(2, ListNode::num_nodes_alive);
+    EXPECT_EQ(1, head->m_value);
+
+    // assignment from a raw pointer
+    head = head->m_next.get_raw_pointer();
+    EXPECT_EQ(1, ListNode::num_nodes_alive);
+    EXPECT_EQ(0, head->m_value);
+    EXPECT_EQ(1, head->get_ref_count_());
+
+    head = nullptr;
+    EXPECT_EQ(0, ListNode::num_nodes_alive);
+}
+
+typedef Counted<RefCountPolicy::Biased> BiasedCounted;
+
+// references are shared with other threads, which copy and release
+// them while the owner releases its own
+TEST(BiasedRefCountableTest, SharedAcrossThreads)
+{
+    auto num_alive_before = BiasedCounted::num_objects_alive.load();
+    {
+        std::vector<ManagedPointer<BiasedCounted> > objects;
+        for (i64 i = 0; i < TEST_NUM_OBJECTS; ++i) {
+            objects.push_back(new BiasedCounted(i));
+        }
+
+        std::vector<std::thread> threads;
+        for (u64 i = 0; i < TEST_NUM_THREADS; ++i) {
+            auto copies = objects;
+            threads.emplace_back([copies]() -> void
+                                 {
+                                     i64 sum = 0;
+                                     for (u64 round = 0; round < TEST_NUM_ROUNDS; ++round) {
+                                         auto local_copies = copies;
+                                         for (auto const& ptr : local_copies) {
+                                             sum += ptr->get_value();
+                                         }
+                                     }
+                                     EXPECT_EQ(TEST_NUM_ROUNDS * (TEST_NUM_OBJECTS - 1) *
+                                               TEST_NUM_OBJECTS / 2, sum);
+                                 });
+        }
+        objects.clear();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    merge_queued_ref_counts();
+    EXPECT_EQ(num_alive_before, BiasedCounted::num_objects_alive.load());
+}
+
+// references taken by the owner, but released by another thread,
+// are reconciled when the owner merges the queued objects
+TEST(BiasedRefCountableTest, ReleasedByOtherThread)
+{
+    auto num_alive_before = BiasedCounted::num_objects_alive.load();
+    ManagedPointer<BiasedCounted> kept = new BiasedCounted(0);
+    {
+        std::vector<ManagedPointer<BiasedCounted> > objects;
+        for (i64 i = 0; i < TEST_NUM_OBJECTS; ++i) {
+            objects.push_back(new BiasedCounted(i));
+        }
+        objects.push_back(kept);
+
+        std::thread thread([&objects]() -> void
+                           {
+                               auto moved_objects = std::move(objects);
+                               moved_objects.clear();
+                           });
+        thread.join();
+    }
+
+    EXPECT_EQ(num_alive_before + TEST_NUM_OBJECTS + 1, BiasedCounted::num_objects_alive.load());
+    merge_queued_ref_counts();
+    EXPECT_EQ(num_alive_before + 1, BiasedCounted::num_objects_alive.load());
+
+    // the owner counts atomically after a merge
+    EXPECT_EQ(1, kept->get_ref_count_());
+    auto copy = kept;
+    EXPECT_EQ(2, kept->get_ref_count_());
+    copy = nullptr;
+    kept = nullptr;
+    EXPECT_EQ(num_alive_before, BiasedCounted::num_objects_alive.load());
+}
+
+// objects whose owner has exited are merged by the
+// thread that releases the last reference to them
+TEST(BiasedRefCountableTest, OwnerExits)
+{
+    auto num_alive_before = BiasedCounted::num_objects_alive.load();
+    std::vector<ManagedPointer<BiasedCounted> > objects;
+
+    std::thread thread([&objects]() -> void
+                       {
+                           std::vector<ManagedPointer<BiasedCounted> > created;
+                           for (i64 i = 0; i < TEST_NUM_OBJECTS; ++i) {
+                               created.push_back(new BiasedCounted(i));
+                           }
+                           objects = std::move(created);
+                       });
+    thread.join();
+
+    EXPECT_EQ(num_alive_before + TEST_NUM_OBJECTS, BiasedCounted::num_objects_alive.load());
+    auto copies = objects;
+    objects.clear();
+    EXPECT_EQ(num_alive_before + TEST_NUM_OBJECTS, BiasedCounted::num_objects_alive.load());
+    copies.clear();
+    EXPECT_EQ(num_alive_before, BiasedCounted::num_objects_alive.load());
+}
+
+typedef Counted<RefCountPolicy::NonAtomic> NonAtomicCounted;
+
+TEST(WeakPointerTest, Expiry)
+{
+    auto num_alive_before = NonAtomicCounted::num_objects_alive.load();
+    WeakPointer<NonAtomicCounted> weak_ptr3;
+    {
+        ManagedPointer<NonAtomicCounted> ptr = new NonAtomicCounted(42);
+        WeakPointer<NonAtomicCounted> weak_ptr1 = ptr;
+        WeakPointer<NonAtomicCounted> weak_ptr2 = weak_ptr1;
+        // weak references do not count
+        EXPECT_EQ(1, ptr->get_ref_count_());
+        EXPECT_FALSE(weak_ptr2.is_expired());
+        EXPECT_EQ(ptr, weak_ptr2.lock());
+        EXPECT_EQ(42, weak_ptr1.lock()->get_value());
+
+        weak_ptr3 = std::move(weak_ptr2);
+        EXPECT_TRUE(weak_ptr2.is_expired());
+        weak_ptr1.reset();
+        EXPECT_TRUE(weak_ptr1.is_expired());
+        EXPECT_FALSE(weak_ptr3.is_expired());
+    }
+
+    // the weak pointer outlives the object
+    EXPECT_EQ(num_alive_before, NonAtomicCounted::num_objects_alive.load());
+    EXPECT_TRUE(weak_ptr3.is_expired());
+    EXPECT_EQ(nullptr, weak_ptr3.lock());
+}
+
+// copies and releases managed pointers on a single thread,
+// which is what the biased counts are meant to make cheap
+template <RefCountPolicy POLICY>
+static inline double time_pointer_copies()
+{
+    typedef Counted<POLICY> CountedType;
+    std::vector<ManagedPointer<CountedType> > objects;
+    for (i64 i = 0; i < TEST_NUM_OBJECTS; ++i) {
+        objects.push_back(new CountedType(i));
+    }
+    std::vector<ManagedPointer<CountedType> > copies(objects.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < PERF_TEST_NUM_OPS / TEST_NUM_OBJECTS; ++i) {
+        std::copy(objects.begin(), objects.end(), copies.begin());
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    EXPECT_EQ(2, objects[0]->get_ref_count_());
+    return elapsed.count();
+}
+
+TEST(RefCountPolicyTest, PerfTest)
+{
+    auto non_atomic_time = time_pointer_copies<RefCountPolicy::NonAtomic>();
+    auto atomic_time = time_pointer_copies<RefCountPolicy::Atomic>();
+    auto biased_time = time_pointer_copies<RefCountPolicy::Biased>();
+    printf("%llu pointer copies: %.3fs non-atomic, %.3fs atomic, %.3fs biased\n",
+           (unsigned long long)PERF_TEST_NUM_OPS, non_atomic_time, atomic_time, biased_time);
+}
+
+//
+// RefCountableTests.cpp ends here
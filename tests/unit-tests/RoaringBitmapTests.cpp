@@ -0,0 +1,408 @@
+// RoaringBitmapTests.cpp ---
+//
+// Filename: RoaringBitmapTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:34:40 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include <AurumConfig.h>
+
+#include "../../src/containers/RoaringBitmap.hpp"
+#include "../../src/containers/BitSet.hpp"
+#include "../../src/containers/UnorderedSet.hpp"
+#include "../../src/io/FilteredStreams.hpp"
+#include "../../src/io/ZLibFilter.hpp"
+#include "../../src/io/AurumIOException.hpp"
+
+#include <random>
+#include <set>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 2)
+#define PERF_TEST_UNIVERSE_SIZE ((u64)(1 << 24))
+#define PERF_TEST_SET_SIZE ((u64)(1 << 18))
+#define PERF_TEST_ITERATIONS ((u64)(1 << 4))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::RoaringBitmap;
+using aurum::containers::BitSet;
+using aurum::containers::UnifiedUnorderedSet;
+
+namespace aio = aurum::io;
+
+// a mix of sparse values, dense clusters and long runs,
+// so that all three container types get exercised
+static inline void make_random_sets(RoaringBitmap& bitmap, std::set<u32>& model,
+                                    std::default_random_engine& generator)
+{
+    std::uniform_int_distribution<u32> distribution;
+    std::uniform_int_distribution<u32> small_distribution(0, 1 << 12);
+
+    for (u32 i = 0; i < 2000; ++i) {
+        auto value = distribution(generator);
+        bitmap.add(value);
+        model.insert(value);
+    }
+
+    for (u32 i = 0; i < 3; ++i) {
+        const u32 base = (distribution(generator) % 64) << 16;
+        for (u32 j = 0; j < 12000; ++j) {
+            auto value = base + (distribution(generator) & 0xFFFF);
+            bitmap.add(value);
+            model.insert(value);
+        }
+    }
+
+    for (u32 i = 0; i < 3; ++i) {
+        const u32 first = (distribution(generator) % 64) << 16;
+        const u32 last = first + small_distribution(generator) * 8;
+        bitmap.add_range(first, last);
+        for (u64 j = first; j <= last; ++j) {
+            model.insert(j);
+        }
+    }
+}
+
+static inline bool test_equal(const RoaringBitmap& bitmap, const std::set<u32>& model)
+{
+    if (bitmap.cardinality() != model.size()) {
+        return false;
+    }
+    return std::equal(model.begin(), model.end(), bitmap.begin());
+}
+
+TEST(RoaringBitmapTest, Basic)
+{
+    RoaringBitmap bitmap;
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_EQ(0ul, bitmap.cardinality());
+    EXPECT_TRUE(bitmap.begin() == bitmap.end());
+
+    EXPECT_TRUE(bitmap.add(5));
+    EXPECT_FALSE(bitmap.add(5));
+    EXPECT_TRUE(bitmap.add(0xFFFFFFFF));
+    EXPECT_TRUE(bitmap.add(0x10000));
+    EXPECT_TRUE(bitmap.add(0xFFFF));
+
+    EXPECT_EQ(4ul, bitmap.cardinality());
+    EXPECT_TRUE(bitmap.contains(5));
+    EXPECT_TRUE(bitmap.contains(0xFFFFFFFF));
+    EXPECT_FALSE(bitmap.contains(6));
+    EXPECT_EQ(5u, bitmap.get_min());
+    EXPECT_EQ(0xFFFFFFFFu, bitmap.get_max());
+
+    EXPECT_EQ(0ul, bitmap.rank(4));
+    EXPECT_EQ(1ul, bitmap.rank(5));
+    EXPECT_EQ(3ul, bitmap.rank(0x10000));
+    EXPECT_EQ(0xFFFFu, bitmap.select(1));
+    EXPECT_EQ(0x10000u, bitmap.select(2));
+
+    EXPECT_EQ("RoaringBitmap with 4 values: {5, 65535, 65536, 4294967295}",
+              bitmap.to_string());
+
+    EXPECT_TRUE(bitmap.remove(0x10000));
+    EXPECT_FALSE(bitmap.remove(0x10000));
+    EXPECT_FALSE(bitmap.remove(7));
+    EXPECT_EQ(3ul, bitmap.cardinality());
+
+    RoaringBitmap other = { 5, 0xFFFF, 0xFFFFFFFF };
+    EXPECT_EQ(other, bitmap);
+    bitmap.clear();
+    EXPECT_TRUE(bitmap.empty());
+    EXPECT_NE(other, bitmap);
+}
+
+TEST(RoaringBitmapTest, ContainerTransitions)
+{
+    RoaringBitmap bitmap;
+    std::set<u32> model;
+
+    // array -> bitmap -> array within a single container
+    for (u32 i = 0; i < 10000; ++i) {
+        bitmap.add(i * 3);
+        model.insert(i * 3);
+    }
+    EXPECT_TRUE(test_equal(bitmap, model));
+    EXPECT_EQ(8192ul, bitmap.get_size_in_bytes());
+
+    for (u32 i = 0; i < 9000; ++i) {
+        bitmap.remove(i * 3);
+        model.erase(i * 3);
+    }
+    EXPECT_TRUE(test_equal(bitmap, model));
+    EXPECT_EQ(2000ul, bitmap.get_size_in_bytes());
+
+    // runs
+    RoaringBitmap ranges;
+    ranges.add_range(100, 200000);
+    EXPECT_EQ(200000ul - 100 + 1, ranges.cardinality());
+    EXPECT_TRUE(ranges.contains(100));
+    EXPECT_TRUE(ranges.contains(65536));
+    EXPECT_TRUE(ranges.contains(200000));
+    EXPECT_FALSE(ranges.contains(99));
+    EXPECT_FALSE(ranges.contains(200001));
+    EXPECT_EQ(1000ul, ranges.rank(1099));
+    EXPECT_EQ(70000u, ranges.select(69900));
+    EXPECT_EQ(16ul, ranges.get_size_in_bytes());
+
+    // modifying a run container converts it
+    ranges.remove(150);
+    EXPECT_FALSE(ranges.contains(150));
+    EXPECT_TRUE(ranges.contains(151));
+    EXPECT_TRUE(ranges.run_optimize());
+    EXPECT_EQ(200000ul - 100, ranges.cardinality());
+
+    RoaringBitmap expected;
+    for (u32 i = 100; i <= 200000; ++i) {
+        if (i != 150) {
+            expected.add(i);
+        }
+    }
+    EXPECT_EQ(expected, ranges);
+    EXPECT_FALSE(expected.get_size_in_bytes() == ranges.get_size_in_bytes());
+    EXPECT_TRUE(expected.run_optimize());
+    EXPECT_EQ(expected.get_size_in_bytes(), ranges.get_size_in_bytes());
+}
+
+// ranges that overlap an array container must leave it an array
+TEST(RoaringBitmapTest, OverlappingRanges)
+{
+    RoaringBitmap bitmap1;
+    RoaringBitmap bitmap2;
+    bitmap1.add_range(0, 3999);
+    bitmap2.add_range(0, 3999);
+    bitmap1.remove(3999);
+    bitmap2.remove(3999);
+
+    bitmap1.add_range(0, 200);
+    EXPECT_EQ(3999ul, bitmap1.cardinality());
+    EXPECT_EQ(bitmap2, bitmap1);
+    EXPECT_EQ(bitmap2.get_size_in_bytes(), bitmap1.get_size_in_bytes());
+
+    std::ostringstream out_sstr;
+    bitmap1.serialize(out_sstr);
+    std::istringstream in_sstr(out_sstr.str());
+    RoaringBitmap deserialized;
+    deserialized.deserialize(in_sstr);
+    EXPECT_EQ(bitmap1, deserialized);
+}
+
+TEST(RoaringBitmapTest, SetAlgebra)
+{
+    std::default_random_engine generator;
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        RoaringBitmap bitmap1, bitmap2;
+        std::set<u32> model1, model2;
+        make_random_sets(bitmap1, model1, generator);
+        make_random_sets(bitmap2, model2, generator);
+        if (i % 2 == 1) {
+            bitmap1.run_optimize();
+        }
+
+        std::set<u32> and_model, or_model, xor_model, diff_model;
+        std::set_intersection(model1.begin(), model1.end(), model2.begin(), model2.end(),
+                              std::inserter(and_model, and_model.end()));
+        std::set_union(model1.begin(), model1.end(), model2.begin(), model2.end(),
+                       std::inserter(or_model, or_model.end()));
+        std::set_symmetric_difference(model1.begin(), model1.end(),
+                                      model2.begin(), model2.end(),
+                                      std::inserter(xor_model, xor_model.end()));
+        std::set_difference(model1.begin(), model1.end(), model2.begin(), model2.end(),
+                            std::inserter(diff_model, diff_model.end()));
+
+        EXPECT_TRUE(test_equal(bitmap1, model1));
+        EXPECT_TRUE(test_equal(bitmap1 & bitmap2, and_model));
+        EXPECT_TRUE(test_equal(bitmap1 | bitmap2, or_model));
+        EXPECT_TRUE(test_equal(bitmap1 ^ bitmap2, xor_model));
+        EXPECT_TRUE(test_equal(bitmap1 - bitmap2, diff_model));
+
+        EXPECT_EQ(!and_model.empty(), bitmap1.intersects(bitmap2));
+        EXPECT_TRUE((bitmap1 & bitmap2).is_subset_of(bitmap1));
+        EXPECT_TRUE(bitmap2.is_subset_of(bitmap1 | bitmap2));
+        EXPECT_FALSE(bitmap1.is_subset_of(bitmap1 - bitmap2) && !diff_model.empty() &&
+                     diff_model.size() != model1.size());
+        EXPECT_FALSE((bitmap1 - bitmap2).intersects(bitmap2));
+
+        auto bitmap3 = bitmap1;
+        bitmap3 |= bitmap2;
+        bitmap3 -= bitmap2;
+        EXPECT_EQ(bitmap1 - bitmap2, bitmap3);
+        bitmap3 ^= bitmap1;
+        EXPECT_EQ(bitmap1 & bitmap2, bitmap3);
+        bitmap3 &= bitmap2;
+        EXPECT_EQ(bitmap1 & bitmap2, bitmap3);
+
+        // rank and select agree with the model
+        u64 index = 0;
+        for (auto value : model1) {
+            if (index % 97 == 0) {
+                EXPECT_EQ(value, bitmap1.select(index));
+                EXPECT_EQ(index + 1, bitmap1.rank(value));
+            }
+            ++index;
+        }
+    }
+}
+
+TEST(RoaringBitmapTest, Serialization)
+{
+    std::default_random_engine generator;
+    RoaringBitmap bitmap;
+    std::set<u32> model;
+    make_random_sets(bitmap, model, generator);
+    bitmap.run_optimize();
+
+    std::ostringstream out_sstr;
+    bitmap.serialize(out_sstr);
+    std::istringstream in_sstr(out_sstr.str());
+    RoaringBitmap deserialized;
+    deserialized.deserialize(in_sstr);
+    EXPECT_EQ(bitmap, deserialized);
+    EXPECT_TRUE(test_equal(deserialized, model));
+
+    // truncated and corrupt input
+    auto serialized = out_sstr.str();
+    std::istringstream truncated_sstr(serialized.substr(0, serialized.size() / 2));
+    EXPECT_THROW(deserialized.deserialize(truncated_sstr), aio::AurumIOException);
+    std::istringstream garbage_sstr("definitely not a bitmap");
+    EXPECT_THROW(deserialized.deserialize(garbage_sstr), aio::AurumIOException);
+
+#ifdef AURUM_CFG_HAVE_ZLIB_
+    // through a compressing filter
+    std::ostringstream compressed_sstr;
+    {
+        aio::FilteredOStream out_stream(compressed_sstr.rdbuf());
+        out_stream.push<aio::ZLibFilter>();
+        bitmap.serialize(out_stream);
+    }
+    EXPECT_LT(compressed_sstr.str().size(), serialized.size());
+
+    std::istringstream compressed_in_sstr(compressed_sstr.str());
+    aio::FilteredIStream in_stream(compressed_in_sstr.rdbuf());
+    in_stream.push<aio::ZLibFilter>();
+    RoaringBitmap decompressed;
+    decompressed.deserialize(in_stream);
+    EXPECT_EQ(bitmap, decompressed);
+#endif /* AURUM_CFG_HAVE_ZLIB_ */
+}
+
+// Benchmarks: intersections and unions of sparse sets
+// in a 2^24 universe, as RoaringBitmaps, BitSets and UnorderedSets
+
+class RoaringBitmapPerfTest : public testing::Test
+{
+protected:
+    std::vector<u32> m_values1;
+    std::vector<u32> m_values2;
+
+    RoaringBitmapPerfTest()
+    {
+        std::default_random_engine generator;
+        std::uniform_int_distribution<u32> distribution(0, PERF_TEST_UNIVERSE_SIZE - 1);
+        for (u64 i = 0; i < PERF_TEST_SET_SIZE; ++i) {
+            m_values1.push_back(distribution(generator));
+            m_values2.push_back(distribution(generator));
+        }
+    }
+
+    virtual ~RoaringBitmapPerfTest()
+    {
+        // Nothing here
+    }
+};
+
+TEST_F(RoaringBitmapPerfTest, RoaringBitmap)
+{
+    RoaringBitmap set1(m_values1.begin(), m_values1.end());
+    RoaringBitmap set2(m_values2.begin(), m_values2.end());
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_ITERATIONS; ++i) {
+        total += (set1 & set2).cardinality();
+        total += (set1 | set2).cardinality();
+    }
+    EXPECT_LT(0ul, total);
+}
+
+TEST_F(RoaringBitmapPerfTest, BitSet)
+{
+    BitSet set1(PERF_TEST_UNIVERSE_SIZE);
+    BitSet set2(PERF_TEST_UNIVERSE_SIZE);
+    for (auto value : m_values1) {
+        set1.set(value);
+    }
+    for (auto value : m_values2) {
+        set2.set(value);
+    }
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_ITERATIONS; ++i) {
+        total += (set1 & set2).count();
+        total += (set1 | set2).count();
+    }
+    EXPECT_LT(0ul, total);
+}
+
+TEST_F(RoaringBitmapPerfTest, UnorderedSet)
+{
+    UnifiedUnorderedSet<u32> set1(m_values1.begin(), m_values1.end());
+    UnifiedUnorderedSet<u32> set2(m_values2.begin(), m_values2.end());
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_ITERATIONS; ++i) {
+        UnifiedUnorderedSet<u32> intersection;
+        for (auto value : set1) {
+            if (set2.find(value) != set2.end()) {
+                intersection.insert(value);
+            }
+        }
+        UnifiedUnorderedSet<u32> set_union(set1);
+        for (auto value : set2) {
+            set_union.insert(value);
+        }
+        total += intersection.size() + set_union.size();
+    }
+    EXPECT_LT(0ul, total);
+}
+
+//
+// RoaringBitmapTests.cpp ends here
@@ -0,0 +1,179 @@
+// SoAVectorTests.cpp ---
+//
+// Filename: SoAVectorTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:41:42 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/SoAVector.hpp"
+#include "../../src/containers/Vector.hpp"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#define PERF_TEST_NUM_ELEMENTS ((u64)(1 << 20))
+#define PERF_TEST_ITERATIONS ((u64)(1 << 6))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::SoAVector;
+using aurum::containers::Vector;
+
+typedef SoAVector<u32, std::string, double> TestVectorType;
+
+TEST(SoAVectorTest, Basic)
+{
+    TestVectorType soa_vector;
+    EXPECT_TRUE(soa_vector.empty());
+    EXPECT_EQ(3ul, TestVectorType::sc_num_columns);
+
+    soa_vector.push_back(std::make_tuple(1u, std::string("one"), 1.0));
+    soa_vector.emplace_back(2u, "two", 2.0);
+    soa_vector.push_back(TestVectorType::ValueType(3u, "three", 3.0));
+    EXPECT_EQ(3ul, soa_vector.size());
+
+    EXPECT_EQ(std::make_tuple(2u, std::string("two"), 2.0), soa_vector.get_value(1));
+    EXPECT_EQ("three", soa_vector.get<1>(2));
+    EXPECT_EQ(1u, std::get<0>(soa_vector.front()));
+    EXPECT_EQ(3.0, std::get<2>(soa_vector.back()));
+
+    // writes through the references land in the columns
+    std::get<1>(soa_vector[0]) = "uno";
+    soa_vector[1] = std::make_tuple(20u, std::string("twenty"), 20.0);
+    EXPECT_EQ("uno", soa_vector.get<1>(0));
+    EXPECT_EQ(20u, soa_vector.get_column<0>()[1]);
+
+    soa_vector.swap_elements(0, 2);
+    EXPECT_EQ(std::make_tuple(3u, std::string("three"), 3.0), soa_vector.get_value(0));
+    soa_vector.erase_unordered(0);
+    EXPECT_EQ(2ul, soa_vector.size());
+    EXPECT_EQ(std::make_tuple(1u, std::string("uno"), 1.0), soa_vector.get_value(0));
+
+    auto copy = soa_vector;
+    EXPECT_EQ(soa_vector, copy);
+    copy.pop_back();
+    EXPECT_NE(soa_vector, copy);
+    auto moved = std::move(copy);
+    EXPECT_EQ(1ul, moved.size());
+    EXPECT_EQ(0ul, copy.size());
+
+    soa_vector.resize(10);
+    EXPECT_EQ(10ul, soa_vector.size());
+    EXPECT_EQ(0u, soa_vector.get<0>(9));
+    EXPECT_EQ("", soa_vector.get<1>(9));
+    soa_vector.clear();
+    EXPECT_TRUE(soa_vector.empty());
+}
+
+TEST(SoAVectorTest, Iterators)
+{
+    TestVectorType soa_vector = { std::make_tuple(1u, std::string("one"), 1.5),
+                                  std::make_tuple(2u, std::string("two"), 2.5),
+                                  std::make_tuple(3u, std::string("three"), 3.5) };
+
+    u32 sum = 0;
+    for (auto element : soa_vector) {
+        sum += std::get<0>(element);
+        std::get<2>(element) *= 2;
+    }
+    EXPECT_EQ(6u, sum);
+    EXPECT_EQ(7.0, soa_vector.get<2>(2));
+
+    const TestVectorType& const_vector = soa_vector;
+    auto it = std::find_if(const_vector.begin(), const_vector.end(),
+                           [] (const TestVectorType::ConstRefType& element) -> bool
+                           {
+                               return (std::get<1>(element) == "two");
+                           });
+    ASSERT_NE(const_vector.end(), it);
+    EXPECT_EQ(1ul, it.get_index());
+    EXPECT_EQ(3, const_vector.end() - const_vector.begin());
+    EXPECT_EQ(3u, std::get<0>(*(it + 1)));
+    EXPECT_EQ(1u, std::get<0>(it[-1]));
+
+    TestVectorType::ConstIterator const_it = soa_vector.begin();
+    EXPECT_TRUE(const_it == soa_vector.begin());
+    EXPECT_TRUE(const_it < it);
+}
+
+namespace {
+
+struct Particle
+{
+    double m_x;
+    double m_y;
+    double m_z;
+    double m_mass;
+    u64 m_id;
+    u64 m_flags;
+};
+
+} /* end anonymous namespace */
+
+// a scan over one field, the whole records vs just the column
+TEST(SoAVectorTest, PerfTest)
+{
+    Vector<Particle> aos_vector;
+    SoAVector<double, double, double, double, u64, u64> soa_vector;
+    soa_vector.reserve(PERF_TEST_NUM_ELEMENTS);
+    for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+        aos_vector.push_back(Particle { 1.0 * i, 2.0 * i, 3.0 * i, 0.5 * (i % 7), i, 0 });
+        soa_vector.emplace_back(1.0 * i, 2.0 * i, 3.0 * i, 0.5 * (i % 7), i, 0ul);
+    }
+
+    double aos_total = 0;
+    for (u64 j = 0; j < PERF_TEST_ITERATIONS; ++j) {
+        for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+            aos_total += aos_vector[i].m_mass;
+        }
+    }
+
+    double soa_total = 0;
+    for (u64 j = 0; j < PERF_TEST_ITERATIONS; ++j) {
+        auto const masses = soa_vector.get_column<3>();
+        for (u64 i = 0; i < PERF_TEST_NUM_ELEMENTS; ++i) {
+            soa_total += masses[i];
+        }
+    }
+
+    EXPECT_EQ(aos_total, soa_total);
+}
+
+//
+// SoAVectorTests.cpp ends here
@@ -0,0 +1,220 @@
+// StaticBitSetTests.cpp ---
+//
+// Filename: StaticBitSetTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:37:27 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/StaticBitSet.hpp"
+
+#include <bitset>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#define NUM_TEST_ITERATIONS (1 << 8)
+#define PERF_TEST_ITERATIONS ((u64)(1 << 22))
+
+using aurum::u32;
+using aurum::u64;
+
+using aurum::containers::StaticBitSet;
+
+// everything below must be usable in constant expressions
+static constexpr auto sc_low_mask = StaticBitSet<128>::from_range(0, 70);
+static constexpr auto sc_some_bits = StaticBitSet<128>::from_bits({ 3, 64, 69, 127 });
+
+static_assert(sc_low_mask.count() == 70, "constexpr count");
+static_assert(sc_some_bits.count() == 4, "constexpr from_bits");
+static_assert(sc_some_bits.find_first() == 3, "constexpr find_first");
+static_assert(sc_some_bits.find_next(3) == 64, "constexpr find_next");
+static_assert(sc_some_bits.find_next(127) == 128, "constexpr find_next at end");
+static_assert((sc_low_mask & sc_some_bits).count() == 3, "constexpr and");
+static_assert((sc_low_mask | sc_some_bits).count() == 71, "constexpr or");
+static_assert((sc_some_bits - sc_low_mask) == StaticBitSet<128>::from_bits({ 127 }),
+              "constexpr difference");
+static_assert((~sc_low_mask).count() == 58, "constexpr complement");
+static_assert(StaticBitSet<100>(true).all(), "constexpr gang set");
+static_assert(StaticBitSet<100>().none(), "constexpr default construction");
+static_assert(!sc_some_bits.is_subset_of(sc_low_mask), "constexpr subset");
+static_assert(sc_some_bits.intersects(sc_low_mask), "constexpr intersects");
+
+template <u64 SIZE>
+static inline StaticBitSet<SIZE> make_random_bit_set(std::bitset<SIZE>& model,
+                                                     std::default_random_engine& generator,
+                                                     u32 one_in)
+{
+    std::uniform_int_distribution<u32> distribution(0, one_in - 1);
+    StaticBitSet<SIZE> retval;
+    model.reset();
+    for (u64 i = 0; i < SIZE; ++i) {
+        if (distribution(generator) == 0) {
+            retval[i] = true;
+            model.set(i);
+        }
+    }
+    return retval;
+}
+
+template <u64 SIZE>
+static inline bool test_equal(const StaticBitSet<SIZE>& bit_set, const std::bitset<SIZE>& model)
+{
+    for (u64 i = 0; i < SIZE; ++i) {
+        if (bit_set.test(i) != model.test(i)) {
+            return false;
+        }
+    }
+    return (bit_set.count() == model.count());
+}
+
+template <u64 SIZE>
+static inline void test_against_model()
+{
+    std::default_random_engine generator;
+
+    for (u32 i = 0; i < NUM_TEST_ITERATIONS; ++i) {
+        std::bitset<SIZE> model1, model2;
+        auto set1 = make_random_bit_set(model1, generator, 1 + (i % 70));
+        auto set2 = make_random_bit_set(model2, generator, 3);
+
+        EXPECT_TRUE(test_equal(set1, model1));
+        EXPECT_TRUE(test_equal(set1 & set2, model1 & model2));
+        EXPECT_TRUE(test_equal(set1 | set2, model1 | model2));
+        EXPECT_TRUE(test_equal(set1 ^ set2, model1 ^ model2));
+        EXPECT_TRUE(test_equal(set1 - set2, model1 & ~model2));
+        EXPECT_TRUE(test_equal(~set1, ~model1));
+        EXPECT_EQ(model1.any(), set1.any());
+        EXPECT_EQ(model1.all(), set1.all());
+        EXPECT_EQ((model1 & ~model2).none(), set1.is_subset_of(set2));
+        EXPECT_EQ((model1 & model2).any(), set1.intersects(set2));
+
+        std::vector<u64> expected_bits;
+        for (u64 j = 0; j < SIZE; ++j) {
+            if (model1.test(j)) {
+                expected_bits.push_back(j);
+            }
+        }
+        std::vector<u64> actual_bits;
+        for (auto j = set1.find_first(); j < set1.size(); j = set1.find_next(j)) {
+            actual_bits.push_back(j);
+        }
+        EXPECT_EQ(expected_bits, actual_bits);
+
+        auto set3 = set1;
+        set3 ^= set2;
+        set3 ^= set2;
+        EXPECT_EQ(set1, set3);
+        EXPECT_FALSE(set1 != set3);
+        set3.flip();
+        EXPECT_EQ(~set1, set3);
+    }
+}
+
+TEST(StaticBitSetTest, Basic)
+{
+    StaticBitSet<100> bit_set;
+    EXPECT_EQ(100ul, bit_set.size());
+    EXPECT_TRUE(bit_set.none());
+    EXPECT_EQ(100ul, bit_set.find_first());
+
+    bit_set.set(3);
+    bit_set.set(64);
+    bit_set[99] = true;
+    EXPECT_EQ("StaticBitSet<100>: { 3, 64, 99 }", bit_set.to_string());
+    EXPECT_TRUE(bit_set[64] != bit_set[65]);
+    EXPECT_TRUE(bit_set[3] == bit_set[64]);
+
+    EXPECT_TRUE(bit_set.flip(99));
+    EXPECT_FALSE(bit_set.flip(99));
+    bit_set.clear(64);
+    EXPECT_EQ(2ul, bit_set.count());
+
+    // flipping must not spill into the bits past the end
+    StaticBitSet<100> ones(true);
+    StaticBitSet<100> zeros;
+    zeros.flip();
+    EXPECT_EQ(ones, zeros);
+    EXPECT_EQ(100ul, zeros.count());
+
+    // same ordering as BitSet: the lowest differing bit decides
+    auto low = StaticBitSet<100>::from_bits({ 1 });
+    auto high = StaticBitSet<100>::from_bits({ 0 });
+    EXPECT_TRUE(low < high);
+    EXPECT_TRUE(high > low);
+    EXPECT_TRUE(low <= low);
+    EXPECT_TRUE(high >= low);
+
+    zeros.clear();
+    EXPECT_TRUE(zeros.none());
+    zeros.set();
+    EXPECT_TRUE(zeros.all());
+}
+
+TEST(StaticBitSetTest, AgainstModel)
+{
+    test_against_model<1>();
+    test_against_model<63>();
+    test_against_model<64>();
+    test_against_model<100>();
+    test_against_model<128>();
+    test_against_model<256>();
+    test_against_model<512>();
+    test_against_model<1000>();
+}
+
+// state vector style workload of the kind we run in inner loops
+TEST(StaticBitSetTest, PerfTest)
+{
+    std::default_random_engine generator;
+    std::bitset<256> model1, model2;
+    auto set1 = make_random_bit_set(model1, generator, 3);
+    auto set2 = make_random_bit_set(model2, generator, 3);
+    StaticBitSet<256> accumulator;
+
+    u64 total = 0;
+    for (u64 i = 0; i < PERF_TEST_ITERATIONS; ++i) {
+        accumulator |= set1;
+        accumulator -= set2;
+        accumulator ^= set2;
+        total += accumulator.count() + accumulator.find_first();
+        set1.flip(i % 256);
+    }
+
+    EXPECT_LT(0ul, total);
+}
+
+//
+// StaticBitSetTests.cpp ends here
@@ -0,0 +1,316 @@
+// TaggedManagedPointerTests.cpp ---
+//
+// Filename: TaggedManagedPointerTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:23:18 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/memory/TaggedManagedPointer.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/basetypes/RefCountable.hpp"
+#include "../../src/basetypes/Hashable.hpp"
+#include "../../src/basetypes/EComparable.hpp"
+#include "../../src/hashing/Hashers.hpp"
+#include "../../src/comparisons/Comparators.hpp"
+#include "../../src/containers/UnorderedSet.hpp"
+#include "../../src/containers/UnorderedMap.hpp"
+
+#include <gtest/gtest.h>
+
+using aurum::i64;
+using aurum::u64;
+
+using aurum::AurumObject;
+using aurum::RefCountable;
+using aurum::Hashable;
+using aurum::EComparable;
+using aurum::memory::ManagedPointer;
+using aurum::memory::TaggedManagedPointer;
+using aurum::memory::TaggedManagedConstPointer;
+using aurum::hashing::Hasher;
+using aurum::hashing::DeepHasher;
+using aurum::comparisons::DeepEqualTo;
+using aurum::comparisons::DeepLesser;
+using aurum::containers::RestrictedUnorderedSet;
+using aurum::containers::RestrictedUnorderedMap;
+
+namespace tagged_managed_pointer_testing {
+
+// a graph node, whose edges carry two flags each
+class Node : public AurumObject<Node>,
+             public RefCountable<Node>,
+             public Hashable<Node>,
+             public EComparable<Node>
+{
+public:
+    typedef TaggedManagedPointer<Node, 2> EdgeType;
+
+private:
+    i64 m_value;
+    EdgeType m_left;
+    EdgeType m_right;
+
+public:
+    static i64 num_nodes_alive;
+
+    explicit Node(i64 value, const EdgeType& left = EdgeType(),
+                  const EdgeType& right = EdgeType())
+        : m_value(value), m_left(left), m_right(right)
+    {
+        ++num_nodes_alive;
+    }
+
+    ~Node()
+    {
+        --num_nodes_alive;
+    }
+
+    u64 compute_hash_value() const
+    {
+        return (u64)m_value;
+    }
+
+    bool equal_to(const Node& other) const
+    {
+        return (m_value == other.m_value);
+    }
+
+    bool lesser_than(const Node& other) const
+    {
+        return (m_value < other.m_value);
+    }
+
+    bool operator < (const Node& other) const
+    {
+        return lesser_than(other);
+    }
+
+    i64 get_value() const
+    {
+        return m_value;
+    }
+
+    const EdgeType& get_left() const
+    {
+        return m_left;
+    }
+};
+
+i64 Node::num_nodes_alive = 0;
+
+} /* end namespace tagged_managed_pointer_testing */
+
+using tagged_managed_pointer_testing::Node;
+
+typedef Node::EdgeType EdgeType;
+
+TEST(TaggedManagedPointerTest, Basic)
+{
+    EXPECT_EQ(sizeof(void*), sizeof(EdgeType));
+    auto num_alive_before = Node::num_nodes_alive;
+    {
+        ManagedPointer<Node> leaf = new Node(1);
+        EdgeType edge1(leaf, 3);
+        EXPECT_EQ(leaf.get_raw_pointer(), edge1.get_raw_pointer());
+        EXPECT_EQ(3u, edge1.get_tag());
+        EXPECT_EQ(2, leaf->get_ref_count_());
+
+        edge1.set_tag(2);
+        EXPECT_EQ(2u, edge1.get_tag());
+        EXPECT_EQ(leaf, edge1.get_managed_pointer());
+
+        // tags beyond the available bits are truncated
+        edge1.set_tag(5);
+        EXPECT_EQ(1u, edge1.get_tag());
+
+        EdgeType edge2 = edge1;
+        TaggedManagedConstPointer<Node, 2> const_edge = edge1;
+        EXPECT_EQ(4, leaf->get_ref_count_());
+        EXPECT_TRUE(edge1 == edge2);
+        EXPECT_TRUE(edge1 == const_edge);
+
+        EdgeType edge3 = std::move(edge2);
+        EXPECT_TRUE(edge2.is_null());
+        EXPECT_EQ(0u, edge2.get_tag());
+        EXPECT_EQ(4, leaf->get_ref_count_());
+
+        edge3 = nullptr;
+        EXPECT_FALSE(edge3);
+        EXPECT_EQ(3, leaf->get_ref_count_());
+
+        Node parent(0, edge1, EdgeType(leaf, 2));
+        leaf = nullptr;
+        EXPECT_EQ(1, parent.get_left()->get_value());
+    }
+    EXPECT_EQ(num_alive_before, Node::num_nodes_alive);
+}
+
+TEST(TaggedManagedPointerTest, TagBits)
+{
+    // as many bits as the alignment of the allocations allows
+    ManagedPointer<Node> node = new Node(41);
+    TaggedManagedPointer<Node, 3> low_edge(node, 0x7);
+    EXPECT_EQ(sizeof(void*), sizeof(low_edge));
+    EXPECT_EQ(node.get_raw_pointer(), low_edge.get_raw_pointer());
+    EXPECT_EQ(0x7u, low_edge.get_tag());
+    EXPECT_EQ(0x7u, low_edge.get_packed_value() & 0x7);
+
+#if defined __x86_64__
+    // more than the alignment allows, so in the top bits
+    TaggedManagedPointer<Node, 16> high_edge(new Node(42), 0xBEEF);
+    EXPECT_EQ(sizeof(void*), sizeof(high_edge));
+    EXPECT_EQ(0xBEEFu, high_edge.get_tag());
+    EXPECT_EQ(42, high_edge->get_value());
+    high_edge.set_tag(0xFFFF);
+    EXPECT_EQ(42, high_edge->get_value());
+    EXPECT_EQ(1, high_edge->get_ref_count_());
+#endif /* __x86_64__ */
+}
+
+TEST(TaggedManagedPointerTest, HashingAndComparisons)
+{
+    ManagedPointer<Node> node1 = new Node(1);
+    ManagedPointer<Node> node2 = new Node(1);
+    EdgeType edge1(node1, 1);
+    EdgeType edge2(node1, 2);
+    EdgeType edge3(node2, 1);
+
+    Hasher<EdgeType> hasher;
+    EXPECT_EQ(hasher(edge1), hasher(EdgeType(node1, 1)));
+    EXPECT_NE(hasher(edge1), hasher(edge2));
+    EXPECT_NE(edge1, edge2);
+    EXPECT_TRUE(edge1 < edge2);
+
+    // deep comparisons look through the pointers, but not the tags
+    DeepHasher<EdgeType, 1> deep_hasher;
+    DeepEqualTo<EdgeType, 1> deep_equal_to;
+    DeepLesser<EdgeType, 1> deep_lesser;
+    EXPECT_NE(edge1, edge3);
+    EXPECT_TRUE(deep_equal_to(edge1, edge3));
+    EXPECT_EQ(deep_hasher(edge1), deep_hasher(edge3));
+    EXPECT_FALSE(deep_equal_to(edge1, edge2));
+    EXPECT_NE(deep_hasher(edge1), deep_hasher(edge2));
+    EXPECT_TRUE(deep_lesser(edge3, edge2));
+    EXPECT_FALSE(deep_lesser(edge2, edge3));
+}
+
+TEST(TaggedManagedPointerTest, HashSets)
+{
+    auto num_alive_before = Node::num_nodes_alive;
+    {
+        ManagedPointer<Node> node1 = new Node(1);
+        ManagedPointer<Node> node2 = new Node(2);
+
+        // null pointers, with any tag, are keys like any other
+        RestrictedUnorderedSet<EdgeType> edge_set;
+        for (u64 tag = 0; tag < 4; ++tag) {
+            edge_set.insert(EdgeType(node1, tag));
+            edge_set.insert(EdgeType(node2, tag));
+            edge_set.insert(EdgeType(nullptr, tag));
+        }
+        edge_set.insert(EdgeType(node1, 1));
+        EXPECT_EQ(12u, edge_set.size());
+        EXPECT_EQ(5, node1->get_ref_count_());
+
+        edge_set.erase(EdgeType(node1, 1));
+        edge_set.erase(EdgeType(nullptr, 2));
+        EXPECT_EQ(10u, edge_set.size());
+        EXPECT_EQ(4, node1->get_ref_count_());
+        EXPECT_EQ(edge_set.end(), edge_set.find(EdgeType(node1, 1)));
+        EXPECT_EQ(edge_set.end(), edge_set.find(EdgeType(nullptr, 2)));
+        EXPECT_NE(edge_set.end(), edge_set.find(EdgeType(nullptr, 0)));
+        EXPECT_NE(edge_set.end(), edge_set.find(EdgeType(nullptr, 1)));
+        EXPECT_NE(edge_set.end(), edge_set.find(EdgeType(node2, 1)));
+
+        u64 num_null_edges = 0;
+        for (auto const& edge : edge_set) {
+            if (edge.is_null()) {
+                ++num_null_edges;
+            }
+        }
+        EXPECT_EQ(3u, num_null_edges);
+
+        edge_set.insert(EdgeType(nullptr, 2));
+        EXPECT_EQ(11u, edge_set.size());
+
+        edge_set.erase(EdgeType(nullptr, 0));
+        EXPECT_EQ(10u, edge_set.size());
+        EXPECT_EQ(edge_set.end(), edge_set.find(EdgeType(nullptr, 0)));
+        num_null_edges = 0;
+        for (auto const& edge : edge_set) {
+            if (edge.is_null()) {
+                ++num_null_edges;
+            }
+        }
+        EXPECT_EQ(3u, num_null_edges);
+
+        RestrictedUnorderedMap<EdgeType, u64> edge_map;
+        edge_map[EdgeType(nullptr, 0)] = 1;
+        edge_map[EdgeType(nullptr, 1)] = 2;
+        EXPECT_EQ(2u, edge_map.size());
+        EXPECT_EQ(1u, edge_map.find(EdgeType(nullptr, 0))->second);
+        u64 sum = 0;
+        for (auto const& key_value : edge_map) {
+            sum += key_value.second;
+        }
+        EXPECT_EQ(3u, sum);
+    }
+    EXPECT_EQ(num_alive_before, Node::num_nodes_alive);
+}
+
+// replacing a tagged pointer with one held by the object it releases
+TEST(TaggedManagedPointerTest, AssignFromReleasedObject)
+{
+    auto num_alive_before = Node::num_nodes_alive;
+    {
+        EdgeType edge(new Node(0, EdgeType(new Node(1, EdgeType(new Node(2), 0)), 2)), 3);
+        EXPECT_EQ(num_alive_before + 3, Node::num_nodes_alive);
+
+        edge = edge->get_left();
+        EXPECT_EQ(num_alive_before + 2, Node::num_nodes_alive);
+        EXPECT_EQ(1, edge->get_value());
+        EXPECT_EQ(2u, edge.get_tag());
+
+        edge = std::move(const_cast<EdgeType&>(edge->get_left()));
+        EXPECT_EQ(num_alive_before + 1, Node::num_nodes_alive);
+        EXPECT_EQ(2, edge->get_value());
+        EXPECT_EQ(0u, edge.get_tag());
+        EXPECT_EQ(1, edge->get_ref_count_());
+    }
+    EXPECT_EQ(num_alive_before, Node::num_nodes_alive);
+}
+
+//
+// TaggedManagedPointerTests.cpp ends here
@@ -112,5 +112,26 @@ TEST(TupleUtils, ForEach)
 
 }
 
+TEST(TupleUtils, ZipForEach)
+{
+    std::ostringstream sstr;
+    auto tuple1 = std::tuple<u32, u64, std::string>(42, 420, "\"4200\"");
+    auto tuple2 = std::tuple<u32, std::string, u64>(1, "one", 2);
+    ac::tuple_zip_foreach(tuple1, tuple2,
+                          [&] (auto const& obj1, auto const& obj2) -> void
+                          {
+                              sstr << obj1 << " " << obj2 << std::endl;
+                          });
+    EXPECT_EQ("42 1\n420 one\n\"4200\" 2\n", sstr.str());
+
+    // the first tuple can be written through
+    ac::tuple_zip_foreach(tuple1, std::make_tuple(1u, 2ul, std::string("3")),
+                          [] (auto& obj1, auto const& obj2) -> void
+                          {
+                              obj1 = obj2;
+                          });
+    EXPECT_EQ(std::make_tuple(1u, 2ul, std::string("3")), tuple1);
+}
+
 //
 // TupleUtilsTests.cpp ends here
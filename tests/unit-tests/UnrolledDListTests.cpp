@@ -0,0 +1,613 @@
+// UnrolledDListTests.cpp ---
+//
+// Filename: UnrolledDListTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 02:03:18 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/UnrolledDList.hpp"
+#include <list>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <algorithm>
+
+#include "RCClass.hpp"
+
+#include <gtest/gtest.h>
+
+using aurum::u32;
+using aurum::u64;
+using aurum::containers::UnrolledDList;
+using aurum::containers::PoolUnrolledDList;
+using aurum::containers::u32UnrolledDList;
+using aurum::containers::u32PoolUnrolledDList;
+using aurum::containers::MPtrUnrolledDList;
+using aurum::containers::PoolMPtrUnrolledDList;
+
+using testing::Types;
+
+template <typename u32UnrolledDListType>
+class u32UnrolledDListTest : public testing::Test
+{
+protected:
+    u32UnrolledDListTest() {}
+    virtual ~u32UnrolledDListTest() {}
+};
+
+template <typename RCUnrolledDListType>
+class RCUnrolledDListTest : public ::testing::Test
+{
+protected:
+    RCUnrolledDListTest() {}
+    virtual ~RCUnrolledDListTest() {}
+};
+
+TYPED_TEST_CASE_P(u32UnrolledDListTest);
+TYPED_TEST_CASE_P(RCUnrolledDListTest);
+
+template <typename ListType>
+static inline void check_against(const ListType& list, const std::list<u32>& ref_list)
+{
+    ASSERT_EQ((u64)ref_list.size(), list.size());
+    auto it = list.begin();
+    for (auto num : ref_list) {
+        ASSERT_EQ(num, *it);
+        ++it;
+    }
+    EXPECT_TRUE(it == list.end());
+
+    auto rit = list.rbegin();
+    for (auto ref_rit = ref_list.rbegin(); ref_rit != ref_list.rend(); ++ref_rit) {
+        ASSERT_EQ(*ref_rit, *rit);
+        ++rit;
+    }
+    EXPECT_TRUE(rit == list.rend());
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Constructor)
+{
+    typedef TypeParam u32ListType;
+
+    u32ListType list1;
+    EXPECT_EQ(0ull, list1.size());
+    EXPECT_TRUE(list1.begin() == list1.end());
+
+    u32ListType list2(10);
+    EXPECT_EQ(10ull, list2.size());
+
+    u32 i = 0;
+    for (auto num : list2) {
+        EXPECT_EQ(0u, num);
+        ++i;
+    }
+    EXPECT_EQ(10u, i);
+
+    u32ListType list3(100, 42u);
+    i = 0;
+    for (auto num : list3) {
+        EXPECT_EQ(42u, num);
+        ++i;
+    }
+    EXPECT_EQ(100u, i);
+
+    u32ListType list4(list3.begin(), list3.end());
+    EXPECT_EQ(list3, list4);
+
+    u32ListType list5(list4);
+    EXPECT_EQ(list3, list5);
+
+    u32ListType list6(std::move(list5));
+    EXPECT_EQ(list3, list6);
+    EXPECT_EQ(0ull, list5.size());
+    EXPECT_TRUE(list5.begin() == list5.end());
+
+    u32ListType list7({1, 2, 3, 4, 5});
+    EXPECT_EQ(5ull, list7.size());
+    i = 0;
+    for (auto num : list7) {
+        EXPECT_EQ(++i, num);
+    }
+    EXPECT_EQ(5u, i);
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Assignment)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list1;
+    for (u32 i = 0; i < 1024; ++i) {
+        list1.push_back(i);
+    }
+
+    EXPECT_EQ(1024ull, list1.size());
+    auto list2 = list1;
+    EXPECT_EQ(1024ull, list2.size());
+    EXPECT_EQ(list1, list2);
+
+    u32ListType list3;
+    list3 = std::move(list2);
+    EXPECT_EQ(1024ull, list3.size());
+    EXPECT_EQ(0ull, list2.size());
+    EXPECT_EQ(list1, list3);
+
+    u32 i = 0;
+    for (auto num : list3) {
+        EXPECT_EQ(i++, num);
+    }
+
+    list3 = { 3, 2, 1 };
+    EXPECT_EQ(3ull, list3.size());
+    EXPECT_EQ(3u, list3.front());
+    EXPECT_EQ(1u, list3.back());
+
+    list3.swap(list1);
+    EXPECT_EQ(1024ull, list3.size());
+    EXPECT_EQ(3ull, list1.size());
+    EXPECT_EQ(1023u, list3.back());
+    EXPECT_EQ(3u, list1.front());
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Insertions)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list;
+    std::list<u32> ref_list;
+
+    for (u32 i = 0; i < 100; ++i) {
+        list.push_front(i);
+        ref_list.push_front(i);
+        list.push_back(i);
+        ref_list.push_back(i);
+    }
+    check_against(list, ref_list);
+
+    // insert in the middle, forcing nodes to split
+    auto it = list.begin();
+    auto ref_it = ref_list.begin();
+    for (u32 i = 0; i < 50; ++i) {
+        ++it;
+        ++ref_it;
+    }
+    for (u32 i = 0; i < 100; ++i) {
+        it = list.insert(it, 1000 + i);
+        ref_it = ref_list.insert(ref_it, 1000 + i);
+    }
+    check_against(list, ref_list);
+
+    it = list.insert(list.end(), 5, 77u);
+    ref_it = ref_list.insert(ref_list.end(), 5, 77u);
+    EXPECT_EQ(77u, *it);
+    check_against(list, ref_list);
+
+    std::vector<u32> values = { 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+    it = list.begin();
+    ++it;
+    ref_it = ref_list.begin();
+    ++ref_it;
+    it = list.insert(it, values.begin(), values.end());
+    ref_list.insert(ref_it, values.begin(), values.end());
+    EXPECT_EQ(11u, *it);
+    check_against(list, ref_list);
+
+    list.emplace(list.begin(), 42u);
+    ref_list.emplace(ref_list.begin(), 42u);
+    check_against(list, ref_list);
+
+    // erasures, which merge sparse nodes
+    it = list.begin();
+    ref_it = ref_list.begin();
+    while (it != list.end()) {
+        it = list.erase(it);
+        ref_it = ref_list.erase(ref_it);
+        if (it != list.end()) {
+            ++it;
+            ++ref_it;
+        }
+    }
+    check_against(list, ref_list);
+
+    auto first = list.begin();
+    auto last = list.begin();
+    ref_it = ref_list.begin();
+    auto ref_last = ref_list.begin();
+    for (u32 i = 0; i < 10; ++i) {
+        ++first;
+        ++ref_it;
+    }
+    last = first;
+    ref_last = ref_it;
+    for (u32 i = 0; i < 25; ++i) {
+        ++last;
+        ++ref_last;
+    }
+    it = list.erase(first, last);
+    ref_it = ref_list.erase(ref_it, ref_last);
+    EXPECT_EQ(*ref_it, *it);
+    check_against(list, ref_list);
+
+    while (!list.empty()) {
+        list.pop_front();
+        ref_list.pop_front();
+        if (!list.empty()) {
+            list.pop_back();
+            ref_list.pop_back();
+        }
+    }
+    check_against(list, ref_list);
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, RandomizedOperations)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list;
+    std::list<u32> ref_list;
+
+    std::mt19937 generator(0x5eed);
+    std::uniform_int_distribution<u32> dist(0, 1000);
+
+    for (u32 round = 0; round < 4000; ++round) {
+        auto op = dist(generator) % 4;
+        auto position = (ref_list.empty() ? 0 : dist(generator) % (ref_list.size() + 1));
+        auto it = list.begin();
+        auto ref_it = ref_list.begin();
+        for (u32 i = 0; i < position; ++i) {
+            ++it;
+            ++ref_it;
+        }
+
+        if (op != 0 || ref_it == ref_list.end()) {
+            auto value = dist(generator);
+            it = list.insert(it, value);
+            ref_it = ref_list.insert(ref_it, value);
+        } else {
+            it = list.erase(it);
+            ref_it = ref_list.erase(ref_it);
+        }
+
+        if (ref_it == ref_list.end()) {
+            EXPECT_TRUE(it == list.end());
+        } else {
+            EXPECT_EQ(*ref_it, *it);
+        }
+    }
+    check_against(list, ref_list);
+
+    list.sort();
+    ref_list.sort();
+    check_against(list, ref_list);
+
+    list.unique();
+    ref_list.unique();
+    check_against(list, ref_list);
+
+    list.remove_if([] (u32 value) -> bool { return (value % 3) == 0; });
+    ref_list.remove_if([] (u32 value) -> bool { return (value % 3) == 0; });
+    check_against(list, ref_list);
+
+    list.reverse();
+    ref_list.reverse();
+    check_against(list, ref_list);
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Resize)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list1(10, 5u);
+
+    list1.resize(20, 10u);
+    EXPECT_EQ(20ull, list1.size());
+    u32 i = 0;
+    for (auto num : list1) {
+        EXPECT_EQ(i < 10 ? 5u : 10u, num);
+        ++i;
+    }
+
+    list1.resize(5);
+    EXPECT_EQ(5ull, list1.size());
+    for (auto num : list1) {
+        EXPECT_EQ(5u, num);
+    }
+
+    list1.resize(0);
+    EXPECT_EQ(0ull, list1.size());
+    EXPECT_TRUE(list1.begin() == list1.end());
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Splice)
+{
+    typedef TypeParam u32ListType;
+
+    u32ListType list1, list2;
+    list1 = { 1, 2, 3, 9, 10 };
+    list2 = { 4, 5, 6, 7, 8 };
+
+    auto pos = list1.begin();
+    ++pos;
+    ++pos;
+    ++pos;
+
+    list1.splice(pos, list2);
+
+    EXPECT_EQ((u64)10, list1.size());
+    EXPECT_EQ((u64)0, list2.size());
+    EXPECT_TRUE(list2.begin() == list2.end());
+
+    u32 i = 0;
+    for (auto num : list1) {
+        EXPECT_EQ((u32)(++i), num);
+    }
+    EXPECT_EQ((u32)10, i);
+
+    list1 = { 1, 2, 4, 5 };
+    list2 = { 6, 7, 3, 8, 9, 10 };
+
+    auto opos = list2.begin();
+    ++opos;
+    ++opos;
+
+    pos = list1.begin();
+    ++pos;
+    ++pos;
+
+    list1.splice(pos, list2, opos);
+    EXPECT_EQ((u64)5, list1.size());
+    EXPECT_EQ((u64)5, list2.size());
+
+    i = 0;
+    for (auto num : list1) {
+        EXPECT_EQ(++i, num);
+    }
+
+    for (auto num : list2) {
+        EXPECT_EQ(++i, num);
+    }
+    EXPECT_EQ(10u, i);
+
+    list1 = { 1, 2, 8, 9, 10 };
+    list2 = { 42, 3, 4, 5, 6, 7, 42 };
+    pos = list1.begin();
+    ++pos;
+    ++pos;
+    auto ofirst = list2.begin();
+    ++ofirst;
+    auto olast = list2.end();
+    --olast;
+
+    list1.splice(pos, list2, ofirst, olast);
+    EXPECT_EQ(10ull, list1.size());
+    EXPECT_EQ(2ull, list2.size());
+    i = 0;
+    for (auto num : list1) {
+        EXPECT_EQ(++i, num);
+    }
+    for (auto num : list2) {
+        EXPECT_EQ(42u, num);
+    }
+
+    // splicing lists that do not share an allocator
+    u32ListType list3;
+    for (u32 j = 0; j < 100; ++j) {
+        list3.push_back(j);
+    }
+    u32ListType list4;
+    for (u32 j = 100; j < 200; ++j) {
+        list4.push_back(j);
+    }
+    list3.splice(list3.end(), list4);
+    EXPECT_EQ(200ull, list3.size());
+    EXPECT_TRUE(list4.empty());
+    i = 0;
+    for (auto num : list3) {
+        EXPECT_EQ(i++, num);
+    }
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Remove)
+{
+    typedef TypeParam u32ListType;
+
+    u32ListType list1;
+
+    list1 = { 1, 2, 3, 4, 5 };
+    list1.remove(3);
+    EXPECT_EQ((u64)4, list1.size());
+    auto it = list1.begin();
+    EXPECT_EQ(1u, *it);
+    ++it;
+    EXPECT_EQ(2u, *it);
+    ++it;
+    EXPECT_EQ(4u, *it);
+    ++it;
+    EXPECT_EQ(5u, *it);
+    ++it;
+    EXPECT_EQ(list1.end(), it);
+
+    list1.remove_if([] (u32 value) -> bool { return true; });
+    EXPECT_TRUE(list1.empty());
+    EXPECT_TRUE(list1.begin() == list1.end());
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Unique)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list = { 1, 2, 2, 3, 4, 4 };
+    list.unique();
+
+    EXPECT_EQ(4ull, list.size());
+    auto it = list.begin();
+
+    EXPECT_EQ(1u, *it);
+    ++it;
+    EXPECT_EQ(2u, *it);
+    ++it;
+    EXPECT_EQ(3u, *it);
+    ++it;
+    EXPECT_EQ(4u, *it);
+    ++it;
+    EXPECT_EQ(list.end(), it);
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, SortMerge)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list1 = { 5, 10, 9, 1, 2 };
+    u32ListType list2 = { 4, 6, 8, 7, 3 };
+    list1.sort();
+    list2.sort();
+
+    EXPECT_EQ(5u, list1.size());
+    EXPECT_EQ(5u, list2.size());
+
+    EXPECT_EQ(u32ListType({ 1, 2, 5, 9, 10 }), list1);
+    EXPECT_EQ(u32ListType({ 3, 4, 6, 7, 8 }), list2);
+
+    list1.merge(list2);
+    EXPECT_EQ(10ull, list1.size());
+    EXPECT_EQ(0ull, list2.size());
+
+    u32 i = 0;
+    for (auto num : list1) {
+        EXPECT_EQ(++i, num);
+    }
+    EXPECT_EQ(10u, i);
+
+    // larger merges, which span many nodes
+    std::list<u32> ref_list1, ref_list2;
+    list1.clear();
+    for (u32 j = 0; j < 500; ++j) {
+        list1.push_back(j * 3);
+        ref_list1.push_back(j * 3);
+        list2.push_front(j * 2);
+        ref_list2.push_front(j * 2);
+    }
+    list2.sort();
+    ref_list2.sort();
+    list1.merge(list2, std::less<u32>());
+    ref_list1.merge(ref_list2);
+    check_against(list1, ref_list1);
+    EXPECT_TRUE(list2.empty());
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Reverse)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list;
+    list = { 5, 4, 3, 2, 1 };
+    list.reverse();
+    EXPECT_EQ(5ull, list.size());
+    u32 i = 0;
+    for (auto num : list) {
+        EXPECT_EQ(++i, num);
+    }
+    EXPECT_EQ(5u, i);
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Relational)
+{
+    typedef TypeParam u32ListType;
+    u32ListType list1, list2, list3, list4, list5;
+    list1 = { 1, 2, 3, 4, 5 };
+    list5 = { 1, 2, 3, 4, 5 };
+    list2 = { 9, 10 };
+    list3 = { 1, 2, 3, 4, 6 };
+    list4 = { 1, 2, 3, 4 };
+
+    EXPECT_LT(list2, list1);
+    EXPECT_GT(list1, list2);
+    EXPECT_LT(list1, list3);
+    EXPECT_EQ(list1, list5);
+    EXPECT_LT(list4, list3);
+    EXPECT_GT(list3, list4);
+}
+
+TYPED_TEST_P(RCUnrolledDListTest, RefCountableTests)
+{
+    typedef TypeParam ListType;
+
+    ListType list1;
+    for (u32 i = 0; i < 128; ++i) {
+        list1.push_back(new RCClass(i));
+    }
+
+    list1.emplace_front(new RCClass(128));
+    list1.emplace_back(new RCClass(129));
+    list1.insert(++(list1.begin()), new RCClass(130));
+
+    list1.resize(10);
+    list1.erase(list1.begin());
+    list1.clear();
+}
+
+TYPED_TEST_P(u32UnrolledDListTest, Stringification)
+{
+    typedef TypeParam u32ListType;
+
+    u32ListType list1 = {1, 2, 3, 4, 5};
+    EXPECT_TRUE(list1.to_string() ==
+                "Unpooled UnrolledDListBase<unsigned int> with 5 elements:\n<<1, 2, 3, 4, 5>>" ||
+                list1.to_string() ==
+                "Pooled UnrolledDListBase<unsigned int> with 5 elements:\n<<1, 2, 3, 4, 5>>");
+}
+
+REGISTER_TYPED_TEST_CASE_P(u32UnrolledDListTest,
+                           Constructor,
+                           Assignment,
+                           Insertions,
+                           RandomizedOperations,
+                           Resize,
+                           Splice,
+                           Remove,
+                           Unique,
+                           SortMerge,
+                           Reverse,
+                           Relational,
+                           Stringification);
+
+REGISTER_TYPED_TEST_CASE_P(RCUnrolledDListTest, RefCountableTests);
+
+// the 32 byte variants have nodes of only four elements,
+// which exercises node splits and merges much harder
+typedef Types<u32UnrolledDList, u32PoolUnrolledDList,
+              UnrolledDList<u32, 32>, PoolUnrolledDList<u32, 32>> u32UnrolledDListImplementations;
+typedef Types<MPtrUnrolledDList<RCClass>, PoolMPtrUnrolledDList<RCClass>,
+              MPtrUnrolledDList<RCClass, 32>> RCUnrolledDListImplementations;
+
+INSTANTIATE_TYPED_TEST_CASE_P(NonPoolAndPoolUnrolledDList,
+                              u32UnrolledDListTest, u32UnrolledDListImplementations);
+INSTANTIATE_TYPED_TEST_CASE_P(NonPoolAndPoolUnrolledDListRC,
+                              RCUnrolledDListTest, RCUnrolledDListImplementations);
+
+//
+// UnrolledDListTests.cpp ends here
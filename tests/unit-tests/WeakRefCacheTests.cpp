@@ -0,0 +1,309 @@
+// WeakRefCacheTests.cpp ---
+//
+// Filename: WeakRefCacheTests.cpp
+// Author: Abhishek Udupa
+// Created: Mon Oct 19 04:09:06 2026 (+0000)
+//
+//
+// Copyright (c) 2015, Abhishek Udupa, University of Pennsylvania
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+// 3. All advertising materials mentioning features or use of this software
+//    must display the following acknowledgement:
+//    This product includes software developed by The University of Pennsylvania
+// 4. Neither the name of the University of Pennsylvania nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER ''AS IS'' AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+
+// Code:
+
+#include "../../src/containers/WeakRefCache.hpp"
+#include "../../src/memory/ManagedPointer.hpp"
+#include "../../src/memory/WeakPointer.hpp"
+#include "../../src/basetypes/Hashable.hpp"
+#include "../../src/basetypes/EComparable.hpp"
+#include "../../src/basetypes/RefCountable.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#define TEST_CHAIN_LENGTH 1000
+#define PERF_TEST_NUM_ROUNDS 256
+
+using aurum::i64;
+using aurum::u64;
+
+using aurum::AurumObject;
+using aurum::RefCountable;
+using aurum::Hashable;
+using aurum::EComparable;
+using aurum::memory::ManagedConstPointer;
+using aurum::memory::WeakPointer;
+using aurum::containers::WeakRefCache;
+using aurum::containers::RefCache;
+
+namespace weak_ref_cache_testing {
+
+// a binary term with a value, the leaves have null children
+class Term : public AurumObject<Term>,
+             public RefCountable<Term>,
+             public Hashable<Term>,
+             public EComparable<Term>
+{
+private:
+    typedef ManagedConstPointer<Term> TermRef;
+
+    static i64 num_terms_alive;
+
+    i64 m_value;
+    TermRef m_left;
+    TermRef m_right;
+
+public:
+    static i64 get_num_terms_alive()
+    {
+        return num_terms_alive;
+    }
+
+    Term(i64 value, const TermRef& left, const TermRef& right)
+        : m_value(value), m_left(left), m_right(right)
+    {
+        ++num_terms_alive;
+    }
+
+    ~Term()
+    {
+        --num_terms_alive;
+    }
+
+    // the children are canonical, so they are hashed and
+    // compared on their addresses
+    static u64 compute_hash_value_for(i64 value, const TermRef& left, const TermRef& right)
+    {
+        u64 retval = (u64)value * 0x9E3779B97F4A7C15ull;
+        retval = (retval ^ (u64)left.get_raw_pointer()) * 0x100000001b3ull;
+        retval = (retval ^ (u64)right.get_raw_pointer()) * 0x100000001b3ull;
+        return retval;
+    }
+
+    static bool equal_to_args(const Term& term, i64 value,
+                              const TermRef& left, const TermRef& right)
+    {
+        return (term.m_value == value && term.m_left == left && term.m_right == right);
+    }
+
+    u64 compute_hash_value() const
+    {
+        return compute_hash_value_for(m_value, m_left, m_right);
+    }
+
+    bool equal_to(const Term& other) const
+    {
+        return equal_to_args(*this, other.m_value, other.m_left, other.m_right);
+    }
+
+    i64 get_value() const
+    {
+        return m_value;
+    }
+};
+
+i64 Term::num_terms_alive = 0;
+
+typedef WeakRefCache<Term> TermCache;
+typedef ManagedConstPointer<Term> TermRef;
+
+// functors other than the defaults, so that lookups
+// construct the object to probe with
+class TermHasher
+{
+public:
+    u64 operator () (const Term* term) const
+    {
+        return term->hash();
+    }
+};
+
+class TermEqualTo
+{
+public:
+    bool operator () (const Term* term1, const Term* term2) const
+    {
+        return term1->equals(*term2);
+    }
+};
+
+} /* end namespace weak_ref_cache_testing */
+
+using weak_ref_cache_testing::Term;
+using weak_ref_cache_testing::TermCache;
+using weak_ref_cache_testing::TermRef;
+using weak_ref_cache_testing::TermHasher;
+using weak_ref_cache_testing::TermEqualTo;
+
+TEST(WeakRefCacheTest, Basic)
+{
+    auto num_alive_before = Term::get_num_terms_alive();
+    {
+        TermCache the_cache;
+
+        TermRef one = the_cache.get<Term>(1, TermRef(), TermRef());
+        TermRef two = the_cache.get<Term>(2, TermRef(), TermRef());
+        TermRef sum = the_cache.get<Term>(0, one, two);
+        EXPECT_EQ(3u, the_cache.size());
+        EXPECT_EQ(one, the_cache.get<Term>(1, TermRef(), TermRef()));
+        EXPECT_EQ(sum, the_cache.get<Term>(0, one, two));
+
+        // nothing refers to the reversed sum, so it is gone at once
+        EXPECT_NE(sum, the_cache.get<Term>(0, two, one));
+        EXPECT_EQ(3u, the_cache.size());
+        EXPECT_EQ(num_alive_before + 3, Term::get_num_terms_alive());
+
+        // the children stay for as long as the sum refers to them
+        one = nullptr;
+        two = nullptr;
+        EXPECT_EQ(3u, the_cache.size());
+        sum = nullptr;
+        EXPECT_EQ(0u, the_cache.size());
+        EXPECT_EQ(num_alive_before, Term::get_num_terms_alive());
+    }
+    EXPECT_EQ(num_alive_before, Term::get_num_terms_alive());
+}
+
+TEST(WeakRefCacheTest, ReleasingChains)
+{
+    auto num_alive_before = Term::get_num_terms_alive();
+    TermCache the_cache;
+
+    TermRef leaf = the_cache.get<Term>(0, TermRef(), TermRef());
+    TermRef chain = leaf;
+    for (i64 i = 1; i < TEST_CHAIN_LENGTH; ++i) {
+        chain = the_cache.get<Term>(i, chain, leaf);
+    }
+    EXPECT_EQ((u64)TEST_CHAIN_LENGTH, the_cache.size());
+
+    // equal terms are found, not created again
+    TermRef other_chain = leaf;
+    for (i64 i = 1; i < TEST_CHAIN_LENGTH; ++i) {
+        other_chain = the_cache.get<Term>(i, other_chain, leaf);
+    }
+    EXPECT_EQ(chain, other_chain);
+    EXPECT_EQ((u64)TEST_CHAIN_LENGTH, the_cache.size());
+
+    chain = nullptr;
+    other_chain = nullptr;
+    EXPECT_EQ(1u, the_cache.size());
+    EXPECT_EQ(num_alive_before + 1, Term::get_num_terms_alive());
+}
+
+TEST(WeakRefCacheTest, ConstructedLookups)
+{
+    auto num_alive_before = Term::get_num_terms_alive();
+    {
+        WeakRefCache<Term, TermHasher, TermEqualTo> the_cache;
+
+        TermRef one = the_cache.get<Term>(1, TermRef(), TermRef());
+        TermRef sum = the_cache.get<Term>(0, one, one);
+        EXPECT_EQ(one, the_cache.get<Term>(1, TermRef(), TermRef()));
+        EXPECT_EQ(sum, the_cache.get<Term>(0, one, one));
+        EXPECT_EQ(2u, the_cache.size());
+        EXPECT_EQ(num_alive_before + 2, Term::get_num_terms_alive());
+
+        one = nullptr;
+        sum = nullptr;
+        EXPECT_EQ(0u, the_cache.size());
+    }
+    EXPECT_EQ(num_alive_before, Term::get_num_terms_alive());
+}
+
+TEST(WeakRefCacheTest, ObjectsOutliveTheCache)
+{
+    auto num_alive_before = Term::get_num_terms_alive();
+    TermRef sum;
+    WeakPointer<Term> weak_sum;
+    {
+        TermCache the_cache;
+        TermRef one = the_cache.get<Term>(1, TermRef(), TermRef());
+        sum = the_cache.get<Term>(0, one, one);
+        weak_sum = the_cache.get<Term>(0, one, one);
+    }
+
+    EXPECT_FALSE(weak_sum.is_expired());
+    EXPECT_EQ(0, weak_sum.lock()->get_value());
+    sum = nullptr;
+    EXPECT_TRUE(weak_sum.is_expired());
+    EXPECT_EQ(nullptr, weak_sum.lock());
+    EXPECT_EQ(num_alive_before, Term::get_num_terms_alive());
+}
+
+// creates batches of terms, looks them up again, and drops them,
+// so that every term created is also collected (or expires)
+template <typename CacheType>
+static inline double time_term_churn(CacheType& the_cache)
+{
+    std::vector<TermRef> terms(TEST_CHAIN_LENGTH);
+    auto start = std::chrono::steady_clock::now();
+    for (u64 round = 0; round < PERF_TEST_NUM_ROUNDS; ++round) {
+        // new values in every round, so that no term is reused
+        const i64 first_value = (i64)(round * TEST_CHAIN_LENGTH);
+        for (i64 i = 0; i < TEST_CHAIN_LENGTH; ++i) {
+            terms[i] = the_cache.template get<Term>(first_value + i, TermRef(), TermRef());
+        }
+        for (i64 i = 0; i < TEST_CHAIN_LENGTH; ++i) {
+            EXPECT_EQ(terms[i], the_cache.template get<Term>(first_value + i, TermRef(), TermRef()));
+        }
+        std::fill(terms.begin(), terms.end(), TermRef());
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    return elapsed.count();
+}
+
+TEST(WeakRefCacheTest, PerfTest)
+{
+    auto num_alive_before = Term::get_num_terms_alive();
+    double weak_time;
+    double gc_time;
+    {
+        TermCache weak_cache;
+        weak_time = time_term_churn(weak_cache);
+        EXPECT_EQ(0u, weak_cache.size());
+    }
+    {
+        RefCache<Term> gc_cache;
+        gc_time = time_term_churn(gc_cache);
+        auto start = std::chrono::steady_clock::now();
+        gc_cache.garbage_collect();
+        gc_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(0u, gc_cache.size());
+    }
+    EXPECT_EQ(num_alive_before, Term::get_num_terms_alive());
+    printf("%llu terms: %.3fs with a WeakRefCache, %.3fs with a RefCache\n",
+           (unsigned long long)(PERF_TEST_NUM_ROUNDS * TEST_CHAIN_LENGTH), weak_time, gc_time);
+}
+
+//
+// WeakRefCacheTests.cpp ends here